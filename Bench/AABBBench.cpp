@@ -0,0 +1,45 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/AABB.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t VERTEX_COUNT = 1000000;
+
+	// 1M vertices, an animated mesh whose bounds are recomputed every frame.
+	struct Mesh
+	{
+		std::vector<Mani::Vec3f> vertices = std::vector<Mani::Vec3f>(VERTEX_COUNT);
+		Mani::Vec3fStream stream;
+
+		Mesh()
+		{
+			for (std::size_t i = 0; i < VERTEX_COUNT; ++i)
+			{
+				vertices[i] = v3(i) * static_cast<float>(1 + i % 7);
+			}
+			stream.gather(vertices);
+		}
+	};
+
+	Mesh mesh;
+
+	Mani::AABBf box(std::size_t i)
+	{
+		return Mani::AABBf::merge({ v3(i), v3(i) }, v3(i + 1));
+	}
+}
+
+MANI_BENCH("AABBf::merge",								Mani::AABBf::merge(box(i), box(i + 2)))
+MANI_BENCH("AABBf::transform(Mat4f)",					box(i).transform(m4(i)))
+MANI_BENCH("AABBf::transform(Affine3f)",				box(i).transform(a3(i)))
+MANI_BENCH("Scalar::computeBounds[1M]",					Mani::Scalar::computeBounds<float>(mesh.vertices))
+MANI_BENCH("AABBf::computeBounds[1M]",					Mani::AABBf::computeBounds(mesh.vertices))
+MANI_BENCH("AABBf::computeBounds[1M, threads]",			Mani::AABBf::computeBounds(mesh.vertices, std::thread::hardware_concurrency()))
+MANI_BENCH("AABBf::computeBounds[1M, stream]",			Mani::AABBf::computeBounds(mesh.stream))
@@ -0,0 +1,18 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+using namespace ManiBench;
+
+MANI_BENCH("Affine3f operator*",			a3(i) * a3(i + 1))
+MANI_BENCH("Affine3f::inverse",				a3(i).inverse())
+MANI_BENCH("Affine3f::inverseRigid",		a3(i).inverseRigid())
+MANI_BENCH("Affine3f::transformPoint",		a3(i).transformPoint(v3(i)))
+MANI_BENCH("Affine3f::transformDirection",	a3(i).transformDirection(v3(i)))
+MANI_BENCH("Affine3f::fromTRS",				Mani::Affine3f::fromTRS(v3(i), q(i), v3(i + 1)))
+MANI_BENCH("Affine3f::toQuat",				a3(i).toQuat())
+MANI_BENCH("toAffine3(Mat4f)",				Mani::toAffine3(m4(i)))
+MANI_BENCH("toMat4(Affine3f)",				Mani::toMat4(a3(i)))
+
+// parent * local down a 64 deep chain, the scene graph propagation case.
+MANI_BENCH("Affine3f chain[64]",	([&]() { Mani::Affine3f r = a3(i); for (std::size_t b = 1; b < 64; ++b) { r = r * a3(i + b); } return r; }()))
+MANI_BENCH("Mat4f chain[64]",		([&]() { Mani::Mat4f r = m4(i); for (std::size_t b = 1; b < 64; ++b) { r = r * m4(i + b); } return r; }()))
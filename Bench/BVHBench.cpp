@@ -0,0 +1,124 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/BVH.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	// bumpy grid of size x size quads, 2 triangles each.
+	struct GridMesh
+	{
+		std::vector<Mani::Vec3f> vertices;
+		std::vector<Mani::BVHf::Index> indices;
+		uint32_t size;
+
+		explicit GridMesh(uint32_t gridSize) : size(gridSize)
+		{
+			for (uint32_t y = 0; y <= size; ++y)
+			{
+				for (uint32_t x = 0; x <= size; ++x)
+				{
+					vertices.push_back({ static_cast<float>(x), Mani::Math::sin(x * .7f) * Mani::Math::cos(y * .4f), static_cast<float>(y) });
+				}
+			}
+			for (uint32_t y = 0; y < size; ++y)
+			{
+				for (uint32_t x = 0; x < size; ++x)
+				{
+					const uint32_t i = y * (size + 1) + x;
+					indices.insert(indices.end(), { i, i + size + 1, i + 1, i + 1, i + size + 1, i + size + 2 });
+				}
+			}
+		}
+	};
+
+	// 708 x 708 quads, 1M triangles.
+	GridMesh mesh(708);
+	// 180 x 180 quads, 64k triangles, builds are too slow to be run thousands of times at 1M.
+	GridMesh smallMesh(180);
+	Mani::BVHf bvh = Mani::BVHf::fromTriangles(mesh.vertices, mesh.indices);
+
+	// picking like rays, from above the mesh looking down at a random angle.
+	Mani::Rayf ray(std::size_t i)
+	{
+		const Mani::Vec3f origin = { unitf(i) * 708.f, 20.f, unitf(i + 1) * 708.f };
+		return Mani::Rayf::make(origin, Mani::Vec3f{ f(i), -2.f, f(i + 1) }.normalize());
+	}
+
+	float closestHit(std::size_t i)
+	{
+		Mani::BVHf::Hit hit;
+		bvh.closestHit(ray(i), mesh.vertices, mesh.indices, hit);
+		return hit.t;
+	}
+
+	// closest hit by testing every triangle, what the queries replace.
+	float linearScan(std::size_t i)
+	{
+		const Mani::Rayf r = ray(i);
+		float closest = std::numeric_limits<float>::max();
+		for (std::size_t tri = 0; tri < mesh.indices.size(); tri += 3)
+		{
+			float t, u, v;
+			if (r.intersectTriangle(mesh.vertices[mesh.indices[tri]], mesh.vertices[mesh.indices[tri + 1]], mesh.vertices[mesh.indices[tri + 2]], t, u, v) && t < closest)
+			{
+				closest = t;
+			}
+		}
+		return closest;
+	}
+
+	// lightmap like coherent rays: 8 neighbour texels 5cm apart, all facing the same way.
+	Mani::Rayf coherentRay(std::size_t i, std::size_t lane)
+	{
+		const Mani::Vec3f origin = { unitf(i) * 700.f + lane * .05f, 20.f, unitf(i + 1) * 700.f };
+		return Mani::Rayf::make(origin, Mani::Vec3f{ f(i), -2.f, f(i + 1) }.normalize());
+	}
+
+	float singleRays(std::size_t i)
+	{
+		float sum = 0.f;
+		for (std::size_t lane = 0; lane < 8; ++lane)
+		{
+			Mani::BVHf::Hit hit;
+			bvh.closestHit(coherentRay(i, lane), mesh.vertices, mesh.indices, hit);
+			sum += hit.t;
+		}
+		return sum;
+	}
+
+	float packetRays(std::size_t i)
+	{
+		Mani::RayPacket8f packet;
+		for (std::size_t lane = 0; lane < 8; ++lane)
+		{
+			packet.set(lane, coherentRay(i, lane));
+		}
+		Mani::BVHf::Hit hits[8];
+		bvh.closestHit(packet, mesh.vertices, mesh.indices, hits);
+		return hits[0].t + hits[7].t;
+	}
+
+	std::size_t overlap(std::size_t i)
+	{
+		const Mani::Vec3f center = { unitf(i) * 708.f, 0.f, unitf(i + 1) * 708.f };
+		std::size_t count = 0;
+		bvh.overlapTriangles(Mani::AABBf::fromCenterExtents(center, { 4.f, 2.f, 4.f }), mesh.vertices, mesh.indices, [&count](uint32_t) { ++count; });
+		return count;
+	}
+}
+
+MANI_BENCH("BVHf::fromTriangles[64k]",					Mani::BVHf::fromTriangles(smallMesh.vertices, smallMesh.indices).getNodes().size())
+MANI_BENCH("BVHf::fromTriangles[64k, threads]",			Mani::BVHf::fromTriangles(smallMesh.vertices, smallMesh.indices, std::thread::hardware_concurrency()).getNodes().size())
+MANI_BENCH("BVHf::refitTriangles[1M]",					(bvh.refitTriangles(mesh.vertices, mesh.indices), bvh.getBounds().max.x))
+MANI_BENCH("BVHf::closestHit[1M]",						closestHit(i))
+MANI_BENCH("BVHf::closestHit[1M, 8 coherent rays]",		singleRays(i))
+MANI_BENCH("BVHf::closestHit[1M, RayPacket8f]",			packetRays(i))
+MANI_BENCH("BVHf::anyHit[1M]",							bvh.anyHit(ray(i), mesh.vertices, mesh.indices))
+MANI_BENCH("BVHf::overlapTriangles[1M, 8x8 box]",		overlap(i))
+MANI_BENCH("linear scan closestHit[1M]",				linearScan(i))
@@ -0,0 +1,92 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Batch.h"
+
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t BATCH_COUNT = 1000000;
+
+	// 1M matrices and quaternions, built on first use.
+	struct Batches
+	{
+		std::vector<Mani::Mat4f> lhs = std::vector<Mani::Mat4f>(BATCH_COUNT);
+		std::vector<Mani::Mat4f> rhs = std::vector<Mani::Mat4f>(BATCH_COUNT);
+		std::vector<Mani::Mat4f> matrices = std::vector<Mani::Mat4f>(BATCH_COUNT);
+		std::vector<Mani::Quatf> q1 = std::vector<Mani::Quatf>(BATCH_COUNT);
+		std::vector<Mani::Quatf> q2 = std::vector<Mani::Quatf>(BATCH_COUNT);
+		std::vector<Mani::Quatf> quats = std::vector<Mani::Quatf>(BATCH_COUNT);
+		std::vector<Mani::Vec3f> points = std::vector<Mani::Vec3f>(BATCH_COUNT);
+
+		Batches()
+		{
+			for (std::size_t i = 0; i < BATCH_COUNT; ++i)
+			{
+				lhs[i] = m4(i);
+				rhs[i] = m4(i * 7 + 3);
+				q1[i] = Mani::Quatf{ randomFloat(), randomFloat(), randomFloat(), randomFloat() }.normalize();
+				q2[i] = Mani::Quatf{ randomFloat(), randomFloat(), randomFloat(), randomFloat() }.normalize();
+				points[i] = { randomFloat(), randomFloat(), randomFloat() };
+			}
+		}
+
+		float multiply(const Mani::ExecutionPolicy& policy)
+		{
+			Mani::Batchf::multiply(policy, lhs, rhs, matrices);
+			return matrices[0]._00;
+		}
+
+		float inverse(const Mani::ExecutionPolicy& policy)
+		{
+			Mani::Batchf::inverse(policy, lhs, matrices);
+			return matrices[0]._00;
+		}
+
+		float transformPoints(const Mani::ExecutionPolicy& policy)
+		{
+			std::span<Mani::Vec3f> out(reinterpret_cast<Mani::Vec3f*>(matrices.data()), BATCH_COUNT);
+			Mani::Batchf::transformPoints(policy, lhs[0], points, out);
+			return out[0].x;
+		}
+
+		float normalize(const Mani::ExecutionPolicy& policy)
+		{
+			Mani::Batchf::normalize(policy, q1, quats);
+			return quats[0].x;
+		}
+
+		float slerp(const Mani::ExecutionPolicy& policy)
+		{
+			Mani::Batchf::slerp(policy, q1, q2, .3f, quats);
+			return quats[0].x;
+		}
+	};
+
+	Batches& batches()
+	{
+		static Batches instance;
+		return instance;
+	}
+
+	constexpr Mani::ExecutionPolicy sequential = Mani::ExecutionPolicy::sequential();
+	constexpr Mani::ExecutionPolicy vectorized = Mani::ExecutionPolicy::vectorized();
+	constexpr Mani::ExecutionPolicy parallel = Mani::ExecutionPolicy::parallel();
+}
+
+MANI_BENCH("Batchf::multiply[1M, sequential]",			batches().multiply(sequential))
+MANI_BENCH("Batchf::multiply[1M, vectorized]",			batches().multiply(vectorized))
+MANI_BENCH("Batchf::multiply[1M, parallel]",			batches().multiply(parallel))
+MANI_BENCH("Batchf::inverse[1M, sequential]",			batches().inverse(sequential))
+MANI_BENCH("Batchf::inverse[1M, parallel]",				batches().inverse(parallel))
+MANI_BENCH("Batchf::transformPoints[1M, sequential]",	batches().transformPoints(sequential))
+MANI_BENCH("Batchf::transformPoints[1M, vectorized]",	batches().transformPoints(vectorized))
+MANI_BENCH("Batchf::transformPoints[1M, parallel]",		batches().transformPoints(parallel))
+MANI_BENCH("Batchf::normalize[1M, sequential]",			batches().normalize(sequential))
+MANI_BENCH("Batchf::normalize[1M, parallel]",			batches().normalize(parallel))
+MANI_BENCH("Batchf::slerp[1M, sequential]",				batches().slerp(sequential))
+MANI_BENCH("Batchf::slerp[1M, vectorized]",				batches().slerp(vectorized))
+MANI_BENCH("Batchf::slerp[1M, parallel]",				batches().slerp(parallel))
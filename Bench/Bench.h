@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// minimal microbenchmark harness: every benchmark is an expression evaluated for an input index,
+// timed over warmed up samples and summarized as ns/op, ops/sec, median and p99.
+namespace ManiBench
+{
+	struct Result
+	{
+		std::string name;
+		uint64_t opsPerSample = 0;
+		uint32_t samples = 0;
+		double nsPerOp = 0.0;		// mean
+		double opsPerSec = 0.0;		// from the median
+		double medianNs = 0.0;
+		double p99Ns = 0.0;
+		double minNs = 0.0;
+	};
+
+	struct Settings
+	{
+		uint32_t samples = 50;
+		std::chrono::nanoseconds warmup = std::chrono::milliseconds(20);
+		std::chrono::nanoseconds minSampleTime = std::chrono::microseconds(500);
+	};
+
+	// keeps the compiler from discarding a value that is otherwise unused.
+	template<typename T>
+	inline void doNotOptimize(const T& value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		static const volatile void* sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		if constexpr (sizeof(T) <= sizeof(void*))
+		{
+			asm volatile("" : : "r,m"(value) : "memory");
+		}
+		else
+		{
+			asm volatile("" : : "m"(value) : "memory");
+		}
+#endif
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	// runs fn(i) ops times, i cycling through the input pools.
+	template<typename TFunction>
+	inline double timeOps(TFunction& fn, uint64_t ops)
+	{
+		const Clock::time_point start = Clock::now();
+		for (uint64_t i = 0; i < ops; ++i)
+		{
+			doNotOptimize(fn(static_cast<std::size_t>(i)));
+		}
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+	}
+
+	template<typename TFunction>
+	Result run(const std::string& name, TFunction fn, const Settings& settings)
+	{
+		// warm up caches and branch predictors, and find how many ops fill a sample.
+		uint64_t ops = 64;
+		const Clock::time_point warmupStart = Clock::now();
+		while (Clock::now() - warmupStart < settings.warmup)
+		{
+			const double elapsed = timeOps(fn, ops);
+			if (elapsed < static_cast<double>(settings.minSampleTime.count()))
+			{
+				ops *= 2;
+			}
+		}
+
+		std::vector<double> nsPerOp;
+		nsPerOp.reserve(settings.samples);
+		for (uint32_t sample = 0; sample < settings.samples; ++sample)
+		{
+			nsPerOp.push_back(timeOps(fn, ops) / static_cast<double>(ops));
+		}
+		std::sort(nsPerOp.begin(), nsPerOp.end());
+
+		Result result;
+		result.name = name;
+		result.opsPerSample = ops;
+		result.samples = settings.samples;
+		for (const double ns : nsPerOp)
+		{
+			result.nsPerOp += ns;
+		}
+		result.nsPerOp /= static_cast<double>(nsPerOp.size());
+		result.medianNs = nsPerOp[nsPerOp.size() / 2];
+		result.p99Ns = nsPerOp[std::min(nsPerOp.size() - 1, (nsPerOp.size() * 99) / 100)];
+		result.minNs = nsPerOp.front();
+		result.opsPerSec = result.medianNs > 0.0 ? 1e9 / result.medianNs : 0.0;
+		return result;
+	}
+
+	struct Registry
+	{
+		std::vector<std::function<Result(const Settings&)>> benchmarks;
+		std::vector<std::string> names;
+
+		static Registry& get()
+		{
+			static Registry registry;
+			return registry;
+		}
+	};
+
+	template<typename TFunction>
+	inline bool add(const char* name, TFunction fn)
+	{
+		Registry::get().names.push_back(name);
+		Registry::get().benchmarks.push_back([name, fn](const Settings& settings) { return run(name, fn, settings); });
+		return true;
+	}
+
+	inline void writeJson(FILE* file, const std::vector<Result>& results)
+	{
+		std::fprintf(file, "{\n\t\"unit\": \"ns\",\n\t\"benchmarks\": [\n");
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			const Result& r = results[i];
+			std::fprintf(file, "\t\t{ \"name\": \"%s\", \"samples\": %u, \"opsPerSample\": %llu, \"nsPerOp\": %.4f, \"opsPerSec\": %.1f, \"median\": %.4f, \"p99\": %.4f, \"min\": %.4f }%s\n",
+				r.name.c_str(), r.samples, static_cast<unsigned long long>(r.opsPerSample), r.nsPerOp, r.opsPerSec, r.medianNs, r.p99Ns, r.minNs,
+				i + 1 < results.size() ? "," : "");
+		}
+		std::fprintf(file, "\t]\n}\n");
+	}
+}
+
+#define MANI_BENCH_CONCAT_IMPL(A, B) A##B
+#define MANI_BENCH_CONCAT(A, B) MANI_BENCH_CONCAT_IMPL(A, B)
+
+// registers EXPRESSION, evaluated with the input index i in scope.
+#define MANI_BENCH(NAME, EXPRESSION) \
+	static const bool MANI_BENCH_CONCAT(maniBench_, __LINE__) = ManiBench::add(NAME, []([[maybe_unused]] std::size_t i) { return EXPRESSION; });
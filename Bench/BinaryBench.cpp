@@ -0,0 +1,70 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Binary.h"
+
+#include <filesystem>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t BINARY_COUNT = 1000000;
+
+	// 1M matrices, 64 MB once written, built on first use.
+	struct Replay
+	{
+		std::vector<Mani::Mat4f> matrices = std::vector<Mani::Mat4f>(BINARY_COUNT);
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "mani_bench_replay.mani";
+
+		Replay()
+		{
+			for (std::size_t i = 0; i < BINARY_COUNT; ++i)
+			{
+				matrices[i] = m4(i);
+			}
+			Mani::Binary::write<Mani::Mat4f>(path, matrices);
+		}
+
+		~Replay()
+		{
+			std::filesystem::remove(path);
+		}
+
+		bool write()
+		{
+			return Mani::Binary::write<Mani::Mat4f>(path, matrices);
+		}
+
+		// mapping is lazy, reading every matrix once is part of the cost.
+		float read(Mani::Binary::Verify verify)
+		{
+			Mani::Binary::MappedArray<Mani::Mat4f> mapped;
+			mapped.open(path, verify);
+			mapped.advise(Mani::AccessPattern::Sequential);
+			float sum = 0.f;
+			for (const Mani::Mat4f& matrix : mapped.getValues())
+			{
+				sum += matrix._30;
+			}
+			return sum;
+		}
+
+		std::uint64_t checksum()
+		{
+			return Mani::Binary::checksum(std::as_bytes(std::span<const Mani::Mat4f>(matrices)));
+		}
+	};
+
+	Replay& replay()
+	{
+		static Replay instance;
+		return instance;
+	}
+}
+
+MANI_BENCH("Binary::write[1M Mat4f]",				replay().write())
+MANI_BENCH("Binary::MappedArray[1M Mat4f]",			replay().read(Mani::Binary::Verify::Header))
+MANI_BENCH("Binary::MappedArray[1M Mat4f, checksum]",	replay().read(Mani::Binary::Verify::Checksum))
+MANI_BENCH("Binary::checksum[64 MB]",				replay().checksum())
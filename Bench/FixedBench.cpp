@@ -0,0 +1,46 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+using namespace ManiBench;
+
+namespace
+{
+	using Fixed = Mani::Fixed16_16;
+
+	// the float pools converted, same values on both sides.
+	const Pool<Fixed> fixeds([]() { static std::size_t i = 0; return Fixed(floats[i++]); });
+	const Pool<Fixed> unitFixeds([]() { static std::size_t i = 0; return Fixed(unitFloats[i++]); });
+	const Pool<Fixed> positiveFixeds([]() { static std::size_t i = 0; return Fixed(positiveFloats[i++]); });
+	const Pool<Mani::Vec3x> vec3xs([]() { static std::size_t i = 0; const Mani::Vec3f& v = vec3fs[i++]; return Mani::Vec3x{ v.x, v.y, v.z }; });
+	const Pool<Mani::Quatx> quatxs([]() { static std::size_t i = 0; const Mani::Quatf& q = quatfs[i++]; return Mani::Quatx{ q.x, q.y, q.z, q.w }; });
+
+	Fixed x(std::size_t i) { return fixeds[i]; }
+	Fixed unitx(std::size_t i) { return unitFixeds[i]; }
+	Fixed positivex(std::size_t i) { return positiveFixeds[i]; }
+
+	// sum of products over the whole pool, the integer throughput against float's.
+	template<typename T>
+	T mulAdd(const Pool<T>& values)
+	{
+		T sum = 0;
+		for (std::size_t i = 0; i < POOL_SIZE; ++i)
+		{
+			sum += values[i] * values[i + 1];
+		}
+		return sum;
+	}
+}
+
+MANI_BENCH("Fixed::mul",			x(i) * x(i + 1))
+MANI_BENCH("Fixed::div",			x(i) / positivex(i))
+MANI_BENCH("Fixed::mulAdd[1024]",	mulAdd(fixeds))
+MANI_BENCH("float::mulAdd[1024]",	mulAdd(floats))
+MANI_BENCH("Fixed::sin",			Mani::Math::sin(x(i)))
+MANI_BENCH("Fixed::cos",			Mani::Math::cos(x(i)))
+MANI_BENCH("Fixed::tan",			Mani::Math::tan(unitx(i)))
+MANI_BENCH("Fixed::atan",			Mani::Math::atan(x(i)))
+MANI_BENCH("Fixed::acos",			Mani::Math::acos(unitx(i)))
+MANI_BENCH("Fixed::sqrt",			Mani::Math::sqrt(positivex(i)))
+MANI_BENCH("Vec3x::dot",			vec3xs[i].dot(vec3xs[i + 1]))
+MANI_BENCH("Vec3x::normalize",		vec3xs[i].normalize())
+MANI_BENCH("Quatx::rotate",			quatxs[i].rotate(vec3xs[i]))
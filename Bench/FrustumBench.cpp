@@ -0,0 +1,49 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Frustum.h"
+
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t OBJECT_COUNT = 500000;
+
+	// 500k objects scattered around the camera, roughly a third of them visible.
+	struct CullingScene
+	{
+		Mani::Frustumf frustum;
+		Mani::Vec3fStream centers = Mani::Vec3fStream::make(OBJECT_COUNT);
+		Mani::Vec3fStream extents = Mani::Vec3fStream::make(OBJECT_COUNT);
+		Mani::Vec3fStream mins = Mani::Vec3fStream::make(OBJECT_COUNT);
+		Mani::Vec3fStream maxs = Mani::Vec3fStream::make(OBJECT_COUNT);
+		std::vector<float> radii = std::vector<float>(OBJECT_COUNT);
+		std::vector<uint64_t> mask = std::vector<uint64_t>(Mani::Frustumf::maskSize(OBJECT_COUNT));
+
+		CullingScene()
+		{
+			const Mani::Mat4f view = Mani::Mat4f::lookAt({ 0.f, 0.f, 0.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f, 0.f });
+			const Mani::Mat4f projection = Mani::Mat4f::perspective(Mani::Math::degToRad(70.f), 16.f / 9.f, .1f, 100.f);
+			frustum = Mani::Frustumf::fromMatrix(projection * view);
+			for (std::size_t i = 0; i < OBJECT_COUNT; ++i)
+			{
+				centers.set(i, v3(i) * 10.f);
+				extents.set(i, { positivef(i), positivef(i + 1), positivef(i + 2) });
+				radii[i] = positivef(i);
+				mins.set(i, centers.get(i) - extents.get(i));
+				maxs.set(i, centers.get(i) + extents.get(i));
+			}
+		}
+	};
+
+	CullingScene scene;
+}
+
+MANI_BENCH("Frustumf::fromMatrix",						Mani::Frustumf::fromMatrix(m4(i)))
+MANI_BENCH("Frustumf::intersectsSphere",				scene.frustum.intersectsSphere(v3(i) * 10.f, positivef(i)))
+MANI_BENCH("Frustumf::intersectsAABB",					scene.frustum.intersectsAABB(v3(i) * 10.f, v3(i) * 10.f + v3(i + 1)))
+MANI_BENCH("Frustumf::cullSpheres[500k]",				scene.frustum.cullSpheres(scene.centers, scene.radii, scene.mask))
+MANI_BENCH("Frustumf::cullCenterExtents[500k]",			scene.frustum.cullCenterExtents(scene.centers, scene.extents, scene.mask))
+MANI_BENCH("Frustumf::cullAABBs[500k]",					scene.frustum.cullAABBs(scene.mins, scene.maxs, scene.mask))
@@ -0,0 +1,86 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Half.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t HALF_COUNT = 1000000;
+
+	// 1M positions with their 16 bits forms, built on first use.
+	struct Halves
+	{
+		std::vector<Mani::Vec3f> positions = std::vector<Mani::Vec3f>(HALF_COUNT);
+		std::vector<Mani::Vec3f> converted = std::vector<Mani::Vec3f>(HALF_COUNT);
+		std::vector<Mani::Vec3h> halves = std::vector<Mani::Vec3h>(HALF_COUNT);
+		std::vector<Mani::Vec3bf> bfloats = std::vector<Mani::Vec3bf>(HALF_COUNT);
+
+		Halves()
+		{
+			for (std::size_t i = 0; i < HALF_COUNT; ++i)
+			{
+				positions[i] = Mani::Vec3f{ randomFloat(), randomFloat(), randomFloat() } * 1000.f;
+			}
+			Mani::convert(positions, halves);
+			Mani::convert(positions, bfloats);
+		}
+
+		float copy()
+		{
+			std::copy(positions.begin(), positions.end(), converted.begin());
+			return converted[0].x;
+		}
+
+		// one component at a time, what the batches compete with.
+		float toHalfScalar()
+		{
+			for (std::size_t i = 0; i < HALF_COUNT; ++i)
+			{
+				halves[i] = { positions[i].x, positions[i].y, positions[i].z };
+			}
+			return halves[0].x;
+		}
+
+		float toHalf()
+		{
+			Mani::convert(positions, halves);
+			return halves[0].x;
+		}
+
+		float fromHalf()
+		{
+			Mani::convert(halves, converted);
+			return converted[0].x;
+		}
+
+		float toBFloat16()
+		{
+			Mani::convert(positions, bfloats);
+			return bfloats[0].x;
+		}
+
+		float fromBFloat16()
+		{
+			Mani::convert(bfloats, converted);
+			return converted[0].x;
+		}
+	};
+
+	Halves& halves()
+	{
+		static Halves instance;
+		return instance;
+	}
+}
+
+MANI_BENCH("Half::copy[1M Vec3f]",				halves().copy())
+MANI_BENCH("Half::toHalf[1M Vec3f, scalar]",	halves().toHalfScalar())
+MANI_BENCH("Half::toHalf[1M Vec3f]",			halves().toHalf())
+MANI_BENCH("Half::fromHalf[1M Vec3h]",			halves().fromHalf())
+MANI_BENCH("BFloat16::toBFloat16[1M Vec3f]",	halves().toBFloat16())
+MANI_BENCH("BFloat16::fromBFloat16[1M Vec3bf]",	halves().fromBFloat16())
@@ -0,0 +1,54 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/TransformHierarchy.h"
+
+#include <thread>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t HIERARCHY_SIZE = 100000;
+
+	// 100k nodes, 16 roots with 4 children per node, added breadth first like a scene loader would.
+	Mani::TransformHierarchyf makeHierarchy()
+	{
+		Mani::TransformHierarchyf hierarchy;
+		hierarchy.reserve(HIERARCHY_SIZE);
+		for (std::size_t i = 0; i < HIERARCHY_SIZE; ++i)
+		{
+			const auto parent = i < 16 ? Mani::TransformHierarchyf::INVALID_INDEX : static_cast<Mani::TransformHierarchyf::Index>((i - 16) / 4);
+			hierarchy.add(parent, v3(i), q(i), { 1.f, 1.f, 1.f });
+		}
+		hierarchy.update();
+		return hierarchy;
+	}
+
+	Mani::TransformHierarchyf hierarchy = makeHierarchy();
+
+	// one op updates the whole hierarchy, after moving every node or 1% of them.
+	float updateAll(std::size_t i, std::size_t threadCount)
+	{
+		for (Mani::TransformHierarchyf::Index n = 0; n < HIERARCHY_SIZE; ++n)
+		{
+			hierarchy.setLocalTranslation(n, v3(i + n));
+		}
+		hierarchy.update(threadCount);
+		return hierarchy.getWorld(static_cast<Mani::TransformHierarchyf::Index>(i % HIERARCHY_SIZE))._30;
+	}
+
+	float updateSome(std::size_t i)
+	{
+		for (std::size_t n = 0; n < HIERARCHY_SIZE / 100; ++n)
+		{
+			hierarchy.setLocalTranslation(static_cast<Mani::TransformHierarchyf::Index>((i * 7919 + n * 104729) % HIERARCHY_SIZE), v3(i + n));
+		}
+		hierarchy.update();
+		return hierarchy.getWorld(static_cast<Mani::TransformHierarchyf::Index>(i % HIERARCHY_SIZE))._30;
+	}
+}
+
+MANI_BENCH("TransformHierarchy::update[100k all dirty]",			updateAll(i, 1))
+MANI_BENCH("TransformHierarchy::update[100k all dirty, threads]",	updateAll(i, std::thread::hardware_concurrency()))
+MANI_BENCH("TransformHierarchy::update[100k 1% dirty]",				updateSome(i))
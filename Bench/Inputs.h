@@ -0,0 +1,117 @@
+#pragma once
+
+#include "ManiMaths/Fwd.h"
+
+#include <array>
+#include <cstdlib>
+
+// pools of random inputs indexed by the benchmark loop counter, so that every op works on fresh data
+// and the compiler can't constant fold anything.
+namespace ManiBench
+{
+	constexpr std::size_t POOL_SIZE = 1024;
+	static_assert((POOL_SIZE & (POOL_SIZE - 1)) == 0, "pool size must be a power of 2");
+
+	template<typename T>
+	struct Pool
+	{
+		std::array<T, POOL_SIZE> values;
+
+		template<typename TGenerator>
+		explicit Pool(TGenerator generator)
+		{
+			for (T& value : values)
+			{
+				value = generator();
+			}
+		}
+
+		const T& operator[](std::size_t i) const { return values[i & (POOL_SIZE - 1)]; }
+	};
+
+	inline float randomFloat(float min = -10.f, float max = 10.f)
+	{
+		return Mani::Math::linearRand(min, max);
+	}
+
+	inline const Pool<float> floats([]() { return randomFloat(); });
+
+	// [-1, 1], for acos/asin.
+	inline const Pool<float> unitFloats([]() { return randomFloat(-1.f, 1.f); });
+
+	// (0, 10], for divisions and sqrt.
+	inline const Pool<float> positiveFloats([]() { return randomFloat(.001f, 10.f); });
+
+	inline const Pool<Mani::Vec2f> vec2fs([]() { return Mani::Vec2f{ randomFloat(), randomFloat() }; });
+
+	inline const Pool<Mani::Vec3f> vec3fs([]() { return Mani::Vec3f{ randomFloat(), randomFloat(), randomFloat() }; });
+
+	inline const Pool<Mani::Vec4f> vec4fs([]() { return Mani::Vec4f{ randomFloat(), randomFloat(), randomFloat(), randomFloat() }; });
+
+	inline const Pool<Mani::Quatf> quatfs([]() { return Mani::Quatf{ randomFloat(), randomFloat(), randomFloat(), randomFloat() }.normalize(); });
+
+	// rigid transforms, always invertible.
+	inline const Pool<Mani::Mat4f> mat4fs([]()
+	{
+		return Mani::MAT4F::IDENTITY
+			.translate(Mani::Vec3f{ randomFloat(), randomFloat(), randomFloat() })
+			.rotate(Mani::Quatf{ randomFloat(), randomFloat(), randomFloat(), randomFloat() }.normalize());
+	});
+
+	// same transforms as mat4fs.
+	inline const Pool<Mani::Affine3f> affine3fs([]() { static std::size_t i = 0; return Mani::toAffine3(mat4fs[i++]); });
+
+	inline const Pool<Mani::Mat3f> mat3fs([]() { return Mani::toMat3(Mani::Quatf{ randomFloat(), randomFloat(), randomFloat(), randomFloat() }.normalize()); });
+
+	inline const Pool<Mani::Vec<float, 8>> vec8fs([]()
+	{
+		Mani::Vec<float, 8> v;
+		for (float& value : v.data)
+		{
+			value = randomFloat();
+		}
+		return v;
+	});
+
+	// diagonally dominant, always invertible.
+	inline const Pool<Mani::Mat<float, 6, 6>> mat6fs([]()
+	{
+		Mani::Mat<float, 6, 6> m;
+		for (float& value : m.data)
+		{
+			value = randomFloat(-1.f, 1.f);
+		}
+		for (Mani::Size i = 0; i < 6; ++i)
+		{
+			m[i][i] += 10.f;
+		}
+		return m;
+	});
+
+	inline const Pool<Mani::Mat<float, 3, 4>> mat34fs([]()
+	{
+		Mani::Mat<float, 3, 4> m;
+		for (float& value : m.data)
+		{
+			value = randomFloat();
+		}
+		return m;
+	});
+
+	// output buffer for the batch benchmarks, one op processes the whole pool.
+	inline std::array<float, POOL_SIZE> scratchFloats;
+
+	inline float f(std::size_t i) { return floats[i]; }
+	inline float unitf(std::size_t i) { return unitFloats[i]; }
+	inline float positivef(std::size_t i) { return positiveFloats[i]; }
+	inline const Mani::Vec2f& v2(std::size_t i) { return vec2fs[i]; }
+	inline const Mani::Vec3f& v3(std::size_t i) { return vec3fs[i]; }
+	inline const Mani::Vec4f& v4(std::size_t i) { return vec4fs[i]; }
+	inline const Mani::Quatf& q(std::size_t i) { return quatfs[i]; }
+	inline const Mani::Mat3f& m3(std::size_t i) { return mat3fs[i]; }
+	inline const Mani::Mat4f& m4(std::size_t i) { return mat4fs[i]; }
+	inline const Mani::Affine3f& a3(std::size_t i) { return affine3fs[i]; }
+	inline const Mani::Vec<float, 8>& v8(std::size_t i) { return vec8fs[i]; }
+	inline const Mani::Mat<float, 6, 6>& m6(std::size_t i) { return mat6fs[i]; }
+	inline const Mani::Mat<float, 3, 4>& m34(std::size_t i) { return mat34fs[i]; }
+}
@@ -0,0 +1,83 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/KdTree.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t CLOUD_SIZE = 10000000;
+	constexpr std::size_t BUILD_SIZE = 1000000;
+	constexpr std::size_t BATCH_SIZE = 1024;
+
+	// 10M point cloud in a 100 units cube. built on first use, its build alone takes seconds.
+	struct Cloud
+	{
+		std::vector<Mani::Vec3f> points = std::vector<Mani::Vec3f>(CLOUD_SIZE);
+		Mani::KdTree3f tree;
+		std::vector<Mani::Vec3f> queries = std::vector<Mani::Vec3f>(BATCH_SIZE);
+		std::vector<uint32_t> results = std::vector<uint32_t>(BATCH_SIZE * 8);
+
+		Cloud()
+		{
+			for (std::size_t i = 0; i < CLOUD_SIZE; ++i)
+			{
+				points[i] = { randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f) };
+			}
+			tree = Mani::KdTree3f::build(points, std::thread::hardware_concurrency());
+			for (std::size_t i = 0; i < BATCH_SIZE; ++i)
+			{
+				queries[i] = { randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f) };
+			}
+		}
+
+		std::size_t bruteForce(std::size_t i) const
+		{
+			const Mani::Vec3f& query = queries[i % BATCH_SIZE];
+			std::size_t nearest = 0;
+			float best = points[0].distanceSquared(query);
+			for (std::size_t p = 1; p < points.size(); ++p)
+			{
+				const float distanceSquared = points[p].distanceSquared(query);
+				nearest = distanceSquared < best ? p : nearest;
+				best = distanceSquared < best ? distanceSquared : best;
+			}
+			return nearest;
+		}
+
+		std::size_t kNearest(std::size_t i)
+		{
+			return tree.queryKNearest(queries[i % BATCH_SIZE], std::span(results).first(8));
+		}
+
+		std::size_t batch(std::size_t threadCount)
+		{
+			tree.queryKNearest(queries, 8, results, threadCount);
+			return results[0];
+		}
+	};
+
+	Cloud& cloud()
+	{
+		static Cloud instance;
+		return instance;
+	}
+
+	const std::vector<Mani::Vec3f>& buildPoints()
+	{
+		static const std::vector<Mani::Vec3f> points(cloud().points.begin(), cloud().points.begin() + BUILD_SIZE);
+		return points;
+	}
+}
+
+MANI_BENCH("KdTree3f::queryNearest[10M]",					cloud().tree.queryNearest(cloud().queries[i % BATCH_SIZE]))
+MANI_BENCH("KdTree3f::queryKNearest[10M, 8]",				cloud().kNearest(i))
+MANI_BENCH("KdTree3f::queryKNearest[10M, 8, batch 1024]",	cloud().batch(1))
+MANI_BENCH("KdTree3f::queryKNearest[10M, 8, batch 1024, threads]",	cloud().batch(std::thread::hardware_concurrency()))
+MANI_BENCH("bruteForce nearest[10M]",						cloud().bruteForce(i))
+MANI_BENCH("KdTree3f::build[1M]",							Mani::KdTree3f::build(buildPoints()).size())
+MANI_BENCH("KdTree3f::build[1M, threads]",					Mani::KdTree3f::build(buildPoints(), std::thread::hardware_concurrency()).size())
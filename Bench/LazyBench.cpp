@@ -0,0 +1,87 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Lazy.h"
+
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t PARTICLE_COUNT = 65536;
+
+	// semi-implicit euler step of 64k particles: v += (g + f * invMass) * dt, p += v * dt.
+	struct Particles
+	{
+		std::vector<Mani::Vec3f> positions = std::vector<Mani::Vec3f>(PARTICLE_COUNT);
+		std::vector<Mani::Vec3f> velocities = std::vector<Mani::Vec3f>(PARTICLE_COUNT);
+		std::vector<float> inverseMasses = std::vector<float>(PARTICLE_COUNT);
+		std::vector<Mani::Vec3f> accelerations = std::vector<Mani::Vec3f>(PARTICLE_COUNT);
+		Mani::Vec3f gravity = { 0.f, -9.81f, 0.f };
+		Mani::Vec3f force = { 1.f, 2.f, -.5f };
+		float dt = 1.f / 60.f;
+
+		Particles()
+		{
+			for (std::size_t i = 0; i < PARTICLE_COUNT; ++i)
+			{
+				positions[i] = { randomFloat(), randomFloat(), randomFloat() };
+				velocities[i] = { randomFloat(), randomFloat(), randomFloat() };
+				inverseMasses[i] = randomFloat(.1f, 1.f);
+			}
+		}
+
+		float eager()
+		{
+			for (std::size_t i = 0; i < PARTICLE_COUNT; ++i)
+			{
+				velocities[i] += (gravity + force * inverseMasses[i]) * dt;
+				positions[i] += velocities[i] * dt;
+			}
+			return positions[0].x;
+		}
+
+		// one operator per pass over the arrays, the way whole span operations compose without fusion.
+		float eagerPasses()
+		{
+			for (std::size_t i = 0; i < PARTICLE_COUNT; ++i)
+			{
+				accelerations[i] = force * inverseMasses[i];
+			}
+			for (std::size_t i = 0; i < PARTICLE_COUNT; ++i)
+			{
+				accelerations[i] += gravity;
+			}
+			for (std::size_t i = 0; i < PARTICLE_COUNT; ++i)
+			{
+				velocities[i] += accelerations[i] * dt;
+			}
+			for (std::size_t i = 0; i < PARTICLE_COUNT; ++i)
+			{
+				positions[i] += velocities[i] * dt;
+			}
+			return positions[0].x;
+		}
+
+		float lazy()
+		{
+			Mani::lazy(velocities) += (Mani::lazy(force) * Mani::lazy(inverseMasses) + gravity) * dt;
+			Mani::lazy(positions) += Mani::lazy(velocities) * dt;
+			return positions[0].x;
+		}
+	};
+
+	Particles particles;
+}
+
+// a * s + b * t - c
+MANI_BENCH("Vec3f a * s + b * t - c",				v3(i) * f(i) + v3(i + 1) * f(i + 1) - v3(i + 2))
+MANI_BENCH("lazy Vec3f a * s + b * t - c",			Mani::Vec3f(Mani::lazy(v3(i)) * f(i) + Mani::lazy(v3(i + 1)) * f(i + 1) - v3(i + 2)))
+MANI_BENCH("Quatf a * s + b * t",					q(i) * f(i) + q(i + 1) * f(i + 1))
+MANI_BENCH("lazy Quatf a * s + b * t",				Mani::Quatf(Mani::lazy(q(i)) * f(i) + Mani::lazy(q(i + 1)) * f(i + 1)))
+
+// particles
+MANI_BENCH("integrate[64k]",						particles.eager())
+MANI_BENCH("integrate[64k, one pass per operator]",	particles.eagerPasses())
+MANI_BENCH("lazy integrate[64k]",					particles.lazy())
@@ -0,0 +1,79 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+using namespace ManiBench;
+
+// Mat3f
+MANI_BENCH("Mat3f::getLineAt",			m3(i).getLineAt(static_cast<Mani::Size>(i % 3)))
+MANI_BENCH("Mat3f::setLineAt",			[&]() { Mani::Mat3f m = m3(i); m.setLineAt(static_cast<Mani::Size>(i % 3), v3(i)); return m; }())
+MANI_BENCH("Mat3f::operator[]",			m3(i)[static_cast<Mani::Size>(i % 3)][static_cast<Mani::Size>((i + 1) % 3)])
+MANI_BENCH("Mat3f::make",				Mani::Mat3f::make(f(i)))
+MANI_BENCH("Mat3f::isNearlyEqual",		m3(i).isNearlyEqual(m3(i + 1)))
+MANI_BENCH("Mat3f::transpose",			m3(i).transpose())
+MANI_BENCH("Mat3f::inverse",			m3(i).inverse())
+MANI_BENCH("Mat3f::determinant",		m3(i).determinant())
+MANI_BENCH("Mat3f::operator Mat4f",		static_cast<Mani::Mat4f>(m3(i)))
+MANI_BENCH("Mat3f::toString",			m3(i).toString())
+MANI_BENCH("Mat3f::toStringOnOneLine",	m3(i).toStringOnOneLine())
+MANI_BENCH("Mat3f operator==",			m3(i) == m3(i + 1))
+MANI_BENCH("Mat3f operator!=",			m3(i) != m3(i + 1))
+MANI_BENCH("Mat3f operator+",			m3(i) + m3(i + 1))
+MANI_BENCH("Mat3f operator-",			m3(i) - m3(i + 1))
+MANI_BENCH("Mat3f operator*",			m3(i) * m3(i + 1))
+MANI_BENCH("Mat3f operator*(scalar)",	m3(i) * f(i))
+MANI_BENCH("Mat3f operator/(scalar)",	m3(i) / positivef(i))
+MANI_BENCH("Mat3f operator*(Vec3f)",	m3(i) * v3(i))
+MANI_BENCH("Mat3f operator+=",			[&]() { Mani::Mat3f m = m3(i); m += m3(i + 1); return m; }())
+MANI_BENCH("Mat3f operator-=",			[&]() { Mani::Mat3f m = m3(i); m -= m3(i + 1); return m; }())
+MANI_BENCH("Mat3f operator*=",			[&]() { Mani::Mat3f m = m3(i); m *= m3(i + 1); return m; }())
+MANI_BENCH("Mat3f operator*=(scalar)",	[&]() { Mani::Mat3f m = m3(i); m *= f(i); return m; }())
+MANI_BENCH("Mat3f operator/=(scalar)",	[&]() { Mani::Mat3f m = m3(i); m /= positivef(i); return m; }())
+
+// Mat4f
+MANI_BENCH("Mat4f::getLineAt",			m4(i).getLineAt(static_cast<Mani::Size>(i % 4)))
+MANI_BENCH("Mat4f::setLineAt",			[&]() { Mani::Mat4f m = m4(i); m.setLineAt(static_cast<Mani::Size>(i % 4), v4(i)); return m; }())
+MANI_BENCH("Mat4f::operator[]",			m4(i)[static_cast<Mani::Size>(i % 4)][static_cast<Mani::Size>((i + 1) % 4)])
+MANI_BENCH("Mat4f::make",				Mani::Mat4f::make(f(i)))
+MANI_BENCH("Mat4f::isNearlyEqual",		m4(i).isNearlyEqual(m4(i + 1)))
+MANI_BENCH("Mat4f::isAffine",			m4(i).isAffine())
+MANI_BENCH("Mat4f::transpose",			m4(i).transpose())
+MANI_BENCH("Mat4f::inverse",			m4(i).inverse())
+MANI_BENCH("Mat4f::determinant",		m4(i).determinant())
+MANI_BENCH("Mat4f::operator Mat3f",		static_cast<Mani::Mat3f>(m4(i)))
+MANI_BENCH("Mat4f::translate",			m4(i).translate(v3(i)))
+MANI_BENCH("Mat4f::rotate",				m4(i).rotate(q(i)))
+MANI_BENCH("Mat4f::scale",				m4(i).scale(v3(i)))
+MANI_BENCH("Mat4f::lookAt",				Mani::Mat4f::lookAt(v3(i), v3(i + 1), Mani::Vec3f{ 0.f, 1.f, 0.f }))
+MANI_BENCH("Mat4f::perspective",		Mani::Mat4f::perspective(positivef(i), positivef(i + 1), .1f, 100.f))
+MANI_BENCH("Mat4f::orthographic",		Mani::Mat4f::orthographic(-positivef(i), positivef(i), -positivef(i + 1), positivef(i + 1), .1f, 100.f))
+MANI_BENCH("Mat4f::toString",			m4(i).toString())
+MANI_BENCH("Mat4f::toStringOnOneLine",	m4(i).toStringOnOneLine())
+MANI_BENCH("Mat4f operator==",			m4(i) == m4(i + 1))
+MANI_BENCH("Mat4f operator!=",			m4(i) != m4(i + 1))
+MANI_BENCH("Mat4f operator+",			m4(i) + m4(i + 1))
+MANI_BENCH("Mat4f operator-",			m4(i) - m4(i + 1))
+MANI_BENCH("Mat4f operator*",			m4(i) * m4(i + 1))
+MANI_BENCH("Mat4f Scalar::mul",			Mani::Scalar::mul(m4(i), m4(i + 1)))
+MANI_BENCH("Mat4f operator*(scalar)",	m4(i) * f(i))
+MANI_BENCH("Mat4f operator/(scalar)",	m4(i) / positivef(i))
+MANI_BENCH("Mat4f operator*(Vec4f)",	m4(i) * v4(i))
+MANI_BENCH("Vec4f operator*(Mat4f)",	v4(i) * m4(i))
+MANI_BENCH("Mat4f operator*(Vec3f)",	m4(i) * v3(i))
+MANI_BENCH("Mat4f operator+=",			[&]() { Mani::Mat4f m = m4(i); m += m4(i + 1); return m; }())
+MANI_BENCH("Mat4f operator-=",			[&]() { Mani::Mat4f m = m4(i); m -= m4(i + 1); return m; }())
+MANI_BENCH("Mat4f operator*=",			[&]() { Mani::Mat4f m = m4(i); m *= m4(i + 1); return m; }())
+MANI_BENCH("Mat4f operator*=(scalar)",	[&]() { Mani::Mat4f m = m4(i); m *= f(i); return m; }())
+MANI_BENCH("Mat4f operator/=(scalar)",	[&]() { Mani::Mat4f m = m4(i); m /= positivef(i); return m; }())
+
+MANI_BENCH("Mat4f::classify",			m4(i).classify())
+MANI_BENCH("Mat4f::inverseAffine",		m4(i).inverseAffine())
+MANI_BENCH("Mat4f::inverseRigid",		m4(i).inverseRigid())
+
+// generic sizes
+MANI_BENCH("Mat<float, 6, 6>::transpose",		m6(i).transpose())
+MANI_BENCH("Mat<float, 6, 6>::inverse",			m6(i).inverse())
+MANI_BENCH("Mat<float, 6, 6>::determinant",		m6(i).determinant())
+MANI_BENCH("Mat<float, 6, 6> operator+",		m6(i) + m6(i + 1))
+MANI_BENCH("Mat<float, 6, 6> operator*",		m6(i) * m6(i + 1))
+MANI_BENCH("Mat<float, 3, 4> operator*(Vec4f)",	m34(i) * v4(i))
+MANI_BENCH("Mat<float, 3, 4> * Mat4f",			m34(i) * m4(i))
@@ -0,0 +1,42 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+using namespace ManiBench;
+
+MANI_BENCH("Math::abs",			Mani::Math::abs(f(i)))
+MANI_BENCH("Math::cos",			Mani::Math::cos(f(i)))
+MANI_BENCH("Math::sin",			Mani::Math::sin(f(i)))
+MANI_BENCH("Math::tan",			Mani::Math::tan(f(i)))
+MANI_BENCH("Math::acos",		Mani::Math::acos(unitf(i)))
+MANI_BENCH("Math::asin",		Mani::Math::asin(unitf(i)))
+MANI_BENCH("Math::atan",		Mani::Math::atan(f(i)))
+MANI_BENCH("Math::sqrt",		Mani::Math::sqrt(positivef(i)))
+MANI_BENCH("Math::pow",			Mani::Math::pow(f(i), static_cast<int>(i & 7)))
+MANI_BENCH("Math::minT",		Mani::Math::minT(f(i), f(i + 1)))
+MANI_BENCH("Math::maxT",		Mani::Math::maxT(f(i), f(i + 1)))
+MANI_BENCH("Math::clamp",		Mani::Math::clamp(f(i), -5.f, 5.f))
+MANI_BENCH("Math::isEqual",		Mani::Math::isEqual(f(i), f(i + 1)))
+MANI_BENCH("Math::degToRad",	Mani::Math::degToRad(f(i)))
+MANI_BENCH("Math::radToDeg",	Mani::Math::radToDeg(f(i)))
+MANI_BENCH("Math::linearRand",	Mani::Math::linearRand(-positivef(i), positivef(i)))
+MANI_BENCH("Math::floor",		Mani::Math::floor(f(i)))
+MANI_BENCH("Math::ceil",		Mani::Math::ceil(f(i)))
+MANI_BENCH("Math::floorToInt",	Mani::Math::floorToInt(f(i)))
+MANI_BENCH("Math::ceilToInt",	Mani::Math::ceilToInt(f(i)))
+MANI_BENCH("Math::fmod",		Mani::Math::fmod(f(i), positivef(i)))
+
+MANI_BENCH("Math::fast::sin",		Mani::Math::fast::sin(f(i)))
+MANI_BENCH("Math::fast::cos",		Mani::Math::fast::cos(f(i)))
+MANI_BENCH("Math::fast::atan",		Mani::Math::fast::atan(f(i)))
+MANI_BENCH("Math::fast::atan2",		Mani::Math::fast::atan2(f(i), f(i + 1)))
+MANI_BENCH("Math::fast::acos",		Mani::Math::fast::acos(unitf(i)))
+MANI_BENCH("Math::fast::rsqrt",		Mani::Math::fast::rsqrt(positivef(i)))
+MANI_BENCH("Math::fast::exp",		Mani::Math::fast::exp(f(i)))
+MANI_BENCH("Math::fast::log",		Mani::Math::fast::log(positivef(i)))
+MANI_BENCH("Math::fast::sin[1024]",	(Mani::Math::fast::sin(floats.values, scratchFloats), scratchFloats[i & (POOL_SIZE - 1)]))
+MANI_BENCH("Math::fast::exp[1024]",	(Mani::Math::fast::exp(floats.values, scratchFloats), scratchFloats[i & (POOL_SIZE - 1)]))
+MANI_BENCH("Math::fast::acos[1024]",	(Mani::Math::fast::acos(unitFloats.values, scratchFloats), scratchFloats[i & (POOL_SIZE - 1)]))
+
+MANI_BENCH("Math::sincos",			([&]() { float s, c; Mani::Math::sincos(f(i), s, c); return s + c; }()))
+MANI_BENCH("Math::sin + Math::cos",	Mani::Math::sin(f(i)) + Mani::Math::cos(f(i)))
+MANI_BENCH("Math::sincos[1024]",	([&]() { static std::array<float, POOL_SIZE> cosines; Mani::Math::sincos(floats.values, scratchFloats, cosines); return scratchFloats[i & (POOL_SIZE - 1)] + cosines[i & (POOL_SIZE - 1)]; }()))
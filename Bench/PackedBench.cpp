@@ -0,0 +1,89 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Packed.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t PACKED_COUNT = 1000000;
+
+	// 1M rotations and normals with their packed forms, built on first use.
+	struct Packed
+	{
+		std::vector<Mani::Quatf> rotations = std::vector<Mani::Quatf>(PACKED_COUNT);
+		std::vector<Mani::Quatf> decoded = std::vector<Mani::Quatf>(PACKED_COUNT);
+		std::vector<Mani::Vec3f> normals = std::vector<Mani::Vec3f>(PACKED_COUNT);
+		std::vector<Mani::Vec3f> decodedNormals = std::vector<Mani::Vec3f>(PACKED_COUNT);
+		std::vector<Mani::PackedQuat32> quats32 = std::vector<Mani::PackedQuat32>(PACKED_COUNT);
+		std::vector<Mani::PackedQuat48> quats48 = std::vector<Mani::PackedQuat48>(PACKED_COUNT);
+		std::vector<Mani::PackedQuat64> quats64 = std::vector<Mani::PackedQuat64>(PACKED_COUNT);
+		std::vector<Mani::PackedNormal32> normals32 = std::vector<Mani::PackedNormal32>(PACKED_COUNT);
+
+		Packed()
+		{
+			for (std::size_t i = 0; i < PACKED_COUNT; ++i)
+			{
+				rotations[i] = Mani::Quatf{ randomFloat(), randomFloat(), randomFloat(), randomFloat() }.normalize();
+				normals[i] = Mani::Vec3f{ randomFloat(), randomFloat(), randomFloat() }.normalize();
+			}
+			Mani::encode<32>(rotations, quats32);
+			Mani::encode<48>(rotations, quats48);
+			Mani::encode<64>(rotations, quats64);
+			Mani::encode<32>(normals, normals32);
+		}
+
+		// what decoding competes with: streaming the full quaternions.
+		float copy()
+		{
+			std::copy(rotations.begin(), rotations.end(), decoded.begin());
+			return decoded[0].x;
+		}
+
+		template<std::size_t Bits>
+		float encode(std::vector<Mani::PackedQuat<Bits>>& out)
+		{
+			Mani::encode<Bits>(rotations, out);
+			return static_cast<float>(out[0].getBits());
+		}
+
+		template<std::size_t Bits>
+		float decode(const std::vector<Mani::PackedQuat<Bits>>& in)
+		{
+			Mani::decode<Bits>(in, decoded);
+			return decoded[0].x;
+		}
+
+		float encodeNormals()
+		{
+			Mani::encode<32>(normals, normals32);
+			return static_cast<float>(normals32[0].bits);
+		}
+
+		float decodeNormals()
+		{
+			Mani::decode<32>(normals32, decodedNormals);
+			return decodedNormals[0].x;
+		}
+	};
+
+	Packed& packed()
+	{
+		static Packed instance;
+		return instance;
+	}
+}
+
+MANI_BENCH("PackedQuat::copy[1M Quatf]",			packed().copy())
+MANI_BENCH("PackedQuat::encode[1M, 32 bits]",		packed().encode(packed().quats32))
+MANI_BENCH("PackedQuat::decode[1M, 32 bits]",		packed().decode(packed().quats32))
+MANI_BENCH("PackedQuat::encode[1M, 48 bits]",		packed().encode(packed().quats48))
+MANI_BENCH("PackedQuat::decode[1M, 48 bits]",		packed().decode(packed().quats48))
+MANI_BENCH("PackedQuat::encode[1M, 64 bits]",		packed().encode(packed().quats64))
+MANI_BENCH("PackedQuat::decode[1M, 64 bits]",		packed().decode(packed().quats64))
+MANI_BENCH("PackedNormal::encode[1M, 32 bits]",		packed().encodeNormals())
+MANI_BENCH("PackedNormal::decode[1M, 32 bits]",		packed().decodeNormals())
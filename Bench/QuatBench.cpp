@@ -0,0 +1,50 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+using namespace ManiBench;
+
+MANI_BENCH("Quatf::isNearlyEqual",		q(i).isNearlyEqual(q(i + 1)))
+MANI_BENCH("Quatf::conjugate",			q(i).conjugate())
+MANI_BENCH("Quatf::length",				q(i).length())
+MANI_BENCH("Quatf::lengthSquared",		q(i).lengthSquared())
+MANI_BENCH("Quatf::normalize",			q(i).normalize())
+MANI_BENCH("Quatf::dot",				q(i).dot(q(i + 1)))
+MANI_BENCH("Quatf::angleRad",			q(i).angleRad(q(i + 1)))
+MANI_BENCH("Quatf::angleDeg",			q(i).angleDeg(q(i + 1)))
+MANI_BENCH("Quatf::axisAngle",			Mani::Quatf::axisAngle(f(i), v3(i)))
+MANI_BENCH("Quatf::axisAngleDeg",		Mani::Quatf::axisAngleDeg(f(i), v3(i)))
+MANI_BENCH("Quatf::rotate",				q(i).rotate(v3(i)))
+MANI_BENCH("Quatf::slerp",				Mani::Quatf::slerp(q(i), q(i + 1), unitf(i) * .5f + .5f))
+MANI_BENCH("Quatf::operator Vec3f",		static_cast<Mani::Vec3f>(q(i)))
+MANI_BENCH("Quatf::operator Vec4f",		static_cast<Mani::Vec4f>(q(i)))
+MANI_BENCH("Quatf::operator Mat3f",		static_cast<Mani::Mat3f>(q(i)))
+MANI_BENCH("Quatf::operator Mat4f",		static_cast<Mani::Mat4f>(q(i)))
+MANI_BENCH("Quatf::toString",			q(i).toString())
+MANI_BENCH("toMat3(Quatf)",				Mani::toMat3(q(i)))
+MANI_BENCH("toMat4(Quatf)",				Mani::toMat4(q(i)))
+MANI_BENCH("Quatf operator-()",			-q(i))
+MANI_BENCH("Quatf operator==",			q(i) == q(i + 1))
+MANI_BENCH("Quatf operator!=",			q(i) != q(i + 1))
+MANI_BENCH("Quatf operator+",			q(i) + q(i + 1))
+MANI_BENCH("Quatf operator-",			q(i) - q(i + 1))
+MANI_BENCH("Quatf operator*",			q(i) * q(i + 1))
+MANI_BENCH("Quatf operator*(scale)",	q(i) * f(i))
+MANI_BENCH("Quatf operator+=",			[&]() { Mani::Quatf r = q(i); r += q(i + 1); return r; }())
+MANI_BENCH("Quatf operator-=",			[&]() { Mani::Quatf r = q(i); r -= q(i + 1); return r; }())
+MANI_BENCH("Quatf operator*=(scale)",	[&]() { Mani::Quatf r = q(i); r *= f(i); return r; }())
+
+// per-bone rotation setup of a 64 bones skeleton, one axis angle per bone.
+MANI_BENCH("Quatf::axisAngle[64 bones]",	[&]() { Mani::Quatf r = Mani::QUATF::IDENTITY; for (std::size_t b = 0; b < 64; ++b) { r = r * Mani::Quatf::axisAngle(f(i + b), v3(i + b)); } return r; }())
+
+// batched blends over the whole quaternion pool, one op interpolates POOL_SIZE pairs.
+namespace
+{
+	const Mani::QuatfStream blendTo = Mani::QuatfStream::make(std::span<const Mani::Quatf>(quatfs.values.data() + 1, POOL_SIZE - 1));
+	const Mani::QuatfStream blendFromTrimmed = Mani::QuatfStream::make(std::span<const Mani::Quatf>(quatfs.values.data(), POOL_SIZE - 1));
+	Mani::QuatfStream blendOut = Mani::QuatfStream::make(POOL_SIZE - 1);
+}
+
+MANI_BENCH("Quatf::slerp[1023]",				([&]() { for (std::size_t b = 0; b < POOL_SIZE - 1; ++b) { blendOut.set(b, Mani::Quatf::slerp(q(b), q(b + 1), .3f)); } return blendOut.x[i % (POOL_SIZE - 1)]; }()))
+MANI_BENCH("QuatfStream::slerp[1023]",			(Mani::QuatfStream::slerp(blendFromTrimmed, blendTo, .3f, blendOut), blendOut.x[i % (POOL_SIZE - 1)]))
+MANI_BENCH("QuatfStream::nlerp[1023]",			(Mani::QuatfStream::nlerp(blendFromTrimmed, blendTo, .3f, blendOut), blendOut.x[i % (POOL_SIZE - 1)]))
+MANI_BENCH("QuatfStream::fastSlerp[1023]",		(Mani::QuatfStream::fastSlerp(blendFromTrimmed, blendTo, .3f, blendOut), blendOut.x[i % (POOL_SIZE - 1)]))
@@ -0,0 +1,88 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Ray.h"
+
+using namespace ManiBench;
+
+namespace
+{
+	// 8 rays per op for both the single ray loops and the packets.
+	Mani::Rayf ray(std::size_t i)
+	{
+		return Mani::Rayf::make(v3(i), v3(i + 1).normalize());
+	}
+
+	Mani::RayPacket8f makePackets()
+	{
+		Mani::RayPacket8f packet;
+		for (std::size_t lane = 0; lane < 8; ++lane)
+		{
+			packet.set(lane, ray(lane));
+		}
+		return packet;
+	}
+
+	Mani::RayPacket8f packet = makePackets();
+
+	unsigned singleTriangles(std::size_t i)
+	{
+		unsigned mask = 0;
+		for (std::size_t lane = 0; lane < 8; ++lane)
+		{
+			float t, u, v;
+			mask |= static_cast<unsigned>(packet.get(lane).intersectTriangle(v3(i), v3(i + 1), v3(i + 2), t, u, v)) << lane;
+		}
+		return mask;
+	}
+
+	unsigned packetTriangles(std::size_t i)
+	{
+		alignas(32) float t[8], u[8], v[8];
+		return packet.intersectTriangle(v3(i), v3(i + 1), v3(i + 2), t, u, v);
+	}
+
+	unsigned singleBoxes(std::size_t i)
+	{
+		const Mani::AABBf box = Mani::AABBf::merge({ v3(i), v3(i) }, v3(i + 1));
+		unsigned mask = 0;
+		for (std::size_t lane = 0; lane < 8; ++lane)
+		{
+			float tNear;
+			mask |= static_cast<unsigned>(packet.get(lane).intersectsAABB(box, 100.f, tNear)) << lane;
+		}
+		return mask;
+	}
+
+	unsigned packetBoxes(std::size_t i)
+	{
+		const Mani::AABBf box = Mani::AABBf::merge({ v3(i), v3(i) }, v3(i + 1));
+		alignas(32) float tMax[8] = { 100.f, 100.f, 100.f, 100.f, 100.f, 100.f, 100.f, 100.f };
+		alignas(32) float tNear[8];
+		return packet.intersectAABB(box, tMax, tNear);
+	}
+
+	unsigned singleSpheres(std::size_t i)
+	{
+		unsigned mask = 0;
+		for (std::size_t lane = 0; lane < 8; ++lane)
+		{
+			float t;
+			mask |= static_cast<unsigned>(packet.get(lane).intersectSphere(v3(i), positivef(i), t)) << lane;
+		}
+		return mask;
+	}
+
+	unsigned packetSpheres(std::size_t i)
+	{
+		alignas(32) float t[8];
+		return packet.intersectSphere(v3(i), positivef(i), t);
+	}
+}
+
+MANI_BENCH("Rayf::intersectTriangle[8 rays]",			singleTriangles(i))
+MANI_BENCH("RayPacket8f::intersectTriangle",			packetTriangles(i))
+MANI_BENCH("Rayf::intersectsAABB[8 rays]",				singleBoxes(i))
+MANI_BENCH("RayPacket8f::intersectAABB",				packetBoxes(i))
+MANI_BENCH("Rayf::intersectSphere[8 rays]",				singleSpheres(i))
+MANI_BENCH("RayPacket8f::intersectSphere",				packetSpheres(i))
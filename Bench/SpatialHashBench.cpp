@@ -0,0 +1,68 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/SpatialHash.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t AGENT_COUNT = 1000000;
+
+	// 1M agents in a 100 x 10 x 100 box, 10 per unit cube, rehashed every frame.
+	struct Crowd
+	{
+		std::vector<Mani::Vec3f> agents = std::vector<Mani::Vec3f>(AGENT_COUNT);
+		Mani::SpatialHashf hash = Mani::SpatialHashf(1.f);
+		std::vector<uint32_t> neighbors;
+
+		Crowd()
+		{
+			for (std::size_t i = 0; i < AGENT_COUNT; ++i)
+			{
+				agents[i] = { randomFloat(-50.f, 50.f), randomFloat(-5.f, 5.f), randomFloat(-50.f, 50.f) };
+			}
+			hash.build(agents);
+		}
+
+		std::size_t radius(std::size_t i)
+		{
+			neighbors.clear();
+			return hash.queryRadius(agents[i % AGENT_COUNT], 1.f, neighbors);
+		}
+
+		std::size_t nearest(std::size_t i) const
+		{
+			uint32_t result[8];
+			return hash.queryKNearest(agents[i % AGENT_COUNT], result);
+		}
+
+		std::size_t bruteForce(std::size_t i) const
+		{
+			const Mani::Vec3f& center = agents[i % AGENT_COUNT];
+			std::size_t count = 0;
+			for (const Mani::Vec3f& agent : agents)
+			{
+				count += agent.distanceSquared(center) <= 1.f;
+			}
+			return count;
+		}
+
+		std::size_t build(std::size_t threadCount)
+		{
+			hash.build(agents, threadCount);
+			return hash.size();
+		}
+	};
+
+	Crowd crowd;
+}
+
+MANI_BENCH("SpatialHashf::queryRadius[1M]",					crowd.radius(i * 7919))
+MANI_BENCH("SpatialHashf::queryKNearest[1M, 8]",			crowd.nearest(i * 7919))
+MANI_BENCH("bruteForce radius[1M]",							crowd.bruteForce(i * 7919))
+MANI_BENCH("SpatialHashf::build[1M]",						crowd.build(1))
+MANI_BENCH("SpatialHashf::build[1M, threads]",				crowd.build(std::thread::hardware_concurrency()))
@@ -0,0 +1,86 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Batch.h"
+#include "ManiMaths/ThreadPool.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t MATRIX_COUNT = 10000000;
+
+	// 10M local transforms parented to one matrix, 2 x 640 MB built on first use.
+	struct Hierarchy
+	{
+		Mani::Mat4f parent = m4(0);
+		std::vector<Mani::Mat4f> locals = std::vector<Mani::Mat4f>(MATRIX_COUNT);
+		std::vector<Mani::Mat4f> worlds = std::vector<Mani::Mat4f>(MATRIX_COUNT);
+
+		Hierarchy()
+		{
+			for (std::size_t i = 0; i < MATRIX_COUNT; ++i)
+			{
+				locals[i] = m4(i);
+			}
+		}
+
+		void multiply(std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				worlds[i] = parent * locals[i];
+			}
+		}
+
+		float sequential()
+		{
+			multiply(0, MATRIX_COUNT);
+			return worlds[0]._00;
+		}
+
+		// the usual hand rolled split: one std::thread per core and per call, equal slices.
+		float threads()
+		{
+			const std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+			const std::size_t slice = (MATRIX_COUNT + threadCount - 1) / threadCount;
+			std::vector<std::thread> threads;
+			for (std::size_t begin = 0; begin < MATRIX_COUNT; begin += slice)
+			{
+				threads.emplace_back([this, begin, slice]() { multiply(begin, std::min(begin + slice, MATRIX_COUNT)); });
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			return worlds[0]._00;
+		}
+
+		float parallelFor()
+		{
+			Mani::ThreadPool::global().parallelFor(MATRIX_COUNT, 0, [this](std::size_t begin, std::size_t end) { multiply(begin, end); });
+			return worlds[0]._00;
+		}
+
+		float batch()
+		{
+			Mani::Batchf::multiply(Mani::ExecutionPolicy::parallel(), parent, locals, worlds);
+			return worlds[0]._00;
+		}
+	};
+
+	Hierarchy& hierarchy()
+	{
+		static Hierarchy instance;
+		return instance;
+	}
+}
+
+MANI_BENCH("ThreadPool::mat4Multiply[10M, sequential]",		hierarchy().sequential())
+MANI_BENCH("ThreadPool::mat4Multiply[10M, std::thread]",	hierarchy().threads())
+MANI_BENCH("ThreadPool::mat4Multiply[10M, parallelFor]",	hierarchy().parallelFor())
+MANI_BENCH("ThreadPool::mat4Multiply[10M, Batchf]",			hierarchy().batch())
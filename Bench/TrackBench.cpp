@@ -0,0 +1,97 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+#include "ManiMaths/Track.h"
+
+#include <filesystem>
+#include <vector>
+
+using namespace ManiBench;
+
+namespace
+{
+	constexpr std::size_t TRACK_FRAMES = 4000000;
+
+	// 4M frames of rotation and position, 112 MB on disk, written on first use.
+	struct Capture
+	{
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "mani_bench_capture.track";
+		Mani::TrackReader<Mani::Quatf, Mani::Vec3f> reader;
+
+		Capture()
+		{
+			std::vector<Mani::Quatf> rotations(TRACK_FRAMES);
+			std::vector<Mani::Vec3f> positions(TRACK_FRAMES);
+			for (std::size_t i = 0; i < TRACK_FRAMES; ++i)
+			{
+				rotations[i] = q(i);
+				positions[i] = v3(i);
+			}
+			Mani::TrackWriter<Mani::Quatf, Mani::Vec3f> writer;
+			writer.open(path);
+			writer.append(rotations, positions);
+			writer.close();
+			reader.open(path);
+		}
+
+		~Capture()
+		{
+			reader.close();
+			std::filesystem::remove(path);
+		}
+
+		// frame by frame, as a playback cursor would.
+		float playFrames()
+		{
+			float sum = 0.f;
+			Mani::Quatf rotation;
+			Mani::Vec3f position;
+			for (std::size_t frame = 0; frame < TRACK_FRAMES; ++frame)
+			{
+				if (reader.get<0>(frame, rotation) && reader.get<1>(frame, position))
+				{
+					sum += rotation.w + position.x;
+				}
+			}
+			return sum;
+		}
+
+		// whole chunks, as a batched playback would.
+		float playChunks()
+		{
+			float sum = 0.f;
+			for (std::size_t chunk = 0; chunk < reader.getChunkCount(); ++chunk)
+			{
+				Mani::TrackReader<Mani::Quatf, Mani::Vec3f>::Chunk view;
+				if (!reader.getChunk(chunk, view))
+				{
+					break;
+				}
+				const std::span<const Mani::Quatf> rotations = view.getColumn<0>();
+				const std::span<const Mani::Vec3f> positions = view.getColumn<1>();
+				for (std::size_t i = 0; i < view.getFrameCount(); ++i)
+				{
+					sum += rotations[i].w + positions[i].x;
+				}
+			}
+			return sum;
+		}
+
+		Mani::Quatf seek(std::size_t i)
+		{
+			Mani::Quatf rotation;
+			(void)reader.get<0>((i * 2654435761u) % TRACK_FRAMES, rotation);
+			return rotation;
+		}
+	};
+
+	Capture& capture()
+	{
+		static Capture instance;
+		return instance;
+	}
+}
+
+MANI_BENCH("TrackReader::get[4M frames]",		capture().playFrames())
+MANI_BENCH("TrackReader::getChunk[4M frames]",	capture().playChunks())
+MANI_BENCH("TrackReader::get[random frame]",	capture().seek(i))
@@ -0,0 +1,93 @@
+#include "Bench.h"
+#include "Inputs.h"
+
+using namespace ManiBench;
+
+// Vec2f
+MANI_BENCH("Vec2f::isNearlyEqual",		v2(i).isNearlyEqual(v2(i + 1)))
+MANI_BENCH("Vec2f::length",				v2(i).length())
+MANI_BENCH("Vec2f::lengthSquared",		v2(i).lengthSquared())
+MANI_BENCH("Vec2f::normalize",			v2(i).normalize())
+MANI_BENCH("Vec2f::distance",			v2(i).distance(v2(i + 1)))
+MANI_BENCH("Vec2f::distanceSquared",	v2(i).distanceSquared(v2(i + 1)))
+MANI_BENCH("Vec2f::dot",				v2(i).dot(v2(i + 1)))
+MANI_BENCH("Vec2f::clamp",				v2(i).clamp(positivef(i)))
+MANI_BENCH("Vec2f::homogenous",			v2(i).homogenous())
+MANI_BENCH("Vec2f::toString",			v2(i).toString())
+MANI_BENCH("Vec2f::operator Vec3f",		static_cast<Mani::Vec3f>(v2(i)))
+MANI_BENCH("Vec2f::operator Vec4f",		static_cast<Mani::Vec4f>(v2(i)))
+MANI_BENCH("Vec2f operator-()",			-v2(i))
+MANI_BENCH("Vec2f operator==",			v2(i) == v2(i + 1))
+MANI_BENCH("Vec2f operator!=",			v2(i) != v2(i + 1))
+MANI_BENCH("Vec2f operator+",			v2(i) + v2(i + 1))
+MANI_BENCH("Vec2f operator-",			v2(i) - v2(i + 1))
+MANI_BENCH("Vec2f operator*",			v2(i) * v2(i + 1))
+MANI_BENCH("Vec2f operator*(scale)",	v2(i) * f(i))
+MANI_BENCH("Vec2f operator/(scale)",	v2(i) / positivef(i))
+MANI_BENCH("Vec2f operator+=",			[&]() { Mani::Vec2f v = v2(i); v += v2(i + 1); return v; }())
+MANI_BENCH("Vec2f operator-=",			[&]() { Mani::Vec2f v = v2(i); v -= v2(i + 1); return v; }())
+MANI_BENCH("Vec2f operator*=",			[&]() { Mani::Vec2f v = v2(i); v *= v2(i + 1); return v; }())
+MANI_BENCH("Vec2f operator*=(scale)",	[&]() { Mani::Vec2f v = v2(i); v *= f(i); return v; }())
+MANI_BENCH("Vec2f operator/=(scale)",	[&]() { Mani::Vec2f v = v2(i); v /= positivef(i); return v; }())
+
+// Vec3f
+MANI_BENCH("Vec3f::isNearlyEqual",		v3(i).isNearlyEqual(v3(i + 1)))
+MANI_BENCH("Vec3f::length",				v3(i).length())
+MANI_BENCH("Vec3f::lengthSquared",		v3(i).lengthSquared())
+MANI_BENCH("Vec3f::normalize",			v3(i).normalize())
+MANI_BENCH("Vec3f::distance",			v3(i).distance(v3(i + 1)))
+MANI_BENCH("Vec3f::distanceSquared",	v3(i).distanceSquared(v3(i + 1)))
+MANI_BENCH("Vec3f::dot",				v3(i).dot(v3(i + 1)))
+MANI_BENCH("Vec3f::cross",				v3(i).cross(v3(i + 1)))
+MANI_BENCH("Vec3f::clamp",				v3(i).clamp(positivef(i)))
+MANI_BENCH("Vec3f::sphericalRandom",	Mani::Vec3f::sphericalRandom(positivef(i)))
+MANI_BENCH("Vec3f::homogenous",			v3(i).homogenous())
+MANI_BENCH("Vec3f::toString",			v3(i).toString())
+MANI_BENCH("Vec3f::operator Vec2f",		static_cast<Mani::Vec2f>(v3(i)))
+MANI_BENCH("Vec3f::operator Vec4f",		static_cast<Mani::Vec4f>(v3(i)))
+MANI_BENCH("Vec3f operator-()",			-v3(i))
+MANI_BENCH("Vec3f operator==",			v3(i) == v3(i + 1))
+MANI_BENCH("Vec3f operator!=",			v3(i) != v3(i + 1))
+MANI_BENCH("Vec3f operator+",			v3(i) + v3(i + 1))
+MANI_BENCH("Vec3f operator-",			v3(i) - v3(i + 1))
+MANI_BENCH("Vec3f operator*",			v3(i) * v3(i + 1))
+MANI_BENCH("Vec3f operator*(scale)",	v3(i) * f(i))
+MANI_BENCH("Vec3f operator/(scale)",	v3(i) / positivef(i))
+MANI_BENCH("Vec3f operator+=",			[&]() { Mani::Vec3f v = v3(i); v += v3(i + 1); return v; }())
+MANI_BENCH("Vec3f operator-=",			[&]() { Mani::Vec3f v = v3(i); v -= v3(i + 1); return v; }())
+MANI_BENCH("Vec3f operator*=",			[&]() { Mani::Vec3f v = v3(i); v *= v3(i + 1); return v; }())
+MANI_BENCH("Vec3f operator*=(scale)",	[&]() { Mani::Vec3f v = v3(i); v *= f(i); return v; }())
+MANI_BENCH("Vec3f operator/=(scale)",	[&]() { Mani::Vec3f v = v3(i); v /= positivef(i); return v; }())
+
+// Vec4f
+MANI_BENCH("Vec4f::isNearlyEqual",		v4(i).isNearlyEqual(v4(i + 1)))
+MANI_BENCH("Vec4f::length",				v4(i).length())
+MANI_BENCH("Vec4f::lengthSquared",		v4(i).lengthSquared())
+MANI_BENCH("Vec4f::normalize",			v4(i).normalize())
+MANI_BENCH("Vec4f::distance",			v4(i).distance(v4(i + 1)))
+MANI_BENCH("Vec4f::distanceSquared",	v4(i).distanceSquared(v4(i + 1)))
+MANI_BENCH("Vec4f::dot",				v4(i).dot(v4(i + 1)))
+MANI_BENCH("Vec4f::clamp",				v4(i).clamp(positivef(i)))
+MANI_BENCH("Vec4f::toString",			v4(i).toString())
+MANI_BENCH("Vec4f::operator Vec2f",		static_cast<Mani::Vec2f>(v4(i)))
+MANI_BENCH("Vec4f::operator Vec3f",		static_cast<Mani::Vec3f>(v4(i)))
+MANI_BENCH("Vec4f operator-()",			-v4(i))
+MANI_BENCH("Vec4f operator==",			v4(i) == v4(i + 1))
+MANI_BENCH("Vec4f operator!=",			v4(i) != v4(i + 1))
+MANI_BENCH("Vec4f operator+",			v4(i) + v4(i + 1))
+MANI_BENCH("Vec4f operator-",			v4(i) - v4(i + 1))
+MANI_BENCH("Vec4f operator*",			v4(i) * v4(i + 1))
+MANI_BENCH("Vec4f operator*(scale)",	v4(i) * f(i))
+MANI_BENCH("Vec4f operator/(scale)",	v4(i) / positivef(i))
+MANI_BENCH("Vec4f operator+=",			[&]() { Mani::Vec4f v = v4(i); v += v4(i + 1); return v; }())
+MANI_BENCH("Vec4f operator-=",			[&]() { Mani::Vec4f v = v4(i); v -= v4(i + 1); return v; }())
+MANI_BENCH("Vec4f operator*=",			[&]() { Mani::Vec4f v = v4(i); v *= v4(i + 1); return v; }())
+MANI_BENCH("Vec4f operator*=(scale)",	[&]() { Mani::Vec4f v = v4(i); v *= f(i); return v; }())
+MANI_BENCH("Vec4f operator/=(scale)",	[&]() { Mani::Vec4f v = v4(i); v /= positivef(i); return v; }())
+
+// generic sizes
+MANI_BENCH("Vec<float, 8>::length",			v8(i).length())
+MANI_BENCH("Vec<float, 8>::dot",			v8(i).dot(v8(i + 1)))
+MANI_BENCH("Vec<float, 8>::normalize",		v8(i).normalize())
+MANI_BENCH("Vec<float, 8> operator+",		v8(i) + v8(i + 1))
+MANI_BENCH("Vec<float, 8> operator*(scale)",	v8(i) * f(i))
@@ -0,0 +1,56 @@
+#include "Bench.h"
+
+#include <cstring>
+
+// usage: Bench [--filter <substring>] [--samples <count>] [--out <file.json>]
+// results are printed as a table, and as json either to --out or to stdout.
+int main(int argc, char** argv)
+{
+	ManiBench::Settings settings;
+	const char* filter = nullptr;
+	const char* outPath = nullptr;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (std::strcmp(argv[i], "--filter") == 0)
+		{
+			filter = argv[i + 1];
+		}
+		else if (std::strcmp(argv[i], "--samples") == 0)
+		{
+			settings.samples = static_cast<uint32_t>(std::max(1, std::atoi(argv[i + 1])));
+		}
+		else if (std::strcmp(argv[i], "--out") == 0)
+		{
+			outPath = argv[i + 1];
+		}
+	}
+
+	const ManiBench::Registry& registry = ManiBench::Registry::get();
+	std::vector<ManiBench::Result> results;
+	for (std::size_t i = 0; i < registry.benchmarks.size(); ++i)
+	{
+		if (filter != nullptr && registry.names[i].find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		const ManiBench::Result result = registry.benchmarks[i](settings);
+		std::fprintf(outPath != nullptr ? stdout : stderr, "%-40s %10.3f ns/op %14.0f ops/s   median %10.3f   p99 %10.3f\n",
+			result.name.c_str(), result.nsPerOp, result.opsPerSec, result.medianNs, result.p99Ns);
+		results.push_back(result);
+	}
+
+	FILE* file = outPath != nullptr ? std::fopen(outPath, "w") : stdout;
+	if (file == nullptr)
+	{
+		std::fprintf(stderr, "could not open %s\n", outPath);
+		return 1;
+	}
+	ManiBench::writeJson(file, results);
+	if (file != stdout)
+	{
+		std::fclose(file);
+	}
+	return 0;
+}
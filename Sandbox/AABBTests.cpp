@@ -0,0 +1,81 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/AABB.h"
+
+#include <vector>
+
+MANI_SECTION_BEGIN(AABB, "AABB section")
+{
+	MANI_TEST(AABBMergeAndIntersection, "union, intersection and measures should follow the corners")
+	{
+		const Mani::AABBf a = { { 0.f, 0.f, 0.f }, { 2.f, 2.f, 2.f } };
+		const Mani::AABBf b = { { 1.f, -1.f, 1.f }, { 3.f, 1.f, 4.f } };
+
+		MANI_TEST_ASSERT(Mani::AABBf::empty().isEmpty() && !a.isEmpty(), "empty should be the only empty box");
+		MANI_TEST_ASSERT(Mani::AABBf::merge(Mani::AABBf::empty(), a) == a, "merging into empty should yield the other box");
+		MANI_TEST_ASSERT((Mani::AABBf::merge(a, b) == Mani::AABBf{ { 0.f, -1.f, 0.f }, { 3.f, 2.f, 4.f } }), "merge should be the component wise min / max");
+		MANI_TEST_ASSERT((Mani::AABBf::intersection(a, b) == Mani::AABBf{ { 1.f, 0.f, 1.f }, { 2.f, 1.f, 2.f } }), "intersection should be the overlap");
+		MANI_TEST_ASSERT(a.intersects(b) && !a.intersects({ { 2.5f, 0.f, 0.f }, { 3.f, 1.f, 1.f } }), "intersects should detect overlaps");
+		MANI_TEST_ASSERT(Mani::AABBf::intersection(a, { { 2.5f, 0.f, 0.f }, { 3.f, 1.f, 1.f } }).isEmpty(), "disjoint boxes should have an empty intersection");
+		MANI_TEST_ASSERT(a.contains(Mani::Vec3f{ 1.f, 2.f, 0.f }) && !a.contains(Mani::Vec3f{ 1.f, 2.1f, 0.f }), "contains should include the faces");
+		MANI_TEST_ASSERT(a.contains(Mani::AABBf::intersection(a, b)) && !a.contains(b), "contains should test whole boxes");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(b.surfaceArea(), 2.f * (2.f * 2.f + 2.f * 3.f + 3.f * 2.f)), "surface area should sum the 6 faces");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(b.volume(), 12.f) && Mani::AABBf::empty().surfaceArea() == 0.f, "empty boxes should have no area");
+		MANI_TEST_ASSERT(b.center() == Mani::Vec3f(2.f, 0.f, 2.5f) && b.extents() == Mani::Vec3f(1.f, 1.f, 1.5f), "center and extents should describe the same box");
+	}
+
+	MANI_TEST(AABBTransform, "Arvo's transform should bound the 8 transformed corners exactly")
+	{
+		const Mani::AABBf box = { { -1.f, 0.f, 2.f }, { 3.f, 1.f, 5.f } };
+		const Mani::Mat4f m = Mani::MAT4F::IDENTITY
+			.translate({ 1.f, -2.f, 3.f })
+			.rotate(Mani::Quatf::axisAngleDeg(35.f, Mani::Vec3f{ 1.f, 1.f, 0.f }.normalize()))
+			.scale({ 2.f, -1.f, .5f });
+
+		Mani::AABBf expected = Mani::AABBf::empty();
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const Mani::Vec3f p = {
+				corner & 1 ? box.max.x : box.min.x,
+				corner & 2 ? box.max.y : box.min.y,
+				corner & 4 ? box.max.z : box.min.z
+			};
+			expected.expand(Mani::Vec3f(m * p.homogenous()));
+		}
+
+		MANI_TEST_ASSERT(box.transform(m).isNearlyEqual(expected, 1e-5), "Mat4 transform should match the transformed corners");
+		MANI_TEST_ASSERT(box.transform(Mani::toAffine3(m)).isNearlyEqual(expected, 1e-5), "Affine3 transform should match Mat4");
+		MANI_TEST_ASSERT(Mani::AABBf::empty().transform(m).isEmpty(), "empty boxes should stay empty");
+	}
+
+	MANI_TEST(AABBComputeBounds, "batched bounds should match the scalar reference")
+	{
+		// 203 points, leaves a tail for the scalar path after the simd groups.
+		std::vector<Mani::Vec3f> points;
+		for (int i = 0; i < 203; ++i)
+		{
+			points.push_back({ Mani::Math::sin(i * .37f) * i, Mani::Math::cos(i * .11f) * 7.f - i * .1f, static_cast<float>((i * 37) % 101) - 50.f });
+		}
+		points[117] = { 500.f, -500.f, 1000.f };
+
+		const Mani::AABBf reference = Mani::Scalar::computeBounds<float>(points);
+		MANI_TEST_ASSERT(reference.max.x == 500.f && reference.min.y == -500.f && reference.max.z == 1000.f, "the reference should contain the outlier");
+		MANI_TEST_ASSERT(Mani::AABBf::computeBounds(points) == reference, "simd bounds should be exact");
+		MANI_TEST_ASSERT(Mani::AABBf::computeBounds(points, 4) == reference, "threaded bounds should be exact");
+		MANI_TEST_ASSERT(Mani::AABBf::computeBounds(std::span(points).first(3)) == Mani::Scalar::computeBounds<float>(std::span(points).first(3)), "short spans should only use the tail");
+		MANI_TEST_ASSERT(Mani::AABBf::computeBounds(std::span<const Mani::Vec3f>{}).isEmpty(), "no point should give an empty box");
+
+		Mani::Vec3fStream stream;
+		stream.gather(points);
+		MANI_TEST_ASSERT(Mani::AABBf::computeBounds(stream) == reference, "structure of arrays bounds should be exact");
+
+		std::vector<Mani::Vec3d> pointsd;
+		for (const Mani::Vec3f& p : points)
+		{
+			pointsd.push_back({ p.x, p.y, p.z });
+		}
+		MANI_TEST_ASSERT(Mani::AABBd::computeBounds(pointsd, 3).max.z == 1000.0, "double bounds should work without simd");
+	}
+}
+MANI_SECTION_END(AABB)
@@ -0,0 +1,96 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Affine3.h"
+
+MANI_SECTION_BEGIN(Affine3, "Affine transforms section")
+{
+	MANI_TEST(Affine3MatchesMat4, "Affine3 products and transforms should match the Mat4 ones")
+	{
+		const Mani::Quatf r1 = Mani::Quatf::axisAngleDeg(30.f, Mani::Vec3f{ 0.f, 1.f, 0.f });
+		const Mani::Quatf r2 = Mani::Quatf::axisAngleDeg(-75.f, Mani::Vec3f{ 1.f, 1.f, 0.f }.normalize());
+		const Mani::Vec3f t1 = { 1.f, -2.f, 3.f };
+		const Mani::Vec3f t2 = { -4.f, .5f, 2.f };
+		const Mani::Vec3f s1 = { 2.f, 2.f, 2.f };
+		const Mani::Vec3f s2 = { .5f, 1.f, 3.f };
+
+		const Mani::Mat4f m1 = Mani::MAT4F::IDENTITY.translate(t1).rotate(r1).scale(s1);
+		const Mani::Mat4f m2 = Mani::MAT4F::IDENTITY.translate(t2).rotate(r2).scale(s2);
+		const Mani::Affine3f a1 = Mani::Affine3f::fromTRS(t1, r1, s1);
+		const Mani::Affine3f a2 = Mani::AFFINE3F::IDENTITY.translate(t2).rotate(r2).scale(s2);
+
+		MANI_TEST_ASSERT(a1.isNearlyEqual(Mani::toAffine3(m1), 1e-5), "fromTRS should match the Mat4 TRS");
+		MANI_TEST_ASSERT(a2.isNearlyEqual(Mani::toAffine3(m2), 1e-5), "chained TRS should match the Mat4 TRS");
+		MANI_TEST_ASSERT(Mani::toMat4(a1 * a2).isNearlyEqual(m1 * m2, 1e-5), "composition should match the Mat4 product");
+
+		const Mani::Vec3f p = { 1.f, 2.f, -3.f };
+		MANI_TEST_ASSERT(a1.transformPoint(p).isNearlyEqual(m1 * p, 1e-5f), "points should match the Mat4 transform");
+		const Mani::Vec4f d = m1 * Mani::Vec4f{ p.x, p.y, p.z, 0.f };
+		MANI_TEST_ASSERT(a1.transformDirection(p).isNearlyEqual(Mani::Vec3f{ d.x, d.y, d.z }, 1e-5f), "directions should ignore the translation");
+	}
+
+	MANI_TEST(Affine3SimdMultiplication, "SIMD affine product should agree with the scalar path, also when aliased")
+	{
+		Mani::Affine3f lhs;
+		Mani::Affine3f rhs;
+		float* pLhs = &lhs._00;
+		float* pRhs = &rhs._00;
+		for (int i = 0; i < 12; ++i)
+		{
+			pLhs[i] = static_cast<float>(i) * .5f - 2.f;
+			pRhs[i] = 3.f - static_cast<float>(i) * .25f;
+		}
+
+		const Mani::Affine3f expected = Mani::Scalar::mul(lhs, rhs);
+		MANI_TEST_ASSERT((lhs * rhs).isNearlyEqual(expected, 1e-5), "product should match the scalar product");
+
+		Mani::Affine3f aliased = lhs;
+		aliased *= rhs;
+		MANI_TEST_ASSERT(aliased.isNearlyEqual(expected, 1e-5), "in place product should match the scalar product");
+	}
+
+	MANI_TEST(Affine3Inverse, "general and rigid inverses should undo the transform")
+	{
+		const Mani::Quatd r = Mani::Quatd::axisAngleDeg(40.0, Mani::Vec3d{ 1.0, 2.0, 3.0 }.normalize());
+		const Mani::Affine3d rigid = Mani::Affine3d::fromTRS({ 1.0, 2.0, 3.0 }, r, { 1.0, 1.0, 1.0 });
+		const Mani::Affine3d scaled = Mani::Affine3d::fromTRS({ 1.0, 2.0, 3.0 }, r, { 2.0, .5, 4.0 });
+
+		MANI_TEST_ASSERT((rigid * rigid.inverseRigid()).isNearlyEqual(Mani::AFFINE3D::IDENTITY, 1e-12), "rigid inverse should give identity");
+		MANI_TEST_ASSERT(rigid.inverseRigid().isNearlyEqual(rigid.inverse(), 1e-12), "rigid and general inverse should agree on rigid transforms");
+		MANI_TEST_ASSERT((scaled * scaled.inverse()).isNearlyEqual(Mani::AFFINE3D::IDENTITY, 1e-12), "inverse should give identity");
+		MANI_TEST_ASSERT(Mani::toMat4(scaled.inverse()).isNearlyEqual(Mani::toMat4(scaled).inverse(), 1e-12), "inverse should match the Mat4 inverse");
+	}
+
+	MANI_TEST(Affine3QuatRoundTrip, "rotations should survive the conversion to and from Quat")
+	{
+		const Mani::Vec3d axis = Mani::Vec3d{ -1.0, 2.0, .5 }.normalize();
+		bool roundTrips = true;
+		for (int i = 0; i < 12; ++i)
+		{
+			// covers every branch of the matrix to quaternion conversion.
+			const Mani::Quatd q = Mani::Quatd::axisAngleDeg(-180.0 + 30.0 * i, axis);
+			const Mani::Quatd back = Mani::Affine3d::fromTRS({ 1.0, 0.0, 0.0 }, q, { 3.0, 3.0, 3.0 }).toQuat();
+			// q and -q are the same rotation.
+			roundTrips &= back.isNearlyEqual(q, 1e-12) || back.isNearlyEqual(-q, 1e-12);
+		}
+		MANI_TEST_ASSERT(roundTrips, "toQuat should give back the rotation");
+
+		const Mani::Quatf x180 = Mani::Quatf::axisAngleDeg(180.f, Mani::Vec3f{ 1.f, 0.f, 0.f });
+		MANI_TEST_ASSERT(Mani::toAffine3(x180).toQuat().isNearlyEqual(x180, 1e-6), "180 degrees rotations should round trip");
+	}
+
+	MANI_TEST(ConstexprAffine3, "Affine3 should be usable in constant expressions")
+	{
+		constexpr Mani::Affine3f a = {
+			1.f, 0.f, 0.f,
+			0.f, 1.f, 0.f,
+			0.f, 0.f, 1.f,
+			1.f, 2.f, 3.f
+		};
+		static_assert(sizeof(Mani::Affine3f) == 48);
+		static_assert(a * Mani::AFFINE3F::IDENTITY == a);
+		static_assert(a.inverseRigid() * a == Mani::AFFINE3F::IDENTITY);
+		static_assert(Mani::toAffine3(Mani::toMat4(a)) == a);
+		static_assert(a.transformPoint(Mani::Vec3f{ 1.f, 1.f, 1.f }) == Mani::Vec3f{ 2.f, 3.f, 4.f });
+	}
+}
+MANI_SECTION_END(Affine3)
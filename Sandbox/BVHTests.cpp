@@ -0,0 +1,189 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/BVH.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace
+{
+	// bumpy grid of size x size quads, 2 triangles each.
+	struct GridMesh
+	{
+		std::vector<Mani::Vec3f> vertices;
+		std::vector<Mani::BVHf::Index> indices;
+
+		explicit GridMesh(uint32_t size)
+		{
+			for (uint32_t y = 0; y <= size; ++y)
+			{
+				for (uint32_t x = 0; x <= size; ++x)
+				{
+					vertices.push_back({ static_cast<float>(x), Mani::Math::sin(x * .7f) * Mani::Math::cos(y * .4f), static_cast<float>(y) });
+				}
+			}
+			for (uint32_t y = 0; y < size; ++y)
+			{
+				for (uint32_t x = 0; x < size; ++x)
+				{
+					const uint32_t i = y * (size + 1) + x;
+					indices.insert(indices.end(), { i, i + size + 1, i + 1, i + 1, i + size + 1, i + size + 2 });
+				}
+			}
+		}
+
+		bool bruteForce(const Mani::Rayf& ray, float& closest, uint32_t& triangle) const
+		{
+			closest = std::numeric_limits<float>::max();
+			for (uint32_t tri = 0; tri < indices.size() / 3; ++tri)
+			{
+				float t, u, v;
+				if (ray.intersectTriangle(vertices[indices[tri * 3]], vertices[indices[tri * 3 + 1]], vertices[indices[tri * 3 + 2]], t, u, v) && t < closest)
+				{
+					closest = t;
+					triangle = tri;
+				}
+			}
+			return closest != std::numeric_limits<float>::max();
+		}
+	};
+
+	Mani::Rayf testRay(int i)
+	{
+		const Mani::Vec3f origin = { static_cast<float>(i % 23), 5.f, static_cast<float>(i % 17) };
+		const Mani::Vec3f target = { static_cast<float>((i * 7) % 31) - 2.f, -1.f, static_cast<float>((i * 13) % 29) - 2.f };
+		return Mani::Rayf::fromPoints(origin, target);
+	}
+}
+
+MANI_SECTION_BEGIN(BVH, "BVH section")
+{
+	MANI_TEST(BVHStructure, "nodes should be depth first with every primitive in exactly one leaf")
+	{
+		const GridMesh mesh(24);
+		const Mani::BVHf bvh = Mani::BVHf::fromTriangles(mesh.vertices, mesh.indices);
+		const auto nodes = bvh.getNodes();
+
+		std::vector<int> seen(mesh.indices.size() / 3, 0);
+		bool ordered = true;
+		for (std::size_t i = 0; i < nodes.size(); ++i)
+		{
+			if (nodes[i].isLeaf())
+			{
+				MANI_TEST_ASSERT(nodes[i].count <= 4, "leaves should respect the max leaf size");
+				for (uint32_t p = nodes[i].index; p < nodes[i].index + nodes[i].count; ++p)
+				{
+					++seen[bvh.getPrimitives()[p]];
+				}
+			}
+			else
+			{
+				ordered &= nodes[i].index > i + 1 && nodes[i].bounds.contains(nodes[i + 1].bounds) && nodes[i].bounds.contains(nodes[nodes[i].index].bounds);
+			}
+		}
+		MANI_TEST_ASSERT(ordered, "children should follow their parent and be contained by it");
+		MANI_TEST_ASSERT(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }), "every triangle should be in one leaf");
+		MANI_TEST_ASSERT(bvh.getBounds() == Mani::AABBf::computeBounds(mesh.vertices), "the root should bound the mesh");
+	}
+
+	MANI_TEST(BVHRayQueries, "closest and any hit should match a brute force scan")
+	{
+		const GridMesh mesh(32);
+		const Mani::BVHf bvh = Mani::BVHf::fromTriangles(mesh.vertices, mesh.indices);
+		// threaded build on a mesh above the parallel threshold.
+		const GridMesh bigMesh(64);
+		const Mani::BVHf bigBvh = Mani::BVHf::fromTriangles(bigMesh.vertices, bigMesh.indices, 4);
+
+		int matches = 0;
+		int hits = 0;
+		for (int i = 0; i < 200; ++i)
+		{
+			const Mani::Rayf ray = testRay(i);
+			float expected = 0.f;
+			uint32_t expectedTriangle = 0;
+			const bool expectedHit = mesh.bruteForce(ray, expected, expectedTriangle);
+			Mani::BVHf::Hit hit;
+			const bool found = bvh.closestHit(ray, mesh.vertices, mesh.indices, hit);
+			// rays through a shared edge hit two triangles at the same distance, only distances are compared.
+			matches += found == expectedHit && (!found || Mani::Math::isEqual(hit.t, expected, 1e-4f));
+			matches += bvh.anyHit(ray, mesh.vertices, mesh.indices) == expectedHit;
+			matches += !expectedHit || bvh.anyHit(ray, mesh.vertices, mesh.indices, expected * 1.01f);
+			hits += expectedHit;
+
+			float bigExpected = 0.f;
+			uint32_t bigTriangle = 0;
+			const bool bigHit = bigMesh.bruteForce(ray, bigExpected, bigTriangle);
+			matches += bigBvh.closestHit(ray, bigMesh.vertices, bigMesh.indices, hit) == bigHit && (!bigHit || Mani::Math::isEqual(hit.t, bigExpected, 1e-4f));
+		}
+		MANI_TEST_ASSERT(hits > 100, "most test rays should hit the mesh");
+		MANI_TEST_ASSERT(matches == 800, "queries should match the brute force results");
+
+		Mani::BVHf::Hit hit;
+		MANI_TEST_ASSERT(!bvh.closestHit(Mani::Rayf::make({ 5.f, 5.f, 5.f }, { 0.f, 1.f, 0.f }), mesh.vertices, mesh.indices, hit), "a ray leaving the mesh should miss");
+		MANI_TEST_ASSERT(!bvh.anyHit(testRay(3), mesh.vertices, mesh.indices, .01f), "a short ray should not reach the mesh");
+	}
+
+	MANI_TEST(BVHOverlapAndRefit, "overlap should find every candidate and refit should follow moved vertices")
+	{
+		GridMesh mesh(32);
+		Mani::BVHf bvh = Mani::BVHf::fromTriangles(mesh.vertices, mesh.indices);
+
+		const Mani::AABBf box = { { 4.5f, -.2f, 7.5f }, { 9.5f, .2f, 11.5f } };
+		std::vector<uint32_t> found;
+		bvh.overlapTriangles(box, mesh.vertices, mesh.indices, [&](uint32_t triangle) { found.push_back(triangle); });
+		std::vector<uint32_t> expected;
+		for (uint32_t tri = 0; tri < mesh.indices.size() / 3; ++tri)
+		{
+			const Mani::Vec3f triangle[3] = { mesh.vertices[mesh.indices[tri * 3]], mesh.vertices[mesh.indices[tri * 3 + 1]], mesh.vertices[mesh.indices[tri * 3 + 2]] };
+			if (Mani::AABBf::computeBounds(triangle).intersects(box))
+			{
+				expected.push_back(tri);
+			}
+		}
+		std::sort(found.begin(), found.end());
+		MANI_TEST_ASSERT(!found.empty() && found == expected, "overlap should report exactly the overlapping triangles");
+
+		// lift the whole grid, the old tree topology still works once refit.
+		for (Mani::Vec3f& v : mesh.vertices)
+		{
+			v.y += 10.f + v.x * .1f;
+		}
+		bvh.refitTriangles(mesh.vertices, mesh.indices);
+		MANI_TEST_ASSERT(bvh.getBounds() == Mani::AABBf::computeBounds(mesh.vertices), "refit should update the root bounds");
+
+		const Mani::Rayf ray = Mani::Rayf::make({ 10.3f, 30.f, 12.6f }, { 0.f, -1.f, 0.f });
+		float expectedT = 0.f;
+		uint32_t expectedTriangle = 0;
+		Mani::BVHf::Hit hit;
+		MANI_TEST_ASSERT(mesh.bruteForce(ray, expectedT, expectedTriangle) && bvh.closestHit(ray, mesh.vertices, mesh.indices, hit), "the moved mesh should still be hit");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(hit.t, expectedT, 1e-4f), "refit queries should match the brute force");
+	}
+
+	MANI_TEST(BVHPacketQueries, "packet closest hits should match single ray closest hits")
+	{
+		const GridMesh mesh(32);
+		const Mani::BVHf bvh = Mani::BVHf::fromTriangles(mesh.vertices, mesh.indices);
+
+		int matches = 0;
+		for (int packetIndex = 0; packetIndex < 16; ++packetIndex)
+		{
+			Mani::RayPacket8f packet;
+			for (int lane = 0; lane < 8; ++lane)
+			{
+				packet.set(lane, testRay(packetIndex * 8 + lane));
+			}
+			Mani::BVHf::Hit hits[8];
+			const unsigned mask = bvh.closestHit(packet, mesh.vertices, mesh.indices, hits);
+			for (int lane = 0; lane < 8; ++lane)
+			{
+				Mani::BVHf::Hit hit;
+				const bool found = bvh.closestHit(testRay(packetIndex * 8 + lane), mesh.vertices, mesh.indices, hit);
+				matches += found == ((mask >> lane) & 1) && (!found || Mani::Math::isEqual(hit.t, hits[lane].t, 1e-4f));
+			}
+		}
+		MANI_TEST_ASSERT(matches == 128, "every lane should match its single ray query");
+	}
+}
+MANI_SECTION_END(BVH)
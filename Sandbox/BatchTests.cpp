@@ -0,0 +1,121 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Batch.h"
+
+#include <vector>
+
+namespace
+{
+	const Mani::ExecutionPolicy policies[] = {
+		Mani::ExecutionPolicy::sequential(),
+		Mani::ExecutionPolicy::vectorized(),
+		Mani::ExecutionPolicy::parallel(),
+		Mani::ExecutionPolicy::parallel(37)
+	};
+
+	std::vector<Mani::Mat4f> transforms(std::size_t count, float seed)
+	{
+		std::vector<Mani::Mat4f> result(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const float x = Mani::Math::sin(i * .37f + seed);
+			result[i] = Mani::MAT4F::IDENTITY
+				.translate(Mani::Vec3f{ x * 10.f, i * .01f, -x })
+				.rotate(Mani::Quatf{ x, .3f, -.2f, 1.f }.normalize())
+				.scale(Mani::Vec3f{ 1.f + x * x, 2.f, .5f });
+		}
+		return result;
+	}
+
+	std::vector<Mani::Quatf> rotations(std::size_t count, float seed)
+	{
+		std::vector<Mani::Quatf> result(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			result[i] = { Mani::Math::sin(i * .7f + seed), Mani::Math::cos(i * .3f), seed, 1.f };
+		}
+		return result;
+	}
+}
+
+MANI_SECTION_BEGIN(Batch, "Batch section")
+{
+	MANI_TEST(BatchMatrices, "batched matrix operations should match the single ones under every policy")
+	{
+		constexpr std::size_t count = 5003;
+		const std::vector<Mani::Mat4f> lhs = transforms(count, 0.f);
+		const std::vector<Mani::Mat4f> rhs = transforms(count, 1.f);
+		const Mani::Mat4f projection = Mani::Mat4f::perspective(1.f, 1.5f, .1f, 100.f);
+		std::vector<Mani::Vec3f> points(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			points[i] = { i * .1f, -2.f, i * -.03f - 1.f };
+		}
+
+		int matches = 0;
+		for (const Mani::ExecutionPolicy& policy : policies)
+		{
+			std::vector<Mani::Mat4f> products(count);
+			std::vector<Mani::Mat4f> parented(count);
+			std::vector<Mani::Mat4f> inverses(count);
+			std::vector<Mani::Vec3f> projected(count);
+			Mani::Batchf::multiply(policy, lhs, rhs, products);
+			Mani::Batchf::multiply(policy, lhs[3], rhs, parented);
+			Mani::Batchf::inverse(policy, lhs, inverses);
+			Mani::Batchf::transformPoints(policy, projection, points, projected);
+
+			bool ok = true;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				ok &= products[i].isNearlyEqual(lhs[i] * rhs[i], 1e-4);
+				ok &= parented[i].isNearlyEqual(lhs[3] * rhs[i], 1e-4);
+				ok &= inverses[i].isNearlyEqual(lhs[i].inverse(), 1e-4);
+				ok &= projected[i].isNearlyEqual(projection * points[i], 1e-4);
+			}
+			matches += ok;
+		}
+		MANI_TEST_ASSERT(matches == 4, "every policy should give the same results");
+	}
+
+	MANI_TEST(BatchQuaternions, "batched quaternion operations should match the single ones under every policy")
+	{
+		constexpr std::size_t count = 3001;
+		const std::vector<Mani::Quatf> q1 = rotations(count, .2f);
+		const std::vector<Mani::Quatf> q2 = rotations(count, -.6f);
+		std::vector<float> t(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			t[i] = (i % 11) / 10.f;
+		}
+
+		int matches = 0;
+		for (const Mani::ExecutionPolicy& policy : policies)
+		{
+			std::vector<Mani::Quatf> normalized(count);
+			Mani::Batchf::normalize(policy, q1, normalized);
+			std::vector<Mani::Quatf> other(count);
+			Mani::Batchf::normalize(policy, q2, other);
+			std::vector<Mani::Quatf> shared(count);
+			Mani::Batchf::slerp(policy, normalized, other, .3f, shared);
+			std::vector<Mani::Quatf> perElement(count);
+			Mani::Batchf::slerp(policy, normalized, other, t, perElement);
+
+			bool ok = true;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				ok &= normalized[i].isNearlyEqual(q1[i].normalize(), 1e-5);
+				ok &= shared[i].isNearlyEqual(Mani::Scalar::quatBlend<Mani::QuatBlend::Slerp>(normalized[i], other[i], .3f), 1e-4);
+				ok &= perElement[i].isNearlyEqual(Mani::Scalar::quatBlend<Mani::QuatBlend::Slerp>(normalized[i], other[i], t[i]), 1e-4);
+			}
+			matches += ok;
+		}
+		MANI_TEST_ASSERT(matches == 4, "every policy should give the same results");
+
+		// in place.
+		std::vector<Mani::Quatf> inPlace = q1;
+		Mani::Batchf::normalize(Mani::ExecutionPolicy::parallel(100), inPlace, inPlace);
+		MANI_TEST_ASSERT(inPlace[count - 1].isNearlyEqual(q1[count - 1].normalize(), 1e-5), "outputs may alias inputs");
+	}
+}
+MANI_SECTION_END(Batch)
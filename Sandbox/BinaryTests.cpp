@@ -0,0 +1,122 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Binary.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+	std::filesystem::path temporaryPath(const char* name)
+	{
+		return std::filesystem::temp_directory_path() / name;
+	}
+}
+
+MANI_SECTION_BEGIN(Binary, "Binary section")
+{
+	MANI_TEST(BinaryFileRoundTrip, "arrays written to a file should map back unchanged")
+	{
+		std::vector<Mani::Mat4f> matrices(1001);
+		std::vector<Mani::Quatf> rotations(777);
+		std::vector<Mani::Vec3f> positions(513);
+		for (std::size_t i = 0; i < matrices.size(); ++i)
+		{
+			matrices[i] = Mani::MAT4F::IDENTITY.translate(Mani::Vec3f{ i * 1.f, -2.f, i * .5f });
+		}
+		for (std::size_t i = 0; i < rotations.size(); ++i)
+		{
+			rotations[i] = Mani::Quatf{ i * .1f, .2f, -.3f, 1.f }.normalize();
+		}
+		for (std::size_t i = 0; i < positions.size(); ++i)
+		{
+			positions[i] = { i * .25f, -1.f * i, 3.f };
+		}
+
+		const std::filesystem::path matricesPath = temporaryPath("mani_binary_matrices.mani");
+		const std::filesystem::path rotationsPath = temporaryPath("mani_binary_rotations.mani");
+		const std::filesystem::path positionsPath = temporaryPath("mani_binary_positions.mani");
+		MANI_TEST_ASSERT(Mani::Binary::write<Mani::Mat4f>(matricesPath, matrices), "the matrices should be written");
+		MANI_TEST_ASSERT(Mani::Binary::write<Mani::Quatf>(rotationsPath, rotations), "the rotations should be written");
+		MANI_TEST_ASSERT(Mani::Binary::write<Mani::Vec3f>(positionsPath, positions), "the positions should be written");
+		MANI_TEST_ASSERT(std::filesystem::file_size(matricesPath) == sizeof(Mani::Binary::Header) + matrices.size() * sizeof(Mani::Mat4f), "the file should hold the header and the raw matrices");
+
+		{
+			Mani::Binary::MappedArray<Mani::Mat4f> mapped;
+			MANI_TEST_ASSERT(mapped.open(matricesPath, Mani::Binary::Verify::Checksum), "the matrices should map back");
+			MANI_TEST_ASSERT(mapped.getCount() == matrices.size(), "the count should be kept");
+			MANI_TEST_ASSERT(std::memcmp(mapped.getValues().data(), matrices.data(), matrices.size() * sizeof(Mani::Mat4f)) == 0, "the matrices should be unchanged");
+			MANI_TEST_ASSERT(reinterpret_cast<std::uintptr_t>(mapped.getValues().data()) % Mani::Binary::ALIGNMENT == 0, "the mapped elements should be aligned");
+
+			Mani::Binary::MappedArray<Mani::Quatf> mappedRotations;
+			MANI_TEST_ASSERT(mappedRotations.open(rotationsPath), "the rotations should map back");
+			MANI_TEST_ASSERT(mappedRotations[776] == rotations[776], "the rotations should be unchanged");
+
+			Mani::Binary::MappedArray<Mani::Vec3f> mappedPositions;
+			MANI_TEST_ASSERT(mappedPositions.open(positionsPath), "the positions should map back");
+			MANI_TEST_ASSERT(mappedPositions[512] == positions[512], "the positions should be unchanged");
+
+			Mani::Binary::MappedArray<Mani::Vec4f> wrongType;
+			MANI_TEST_ASSERT(!wrongType.open(positionsPath), "a file should only map back as the type it was written from");
+			Mani::Binary::MappedArray<Mani::Mat4d> wrongScalar;
+			MANI_TEST_ASSERT(!wrongScalar.open(matricesPath), "a file should only map back with the scalar it was written from");
+		}
+
+		// flip one bit of the last matrix.
+		{
+			std::fstream file(matricesPath, std::ios::in | std::ios::out | std::ios::binary);
+			file.seekg(-1, std::ios::end);
+			const char last = static_cast<char>(file.get());
+			file.seekp(-1, std::ios::end);
+			file.put(static_cast<char>(last ^ 1));
+		}
+		Mani::Binary::MappedArray<Mani::Mat4f> corrupted;
+		MANI_TEST_ASSERT(corrupted.open(matricesPath), "the header alone doesn't see corrupted elements");
+		corrupted.close();
+		MANI_TEST_ASSERT(!corrupted.open(matricesPath, Mani::Binary::Verify::Checksum), "the checksum should catch corrupted elements");
+
+		std::filesystem::resize_file(matricesPath, 100);
+		MANI_TEST_ASSERT(!corrupted.open(matricesPath), "a truncated file should be refused");
+
+		std::filesystem::remove(matricesPath);
+		std::filesystem::remove(rotationsPath);
+		std::filesystem::remove(positionsPath);
+		MANI_TEST_ASSERT(!corrupted.open(matricesPath), "a missing file should be refused");
+	}
+
+	MANI_TEST(BinaryBuffers, "serialized buffers should be viewed in place")
+	{
+		const std::vector<Mani::Vec3d> points = { { 1., 2., 3. }, { -4., 5.5, 6. }, { 0., 0., -1. } };
+		const std::vector<std::byte> bytes = Mani::Binary::serialize<Mani::Vec3d>(points);
+		MANI_TEST_ASSERT(bytes.size() == sizeof(Mani::Binary::Header) + 3 * sizeof(Mani::Vec3d), "the buffer should hold the header and the raw points");
+
+		std::span<const Mani::Vec3d> view;
+		MANI_TEST_ASSERT(Mani::Binary::view(bytes, view, Mani::Binary::Verify::Checksum), "the buffer should be viewed");
+		MANI_TEST_ASSERT((view.size() == 3 && view[1] == points[1]), "the view should show the points");
+		MANI_TEST_ASSERT(static_cast<const void*>(view.data()) == bytes.data() + sizeof(Mani::Binary::Header), "the view should point into the buffer");
+
+		std::span<const double> scalars;
+		MANI_TEST_ASSERT(!Mani::Binary::view(bytes, scalars), "points should not be viewed as scalars");
+
+		const std::vector<Mani::Vec3h> halves = { { 1.f, 2.f, 3.f }, { -4.f, 5.5f, 6.f } };
+		const std::vector<std::byte> halfBytes = Mani::Binary::serialize<Mani::Vec3h>(halves);
+		std::span<const Mani::Vec3h> halfView;
+		std::span<const Mani::Vec3bf> bfloatView;
+		MANI_TEST_ASSERT((Mani::Binary::view(halfBytes, halfView) && halfView[1] == halves[1]), "half points should be viewed");
+		MANI_TEST_ASSERT(!Mani::Binary::view(halfBytes, bfloatView), "halves should not be viewed as bfloat16");
+
+		const std::vector<std::byte> empty = Mani::Binary::serialize<Mani::Quatf>({});
+		std::span<const Mani::Quatf> emptyView;
+		MANI_TEST_ASSERT((Mani::Binary::view(empty, emptyView, Mani::Binary::Verify::Checksum) && emptyView.empty()), "an empty array should round trip");
+
+		std::vector<std::byte> forged = bytes;
+		const std::uint64_t count = 1000;
+		std::memcpy(forged.data() + offsetof(Mani::Binary::Header, count), &count, sizeof(count));
+		MANI_TEST_ASSERT(!Mani::Binary::view(forged, view), "a count past the end of the buffer should be refused");
+	}
+}
+MANI_SECTION_END(Binary)
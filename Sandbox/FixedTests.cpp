@@ -0,0 +1,117 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Fixed.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+	using Fixed = Mani::Fixed16_16;
+
+	constexpr double STEP = 1. / Fixed::ONE;
+
+	// largest distance to the double precision result over inputs spread across [from, to].
+	template<typename TFunction, typename TReference>
+	double maxError(double from, double to, TFunction function, TReference reference)
+	{
+		double error = 0.;
+		for (std::int64_t raw = Fixed(from).raw; raw <= Fixed(to).raw; raw += 97)
+		{
+			const Fixed x = Fixed::fromRaw(static_cast<std::int32_t>(raw));
+			error = std::max(error, std::abs(static_cast<double>(function(x)) - reference(static_cast<double>(x))));
+		}
+		return error;
+	}
+
+	// mixes every raw result of a sweep, the same value on every compiler and cpu.
+	std::uint64_t fingerprint()
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		const auto mix = [&](Fixed value) { hash = (hash ^ static_cast<std::uint32_t>(value.raw)) * 1099511628211ull; };
+		for (std::int32_t raw = -Fixed::ONE * 1000; raw <= Fixed::ONE * 1000; raw += 4099)
+		{
+			const Fixed x = Fixed::fromRaw(raw);
+			const Fixed unit = Fixed::fromRaw(raw / 1000);
+			mix(Mani::Math::sin(x));
+			mix(Mani::Math::cos(x));
+			mix(Mani::Math::tan(unit));
+			mix(Mani::Math::atan(x));
+			mix(Mani::Math::acos(unit));
+			mix(Mani::Math::asin(unit));
+			mix(Mani::Math::sqrt(Mani::Math::abs(x)));
+			mix(x * x / (Mani::Math::abs(x) + Fixed(1)));
+
+			const Mani::Quatx rotation = Mani::Quatx::axisAngle(x, Mani::Vec3x{ 1, 2, 2 }.normalize());
+			const Mani::Vec3x rotated = rotation.rotate(Mani::Vec3x{ 3, -1, Fixed(.5) });
+			mix(rotated.x);
+			mix(rotated.y);
+			mix(rotated.z);
+		}
+		return hash;
+	}
+}
+
+MANI_SECTION_BEGIN(Fixed, "Fixed section")
+{
+	MANI_TEST(FixedArithmetic, "fixed point arithmetic should be exact integer arithmetic")
+	{
+		MANI_TEST_ASSERT(Fixed(3) * Fixed(2.5) == Fixed(7.5), "fixed point values should multiply");
+		MANI_TEST_ASSERT(Fixed(7) / Fixed(2) == Fixed(3.5), "fixed point values should divide");
+		MANI_TEST_ASSERT(Fixed(1) / Fixed(3) == Fixed::fromRaw(21845), "division should truncate");
+		MANI_TEST_ASSERT(Fixed::fromRaw(1) * Fixed(.5) == Fixed::fromRaw(1), "multiplication should round to nearest");
+		MANI_TEST_ASSERT(Fixed(-2.25) + Fixed(1) == Fixed(-1.25), "fixed point values should add");
+		MANI_TEST_ASSERT((Fixed(-.5) < 0 && Fixed(.5) > Fixed(.25)), "fixed point values should compare");
+		MANI_TEST_ASSERT(std::numeric_limits<Fixed>::max() + Fixed::fromRaw(1) == std::numeric_limits<Fixed>::lowest(), "overflows should wrap");
+		MANI_TEST_ASSERT((static_cast<int>(Fixed(-2.75)) == -2 && static_cast<float>(Fixed(-2.75)) == -2.75f), "conversions should truncate toward zero");
+		MANI_TEST_ASSERT((Mani::IsNumeric<Fixed> && !Mani::IsFloatingPoint<Fixed>), "fixed point values should be numeric");
+	}
+
+	MANI_TEST(FixedMaths, "fixed point Math:: functions should be exact to about one step")
+	{
+		const double sin = maxError(-32767., 32767., [](Fixed x) { return Mani::Math::sin(x); }, [](double x) { return std::sin(x); });
+		const double cos = maxError(-100., 100., [](Fixed x) { return Mani::Math::cos(x); }, [](double x) { return std::cos(x); });
+		const double tan = maxError(-1.5, 1.5, [](Fixed x) { return Mani::Math::tan(x); }, [](double x) { return std::tan(x); });
+		const double atan = maxError(-32767., 32767., [](Fixed x) { return Mani::Math::atan(x); }, [](double x) { return std::atan(x); });
+		const double asin = maxError(-1., 1., [](Fixed x) { return Mani::Math::asin(x); }, [](double x) { return std::asin(x); });
+		const double acos = maxError(-1., 1., [](Fixed x) { return Mani::Math::acos(x); }, [](double x) { return std::acos(x); });
+		const double sqrt = maxError(0., 32767., [](Fixed x) { return Mani::Math::sqrt(x); }, [](double x) { return std::sqrt(x); });
+		MANI_TEST_ASSERT((sin <= STEP && cos <= STEP), "sin and cos should be exact to one step");
+		MANI_TEST_ASSERT(tan <= 16. * STEP, "tan should be exact to one step of its derivative");
+		MANI_TEST_ASSERT((atan <= STEP && asin <= STEP && acos <= STEP), "inverse trigonometry should be exact to one step");
+		MANI_TEST_ASSERT(sqrt <= STEP * .5, "sqrt should round to nearest");
+		bool roundsAtTies = true;
+		for (std::uint64_t n = 2; n < (std::uint64_t(1) << 31); n = n * 3 + 1)
+		{
+			// n^2 + n rounds down, n^2 + n + 1 rounds up, wherever the hardware estimate lands.
+			roundsAtTies &= Mani::FixedPoint::sqrt(n * n - 1) == n && Mani::FixedPoint::sqrt(n * n + n) == n && Mani::FixedPoint::sqrt(n * n + n + 1) == n + 1;
+		}
+		MANI_TEST_ASSERT(roundsAtTies, "integer sqrt should be exact next to the ties");
+		MANI_TEST_ASSERT(Mani::Math::acos(Fixed(1.5)) == Fixed(0), "acos should clamp its input");
+		MANI_TEST_ASSERT(Mani::Math::atan2(Fixed(-1), Fixed(-1)) == Fixed(-2.35619449), "atan2 should find the quadrant");
+	}
+
+	MANI_TEST(FixedVectors, "vectors, quaternions and matrices of fixed point values should compute deterministically")
+	{
+		MANI_TEST_ASSERT((Mani::Vec3x{ 3, 4, 0 }.length() == Fixed(5)), "fixed point vectors should have a length");
+		MANI_TEST_ASSERT((Mani::Vec3x{ 1, 2, 3 }.cross(Mani::Vec3x{ 0, 1, 0 }) == Mani::Vec3x{ -3, 0, 1 }), "fixed point vectors should cross");
+
+		const Mani::Quatf rotation = Mani::Quatf::axisAngle(.7f, Mani::Vec3f{ 1.f, 2.f, 2.f }.normalize());
+		const Mani::Quatx fixedRotation = Mani::Quatx::axisAngle(Fixed(.7), Mani::Vec3x{ 1, 2, 2 }.normalize());
+		const Mani::Vec3f expected = rotation.rotate(Mani::Vec3f{ 3.f, -1.f, .5f });
+		MANI_TEST_ASSERT(fixedRotation.rotate(Mani::Vec3x{ 3, -1, Fixed(.5) }).isNearlyEqual(expected, 1e-3), "fixed point quaternions should rotate");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(static_cast<float>(fixedRotation.normalize().length()), 1.f, 1e-4f), "fixed point quaternions should normalize");
+
+		const Mani::Mat4f world = Mani::Mat4f::translate(static_cast<Mani::Mat4f>(rotation), Mani::Vec3f{ 10.f, 0.f, -5.f });
+		const Mani::Mat4x fixedWorld = Mani::Mat4x::translate(static_cast<Mani::Mat4x>(fixedRotation), Mani::Vec3x{ 10, 0, -5 });
+		const Mani::Vec4f transformed = world * Mani::Vec4f{ 3.f, -1.f, .5f, 1.f };
+		MANI_TEST_ASSERT((fixedWorld * Mani::Vec4x{ 3, -1, Fixed(.5), 1 }).isNearlyEqual(transformed, 1e-3), "fixed point matrices should transform");
+		const Mani::Mat3x basis = fixedRotation;
+		MANI_TEST_ASSERT(((basis * basis.transpose()).isNearlyEqual(Mani::Mat3f{ 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f }, 1e-3)), "fixed point rotations should be orthonormal");
+
+		// recorded once, a different value means results changed: replays and lockstep peers would diverge.
+		MANI_TEST_ASSERT(fingerprint() == 10713438684651703408ull, "fixed point results should be the same bits everywhere");
+	}
+}
+MANI_SECTION_END(Fixed)
@@ -0,0 +1,119 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Frustum.h"
+
+#include <vector>
+
+MANI_SECTION_BEGIN(Frustum, "Frustum section")
+{
+	MANI_TEST(FrustumPlaneExtraction, "planes extracted from a view projection should bound the visible volume")
+	{
+		const Mani::Mat4f view = Mani::Mat4f::lookAt({ 0.f, 0.f, 0.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f, 0.f });
+		const Mani::Mat4f projection = Mani::Mat4f::perspective(Mani::Math::degToRad(90.f), 1.f, .1f, 100.f);
+		const Mani::Frustumf frustum = Mani::Frustumf::fromMatrix(projection * view);
+
+		MANI_TEST_ASSERT(frustum.containsPoint({ 0.f, 0.f, -10.f }), "a point in front of the camera should be inside");
+		MANI_TEST_ASSERT(frustum.containsPoint({ 9.f, -9.f, -10.f }), "a point inside the 90 degrees cone should be inside");
+		MANI_TEST_ASSERT(!frustum.containsPoint({ 11.f, 0.f, -10.f }), "a point outside the cone should be outside");
+		MANI_TEST_ASSERT(!frustum.containsPoint({ 0.f, 0.f, 10.f }), "a point behind the camera should be outside");
+		MANI_TEST_ASSERT(!frustum.containsPoint({ 0.f, 0.f, -101.f }), "a point past the far plane should be outside");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(frustum.distance(Mani::Frustumf::Near, { 0.f, 0.f, -1.1f }), 1.f, 1e-4f), "plane distances should be normalized");
+
+		MANI_TEST_ASSERT(frustum.intersectsSphere({ 0.f, 0.f, 1.f }, 1.5f), "a sphere crossing the near plane should be visible");
+		MANI_TEST_ASSERT(!frustum.intersectsSphere({ 0.f, 0.f, 1.f }, .5f), "a sphere behind the camera should be culled");
+		MANI_TEST_ASSERT(frustum.intersectsAABB({ 10.5f, -1.f, -11.f }, { 12.f, 1.f, -9.f }), "a box crossing a side plane should be visible");
+		MANI_TEST_ASSERT(!frustum.intersectsAABB({ 11.f, -1.f, -10.5f }, { 12.f, 1.f, -9.5f }), "a box outside a side plane should be culled");
+
+		const Mani::Frustumf ortho = Mani::Frustumf::fromMatrix(Mani::Mat4f::orthographic(-1.f, 1.f, -1.f, 1.f, .1f, 10.f));
+		MANI_TEST_ASSERT(ortho.containsPoint({ .5f, .5f, -5.f }) && !ortho.containsPoint({ 1.5f, .5f, -5.f }), "orthographic frustums should be boxes");
+	}
+
+	MANI_TEST(FrustumBatchCulling, "batched culling should match the per volume tests")
+	{
+		const Mani::Mat4f view = Mani::Mat4f::lookAt({ 1.f, 2.f, 3.f }, { 0.f, 0.f, -5.f }, { 0.f, 1.f, 0.f });
+		const Mani::Mat4f projection = Mani::Mat4f::perspective(Mani::Math::degToRad(60.f), 16.f / 9.f, .1f, 50.f);
+		const Mani::Frustumf frustum = Mani::Frustumf::fromMatrix(projection * view);
+
+		// 203 volumes, spans several mask words and leaves a tail for the scalar path.
+		constexpr std::size_t count = 203;
+		Mani::Vec3fStream centers = Mani::Vec3fStream::make(count);
+		Mani::Vec3fStream extents = Mani::Vec3fStream::make(count);
+		std::vector<float> radii(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const float f = static_cast<float>(i);
+			centers.set(i, { Mani::Math::fmod(f * 7.3f, 40.f) - 20.f, Mani::Math::fmod(f * 3.1f, 20.f) - 10.f, -Mani::Math::fmod(f * 5.7f, 60.f) + 5.f });
+			extents.set(i, { .5f + Mani::Math::fmod(f, 3.f), 1.f, .25f });
+			radii[i] = .5f + Mani::Math::fmod(f, 4.f);
+		}
+
+		std::vector<uint64_t> sphereMask(Mani::Frustumf::maskSize(count));
+		std::vector<uint64_t> boxMask(Mani::Frustumf::maskSize(count));
+		std::vector<uint64_t> minMaxMask(Mani::Frustumf::maskSize(count));
+		Mani::Vec3fStream mins = Mani::Vec3fStream::make(count);
+		Mani::Vec3fStream maxs = Mani::Vec3fStream::make(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			mins.set(i, centers.get(i) - extents.get(i));
+			maxs.set(i, centers.get(i) + extents.get(i) * 1.5f);
+		}
+		const std::size_t visibleSpheres = frustum.cullSpheres(centers, radii, sphereMask);
+		const std::size_t visibleBoxes = frustum.cullCenterExtents(centers, extents, boxMask);
+		const std::size_t visibleMinMax = frustum.cullAABBs(mins, maxs, minMaxMask);
+
+		bool spheresMatch = true;
+		bool boxesMatch = true;
+		bool minMaxMatch = true;
+		std::size_t expectedSpheres = 0;
+		std::size_t expectedBoxes = 0;
+		std::size_t expectedMinMax = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const bool sphereVisible = frustum.intersectsSphere(centers.get(i), radii[i]);
+			const bool boxVisible = frustum.intersectsCenterExtent(centers.get(i), extents.get(i));
+			const bool minMaxVisible = frustum.intersectsAABB(mins.get(i), maxs.get(i));
+			spheresMatch &= sphereVisible == (((sphereMask[i / 64] >> (i % 64)) & 1) != 0);
+			boxesMatch &= boxVisible == (((boxMask[i / 64] >> (i % 64)) & 1) != 0);
+			minMaxMatch &= minMaxVisible == (((minMaxMask[i / 64] >> (i % 64)) & 1) != 0);
+			expectedSpheres += sphereVisible;
+			expectedBoxes += boxVisible;
+			expectedMinMax += minMaxVisible;
+		}
+		MANI_TEST_ASSERT(spheresMatch && visibleSpheres == expectedSpheres, "sphere bits should match intersectsSphere");
+		MANI_TEST_ASSERT(boxesMatch && visibleBoxes == expectedBoxes, "box bits should match intersectsCenterExtent");
+		MANI_TEST_ASSERT(minMaxMatch && visibleMinMax == expectedMinMax, "min max bits should match intersectsAABB");
+		MANI_TEST_ASSERT(expectedSpheres > 0 && expectedSpheres < count, "the scene should be partially visible");
+	}
+
+	MANI_TEST(FrustumBatchCullingTouching, "spheres touching a plane should be visible in both the batched and per volume tests")
+	{
+		const Mani::Mat4f view = Mani::Mat4f::lookAt({ 1.f, 2.f, 3.f }, { 0.f, 0.f, -5.f }, { 0.f, 1.f, 0.f });
+		const Mani::Mat4f projection = Mani::Mat4f::perspective(Mani::Math::degToRad(60.f), 16.f / 9.f, .1f, 50.f);
+		const Mani::Frustumf frustum = Mani::Frustumf::fromMatrix(projection * view);
+
+		// centers pushed out of the left plane, radius exactly the distance back to it: any difference in rounding
+		// between the lanes and the scalar test flips the result.
+		constexpr std::size_t count = 37;
+		Mani::Vec3fStream centers = Mani::Vec3fStream::make(count);
+		std::vector<float> radii(count);
+		const Mani::Vec4f& left = frustum.planes[Mani::Frustumf::Left];
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const float f = static_cast<float>(i);
+			const Mani::Vec3f inside = { .3f * f - 5.f, Mani::Math::sin(f) - .05f * f, -10.f - .2f * f };
+			const Mani::Vec3f center = inside - Mani::Vec3f{ left.x, left.y, left.z } * (frustum.distance(Mani::Frustumf::Left, inside) + .37f + .01f * f);
+			centers.set(i, center);
+			radii[i] = -frustum.distance(Mani::Frustumf::Left, center);
+		}
+
+		std::vector<uint64_t> mask(Mani::Frustumf::maskSize(count));
+		bool visible = frustum.cullSpheres(centers, radii, mask) == count;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			visible &= frustum.intersectsSphere(centers.get(i), radii[i]);
+		}
+		MANI_TEST_ASSERT(visible, "every touching sphere should be visible");
+	}
+}
+MANI_SECTION_END(Frustum)
@@ -0,0 +1,166 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Half.h"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+	// every bit pattern converts to a float and back to itself, NaNs stay NaNs. batches agree with the scalar path.
+	template<typename T>
+	bool roundTripsExactly()
+	{
+		std::vector<T> all(65536);
+		for (std::uint32_t bits = 0; bits < 65536; ++bits)
+		{
+			all[bits] = T::fromBits(static_cast<std::uint16_t>(bits));
+		}
+		std::vector<float> floats(all.size());
+		std::vector<T> back(all.size());
+		Mani::convert(all, floats);
+		Mani::convert(floats, back);
+
+		bool ok = true;
+		for (std::size_t i = 0; i < all.size(); ++i)
+		{
+			const float value = all[i];
+			ok &= std::bit_cast<std::uint32_t>(floats[i]) == std::bit_cast<std::uint32_t>(value) || (std::isnan(floats[i]) && std::isnan(value));
+			ok &= std::isnan(value) ? std::isnan(static_cast<float>(back[i])) : back[i].bits == all[i].bits;
+			ok &= std::isnan(value) || T(value).bits == all[i].bits;
+		}
+		return ok;
+	}
+
+	// floats across the whole range round to the nearest 16 bits float, the same in batches.
+	template<typename T>
+	bool roundsToNearest()
+	{
+		std::vector<float> floats;
+		for (std::uint64_t bits = 0; bits < 0x100000000ull; bits += 7919)
+		{
+			floats.push_back(std::bit_cast<float>(static_cast<std::uint32_t>(bits)));
+		}
+		std::vector<T> rounded(floats.size());
+		Mani::convert(floats, rounded);
+
+		bool ok = true;
+		for (std::size_t i = 0; i < floats.size(); ++i)
+		{
+			const T scalar = floats[i];
+			ok &= rounded[i].bits == scalar.bits;
+			if (std::isnan(floats[i]))
+			{
+				ok &= std::isnan(static_cast<float>(scalar));
+				continue;
+			}
+			// neither neighbour is closer, past the largest finite value the neighbour is infinity.
+			const double error = std::abs(static_cast<double>(static_cast<float>(scalar)) - floats[i]);
+			const T below = T::fromBits(static_cast<std::uint16_t>(scalar.bits - 1));
+			const T above = T::fromBits(static_cast<std::uint16_t>(scalar.bits + 1));
+			if (std::isfinite(static_cast<float>(scalar)) && (scalar.bits & 0x7FFF) != 0)
+			{
+				ok &= error <= std::abs(static_cast<double>(static_cast<float>(below)) - floats[i]);
+			}
+			if (std::isfinite(static_cast<float>(above)))
+			{
+				ok &= error <= std::abs(static_cast<double>(static_cast<float>(above)) - floats[i]);
+			}
+		}
+		return ok;
+	}
+}
+
+MANI_SECTION_BEGIN(Half, "Half section")
+{
+	MANI_TEST(HalfConversions, "halves should round to nearest even and convert back exactly")
+	{
+		MANI_TEST_ASSERT(roundTripsExactly<Mani::Half>(), "every half should survive a float round trip");
+		MANI_TEST_ASSERT(roundsToNearest<Mani::Half>(), "floats should round to the nearest half");
+
+		MANI_TEST_ASSERT(Mani::Half(1.f + 1.f / 2048.f) == 1.f, "ties should round to even");
+		MANI_TEST_ASSERT(Mani::Half(1.f + 3.f / 2048.f) == 1.f + 1.f / 512.f, "ties should round to even");
+		MANI_TEST_ASSERT(Mani::Half(65504.f).bits == 0x7BFF, "65504 is the largest half");
+		MANI_TEST_ASSERT(Mani::Half(65520.f).bits == 0x7C00, "past the largest half should overflow to infinity");
+		MANI_TEST_ASSERT(Mani::Half(std::ldexp(1.f, -24)).bits == 0x0001, "the smallest subnormal should be exact");
+		MANI_TEST_ASSERT(Mani::Half(std::ldexp(1.f, -25)).bits == 0x0000, "half the smallest subnormal should tie to zero");
+		MANI_TEST_ASSERT(Mani::Half(-0.f).bits == 0x8000, "the sign of zero should be kept");
+		MANI_TEST_ASSERT((std::numeric_limits<Mani::Half>::max() == 65504.f && std::numeric_limits<Mani::Half>::epsilon() == 1.f / 1024.f), "half limits");
+	}
+
+	MANI_TEST(BFloat16Conversions, "bfloat16 should round to nearest even and convert back exactly")
+	{
+		MANI_TEST_ASSERT(roundTripsExactly<Mani::BFloat16>(), "every bfloat16 should survive a float round trip");
+		MANI_TEST_ASSERT(roundsToNearest<Mani::BFloat16>(), "floats should round to the nearest bfloat16");
+
+		MANI_TEST_ASSERT(Mani::BFloat16(1.f + 1.f / 256.f) == 1.f, "ties should round to even");
+		MANI_TEST_ASSERT(Mani::BFloat16(1.f + 3.f / 256.f) == 1.f + 1.f / 64.f, "ties should round to even");
+		MANI_TEST_ASSERT(Mani::Math::abs(Mani::BFloat16(3e38f) / 3e38f - 1.f) < 1.f / 256.f, "bfloat16 should keep the float range");
+		MANI_TEST_ASSERT(std::isnan(static_cast<float>(Mani::BFloat16(std::bit_cast<float>(0x7F800001u)))), "NaNs shouldn't round to infinity");
+	}
+
+	MANI_TEST(HalfVectors, "vectors and quaternions of 16 bits floats should compute in float")
+	{
+		const Mani::Vec3h a = { 1.f, 2.f, 3.f };
+		MANI_TEST_ASSERT((a + a == Mani::Vec3h{ 2.f, 4.f, 6.f }), "half vectors should add");
+		MANI_TEST_ASSERT((a * 0.5f == Mani::Vec3h{ 0.5f, 1.f, 1.5f }), "half vectors should scale");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(a.dot(a), 14.f), "half vectors should dot");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(a.normalize().length(), 1.f, 2e-3f), "half vectors should normalize");
+		MANI_TEST_ASSERT((a.cross(Mani::Vec3h{ 0.f, 1.f, 0.f }) == Mani::Vec3h{ -3.f, 0.f, 1.f }), "half vectors should cross");
+
+		const Mani::Quatf rotation = Mani::Quatf::axisAngle(.7f, Mani::Vec3f{ 1.f, 2.f, 2.f }.normalize());
+		const Mani::Quath halfRotation = Mani::Quath::axisAngle(.7f, Mani::Vec3h{ 1.f, 2.f, 2.f }.normalize());
+		const Mani::Vec3f expected = rotation.rotate(Mani::Vec3f{ 3.f, -1.f, .5f });
+		MANI_TEST_ASSERT(halfRotation.rotate(Mani::Vec3h{ 3.f, -1.f, .5f }).isNearlyEqual(expected, 1e-2), "half quaternions should rotate");
+
+		const Mani::Vec3bf b = { 1.f, 2.f, 3.f };
+		MANI_TEST_ASSERT((b - b == Mani::Vec3bf{}), "bfloat16 vectors should subtract");
+		MANI_TEST_ASSERT((-b == Mani::Vec3bf{ -1.f, -2.f, -3.f }), "bfloat16 vectors should negate");
+		MANI_TEST_ASSERT((sizeof(Mani::Vec3h) == 6 && sizeof(Mani::Quatbf) == 8), "16 bits vectors should be half the size");
+	}
+
+	MANI_TEST(HalfBatches, "vector and quaternion spans should convert like their components")
+	{
+		// odd count, the SIMD batches have a scalar tail.
+		std::vector<Mani::Vec3f> positions(1001);
+		std::vector<Mani::Quatf> rotations(1001);
+		for (std::size_t i = 0; i < positions.size(); ++i)
+		{
+			positions[i] = { Mani::Math::sin(i * .3f) * 100.f, i * .01f, -static_cast<float>(i) };
+			rotations[i] = Mani::Quatf{ Mani::Math::sin(i * 1.3f), Mani::Math::cos(i * .7f), .2f, .5f }.normalize();
+		}
+
+		std::vector<Mani::Vec3h> halves(positions.size());
+		std::vector<Mani::Vec3bf> bfloats(positions.size());
+		std::vector<Mani::Vec3f> back(positions.size());
+		Mani::convert(positions, halves);
+		Mani::convert(positions, bfloats);
+		bool ok = true;
+		for (std::size_t i = 0; i < positions.size(); ++i)
+		{
+			ok &= halves[i] == Mani::Vec3h{ positions[i].x, positions[i].y, positions[i].z };
+			ok &= bfloats[i] == Mani::Vec3bf{ positions[i].x, positions[i].y, positions[i].z };
+		}
+		Mani::convert(halves, back);
+		for (std::size_t i = 0; i < positions.size(); ++i)
+		{
+			ok &= back[i] == halves[i];
+		}
+		MANI_TEST_ASSERT(ok, "vectors should convert component by component");
+
+		std::vector<Mani::Quath> halfRotations(rotations.size());
+		std::vector<Mani::Quatf> decoded(rotations.size());
+		Mani::convert(rotations, halfRotations);
+		Mani::convert(halfRotations, decoded);
+		bool close = true;
+		for (std::size_t i = 0; i < rotations.size(); ++i)
+		{
+			close &= decoded[i].isNearlyEqual(rotations[i], 1. / 2048.);
+		}
+		MANI_TEST_ASSERT(close, "half quaternions should keep 11 bits");
+	}
+}
+MANI_SECTION_END(Half)
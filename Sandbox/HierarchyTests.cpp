@@ -0,0 +1,95 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/TransformHierarchy.h"
+
+MANI_SECTION_BEGIN(TransformHierarchy, "Transform hierarchy section")
+{
+	MANI_TEST(HierarchyMatchesMat4Chain, "world transforms should match the Mat4 TRS chain")
+	{
+		Mani::TransformHierarchyf hierarchy;
+		const Mani::Vec3f t = { 1.f, 2.f, 3.f };
+		const Mani::Quatf r = Mani::Quatf::axisAngleDeg(30.f, Mani::Vec3f{ 0.f, 1.f, 0.f });
+		const Mani::Vec3f s = { 1.f, 2.f, 1.f };
+
+		const auto root = hierarchy.add(Mani::TransformHierarchyf::INVALID_INDEX, t, r, s);
+		const auto child = hierarchy.add(root, t, r, s);
+		const auto grandChild = hierarchy.add(child, t, r, s);
+		const auto sibling = hierarchy.add(root);
+		hierarchy.update();
+
+		const Mani::Mat4f local = Mani::MAT4F::IDENTITY.translate(t).rotate(r).scale(s);
+		MANI_TEST_ASSERT(hierarchy.getWorldMatrix(root).isNearlyEqual(local, 1e-5), "root world should be its local transform");
+		MANI_TEST_ASSERT(hierarchy.getWorldMatrix(child).isNearlyEqual(local * local, 1e-5), "child world should be parent * local");
+		MANI_TEST_ASSERT(hierarchy.getWorldMatrix(grandChild).isNearlyEqual(local * local * local, 1e-4), "grand child world should chain all parents");
+		MANI_TEST_ASSERT(hierarchy.getWorldMatrix(sibling).isNearlyEqual(local, 1e-5), "identity child should copy its parent");
+		MANI_TEST_ASSERT(!hierarchy.isDirty(root) && !hierarchy.isDirty(grandChild), "update should clear the dirty flags");
+	}
+
+	MANI_TEST(HierarchyDirtyPropagation, "changing a node should update its subtree only")
+	{
+		Mani::TransformHierarchyd hierarchy;
+		const auto root = hierarchy.add();
+		const auto child = hierarchy.add(root);
+		const auto otherRoot = hierarchy.add();
+		hierarchy.update();
+
+		hierarchy.setLocalTranslation(root, { 0.0, 5.0, 0.0 });
+		MANI_TEST_ASSERT(hierarchy.isDirty(root) && !hierarchy.isDirty(child), "only the modified node should be flagged");
+		hierarchy.update();
+
+		MANI_TEST_ASSERT(hierarchy.getWorld(child).getTranslation().isNearlyEqual(Mani::Vec3d{ 0.0, 5.0, 0.0 }), "the child should follow its parent");
+		MANI_TEST_ASSERT(hierarchy.getWorld(otherRoot) == Mani::AFFINE3D::IDENTITY, "other subtrees should be left alone");
+	}
+
+	MANI_TEST(HierarchyThreadedUpdate, "threaded update should give the same worlds as the serial one")
+	{
+		Mani::TransformHierarchyf serial;
+		Mani::TransformHierarchyf threaded;
+		// above the parallel threshold, a mix of roots, wide levels and deep chains.
+		const auto addNode = [&serial, &threaded](int i)
+		{
+			const auto parent = i % 7 == 0 ? Mani::TransformHierarchyf::INVALID_INDEX : static_cast<Mani::TransformHierarchyf::Index>(i / 2);
+			const Mani::Vec3f t = { static_cast<float>(i % 5), 1.f, -static_cast<float>(i % 3) };
+			const Mani::Quatf r = Mani::Quatf::axisAngle(static_cast<float>(i) * .01f, Mani::Vec3f{ 0.f, 0.f, 1.f });
+			serial.add(parent, t, r, { 1.f, 1.f, 1.f });
+			threaded.add(parent, t, r, { 1.f, 1.f, 1.f });
+		};
+		const auto matches = [&serial, &threaded]()
+		{
+			bool equal = serial.size() == threaded.size();
+			for (Mani::TransformHierarchyf::Index i = 0; i < serial.size(); ++i)
+			{
+				equal &= serial.getWorld(i) == threaded.getWorld(i);
+			}
+			return equal;
+		};
+
+		for (int i = 0; i < 6000; ++i)
+		{
+			addNode(i);
+		}
+		serial.update();
+		threaded.update(4);
+		MANI_TEST_ASSERT(matches(), "every world should match");
+
+		// a few dirty subtrees on the cached partition, then new nodes forcing a new one.
+		for (Mani::TransformHierarchyf::Index i = 3; i < serial.size(); i += 97)
+		{
+			serial.setLocalTranslation(i, { 2.f, static_cast<float>(i), 0.f });
+			threaded.setLocalTranslation(i, { 2.f, static_cast<float>(i), 0.f });
+		}
+		serial.update();
+		threaded.update(4);
+		MANI_TEST_ASSERT(matches(), "dirty subtrees should match");
+
+		for (int i = 6000; i < 7000; ++i)
+		{
+			addNode(i);
+		}
+		serial.update();
+		threaded.update(4);
+		MANI_TEST_ASSERT(matches() && !threaded.isDirty(6999), "added nodes should match");
+	}
+}
+MANI_SECTION_END(TransformHierarchy)
@@ -0,0 +1,114 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/KdTree.h"
+
+#include "TestPoints.h"
+
+#include <algorithm>
+#include <vector>
+
+using ManiSandbox::scatteredPoints;
+using ManiSandbox::isSameDistance;
+using ManiSandbox::isRadiusResult;
+
+namespace
+{
+	template<Mani::Size N>
+	std::vector<float> sortedDistances(const std::vector<Mani::Vec<float, N>>& points, const Mani::Vec<float, N>& center)
+	{
+		std::vector<float> distances(points.size());
+		for (std::size_t i = 0; i < points.size(); ++i)
+		{
+			distances[i] = points[i].distanceSquared(center);
+		}
+		std::sort(distances.begin(), distances.end());
+		return distances;
+	}
+
+	// nearest and 5 nearest of 50 queries against a sorted brute force, distances are compared since ties may swap indices.
+	template<Mani::Size N>
+	int nearestMatches(std::size_t count, std::size_t threadCount)
+	{
+		const std::vector<Mani::Vec<float, N>> points = scatteredPoints<N>(count);
+		const std::vector<Mani::Vec<float, N>> queries = scatteredPoints<N>(count + 50);
+		const Mani::KdTree<float, N> tree = Mani::KdTree<float, N>::build(points, threadCount);
+
+		int matches = 0;
+		for (std::size_t q = count; q < count + 50; ++q)
+		{
+			const std::vector<float> expected = sortedDistances(points, queries[q]);
+			matches += isSameDistance(points[tree.queryNearest(queries[q])].distanceSquared(queries[q]), expected[0]);
+
+			uint32_t nearest[5];
+			bool ok = tree.queryKNearest(queries[q], nearest) == 5;
+			for (std::size_t k = 0; k < 5; ++k)
+			{
+				ok &= isSameDistance(points[nearest[k]].distanceSquared(queries[q]), expected[k]);
+			}
+			matches += ok;
+		}
+		return matches;
+	}
+}
+
+MANI_SECTION_BEGIN(KdTree, "K-d tree section")
+{
+	MANI_TEST(KdTreeNearest, "nearest and k nearest queries should match a brute force scan in 2, 3 and 4 dimensions")
+	{
+		MANI_TEST_ASSERT(nearestMatches<2>(3000, 1) == 100, "2d queries should match the brute force");
+		MANI_TEST_ASSERT(nearestMatches<3>(3000, 1) == 100, "3d queries should match the brute force");
+		MANI_TEST_ASSERT(nearestMatches<4>(3000, 1) == 100, "4d queries should match the brute force");
+		// threaded build above the parallel threshold.
+		MANI_TEST_ASSERT(nearestMatches<3>(50000, 4) == 100, "a threaded build should answer the same queries");
+
+		const Mani::KdTree3f tree = Mani::KdTree3f::build(scatteredPoints<3>(100));
+		MANI_TEST_ASSERT(tree.queryNearest({ 100.f, 100.f, 100.f }, 1.f) == Mani::KdTree3f::INVALID_INDEX, "nothing should be found beyond the max radius");
+		MANI_TEST_ASSERT(Mani::KdTree3f().queryNearest({ 0.f, 0.f, 0.f }) == Mani::KdTree3f::INVALID_INDEX, "an empty tree should find nothing");
+	}
+
+	MANI_TEST(KdTreeRadius, "radius queries should report each point within the radius exactly once")
+	{
+		const std::vector<Mani::Vec3f> points = scatteredPoints<3>(4000);
+		const Mani::KdTree3f tree = Mani::KdTree3f::build(points);
+
+		int matches = 0;
+		for (int i = 0; i < 50; ++i)
+		{
+			const Mani::Vec3f& center = points[i * 71];
+			const float radius = .5f + (i % 5) * .5f;
+			std::vector<uint32_t> found;
+			tree.queryRadius(center, radius, found);
+			matches += isRadiusResult(points, center, radius, found);
+		}
+		MANI_TEST_ASSERT(matches == 50, "radius queries should match the brute force");
+	}
+
+	MANI_TEST(KdTreeBatched, "batched queries should match single queries")
+	{
+		const std::vector<Mani::Vec3f> points = scatteredPoints<3>(2000);
+		const std::vector<Mani::Vec3f> queries = scatteredPoints<3>(2300);
+		const std::span<const Mani::Vec3f> batch = std::span(queries).subspan(2000);
+		const Mani::KdTree3f tree = Mani::KdTree3f::build(points);
+
+		std::vector<uint32_t> nearest(batch.size());
+		tree.queryNearest(batch, nearest, 3);
+		std::vector<uint32_t> kNearest(batch.size() * 4);
+		tree.queryKNearest(batch, 4, kNearest, 3);
+
+		int matches = 0;
+		for (std::size_t q = 0; q < batch.size(); ++q)
+		{
+			uint32_t expected[4];
+			tree.queryKNearest(batch[q], expected);
+			matches += nearest[q] == tree.queryNearest(batch[q]) && std::equal(expected, expected + 4, kNearest.begin() + q * 4);
+		}
+		MANI_TEST_ASSERT(matches == 300, "every batched result should match its single query");
+
+		const Mani::KdTree3f small = Mani::KdTree3f::build(scatteredPoints<3>(2));
+		std::vector<uint32_t> padded(4);
+		small.queryKNearest(batch.first(1), 4, padded);
+		MANI_TEST_ASSERT(padded[2] == Mani::KdTree3f::INVALID_INDEX && padded[3] == Mani::KdTree3f::INVALID_INDEX, "missing neighbors should be invalid");
+	}
+}
+MANI_SECTION_END(KdTree)
@@ -0,0 +1,83 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Lazy.h"
+
+#include <vector>
+
+MANI_SECTION_BEGIN(Lazy, "Lazy expression section")
+{
+	MANI_TEST(LazyValues, "lazy expressions should evaluate like the eager operators")
+	{
+		const Mani::Vec3f a = { 1.f, 2.f, 3.f };
+		const Mani::Vec3f b = { -4.f, .5f, 2.f };
+		const Mani::Vec3f c = { .25f, -1.f, 8.f };
+
+		const Mani::Vec3f eager = a * 2.f + b * .5f - c;
+		const Mani::Vec3f fused = Mani::lazy(a) * 2.f + Mani::lazy(b) * .5f - c;
+		MANI_TEST_ASSERT(fused.isNearlyEqual(eager, 1e-6), "a fused chain should match the eager one, up to the fma rounding");
+		MANI_TEST_ASSERT((Mani::lazy(a) * b - a / 2.f).eval() == a * b - a / 2.f, "component-wise products and divisions should match");
+		MANI_TEST_ASSERT((-(Mani::lazy(a) + b)).eval() == -(a + b), "negation should match");
+
+		Mani::Vec3f v = a;
+		Mani::lazy(v) += Mani::lazy(b) * 3.f;
+		MANI_TEST_ASSERT(v == a + b * 3.f, "compound assignment should update the target");
+		Mani::lazy(v) = Mani::lazy(v) * 2.f - v;
+		MANI_TEST_ASSERT(v == a + b * 3.f, "the target may appear in its own expression");
+
+		const Mani::Quatf q1 = { .1f, .2f, .3f, .9f };
+		const Mani::Quatf q2 = { -.5f, .5f, .1f, .7f };
+		const Mani::Quatf blended = Mani::lazy(q1) * .25f + Mani::lazy(q2) * .75f;
+		MANI_TEST_ASSERT(blended.isNearlyEqual(q1 * .25f + q2 * .75f, 1e-6), "quaternion blends should match");
+	}
+
+	MANI_TEST(LazyRanges, "lazy ranges should be evaluated element by element in one pass")
+	{
+		constexpr std::size_t count = 101;
+		std::vector<Mani::Vec3f> positions(count);
+		std::vector<Mani::Vec3f> velocities(count);
+		std::vector<float> inverseMasses(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			positions[i] = { i * .5f, -1.f * i, 2.f };
+			velocities[i] = { 1.f, i * .25f, -3.f };
+			inverseMasses[i] = 1.f / (1.f + i);
+		}
+		const Mani::Vec3f gravity = { 0.f, -9.81f, 0.f };
+		const Mani::Vec3f force = { 2.f, 0.f, -1.f };
+		const float dt = 1.f / 60.f;
+
+		std::vector<Mani::Vec3f> expectedPositions = positions;
+		std::vector<Mani::Vec3f> expectedVelocities = velocities;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			expectedVelocities[i] += (gravity + force * inverseMasses[i]) * dt;
+			expectedPositions[i] += expectedVelocities[i] * dt;
+		}
+
+		Mani::lazy(velocities) += (Mani::lazy(force) * Mani::lazy(inverseMasses) + gravity) * dt;
+		Mani::lazy(positions) += Mani::lazy(velocities) * dt;
+
+		int matches = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			matches += velocities[i].isNearlyEqual(expectedVelocities[i], 1e-5) && positions[i].isNearlyEqual(expectedPositions[i], 1e-5);
+		}
+		MANI_TEST_ASSERT(matches == count, "every particle should be integrated");
+
+		std::vector<Mani::Vec3f> copy(count);
+		Mani::lazy(copy) = Mani::lazy(positions);
+		MANI_TEST_ASSERT(copy == positions, "assigning a range should copy the values");
+		Mani::Vec3f wind = { .5f, 0.f, -.5f };
+		Mani::lazy(copy) = Mani::lazy(positions) + Mani::lazy(wind);
+		MANI_TEST_ASSERT(copy[count - 1] == positions[count - 1] + wind, "a single writable value should be broadcast when read");
+		Mani::lazy(copy) = Mani::Vec3f{ 1.f, 2.f, 3.f };
+		MANI_TEST_ASSERT(copy[count - 1] == (Mani::Vec3f{ 1.f, 2.f, 3.f }), "a single value should be broadcast to every element");
+
+		std::vector<Mani::Vec<float, 6>> states(count, Mani::Vec<float, 6>::make(1.f));
+		const std::vector<Mani::Vec<float, 6>> deltas(count, Mani::Vec<float, 6>::make(.5f));
+		Mani::lazy(states) -= Mani::lazy(deltas) * 4.f;
+		MANI_TEST_ASSERT((states[7] == Mani::Vec<float, 6>::make(-1.f)), "generic vectors should be supported");
+	}
+}
+MANI_SECTION_END(Lazy)
@@ -3,6 +3,9 @@
 
 #include "ManiMaths/Fwd.h"
 
+#include <bit>
+#include <vector>
+
 MANI_SECTION_BEGIN(Matrix4x4, "Enter the Matrix")
 {
 	MANI_TEST(CanSerializeAMat4, "Should successfully serialize and deserialize a Matrix")
@@ -173,6 +176,48 @@ MANI_SECTION_BEGIN(Matrix4x4, "Enter the Matrix")
         MANI_TEST_ASSERT(m1.isNearlyEqual(expected), "should equal matf(24.f)");
     }
 
+    MANI_TEST(Mat4SimdMultiplication, "SIMD mat4 product should agree with the scalar path")
+    {
+        // fused multiply-add rounds once instead of twice, so allow a few ulps when FMA is used.
+#if defined(MANIMATHS_SIMD_FMA)
+        constexpr int32_t maxUlps = 4;
+#else
+        constexpr int32_t maxUlps = 0;
+#endif
+        // positive values only, so that no cancellation inflates the ulp distance.
+        const auto randomMat4 = []()
+        {
+            Mani::Mat4f m;
+            for (Mani::Size i = 0; i < 4; ++i)
+            {
+                m.setLineAt(i, { Mani::Math::linearRand(.5f, 2.f), Mani::Math::linearRand(.5f, 2.f), Mani::Math::linearRand(.5f, 2.f), Mani::Math::linearRand(.5f, 2.f) });
+            }
+            return m;
+        };
+
+        bool agrees = true;
+        for (int n = 0; n < 1000; ++n)
+        {
+            const Mani::Mat4f m1 = randomMat4();
+            const Mani::Mat4f m2 = randomMat4();
+
+            const Mani::Mat4f result = m1 * m2;
+            const Mani::Mat4f expected = Mani::Scalar::mul(m1, m2);
+
+            const float* r = &result._00;
+            const float* e = &expected._00;
+            for (int i = 0; i < 16; ++i)
+            {
+                const int32_t ulps = std::bit_cast<int32_t>(r[i]) - std::bit_cast<int32_t>(e[i]);
+                agrees &= ulps <= maxUlps && ulps >= -maxUlps;
+            }
+        }
+        MANI_TEST_ASSERT(agrees, "m1 * m2 should match Scalar::mul within the allowed ulps");
+
+        constexpr Mani::Mat4f identity = Mani::MAT4F::IDENTITY * Mani::MAT4F::IDENTITY;
+        static_assert(identity == Mani::MAT4F::IDENTITY, "mat4f product should still be usable in constant expressions");
+    }
+
     MANI_TEST(Mat4Transpose, "Should transpose a mat4")
     {
         Mani::Mat4i m1 = {
@@ -225,6 +270,30 @@ MANI_SECTION_BEGIN(Matrix4x4, "Enter the Matrix")
         MANI_TEST_ASSERT((m1 * expected).isNearlyEqual(Mani::MAT4F::IDENTITY), "AB == I means that A and B are inverse of each other");
     }
 
+    MANI_TEST(Mat4RigidAndAffineInverse, "Rigid and affine inverses should match the general inverse")
+    {
+        const Mani::Mat4f view = Mani::Mat4f::lookAt({ 3.f, 4.f, -5.f }, { 0.f, 1.f, 0.f }, { 0.f, 1.f, 0.f });
+        const Mani::Mat4f trs = Mani::MAT4F::IDENTITY
+            .translate(Mani::Vec3f{ 1.f, -2.f, 3.f })
+            .rotate(Mani::Quatf::axisAngleDeg(35.f, Mani::Vec3f{ 1.f, 1.f, 0.f }.normalize()))
+            .scale(Mani::Vec3f{ 2.f, .5f, 3.f });
+        const Mani::Mat4f projection = Mani::Mat4f::perspective(Mani::Math::degToRad(60.f), 16.f / 9.f, .1f, 100.f);
+
+        MANI_TEST_ASSERT(view.classify() == Mani::TransformClass::Rigid, "lookAt should be rigid");
+        MANI_TEST_ASSERT(trs.classify() == Mani::TransformClass::Affine, "scaled TRS should be affine");
+        MANI_TEST_ASSERT(projection.classify() == Mani::TransformClass::Projective, "perspective should be projective");
+
+        MANI_TEST_ASSERT(view.inverseRigid().isNearlyEqual(view.inverse(), 1e-5), "rigid inverse should match the general inverse");
+        MANI_TEST_ASSERT(view.inverseAffine().isNearlyEqual(view.inverse(), 1e-5), "affine inverse should match the general inverse on rigid matrices");
+        MANI_TEST_ASSERT(trs.inverseAffine().isNearlyEqual(trs.inverse(), 1e-5), "affine inverse should match the general inverse");
+        MANI_TEST_ASSERT((trs * trs.inverse(trs.classify())).isNearlyEqual(Mani::MAT4F::IDENTITY, 1e-5), "classified inverse should give identity");
+        MANI_TEST_ASSERT((projection * projection.inverse(projection.classify())).isNearlyEqual(Mani::MAT4F::IDENTITY, 1e-5), "projective matrices should use the general inverse");
+
+        const Mani::Mat4d viewd = Mani::Mat4d::lookAt({ 3.0, 4.0, -5.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 1.0, 0.0 });
+        MANI_TEST_ASSERT(viewd.inverseRigid().isNearlyEqual(viewd.inverse(), 1e-12), "double rigid inverse should match the general inverse");
+        MANI_TEST_ASSERT(viewd.inverseAffine().isNearlyEqual(viewd.inverse(), 1e-12), "double affine inverse should match the general inverse");
+    }
+
     MANI_TEST(Mat4to3Conversion, "should convert properly")
     {
         Mani::Mat4i m1 = {
@@ -380,6 +449,54 @@ MANI_SECTION_BEGIN(Matrix4x4, "Enter the Matrix")
         MANI_TEST_ASSERT(perspectiveMatrix.isNearlyEqual(expected, tolerance), "Perspective matrix should match the expected values.");
     }
 
+    MANI_TEST(Mat4BatchTransforms, "Batched transforms should match per-point products")
+    {
+        std::vector<Mani::Vec3f> points(33);
+        std::vector<Mani::Vec4f> vectors(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            points[i] = { Mani::Math::linearRand(-10.f, 10.f), Mani::Math::linearRand(-10.f, 10.f), Mani::Math::linearRand(-10.f, -1.f) };
+            vectors[i] = { points[i].x, points[i].y, points[i].z, Mani::Math::linearRand(-1.f, 1.f) };
+        }
+
+        const Mani::Mat4f affine = Mani::MAT4F::IDENTITY
+            .scale(Mani::Vec3f{ 1.f, 2.f, 3.f })
+            .rotate(Mani::Quatf::axisAngleDeg(30.f, Mani::Vec3f{ 0.f, 1.f, 0.f }))
+            .translate(Mani::Vec3f{ 5.f, -2.f, 3.f });
+        const Mani::Mat4f projection = Mani::Mat4f::perspective(Mani::Math::degToRad(60.f), 16.f / 9.f, .1f, 100.f);
+
+        MANI_TEST_ASSERT(affine.isAffine(), "TRS matrices are affine");
+        MANI_TEST_ASSERT(!projection.isAffine(), "perspective matrices are not affine");
+
+        std::vector<Mani::Vec3f> transformedPoints(points.size());
+        std::vector<Mani::Vec3f> projectedPoints(points.size());
+        std::vector<Mani::Vec3f> projectivePoints(points.size());
+        std::vector<Mani::Vec3f> transformedDirections(points.size());
+        std::vector<Mani::Vec4f> transformedVectors(points.size());
+        Mani::transformPoints(affine, points, transformedPoints);
+        Mani::transformPoints(projection, points, projectedPoints);
+        Mani::transformPointsProjective(affine, points, projectivePoints);
+        Mani::transformDirections(affine, points, transformedDirections);
+        Mani::transform(affine, vectors, transformedVectors);
+
+        constexpr float tolerance = .0001f;
+        bool matches = true;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const Mani::Vec4f direction = affine * Mani::Vec4f{ points[i].x, points[i].y, points[i].z, 0.f };
+            matches &= transformedPoints[i].isNearlyEqual(affine * points[i], tolerance);
+            matches &= projectedPoints[i].isNearlyEqual(projection * points[i], tolerance);
+            matches &= projectivePoints[i].isNearlyEqual(affine * points[i], tolerance);
+            matches &= transformedDirections[i].isNearlyEqual(Mani::Vec3f{ direction.x, direction.y, direction.z }, tolerance);
+            matches &= transformedVectors[i].isNearlyEqual(affine * vectors[i], tolerance);
+        }
+        MANI_TEST_ASSERT(matches, "every batched result should match its per-point counterpart");
+
+        std::vector<Mani::Vec3f> inPlace = points;
+        Mani::transformPoints(affine, inPlace);
+        MANI_TEST_ASSERT(inPlace == transformedPoints, "in place transforms should match out of place ones");
+    }
+
     MANI_TEST(Mat4Orthographic, "Should generate a valid orthographic projection matrix")
     {
         // Define test parameters
@@ -841,4 +958,94 @@ MANI_SECTION_BEGIN(Matrix3x3, "Enter the Matrix 3x3")
         }
     }
 }
-MANI_SECTION_END(Matrix3x3)
\ No newline at end of file
+MANI_SECTION_END(Matrix3x3)
+
+MANI_SECTION_BEGIN(MatrixNxM, "Generic matrix section")
+{
+	MANI_TEST(GenericMatArithmetic, "Array backed matrices should add, scale and compare")
+	{
+		constexpr Mani::Mat<float, 2, 3> a = { 1.f, 2.f, 3.f, 4.f, 5.f, 6.f };
+		constexpr Mani::Mat<float, 2, 3> b = Mani::Mat<float, 2, 3>::make(1.f);
+
+		static_assert((a + b) == Mani::Mat<float, 2, 3>{ 2.f, 3.f, 4.f, 5.f, 6.f, 7.f });
+		static_assert((a - b) * 2.f == Mani::Mat<float, 2, 3>{ 0.f, 2.f, 4.f, 6.f, 8.f, 10.f });
+		static_assert(2.f * a == a * 2.f && (a * 2.f) / 2.f == a && a != b);
+		// column major: row 1, column 2 is the sixth value.
+		static_assert(a.at(1, 2) == 6.f && a.transpose().at(2, 1) == 6.f && a.transpose().transpose() == a);
+
+		Mani::Mat<float, 2, 3> c = a;
+		c += b;
+		c -= a;
+		c *= 4.f;
+		c /= 2.f;
+		MANI_TEST_ASSERT((c == Mani::Mat<float, 2, 3>::make(2.f)), "compound operators should match the binary ones");
+		MANI_TEST_ASSERT((a[1][2] == 6.f && a.getLineAt(2) == Mani::Vec2f{ 5.f, 6.f }), "index operator and lines should follow the Mat3 / Mat4 layout");
+		MANI_TEST_ASSERT(a.toStringOnOneLine() == "(1, 2)(3, 4)(5, 6)", "toString should print one line per column");
+	}
+
+	MANI_TEST(GenericMatProducts, "Products should mix generic and hand written sizes")
+	{
+		const Mani::Mat4f m4 = Mani::Mat4f::lookAt({ 3.f, 4.f, -5.f }, { 0.f, 1.f, 0.f }, { 0.f, 1.f, 0.f });
+		// top 3 rows of the 4x4.
+		Mani::Mat<float, 3, 4> m34;
+		for (Mani::Size column = 0; column < 4; ++column)
+		{
+			for (Mani::Size row = 0; row < 3; ++row)
+			{
+				m34[row][column] = m4[row][column];
+			}
+		}
+
+		const Mani::Vec4f v = { 1.f, -2.f, 3.f, 1.f };
+		const Mani::Vec4f expected = m4 * v;
+		const Mani::Vec3f product = m34 * v;
+		MANI_TEST_ASSERT(product.isNearlyEqual(Mani::Vec3f{ expected.x, expected.y, expected.z }, 1e-5), "Mat<3, 4> * Vec4 should match the top rows of Mat4 * Vec4");
+
+		// (3x4)^T * (3x4) is a hand written 4x4.
+		const Mani::Mat4f gram = m34.transpose() * m34;
+		bool gramMatches = true;
+		for (Mani::Size row = 0; row < 4; ++row)
+		{
+			for (Mani::Size column = 0; column < 4; ++column)
+			{
+				float sum = 0.f;
+				for (Mani::Size k = 0; k < 3; ++k)
+				{
+					sum += m34[k][row] * m34[k][column];
+				}
+				gramMatches &= Mani::Math::isEqual(gram[row][column], sum, 1e-5f);
+			}
+		}
+		MANI_TEST_ASSERT(gramMatches, "a generic product may produce a hand written matrix");
+
+		const Mani::Mat<float, 4, 3> m43 = m34.transpose();
+		MANI_TEST_ASSERT((m43 * Mani::MAT3F::IDENTITY) == m43, "multiplying by a hand written identity should keep the matrix");
+	}
+
+	MANI_TEST(GenericMatInverse, "Square generic matrices should invert and compute their determinant")
+	{
+		// 6x6 covariance like matrix: diagonally dominant, symmetric.
+		Mani::Mat<double, 6, 6> p;
+		for (Mani::Size row = 0; row < 6; ++row)
+		{
+			for (Mani::Size column = 0; column < 6; ++column)
+			{
+				p[row][column] = row == column ? 10.0 + row : 1.0 / (1.0 + row + column);
+			}
+		}
+		const Mani::Mat<double, 6, 6> identity = Mani::Mat<double, 6, 6>::identity();
+		MANI_TEST_ASSERT((p * p.inverse()).isNearlyEqual(identity, 1e-12) && (p.inverse() * p).isNearlyEqual(identity, 1e-12), "P * P^-1 should be the identity");
+		MANI_TEST_ASSERT(p * identity == p, "multiplying by the identity should keep the matrix");
+
+		// a zero pivot forces a row swap.
+		const Mani::Mat<float, 2, 2> swapped = { 0.f, 1.f, 2.f, 3.f };
+		MANI_TEST_ASSERT(Mani::Math::isEqual(swapped.determinant(), -2.f), "det [0 2; 1 3] should be -2");
+		MANI_TEST_ASSERT((swapped * swapped.inverse()).isNearlyEqual(Mani::Mat<float, 2, 2>::identity()), "a pivoted inverse should still invert");
+
+		Mani::Mat<double, 5, 5> triangular = Mani::Mat<double, 5, 5>::identity() * 2.0;
+		triangular[0][4] = 7.0;
+		MANI_TEST_ASSERT(Mani::Math::isEqual(triangular.determinant(), 32.0), "the determinant of a triangular matrix is the product of its diagonal");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(Mani::Mat<double, 5, 5>::make(1.0).determinant(), 0.0), "a singular matrix should have a zero determinant");
+	}
+}
+MANI_SECTION_END(MatrixNxM)
@@ -0,0 +1,177 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Maths.h"
+#include "ManiMaths/MathsFast.h"
+
+#include <vector>
+
+MANI_SECTION_BEGIN(MathsFast, "Fast approximations section")
+{
+	MANI_TEST(SinCos, "sincos should match sin and cos, in scalar and batch form")
+	{
+		float s = 0.f;
+		float c = 0.f;
+		Mani::Math::sincos(1.25f, s, c);
+		MANI_TEST_ASSERT(s == Mani::Math::sin(1.25f) && c == Mani::Math::cos(1.25f), "sincos should match sin and cos");
+
+		std::vector<double> angles(37);
+		for (std::size_t i = 0; i < angles.size(); ++i)
+		{
+			angles[i] = static_cast<double>(i) * Mani::Math::PId / 18.0;
+		}
+		std::vector<double> sines(angles.size());
+		std::vector<double> cosines(angles.size());
+		Mani::Math::sincos(angles, sines, cosines);
+
+		bool matches = true;
+		for (std::size_t i = 0; i < angles.size(); ++i)
+		{
+			matches &= sines[i] == Mani::Math::sin(angles[i]) && cosines[i] == Mani::Math::cos(angles[i]);
+		}
+		MANI_TEST_ASSERT(matches, "batch sincos should match sin and cos");
+	}
+
+	MANI_TEST(FastTrigonometry, "fast trigonometry should stay within its documented error")
+	{
+		float maxSinError = 0.f;
+		float maxCosError = 0.f;
+		float maxAtan2Error = 0.f;
+		float maxAcosError = 0.f;
+		for (int i = 0; i <= 10000; ++i)
+		{
+			const float v = -100.f + 200.f * static_cast<float>(i) / 10000.f;
+			float s = 0.f;
+			float c = 0.f;
+			Mani::Math::fast::sincos(v, s, c);
+			maxSinError = Mani::Math::maxT(maxSinError, Mani::Math::maxT(Mani::Math::abs(s - Mani::Math::sin(v)), Mani::Math::abs(Mani::Math::fast::sin(v) - Mani::Math::sin(v))));
+			maxCosError = Mani::Math::maxT(maxCosError, Mani::Math::maxT(Mani::Math::abs(c - Mani::Math::cos(v)), Mani::Math::abs(Mani::Math::fast::cos(v) - Mani::Math::cos(v))));
+
+			const float y = Mani::Math::sin(v * 3.f);
+			const float x = Mani::Math::cos(v * 7.f);
+			maxAtan2Error = Mani::Math::maxT(maxAtan2Error, Mani::Math::abs(Mani::Math::fast::atan2(y, x) - std::atan2(y, x)));
+
+			const float u = -1.f + 2.f * static_cast<float>(i) / 10000.f;
+			maxAcosError = Mani::Math::maxT(maxAcosError, Mani::Math::abs(Mani::Math::fast::acos(u) - Mani::Math::acos(u)));
+		}
+
+		// documented bounds plus one float ulp of the reference.
+		MANI_TEST_ASSERT(maxSinError < 2e-7f, "sin should be within 2e-7");
+		MANI_TEST_ASSERT(maxCosError < 2e-7f, "cos should be within 2e-7");
+		MANI_TEST_ASSERT(maxAtan2Error < 5e-7f, "atan2 should be within 5e-7");
+		MANI_TEST_ASSERT(maxAcosError < 6e-7f, "acos should be within 6e-7");
+		MANI_TEST_ASSERT(Mani::Math::fast::atan2(0.f, 0.f) == 0.f, "atan2(0, 0) should be 0");
+	}
+
+	MANI_TEST(FastExpLogRsqrt, "fast exp, log and rsqrt should stay within their documented error")
+	{
+		float maxExpError = 0.f;
+		float maxLogError = 0.f;
+		float maxRsqrtError = 0.f;
+		for (int i = 1; i <= 10000; ++i)
+		{
+			const float e = -80.f + 160.f * static_cast<float>(i) / 10000.f;
+			maxExpError = Mani::Math::maxT(maxExpError, Mani::Math::abs(Mani::Math::fast::exp(e) / std::exp(e) - 1.f));
+
+			const float v = 1000.f * static_cast<float>(i) / 10000.f;
+			maxLogError = Mani::Math::maxT(maxLogError, Mani::Math::abs(Mani::Math::fast::log(v) - std::log(v)));
+			maxRsqrtError = Mani::Math::maxT(maxRsqrtError, Mani::Math::abs(Mani::Math::fast::rsqrt(v) * Mani::Math::sqrt(v) - 1.f));
+		}
+
+		MANI_TEST_ASSERT(maxExpError < 4e-7f, "exp should be within 4e-7 relative");
+		MANI_TEST_ASSERT(maxLogError < 6e-7f, "log should be within 6e-7");
+		MANI_TEST_ASSERT(maxRsqrtError < 6e-6f, "rsqrt should be within 6e-6 relative");
+	}
+
+	MANI_TEST(FastDoublePrecision, "fast functions on doubles should stay within their documented error")
+	{
+		double maxSinError = 0.0;
+		double maxSinCosError = 0.0;
+		double maxAtan2Error = 0.0;
+		double maxAcosError = 0.0;
+		double maxExpError = 0.0;
+		double maxLogError = 0.0;
+		for (int i = 0; i <= 20000; ++i)
+		{
+			const double t = static_cast<double>(i) / 20000.0;
+			const double v = -1e4 + 2e4 * t;
+			double s = 0.0;
+			double c = 0.0;
+			Mani::Math::fast::sincos(v, s, c);
+			maxSinError = Mani::Math::maxT(maxSinError, Mani::Math::maxT(Mani::Math::abs(Mani::Math::fast::sin(v) - std::sin(v)), Mani::Math::abs(Mani::Math::fast::cos(v) - std::cos(v))));
+			maxSinCosError = Mani::Math::maxT(maxSinCosError, Mani::Math::maxT(Mani::Math::abs(s - std::sin(v)), Mani::Math::abs(c - std::cos(v))));
+
+			const double y = std::sin(v * 3.0);
+			const double x = std::cos(v * 7.0);
+			maxAtan2Error = Mani::Math::maxT(maxAtan2Error, Mani::Math::abs(Mani::Math::fast::atan2(y, x) - std::atan2(y, x)));
+
+			const double u = -1.0 + 2.0 * t;
+			maxAcosError = Mani::Math::maxT(maxAcosError, Mani::Math::abs(Mani::Math::fast::acos(u) - std::acos(u)));
+
+			const double e = -87.0 + 174.0 * t;
+			maxExpError = Mani::Math::maxT(maxExpError, Mani::Math::abs(Mani::Math::fast::exp(e) / std::exp(e) - 1.0));
+
+			const double l = 1e-30 + 1e6 * t;
+			maxLogError = Mani::Math::maxT(maxLogError, Mani::Math::abs(Mani::Math::fast::log(l) - std::log(l)));
+		}
+
+		MANI_TEST_ASSERT(maxSinError < 2e-11, "sin and cos should be within 2e-11");
+		MANI_TEST_ASSERT(maxSinCosError < 3e-9, "sincos should be within 3e-9");
+		MANI_TEST_ASSERT(maxAtan2Error < 2e-8, "atan2 should be within 2e-8");
+		MANI_TEST_ASSERT(maxAcosError < 3e-8, "acos should be within 3e-8");
+		MANI_TEST_ASSERT(maxExpError < 2e-9, "exp should be within 2e-9 relative");
+		MANI_TEST_ASSERT(maxLogError < 2e-9, "log should be within 2e-9");
+		MANI_TEST_ASSERT(Mani::Math::fast::exp(200.0) == Mani::Math::fast::exp(87.0) && Mani::Math::fast::exp(-200.0) == Mani::Math::fast::exp(-87.0), "exp should clamp outside [-87, 87]");
+	}
+
+	MANI_TEST(FastBatches, "batch forms should match the scalar functions")
+	{
+		std::vector<float> values(101);
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			values[i] = static_cast<float>(i) * .1f - 5.f;
+		}
+
+		std::vector<float> sines(values.size());
+		std::vector<float> cosines(values.size());
+		Mani::Math::fast::sincos(values, sines, cosines);
+
+		std::vector<float> exps(values.size());
+		Mani::Math::fast::exp(values, exps);
+
+		std::vector<float> arcs(values.size());
+		std::vector<float> units(values.size());
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			units[i] = values[i] * .2f;
+		}
+		Mani::Math::fast::acos(units, arcs);
+
+		std::vector<double> doubles(values.begin(), values.end());
+		std::vector<double> doubleSines(values.size());
+		Mani::Math::fast::sin(doubles, doubleSines);
+
+		bool matches = true;
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			float s = 0.f;
+			float c = 0.f;
+			Mani::Math::fast::sincos(values[i], s, c);
+			matches &= sines[i] == s && cosines[i] == c;
+			matches &= exps[i] == Mani::Math::fast::exp(values[i]);
+			matches &= arcs[i] == Mani::Math::fast::acos(units[i]);
+			matches &= doubleSines[i] == Mani::Math::fast::sin(doubles[i]);
+		}
+		MANI_TEST_ASSERT(matches, "batches should give the same results as the scalar calls");
+	}
+
+	MANI_TEST(ConstexprFastMaths, "fast functions should be usable in constant expressions")
+	{
+		static_assert(Mani::Math::fast::sin(0.f) == 0.f);
+		static_assert(Mani::Math::fast::cos(0.f) == 1.f);
+		static_assert(Mani::Math::fast::acos(1.f) == 0.f);
+		static_assert(Mani::Math::fast::exp(0.f) == 1.f);
+		static_assert(Mani::Math::fast::log(1.f) == 0.f);
+		static_assert(Mani::Math::fast::rsqrt(4.f) > .4999f && Mani::Math::fast::rsqrt(4.f) < .5001f);
+	}
+}
+MANI_SECTION_END(MathsFast)
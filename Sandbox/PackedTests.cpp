@@ -0,0 +1,118 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Packed.h"
+
+#include <vector>
+
+namespace
+{
+	// the chord formula stays accurate for tiny angles, unlike acos of the dot product.
+	double angleBetween(const Mani::Quatf& a, const Mani::Quatf& b)
+	{
+		const double sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0. ? -1. : 1.;
+		const double dx = a.x - sign * b.x, dy = a.y - sign * b.y, dz = a.z - sign * b.z, dw = a.w - sign * b.w;
+		return 4. * std::asin(std::min(std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw) * .5, 1.));
+	}
+
+	double angleBetween(const Mani::Vec3f& a, const Mani::Vec3f& b)
+	{
+		const double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+		return 2. * std::asin(std::min(std::sqrt(dx * dx + dy * dy + dz * dz) * .5, 1.));
+	}
+
+	std::vector<Mani::Quatf> rotations(std::size_t count)
+	{
+		std::vector<Mani::Quatf> result(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			result[i] = Mani::Quatf{ Mani::Math::sin(i * 1.3f), Mani::Math::cos(i * .7f), Mani::Math::sin(i * 2.9f + 1.f), Mani::Math::cos(i * .11f) - .5f }.normalize();
+		}
+		// exact ties between the largest components.
+		result[0] = { 0.f, 0.f, 0.f, 1.f };
+		result[1] = { .5f, .5f, .5f, .5f };
+		result[2] = { -.5f, .5f, -.5f, .5f };
+		result[3] = { 0.f, -1.f, 0.f, 0.f };
+		return result;
+	}
+
+	std::vector<Mani::Vec3f> directions(std::size_t count)
+	{
+		std::vector<Mani::Vec3f> result(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			result[i] = Mani::Vec3f{ Mani::Math::sin(i * 1.7f), Mani::Math::cos(i * .3f), Mani::Math::sin(i * 2.3f + 2.f) }.normalize();
+		}
+		result[0] = { 1.f, 0.f, 0.f };
+		result[1] = { 0.f, -1.f, 0.f };
+		result[2] = { 0.f, 0.f, 1.f };
+		result[3] = { 0.f, 0.f, -1.f };
+		return result;
+	}
+
+	template<std::size_t Bits>
+	bool quatsWithinBound(const std::vector<Mani::Quatf>& in)
+	{
+		std::vector<Mani::PackedQuat<Bits>> packed(in.size());
+		std::vector<Mani::Quatf> out(in.size());
+		Mani::encode<Bits>(in, packed);
+		Mani::decode<Bits>(packed, out);
+		bool ok = true;
+		for (std::size_t i = 0; i < in.size(); ++i)
+		{
+			ok &= packed[i] == Mani::PackedQuat<Bits>::encode(in[i]);
+			ok &= out[i].isNearlyEqual(packed[i].decode(), 1e-6);
+			ok &= angleBetween(in[i], out[i]) <= Mani::PackedQuat<Bits>::MAX_ANGULAR_ERROR;
+		}
+		return ok;
+	}
+
+	template<std::size_t Bits>
+	bool normalsWithinBound(const std::vector<Mani::Vec3f>& in)
+	{
+		std::vector<Mani::PackedNormal<Bits>> packed(in.size());
+		std::vector<Mani::Vec3f> out(in.size());
+		Mani::encode<Bits>(in, packed);
+		Mani::decode<Bits>(packed, out);
+		bool ok = true;
+		for (std::size_t i = 0; i < in.size(); ++i)
+		{
+			ok &= packed[i] == Mani::PackedNormal<Bits>::encode(in[i]);
+			ok &= out[i].isNearlyEqual(packed[i].decode(), 1e-6);
+			ok &= angleBetween(in[i], out[i]) <= Mani::PackedNormal<Bits>::MAX_ANGULAR_ERROR;
+		}
+		return ok;
+	}
+}
+
+MANI_SECTION_BEGIN(Packed, "Packed section")
+{
+	MANI_TEST(PackedQuat, "smallest three quaternions should decode within their documented error")
+	{
+		// odd count, the SIMD batches have a scalar tail.
+		const std::vector<Mani::Quatf> in = rotations(10007);
+		MANI_TEST_ASSERT(quatsWithinBound<32>(in), "32 bits quaternions should stay within their bound");
+		MANI_TEST_ASSERT(quatsWithinBound<48>(in), "48 bits quaternions should stay within their bound");
+		MANI_TEST_ASSERT(quatsWithinBound<64>(in), "64 bits quaternions should stay within their bound");
+
+		const Mani::Quatf q = in[42];
+		const Mani::Quatf negated = { -q.x, -q.y, -q.z, -q.w };
+		MANI_TEST_ASSERT(Mani::PackedQuat32::encode(q) == Mani::PackedQuat32::encode(negated), "q and -q are the same rotation");
+		MANI_TEST_ASSERT(Mani::PackedQuat64::encode(Mani::Quatf{}).decode() == Mani::Quatf{}, "the identity should be exact");
+
+		const Mani::Quatd rotation = Mani::Quatd{ .1, -.4, .2, .8 }.normalize();
+		MANI_TEST_ASSERT(Mani::PackedQuat64::encode(rotation).decode<double>().isNearlyEqual(rotation, 1e-5), "quaternions should decode as doubles too");
+	}
+
+	MANI_TEST(PackedNormal, "octahedral normals should decode within their documented error")
+	{
+		const std::vector<Mani::Vec3f> in = directions(10007);
+		MANI_TEST_ASSERT(normalsWithinBound<16>(in), "16 bits normals should stay within their bound");
+		MANI_TEST_ASSERT(normalsWithinBound<32>(in), "32 bits normals should stay within their bound");
+
+		MANI_TEST_ASSERT(Mani::PackedNormal32::encode(Mani::Vec3f{ 0.f, 0.f, -1.f }).decode() == (Mani::Vec3f{ 0.f, 0.f, -1.f }), "-z should be exact");
+		MANI_TEST_ASSERT(Mani::PackedNormal16::encode(Mani::Vec3f{ 0.f, 0.f, 0.f }).decode() == (Mani::Vec3f{ 0.f, 0.f, 1.f }), "a zero vector should decode as +z");
+		MANI_TEST_ASSERT((sizeof(Mani::PackedNormal16) == 2 && sizeof(Mani::PackedNormal32) == 4), "normals should take 2 or 4 bytes");
+	}
+}
+MANI_SECTION_END(Packed)
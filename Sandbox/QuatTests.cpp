@@ -2,9 +2,12 @@
 #include "ManiZ/ManiZ.h"
 
 #include "ManiMaths/Quat.h"
+#include "ManiMaths/QuatStream.h"
 #include "ManiMaths/Vec3.h"
 #include "ManiMaths/Maths.h"
 
+#include <vector>
+
 MANI_SECTION_BEGIN(Quaternion, "Quaternion section")
 {
 	MANI_TEST(CanSerializeAQuaternion, "Should successfully serialize and deserialize a quaternion")
@@ -105,6 +108,73 @@ MANI_SECTION_BEGIN(Quaternion, "Quaternion section")
 		}
 	}
 
+	MANI_TEST(QuatStreamBlends, "Batched slerp, nlerp and fastSlerp should match the per quaternion blends")
+	{
+		// 37 pairs, not a multiple of the SIMD width so that the tail is exercised too.
+		std::vector<Mani::Quatf> from(37);
+		std::vector<Mani::Quatf> to(37);
+		std::vector<float> t(37);
+		for (std::size_t i = 0; i < from.size(); ++i)
+		{
+			const float angle = static_cast<float>(i) * .17f;
+			from[i] = Mani::Quatf::axisAngle(angle, Mani::Vec3f{ 1.f, 2.f, 3.f }.normalize());
+			to[i] = Mani::Quatf::axisAngle(angle * 1.5f + 1.f, Mani::Vec3f{ -2.f, 1.f, .5f }.normalize());
+			if (from[i].dot(to[i]) < 0.f)
+			{
+				to[i] = -to[i];
+			}
+			t[i] = static_cast<float>(i) / 36.f;
+		}
+		// identical pair, takes the nearly parallel fallback.
+		to[5] = from[5];
+
+		const Mani::QuatfStream q1 = Mani::QuatfStream::make(from);
+		const Mani::QuatfStream q2 = Mani::QuatfStream::make(to);
+
+		Mani::QuatfStream slerped;
+		Mani::QuatfStream::slerp(q1, q2, t, slerped);
+		Mani::QuatfStream nlerped;
+		Mani::QuatfStream::nlerp(q1, q2, t, nlerped);
+		Mani::QuatfStream fastSlerped;
+		Mani::QuatfStream::fastSlerp(q1, q2, t, fastSlerped);
+		Mani::QuatfStream shared;
+		Mani::QuatfStream::slerp(q1, q2, .25f, shared);
+
+		bool slerpMatches = true;
+		bool nlerpMatches = true;
+		bool fastSlerpMatches = true;
+		bool sharedMatches = true;
+		for (std::size_t i = 0; i < from.size(); ++i)
+		{
+			slerpMatches &= slerped.get(i).isNearlyEqual(Mani::Quatf::slerp(from[i], to[i], t[i]), 1e-5f);
+			nlerpMatches &= nlerped.get(i).isNearlyEqual(Mani::Scalar::quatBlend<Mani::QuatBlend::Nlerp>(from[i], to[i], t[i]), 1e-5f);
+			fastSlerpMatches &= fastSlerped.get(i).isNearlyEqual(slerped.get(i), 1e-3f);
+			sharedMatches &= shared.get(i).isNearlyEqual(Mani::Quatf::slerp(from[i], to[i], .25f), 1e-5f);
+		}
+		MANI_TEST_ASSERT(slerpMatches, "batched slerp should match Quat::slerp");
+		MANI_TEST_ASSERT(nlerpMatches, "batched nlerp should match the scalar nlerp");
+		MANI_TEST_ASSERT(fastSlerpMatches, "fastSlerp should stay close to slerp");
+		MANI_TEST_ASSERT(sharedMatches, "a shared t should be applied to every pair");
+	}
+
+	MANI_TEST(QuatStreamShortestPath, "Batched blends should go along the shortest path")
+	{
+		const Mani::Quatd from = Mani::Quatd::axisAngle(.2, Mani::Vec3d{ 0.0, 1.0, 0.0 });
+		const Mani::Quatd to = Mani::Quatd::axisAngle(.8, Mani::Vec3d{ 0.0, 1.0, 0.0 });
+		const Mani::Quatd expected = Mani::Quatd::axisAngle(.5, Mani::Vec3d{ 0.0, 1.0, 0.0 });
+
+		Mani::QuatdStream q1 = Mani::QuatdStream::make(1);
+		Mani::QuatdStream q2 = Mani::QuatdStream::make(1);
+		q1.set(0, from);
+		q2.set(0, -to);
+
+		Mani::QuatdStream out;
+		Mani::QuatdStream::slerp(q1, q2, .5, out);
+		MANI_TEST_ASSERT(out.get(0).isNearlyEqual(expected, 1e-9), "slerp should flip the second quaternion");
+		Mani::QuatdStream::nlerp(q1, q2, .5, out);
+		MANI_TEST_ASSERT(out.get(0).isNearlyEqual(expected, 1e-9), "nlerp should flip the second quaternion");
+	}
+
 	MANI_TEST(ConstexprQuatfOperators, "All Quatf operators should be constexpr-compatible")
 	{
 		{
@@ -0,0 +1,114 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Ray.h"
+
+#include <vector>
+
+MANI_SECTION_BEGIN(Ray, "Ray section")
+{
+	MANI_TEST(RayAABBSlabs, "slab tests should return the entry distance")
+	{
+		const Mani::AABBf box = { { -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f } };
+		float tNear = 0.f;
+
+		MANI_TEST_ASSERT(Mani::Rayf::make({ -5.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }).intersectsAABB(box, 100.f, tNear) && Mani::Math::isEqual(tNear, 4.f), "a ray facing the box should enter at its face");
+		MANI_TEST_ASSERT(Mani::Rayf::make({ 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }).intersectsAABB(box, 100.f, tNear) && tNear == 0.f, "a ray starting inside should enter at 0");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ -5.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }).intersectsAABB(box), "a ray facing away should miss");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ -5.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }).intersectsAABB(box, 3.f, tNear), "a box past tMax should miss");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ -5.f, 2.f, 0.f }, { 1.f, 0.f, 0.f }).intersectsAABB(box), "an axis parallel ray beside the box should miss");
+		MANI_TEST_ASSERT(Mani::Rayf::fromPoints({ -5.f, -5.f, -5.f }, { 0.f, 0.f, 0.f }).intersectsAABB(box), "a diagonal ray should hit");
+	}
+
+	MANI_TEST(RayTriangle, "Moller-Trumbore should return distances and barycentrics")
+	{
+		const Mani::Vec3f v0 = { 0.f, 0.f, 0.f };
+		const Mani::Vec3f v1 = { 1.f, 0.f, 0.f };
+		const Mani::Vec3f v2 = { 0.f, 1.f, 0.f };
+		float t = 0.f, u = 0.f, v = 0.f;
+
+		const Mani::Rayf ray = Mani::Rayf::make({ .25f, .5f, 2.f }, { 0.f, 0.f, -1.f });
+		MANI_TEST_ASSERT(ray.intersectTriangle(v0, v1, v2, t, u, v), "a ray through the triangle should hit");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(t, 2.f) && Mani::Math::isEqual(u, .25f) && Mani::Math::isEqual(v, .5f), "hit distance and barycentrics should match");
+		MANI_TEST_ASSERT(ray.at(t).isNearlyEqual(v0 * (1.f - u - v) + v1 * u + v2 * v), "barycentrics should rebuild the hit point");
+		MANI_TEST_ASSERT(Mani::Rayf::make({ .25f, .5f, -2.f }, { 0.f, 0.f, 1.f }).intersectTriangle(v0, v1, v2, t, u, v), "back faces should be hit");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ .75f, .5f, 2.f }, { 0.f, 0.f, -1.f }).intersectTriangle(v0, v1, v2, t, u, v), "a ray beside the triangle should miss");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ .25f, .5f, 2.f }, { 0.f, 0.f, 1.f }).intersectTriangle(v0, v1, v2, t, u, v), "a triangle behind the ray should miss");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ .25f, .5f, 2.f }, { 1.f, 0.f, 0.f }).intersectTriangle(v0, v1, v2, t, u, v), "a parallel ray should miss");
+	}
+
+	MANI_TEST(RaySphereAndPlane, "sphere and plane tests should return the nearest non negative distance")
+	{
+		float t = 0.f;
+		MANI_TEST_ASSERT(Mani::Rayf::make({ 0.f, 0.f, -5.f }, { 0.f, 0.f, 1.f }).intersectSphere({ 0.f, 0.f, 0.f }, 2.f, t) && Mani::Math::isEqual(t, 3.f), "a ray facing the sphere should hit its near side");
+		MANI_TEST_ASSERT(Mani::Rayf::make({ 0.f, 0.f, 0.f }, { 0.f, 0.f, 2.f }).intersectSphere({ 0.f, 0.f, 0.f }, 2.f, t) && Mani::Math::isEqual(t, 1.f), "a ray inside should hit the far side, in direction units");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ 0.f, 3.f, -5.f }, { 0.f, 0.f, 1.f }).intersectSphere({ 0.f, 0.f, 0.f }, 2.f, t), "a ray beside the sphere should miss");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ 0.f, 0.f, 5.f }, { 0.f, 0.f, 1.f }).intersectSphere({ 0.f, 0.f, 0.f }, 2.f, t), "a sphere behind the ray should miss");
+
+		const Mani::Vec4f ground = { 0.f, 1.f, 0.f, 1.f };
+		MANI_TEST_ASSERT(Mani::Rayf::make({ 3.f, 4.f, 0.f }, { 0.f, -1.f, 0.f }).intersectPlane(ground, t) && Mani::Math::isEqual(t, 5.f), "a ray facing the plane should hit it");
+		MANI_TEST_ASSERT(Mani::Rayf::make({ 3.f, -4.f, 0.f }, { 0.f, 1.f, 0.f }).intersectPlane(ground, t) && Mani::Math::isEqual(t, 3.f), "planes should be hit from both sides");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ 3.f, 4.f, 0.f }, { 0.f, 1.f, 0.f }).intersectPlane(ground, t), "a plane behind the ray should miss");
+		MANI_TEST_ASSERT(!Mani::Rayf::make({ 3.f, 4.f, 0.f }, { 1.f, 0.f, 0.f }).intersectPlane(ground, t), "a parallel ray should miss");
+	}
+
+	MANI_TEST(RayPackets, "packet tests should match the single ray tests lane by lane")
+	{
+		std::vector<Mani::Rayf> rays;
+		for (int i = 0; i < 8; ++i)
+		{
+			const Mani::Vec3f origin = { -2.f + i * .6f, .3f * (i % 3), 4.f - (i % 2) * 8.f };
+			rays.push_back(Mani::Rayf::fromPoints(origin, { .2f * i - .5f, .25f, (i % 4) * .5f - 1.f }));
+		}
+		// degenerate lanes: parallel to the triangle and the plane, starting inside the sphere.
+		rays[5] = Mani::Rayf::make({ 0.f, 0.f, 1.f }, { 1.f, 0.f, 0.f });
+		rays[6] = Mani::Rayf::make({ .1f, .1f, .1f }, { 0.f, 1.f, 0.f });
+
+		const Mani::Vec3f v0 = { -1.f, -1.f, 0.f };
+		const Mani::Vec3f v1 = { 2.f, -1.f, 0.f };
+		const Mani::Vec3f v2 = { 0.f, 2.f, 0.f };
+		const Mani::AABBf box = { { -1.f, 0.f, -.5f }, { 1.f, .5f, .5f } };
+		const Mani::Vec4f plane = { 0.f, 0.f, 1.f, 0.f };
+
+		auto check = [&](const auto& packet, std::span<const Mani::Rayf> source)
+		{
+			alignas(32) float t[8], u[8], v[8], tMax[8], tNear[8];
+			std::fill_n(tMax, 8, 100.f);
+			const unsigned triangleHits = packet.intersectTriangle(v0, v1, v2, t, u, v);
+			bool same = true;
+			for (std::size_t i = 0; i < source.size(); ++i)
+			{
+				float rt = 0.f, ru = 0.f, rv = 0.f;
+				const bool hit = source[i].intersectTriangle(v0, v1, v2, rt, ru, rv);
+				same &= hit == ((triangleHits >> i) & 1) && (!hit || (Mani::Math::isEqual(rt, t[i], 1e-5f) && Mani::Math::isEqual(ru, u[i], 1e-5f) && Mani::Math::isEqual(rv, v[i], 1e-5f)));
+			}
+			const unsigned boxHits = packet.intersectAABB(box, tMax, tNear);
+			const unsigned sphereHits = packet.intersectSphere({ 0.f, .5f, 0.f }, 1.f, t);
+			for (std::size_t i = 0; i < source.size(); ++i)
+			{
+				float rt = 0.f;
+				const bool hit = source[i].intersectsAABB(box, 100.f, rt);
+				same &= hit == ((boxHits >> i) & 1) && (!hit || Mani::Math::isEqual(rt, tNear[i], 1e-5f));
+				const bool sphereHit = source[i].intersectSphere({ 0.f, .5f, 0.f }, 1.f, rt);
+				same &= sphereHit == ((sphereHits >> i) & 1) && (!sphereHit || Mani::Math::isEqual(rt, t[i], 1e-5f));
+			}
+			const unsigned planeHits = packet.intersectPlane(plane, t);
+			for (std::size_t i = 0; i < source.size(); ++i)
+			{
+				float rt = 0.f;
+				const bool hit = source[i].intersectPlane(plane, rt);
+				same &= hit == ((planeHits >> i) & 1) && (!hit || Mani::Math::isEqual(rt, t[i], 1e-5f));
+			}
+			return same;
+		};
+
+		alignas(32) float t[8], u[8], v[8];
+		const unsigned triangleHits = Mani::RayPacket8f::make(rays).intersectTriangle(v0, v1, v2, t, u, v);
+		MANI_TEST_ASSERT(triangleHits != 0 && triangleHits != Mani::RayPacket8f::ALL_RAYS, "the test rays should mix hits and misses");
+		MANI_TEST_ASSERT(check(Mani::RayPacket8f::make(rays), rays), "8 wide packets should match single rays");
+		MANI_TEST_ASSERT(check(Mani::RayPacket4f::make(std::span(rays).subspan(4)), std::span(rays).subspan(4)), "4 wide packets should match single rays");
+		MANI_TEST_ASSERT(Mani::RayPacket4f::make(std::span(rays).first(2)).get(3).origin == rays[0].origin, "missing lanes should repeat the first ray");
+		MANI_TEST_ASSERT(Mani::RayPacket8f::make(rays).get(3).origin == rays[3].origin, "get should return the stored ray");
+	}
+}
+MANI_SECTION_END(Ray)
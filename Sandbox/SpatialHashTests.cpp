@@ -0,0 +1,115 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/SpatialHash.h"
+
+#include "TestPoints.h"
+
+#include <algorithm>
+#include <vector>
+
+using ManiSandbox::scatteredPoints;
+using ManiSandbox::isSameDistance;
+using ManiSandbox::isRadiusResult;
+
+MANI_SECTION_BEGIN(SpatialHash, "Spatial hash section")
+{
+	MANI_TEST(SpatialHashRadiusQueries, "radius queries should match a brute force scan")
+	{
+		const std::vector<Mani::Vec3f> points = scatteredPoints<3>(5000, 20.f);
+		Mani::SpatialHashf hash(2.f);
+		hash.build(points);
+		// a tiny table maps many cells to each bucket.
+		Mani::SpatialHashf collisions(2.f);
+		collisions.build(points, 1, 8);
+		MANI_TEST_ASSERT(hash.size() == points.size() && collisions.getBucketCount() == 8, "build should keep every point");
+
+		int matches = 0;
+		for (int i = 0; i < 100; ++i)
+		{
+			const Mani::Vec3f center = points[i * 37] + Mani::Vec3f{ .3f, -.2f, .1f };
+			const float radius = .5f + (i % 8) * .75f;
+			std::vector<uint32_t> found;
+			hash.queryRadius(center, radius, found);
+			matches += isRadiusResult(points, center, radius, found);
+
+			found.clear();
+			collisions.queryRadius(center, radius, found);
+			matches += isRadiusResult(points, center, radius, found);
+		}
+		MANI_TEST_ASSERT(matches == 200, "queries should report each point within the radius exactly once");
+
+		std::vector<uint32_t> all;
+		hash.queryRadius({ 0.f, 0.f, 0.f }, 100.f, all);
+		MANI_TEST_ASSERT(all.size() == points.size(), "a radius covering everything should report every point");
+	}
+
+	MANI_TEST(SpatialHashKNearest, "k nearest queries should return the closest points in order")
+	{
+		const std::vector<Mani::Vec3f> points = scatteredPoints<3>(3000, 20.f);
+		Mani::SpatialHashf hash(1.f);
+		hash.build(points);
+
+		int matches = 0;
+		for (int i = 0; i < 50; ++i)
+		{
+			const Mani::Vec3f center = { (i % 7) * 5.f - 15.f, (i % 5) * 6.f - 12.f, (i % 3) * 9.f - 9.f };
+			std::vector<float> distances(points.size());
+			for (std::size_t p = 0; p < points.size(); ++p)
+			{
+				distances[p] = points[p].distanceSquared(center);
+			}
+			std::vector<float> expected = distances;
+			std::sort(expected.begin(), expected.end());
+
+			uint32_t nearest[8];
+			const std::size_t count = hash.queryKNearest(center, nearest);
+			bool ok = count == 8;
+			for (std::size_t k = 0; k < count; ++k)
+			{
+				// ties may swap indices, distances are compared.
+				ok &= isSameDistance(distances[nearest[k]], expected[k]);
+			}
+			matches += ok;
+		}
+		MANI_TEST_ASSERT(matches == 50, "k nearest should match a sorted brute force scan");
+
+		uint32_t nearest[4];
+		MANI_TEST_ASSERT(hash.queryKNearest({ 100.f, 100.f, 100.f }, nearest, 5.f) == 0, "nothing should be found beyond the max radius");
+		const std::vector<Mani::Vec3f> few = { { 0.f, 0.f, 0.f }, { 3.f, 0.f, 0.f } };
+		Mani::SpatialHashf small(1.f);
+		small.build(few);
+		MANI_TEST_ASSERT(small.queryKNearest({ 2.f, 0.f, 0.f }, nearest) == 2 && nearest[0] == 1 && nearest[1] == 0, "k above the point count should return every point");
+	}
+
+	MANI_TEST(SpatialHashThreadedBuild, "a threaded build should give the same layout as a serial one")
+	{
+		const std::vector<Mani::Vec3f> points = scatteredPoints<3>(100000, 20.f);
+		Mani::SpatialHashf serial(1.5f);
+		serial.build(points);
+		Mani::SpatialHashf threaded(1.5f);
+		threaded.build(points, 4);
+		// 2^23 buckets, a third radix pass on a partial digit.
+		Mani::SpatialHashf wide(1.5f);
+		wide.build(points, 4, 1 << 23);
+
+		int matches = 0;
+		int wideMatches = 0;
+		for (int i = 0; i < 50; ++i)
+		{
+			std::vector<uint32_t> expected;
+			std::vector<uint32_t> found;
+			std::vector<uint32_t> wideFound;
+			serial.queryRadius(points[i * 1999], 1.f, expected);
+			threaded.queryRadius(points[i * 1999], 1.f, found);
+			wide.queryRadius(points[i * 1999], 1.f, wideFound);
+			matches += !expected.empty() && found == expected;
+			std::sort(expected.begin(), expected.end());
+			std::sort(wideFound.begin(), wideFound.end());
+			wideMatches += wideFound == expected;
+		}
+		MANI_TEST_ASSERT(matches == 50, "threaded queries should visit points in the same order");
+		MANI_TEST_ASSERT(wide.getBucketCount() == 1 << 23 && wideMatches == 50, "a table of 2^23 buckets should find the same points");
+	}
+}
+MANI_SECTION_END(SpatialHash)
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ManiMaths/Fwd.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// deterministic point sets shared by the spatial structure tests.
+namespace ManiSandbox
+{
+	// points spread over [-extent, extent] on each axis, negative cells included.
+	template<Mani::Size N>
+	std::vector<Mani::Vec<float, N>> scatteredPoints(std::size_t count, float extent = 10.f)
+	{
+		std::vector<Mani::Vec<float, N>> points(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			float* p = &points[i].x;
+			for (std::size_t axis = 0; axis < N; ++axis)
+			{
+				p[axis] = Mani::Math::sin(i * (1.3f + axis * .57f) + axis) * extent;
+			}
+		}
+		return points;
+	}
+
+	// squared distances computed by different code paths may be contracted into fused multiply adds differently.
+	inline bool isSameDistance(float distanceSquared, float expected)
+	{
+		return Mani::Math::abs(distanceSquared - expected) <= expected * 1e-5f + 1e-6f;
+	}
+
+	// found holds every point within radius of center exactly once, in any order. points within rounding of the
+	// radius may be reported or not.
+	template<Mani::Size N>
+	bool isRadiusResult(const std::vector<Mani::Vec<float, N>>& points, const Mani::Vec<float, N>& center, float radius, std::vector<uint32_t> found)
+	{
+		std::vector<uint32_t> inside;
+		std::vector<uint32_t> allowed;
+		for (uint32_t p = 0; p < points.size(); ++p)
+		{
+			const float distanceSquared = points[p].distanceSquared(center);
+			const bool onBoundary = isSameDistance(distanceSquared, radius * radius);
+			if (distanceSquared <= radius * radius || onBoundary)
+			{
+				allowed.push_back(p);
+				if (!onBoundary)
+				{
+					inside.push_back(p);
+				}
+			}
+		}
+		std::sort(found.begin(), found.end());
+		return std::adjacent_find(found.begin(), found.end()) == found.end()
+			&& std::includes(found.begin(), found.end(), inside.begin(), inside.end())
+			&& std::includes(allowed.begin(), allowed.end(), found.begin(), found.end());
+	}
+}
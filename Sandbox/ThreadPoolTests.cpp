@@ -0,0 +1,168 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/ThreadPool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	std::size_t sum(Mani::ThreadPool& pool, std::size_t begin, std::size_t end)
+	{
+		if (end - begin <= 64)
+		{
+			std::size_t result = 0;
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				result += i;
+			}
+			return result;
+		}
+
+		const std::size_t middle = begin + (end - begin) / 2;
+		std::size_t left = 0;
+		std::size_t right = 0;
+		pool.invoke([&]() { left = sum(pool, begin, middle); }, [&]() { right = sum(pool, middle, end); });
+		return left + right;
+	}
+}
+
+MANI_SECTION_BEGIN(ThreadPool, "ThreadPool section")
+{
+	MANI_TEST(WorkStealingDeque, "the owner should pop the last pushed, thieves the first pushed")
+	{
+		Mani::WorkStealingDeque<int> deque(2);
+		for (int i = 0; i < 100; ++i)
+		{
+			deque.push(i);
+		}
+		MANI_TEST_ASSERT(deque.size() == 100, "the deque should grow past its capacity");
+
+		int value = -1;
+		MANI_TEST_ASSERT((deque.pop(value) && value == 99), "pop should return the last pushed");
+		MANI_TEST_ASSERT((deque.steal(value) && value == 0), "steal should return the first pushed");
+
+		int taken = 2;
+		while (deque.pop(value))
+		{
+			++taken;
+		}
+		MANI_TEST_ASSERT(taken == 100, "every element should be taken once");
+		MANI_TEST_ASSERT((deque.empty() && !deque.steal(value)), "an empty deque has nothing to steal");
+	}
+
+	MANI_TEST(WorkStealingDequeConcurrent, "items should be taken exactly once while thieves race the owner")
+	{
+		constexpr int count = 200000;
+		Mani::WorkStealingDeque<int> deque;
+		std::vector<std::atomic<int>> seen(count);
+		std::atomic<bool> done = false;
+
+		std::vector<std::thread> thieves;
+		for (int thief = 0; thief < 3; ++thief)
+		{
+			thieves.emplace_back([&]()
+			{
+				int value = 0;
+				while (!done.load())
+				{
+					if (deque.steal(value))
+					{
+						seen[value].fetch_add(1);
+					}
+				}
+			});
+		}
+
+		int value = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			deque.push(i);
+			// pop every other push, so the owner keeps fighting over the last elements.
+			if ((i & 1) && deque.pop(value))
+			{
+				seen[value].fetch_add(1);
+			}
+		}
+		while (deque.pop(value))
+		{
+			seen[value].fetch_add(1);
+		}
+		done.store(true);
+		for (std::thread& thief : thieves)
+		{
+			thief.join();
+		}
+
+		int once = 0;
+		for (const std::atomic<int>& hit : seen)
+		{
+			once += hit.load() == 1;
+		}
+		MANI_TEST_ASSERT(once == count, "every item should be taken once");
+	}
+
+	MANI_TEST(ThreadPoolParallelFor, "parallelFor should run every index exactly once")
+	{
+		Mani::ThreadPool pool(4);
+		MANI_TEST_ASSERT(pool.getWorkerCount() == 4, "the calling thread should count as a worker");
+
+		std::vector<std::atomic<int>> hits(10007);
+		pool.parallelFor(hits.size(), 13, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				hits[i].fetch_add(1);
+			}
+		});
+		int once = 0;
+		for (const std::atomic<int>& hit : hits)
+		{
+			once += hit.load() == 1;
+		}
+		MANI_TEST_ASSERT(once == 10007, "every index should be visited once");
+
+		// nested loops, the waiting thread helps instead of blocking a worker.
+		std::atomic<std::size_t> sum = 0;
+		pool.parallelFor(64, 1, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				pool.parallelFor(100, 7, [&](std::size_t innerBegin, std::size_t innerEnd) { sum.fetch_add(innerEnd - innerBegin); });
+			}
+		});
+		MANI_TEST_ASSERT(sum.load() == 6400, "nested loops should complete");
+
+		Mani::ThreadPool inlinePool(1);
+		std::size_t calls = 0;
+		inlinePool.parallelFor(5000, 10, [&](std::size_t begin, std::size_t end) { calls += begin == 0 && end == 5000; });
+		MANI_TEST_ASSERT(calls == 1, "a single worker pool should run the range inline");
+	}
+
+
+	MANI_TEST(ThreadPoolForkJoin, "fork/join tasks should all complete")
+	{
+		Mani::ThreadPool pool(4);
+		MANI_TEST_ASSERT(sum(pool, 0, 100000) == std::size_t(100000) * 99999 / 2, "a recursive invoke should add every half");
+
+		std::atomic<int> ran = 0;
+		{
+			Mani::TaskGroup group(pool);
+			for (int i = 0; i < 1000; ++i)
+			{
+				group.run([&]() { ran.fetch_add(1); });
+			}
+		}
+		MANI_TEST_ASSERT(ran.load() == 1000, "a task group should wait for its tasks when destroyed");
+
+		Mani::ThreadPool inlinePool(1);
+		MANI_TEST_ASSERT(sum(inlinePool, 0, 1000) == 499500, "a single worker pool should run tasks inline");
+
+		Mani::ThreadPool pinned(3, true);
+		std::atomic<std::size_t> pinnedSum = 0;
+		pinned.parallelFor(3000, 10, [&](std::size_t begin, std::size_t end) { pinnedSum.fetch_add(end - begin); });
+		MANI_TEST_ASSERT(pinnedSum.load() == 3000, "pinned workers should run like the others");
+	}
+}
+MANI_SECTION_END(ThreadPool)
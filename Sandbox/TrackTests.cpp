@@ -0,0 +1,108 @@
+#include "ManiTests/ManiTests.h"
+
+#include "ManiMaths/Fwd.h"
+#include "ManiMaths/Track.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+	Mani::Quatf rotationAt(std::size_t frame)
+	{
+		return { Mani::Math::sin(frame * .01f), .5f, frame * .001f, 1.f };
+	}
+
+	Mani::Vec3f positionAt(std::size_t frame)
+	{
+		return { frame * 1.f, -.5f * frame, 2.f };
+	}
+}
+
+MANI_SECTION_BEGIN(Track, "Track section")
+{
+	MANI_TEST(TrackRoundTrip, "frames written to a track should read back unchanged in any order")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "mani_track.track";
+		constexpr std::size_t framesPerChunk = 1000;
+		constexpr std::size_t frameCount = 10500;
+
+		Mani::TrackWriter<Mani::Quatf, Mani::Vec3f> writer;
+		MANI_TEST_ASSERT(writer.open(path, framesPerChunk), "the track should be created");
+		// frame by frame, then in bulk across chunk boundaries.
+		for (std::size_t frame = 0; frame < 2500; ++frame)
+		{
+			writer.append(rotationAt(frame), positionAt(frame));
+		}
+		std::vector<Mani::Quatf> rotations;
+		std::vector<Mani::Vec3f> positions;
+		for (std::size_t frame = 2500; frame < frameCount; ++frame)
+		{
+			rotations.push_back(rotationAt(frame));
+			positions.push_back(positionAt(frame));
+		}
+		writer.append(rotations, positions);
+		MANI_TEST_ASSERT(writer.getFrameCount() == frameCount, "every frame should be counted");
+		MANI_TEST_ASSERT(writer.close(), "the track should be written");
+
+		using Reader = Mani::TrackReader<Mani::Quatf, Mani::Vec3f>;
+		Reader reader;
+		MANI_TEST_ASSERT(reader.open(path, 3, 1), "the track should be read");
+		MANI_TEST_ASSERT((reader.getFrameCount() == frameCount && reader.getChunkCount() == 11), "the frame and chunk counts should be kept");
+
+		bool sequential = true;
+		for (std::size_t frame = 0; frame < frameCount; ++frame)
+		{
+			Mani::Quatf rotation;
+			Mani::Vec3f position;
+			sequential &= reader.get<0>(frame, rotation) && reader.get<1>(frame, position) && rotation == rotationAt(frame) && position == positionAt(frame);
+		}
+		MANI_TEST_ASSERT(sequential, "a sequential playback should read every frame");
+
+		bool random = true;
+		for (std::size_t i = 0; i < 5000; ++i)
+		{
+			const std::size_t frame = (i * 7919) % frameCount;
+			std::tuple<Mani::Quatf, Mani::Vec3f> values;
+			random &= reader.getFrame(frame, values) && std::get<0>(values) == rotationAt(frame) && std::get<1>(values) == positionAt(frame);
+		}
+		MANI_TEST_ASSERT(random, "random accesses should go through the chunk cache");
+
+		Reader::Chunk last;
+		MANI_TEST_ASSERT(reader.getChunk(10, last), "the last chunk should be mapped");
+		const std::span<const Mani::Vec3f> lastPositions = last.getColumn<1>();
+		MANI_TEST_ASSERT((last.getFirstFrame() == 10000 && lastPositions.size() == 500), "the last chunk should only hold the remaining frames");
+		// the view keeps its chunk mapped once the cache moved on.
+		for (std::size_t chunk = 0; chunk < 10; ++chunk)
+		{
+			Reader::Chunk view;
+			(void)reader.getChunk(chunk, view);
+		}
+		MANI_TEST_ASSERT(lastPositions[499] == positionAt(10499), "a chunk view should outlive its cache entry");
+		MANI_TEST_ASSERT(reinterpret_cast<std::uintptr_t>(last.getColumn<0>().data()) % Mani::Binary::ALIGNMENT == 0, "columns should be aligned");
+
+		Mani::TrackReader<Mani::Vec3f, Mani::Quatf> swapped;
+		MANI_TEST_ASSERT(!swapped.open(path), "a track should only be read with the types it was written with");
+
+		reader.close();
+		Mani::Quatf rotation;
+		Reader::Chunk view;
+		MANI_TEST_ASSERT((reader.getChunkCount() == 0 && !reader.get<0>(0, rotation) && !reader.getChunk(0, view)), "a closed reader should have nothing to read");
+
+		// 2^48 chunks of 64 KB, their size overflows to 0 on 64 bits.
+		{
+			std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+			const std::uint64_t corrupted = (std::uint64_t(1) << 48) * framesPerChunk;
+			file.seekp(offsetof(Mani::TrackHeader, frameCount));
+			file.write(reinterpret_cast<const char*>(&corrupted), sizeof(corrupted));
+		}
+		MANI_TEST_ASSERT((!reader.open(path) && !reader.isOpen() && reader.getChunkCount() == 0), "a frame count beyond the file size should be refused");
+
+		std::filesystem::resize_file(path, Mani::TRACK_BLOCK_SIZE * 3);
+		MANI_TEST_ASSERT(!reader.open(path), "a truncated track should be refused");
+		std::filesystem::remove(path);
+	}
+}
+MANI_SECTION_END(Track)
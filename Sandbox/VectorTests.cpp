@@ -4,6 +4,8 @@
 #include "ManiMaths/Vec2.h"
 #include "ManiMaths/Vec3.h"
 #include "ManiMaths/Vec4.h"
+#include "ManiMaths/VecN.h"
+#include "ManiMaths/Vec3Stream.h"
 
 #include "ManiMaths/Maths.h"
 
@@ -560,6 +562,20 @@ MANI_SECTION_BEGIN(Vec4, "Vector 4D section")
 		MANI_TEST_ASSERT(Mani::Math::isEqual(point.length(), radius), "vector length should equal requested radius");
 	}
 
+	MANI_TEST(SphericalRandomLengthIsRelativeToRadius, "spherical random points should lie on the sphere up to float rounding")
+	{
+		bool onSphere = true;
+		for (const float radius : { 1e-3f, 1.f, 50.f, 1e4f })
+		{
+			for (int i = 0; i < 100; ++i)
+			{
+				const Mani::Vec3f point = Mani::Vec3f::sphericalRandom(radius);
+				onSphere &= Mani::Math::isEqual(point.length(), radius, radius * 1e-5f);
+			}
+		}
+		MANI_TEST_ASSERT(onSphere, "vector length should equal requested radius relative to it");
+	}
+
 	MANI_TEST(ShouldProperlyClampEverything, "Should properly clamp all the expected value")
 	{
 		{
@@ -635,3 +651,118 @@ MANI_SECTION_BEGIN(Vec4, "Vector 4D section")
 	}
 }
 MANI_SECTION_END(Vec4)
+
+
+MANI_SECTION_BEGIN(Vec3Stream, "Vec3 stream section")
+{
+	MANI_TEST(Vec3StreamGatherScatter, "Should round trip between AoS and SoA layouts")
+	{
+		const std::vector<Mani::Vec3f> values = { { 1.f, 2.f, 3.f }, { 4.f, 5.f, 6.f }, { 7.f, 8.f, 9.f } };
+		const Mani::Vec3fStream stream = Mani::Vec3fStream::make(values);
+		MANI_TEST_ASSERT(stream.size() == 3, "stream should have as many elements as the span");
+		MANI_TEST_ASSERT(stream.y[1] == 5.f, "components should be stored per axis");
+		MANI_TEST_ASSERT(stream.get(2) == values[2], "get should rebuild the vector");
+
+		std::vector<Mani::Vec3f> out(values.size());
+		stream.scatter(out);
+		MANI_TEST_ASSERT(out == values, "scatter should restore the original vectors");
+	}
+
+	MANI_TEST(Vec3StreamArithmetic, "Batched operations should match Vec3 operations")
+	{
+		// odd count so that the SIMD tails get exercised too.
+		constexpr std::size_t count = 37;
+		std::vector<Mani::Vec3f> a(count);
+		std::vector<Mani::Vec3f> b(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			a[i] = { Mani::Math::linearRand(-10.f, 10.f), Mani::Math::linearRand(-10.f, 10.f), Mani::Math::linearRand(-10.f, 10.f) };
+			b[i] = { Mani::Math::linearRand(-10.f, 10.f), Mani::Math::linearRand(-10.f, 10.f), Mani::Math::linearRand(-10.f, 10.f) };
+		}
+		a[0] = { 0.f, 0.f, 0.f };
+
+		const Mani::Vec3fStream sa = Mani::Vec3fStream::make(a);
+		const Mani::Vec3fStream sb = Mani::Vec3fStream::make(b);
+
+		const Mani::Vec3fStream sum = sa + sb;
+		const Mani::Vec3fStream difference = sa - sb;
+		const Mani::Vec3fStream scaled = sa * 2.f;
+		Mani::Vec3fStream crossed;
+		Mani::Vec3fStream::cross(sa, sb, crossed);
+		Mani::Vec3fStream normalized = sa;
+		normalized.normalize();
+
+		std::vector<float> dots(count);
+		std::vector<float> lengths(count);
+		std::vector<float> distances(count);
+		sa.dot(sb, dots);
+		sa.length(lengths);
+		sa.distanceSquared(sb, distances);
+
+		constexpr float tolerance = .0001f;
+		bool matches = true;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			matches &= sum.get(i).isNearlyEqual(a[i] + b[i], tolerance);
+			matches &= difference.get(i).isNearlyEqual(a[i] - b[i], tolerance);
+			matches &= scaled.get(i).isNearlyEqual(a[i] * 2.f, tolerance);
+			matches &= crossed.get(i).isNearlyEqual(a[i].cross(b[i]), tolerance);
+			matches &= normalized.get(i).isNearlyEqual(a[i].normalize(), tolerance);
+			matches &= Mani::Math::isEqual(dots[i], a[i].dot(b[i]), tolerance);
+			matches &= Mani::Math::isEqual(lengths[i], a[i].length(), tolerance);
+			matches &= Mani::Math::isEqual(distances[i], a[i].distanceSquared(b[i]), tolerance);
+		}
+		MANI_TEST_ASSERT(matches, "every batched result should match its per-element counterpart");
+		MANI_TEST_ASSERT(normalized.get(0) == Mani::Vec3f{}, "normalizing a zero vector should leave it untouched");
+
+		Mani::Vec3fStream accumulated = sa;
+		accumulated += sb;
+		accumulated -= sb;
+		accumulated *= 3.f;
+		MANI_TEST_ASSERT(accumulated.get(5).isNearlyEqual(a[5] * 3.f, tolerance), "compound operators should work in place");
+	}
+}
+MANI_SECTION_END(Vec3Stream)
+
+MANI_SECTION_BEGIN(VecN, "Generic vector section")
+{
+	MANI_TEST(GenericVecOperators, "Array backed vectors should support the same operations as the hand written ones")
+	{
+		constexpr Mani::Vec<float, 6> a = { 1.f, 2.f, 3.f, 4.f, 5.f, 6.f };
+		constexpr Mani::Vec<float, 6> b = Mani::Vec<float, 6>::make(2.f);
+
+		static_assert((a + b) == Mani::Vec<float, 6>{ 3.f, 4.f, 5.f, 6.f, 7.f, 8.f });
+		static_assert((a - b) == Mani::Vec<float, 6>{ -1.f, 0.f, 1.f, 2.f, 3.f, 4.f });
+		static_assert((a * b) == a * 2.f && 2.f * a == a * 2.f);
+		static_assert((a / 2.f) == Mani::Vec<float, 6>{ .5f, 1.f, 1.5f, 2.f, 2.5f, 3.f });
+		static_assert((-a)[5] == -6.f && a != b);
+		static_assert(a.dot(b) == 42.f && a.lengthSquared() == 91.f);
+
+		Mani::Vec<float, 6> c = a;
+		c += b;
+		c -= a;
+		c *= 3.f;
+		c /= 2.f;
+		MANI_TEST_ASSERT((c == Mani::Vec<float, 6>::make(3.f)), "compound operators should match the binary ones");
+
+		MANI_TEST_ASSERT(Mani::Math::isEqual(a.length(), Mani::Math::sqrt(91.f)), "length should cover every component");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(a.normalize().length(), 1.f), "a normalized vector should have a unit length");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(a.distanceSquared(b), 31.f), "distance should cover every component");
+		MANI_TEST_ASSERT(Mani::Math::isEqual(a.clamp(2.f).length(), 2.f, 1e-5f), "clamp should limit the length");
+		MANI_TEST_ASSERT(a.isNearlyEqual(a + Mani::Vec<float, 6>::make(1e-8f)), "isNearlyEqual should tolerate small differences");
+
+		const Mani::Vec<double, 8> eight = Mani::Vec<double, 8>::make(1.0);
+		MANI_TEST_ASSERT(Mani::Math::isEqual(eight.length(), Mani::Math::sqrt(8.0)), "any size should work");
+		MANI_TEST_ASSERT((Mani::Vec<int, 1>{ 7 }).toString() == "(7)" && (Mani::Vec<int, 5>{ 1, 2, 3, 4, 5 }).toString() == "(1, 2, 3, 4, 5)", "toString should list every component");
+	}
+
+	MANI_TEST(GenericVecComponentAccess, "component() should address hand written and generic vectors alike")
+	{
+		Mani::Vec3f v3 = { 1.f, 2.f, 3.f };
+		Mani::component(v3, 2) = 5.f;
+		Mani::Vec<float, 7> v7;
+		Mani::component(v7, 6) = 4.f;
+		MANI_TEST_ASSERT(v3.z == 5.f && v7[6] == 4.f && Mani::component(Mani::Vec4f{ 1.f, 2.f, 3.f, 4.f }, 3) == 4.f, "component should read and write any vector");
+	}
+}
+MANI_SECTION_END(VecN)
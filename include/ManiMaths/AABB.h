@@ -0,0 +1,326 @@
+#pragma once
+
+#include "_Vec.h"
+#include "_Mat.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Simd.h"
+#include "Vec3.h"
+#include "Mat4.h"
+#include "Affine3.h"
+#include "ThreadPool.h"
+#include "Vec3Stream.h"
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Mani
+{
+	// Axis aligned bounding box stored as its min and max corners.
+	// empty() is inverted (min = +max, max = lowest) so that merging anything into it yields that thing,
+	// an empty box intersects and contains nothing.
+	template<IsNumeric T>
+	struct AABB
+	{
+		Vec<T, 3> min;
+		Vec<T, 3> max;
+
+		[[nodiscard]] static constexpr AABB<T> empty()
+		{
+			constexpr T highest = std::numeric_limits<T>::max();
+			constexpr T lowest = std::numeric_limits<T>::lowest();
+			return { { highest, highest, highest }, { lowest, lowest, lowest } };
+		}
+
+		[[nodiscard]] static constexpr AABB<T> fromCenterExtents(const Vec<T, 3>& center, const Vec<T, 3>& extents)
+		{
+			return { center - extents, center + extents };
+		}
+
+		[[nodiscard]] constexpr bool isEmpty() const
+		{
+			return min.x > max.x || min.y > max.y || min.z > max.z;
+		}
+
+		[[nodiscard]] constexpr Vec<T, 3> center() const
+		{
+			constexpr T _0_5 = static_cast<T>(0.5);
+			return (min + max) * _0_5;
+		}
+
+		// half size along each axis.
+		[[nodiscard]] constexpr Vec<T, 3> extents() const
+		{
+			constexpr T _0_5 = static_cast<T>(0.5);
+			return (max - min) * _0_5;
+		}
+
+		[[nodiscard]] constexpr Vec<T, 3> size() const
+		{
+			return max - min;
+		}
+
+		[[nodiscard]] constexpr T surfaceArea() const
+		{
+			constexpr T _2 = static_cast<T>(2);
+			const Vec<T, 3> d = size();
+			return isEmpty() ? static_cast<T>(0) : _2 * (d.x * d.y + d.y * d.z + d.z * d.x);
+		}
+
+		[[nodiscard]] constexpr T volume() const
+		{
+			const Vec<T, 3> d = size();
+			return isEmpty() ? static_cast<T>(0) : d.x * d.y * d.z;
+		}
+
+		[[nodiscard]] constexpr bool contains(const Vec<T, 3>& p) const
+		{
+			return p.x >= min.x && p.x <= max.x
+				&& p.y >= min.y && p.y <= max.y
+				&& p.z >= min.z && p.z <= max.z;
+		}
+
+		[[nodiscard]] constexpr bool contains(const AABB<T>& other) const
+		{
+			return !other.isEmpty()
+				&& other.min.x >= min.x && other.max.x <= max.x
+				&& other.min.y >= min.y && other.max.y <= max.y
+				&& other.min.z >= min.z && other.max.z <= max.z;
+		}
+
+		// touching boxes intersect.
+		[[nodiscard]] static constexpr bool intersects(const AABB<T>& a, const AABB<T>& b)
+		{
+			return a.min.x <= b.max.x && b.min.x <= a.max.x
+				&& a.min.y <= b.max.y && b.min.y <= a.max.y
+				&& a.min.z <= b.max.z && b.min.z <= a.max.z;
+		}
+
+		[[nodiscard]] constexpr bool intersects(const AABB<T>& other) const
+		{
+			return intersects(*this, other);
+		}
+
+		// union of both boxes.
+		[[nodiscard]] static constexpr AABB<T> merge(const AABB<T>& a, const AABB<T>& b)
+		{
+			return { lower(a.min, b.min), upper(a.max, b.max) };
+		}
+
+		[[nodiscard]] static constexpr AABB<T> merge(const AABB<T>& a, const Vec<T, 3>& p)
+		{
+			return merge(a, AABB<T>{ p, p });
+		}
+
+		// union of all the boxes, empty() for no box.
+		[[nodiscard]] static AABB<T> merge(std::type_identity_t<std::span<const AABB<T>>> boxes)
+		{
+			AABB<T> result = empty();
+			for (const AABB<T>& box : boxes)
+			{
+				result.expand(box);
+			}
+			return result;
+		}
+
+		constexpr AABB<T>& expand(const AABB<T>& other)
+		{
+			*this = merge(*this, other);
+			return *this;
+		}
+
+		constexpr AABB<T>& expand(const Vec<T, 3>& p)
+		{
+			*this = merge(*this, p);
+			return *this;
+		}
+
+		// the result isEmpty() when the boxes don't intersect.
+		[[nodiscard]] static constexpr AABB<T> intersection(const AABB<T>& a, const AABB<T>& b)
+		{
+			return { upper(a.min, b.min), lower(a.max, b.max) };
+		}
+
+		// Arvo's method: each output axis starts at the translation and accumulates, for every input axis, the
+		// smaller and the larger of the two scaled corners. exact bounds of the 8 transformed corners for
+		// 9 products pairs instead of 8 full point transforms. https://www.realtimerendering.com/resources/GraphicsGems/gems/TransBox.c
+		[[nodiscard]] constexpr AABB<T> transform(const Affine3<T>& m) const
+		{
+			if (isEmpty())
+			{
+				return *this;
+			}
+
+			// column j, row i at columns[j][i].
+			const T columns[3][3] = { { m._00, m._01, m._02 }, { m._10, m._11, m._12 }, { m._20, m._21, m._22 } };
+			const T inMin[3] = { min.x, min.y, min.z };
+			const T inMax[3] = { max.x, max.y, max.z };
+			T outMin[3] = { m._30, m._31, m._32 };
+			T outMax[3] = { m._30, m._31, m._32 };
+			for (int i = 0; i < 3; ++i)
+			{
+				for (int j = 0; j < 3; ++j)
+				{
+					const T a = columns[j][i] * inMin[j];
+					const T b = columns[j][i] * inMax[j];
+					outMin[i] += Math::minT(a, b);
+					outMax[i] += Math::maxT(a, b);
+				}
+			}
+			return { { outMin[0], outMin[1], outMin[2] }, { outMax[0], outMax[1], outMax[2] } };
+		}
+
+		// m must be affine, use the 8 corners for projections.
+		[[nodiscard]] AABB<T> transform(const Mat<T, 4, 4>& m) const
+		{
+			return transform(Affine3<T>::fromMat4(m));
+		}
+
+		// out may alias boxes.
+		static void transform(std::type_identity_t<std::span<const AABB<T>>> boxes, const Affine3<T>& m, std::type_identity_t<std::span<AABB<T>>> out)
+		{
+			MANIMATHS_ASSERT(out.size() >= boxes.size());
+			for (std::size_t i = 0; i < boxes.size(); ++i)
+			{
+				out[i] = boxes[i].transform(m);
+			}
+		}
+
+		// bounds of all the points, empty() for no point.
+		[[nodiscard]] static AABB<T> computeBounds(std::span<const Vec<T, 3>> points)
+		{
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				static_assert(sizeof(Vec<float, 3>) == 3 * sizeof(float));
+				AABB<float> bounds = empty();
+				const float* xyz = reinterpret_cast<const float*>(points.data());
+				std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_AVX)
+				i = Simd::bounds3Lanes<Simd::Lanes8>(xyz, points.size(), &bounds.min.x, &bounds.max.x);
+#endif
+				i += Simd::bounds3Lanes<Simd::Lanes4>(xyz + i * 3, points.size() - i, &bounds.min.x, &bounds.max.x);
+				for (; i < points.size(); ++i)
+				{
+					bounds.expand(points[i]);
+				}
+				return bounds;
+			}
+#endif
+			AABB<T> bounds = empty();
+			for (const Vec<T, 3>& p : points)
+			{
+				bounds.expand(p);
+			}
+			return bounds;
+		}
+
+		// same as computeBounds(points) with the points split in threadCount chunks run on the global ThreadPool,
+		// each one bounding its own chunk before the chunks are merged. only worth it for hundreds of thousands of points.
+		[[nodiscard]] static AABB<T> computeBounds(std::span<const Vec<T, 3>> points, std::size_t threadCount)
+		{
+			threadCount = std::clamp<std::size_t>(threadCount, 1, points.size() > 0 ? points.size() : 1);
+			if (threadCount == 1)
+			{
+				return computeBounds(points);
+			}
+
+			std::vector<AABB<T>> chunks(threadCount);
+			ThreadPool::forEachChunk(points.size(), threadCount, [points, &chunks](std::size_t chunk, std::size_t begin, std::size_t end)
+			{
+				chunks[chunk] = computeBounds(points.subspan(begin, end - begin));
+			});
+			return merge(chunks);
+		}
+
+		// structure of arrays points, bounded one axis at a time.
+		[[nodiscard]] static AABB<T> computeBounds(const Vec3Stream<T>& points)
+		{
+			AABB<T> bounds = empty();
+			const T* axes[3] = { points.x.data(), points.y.data(), points.z.data() };
+			T* outMin = &bounds.min.x;
+			T* outMax = &bounds.max.x;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_SSE2)
+				if constexpr (std::is_same_v<T, float>)
+				{
+#if defined(MANIMATHS_SIMD_AVX)
+					i = Simd::bounds1Lanes<Simd::Lanes8>(axes[axis], points.size(), outMin[axis], outMax[axis]);
+#endif
+					i += Simd::bounds1Lanes<Simd::Lanes4>(axes[axis] + i, points.size() - i, outMin[axis], outMax[axis]);
+				}
+#endif
+				for (; i < points.size(); ++i)
+				{
+					outMin[axis] = Math::minT(outMin[axis], axes[axis][i]);
+					outMax[axis] = Math::maxT(outMax[axis], axes[axis][i]);
+				}
+			}
+			return bounds;
+		}
+
+		[[nodiscard]] static bool isNearlyEqual(const AABB<T>& lhs, const AABB<T>& rhs, double tolerance = FLT_EPSILON)
+		{
+			return lhs.min.isNearlyEqual(rhs.min, tolerance) && lhs.max.isNearlyEqual(rhs.max, tolerance);
+		}
+
+		[[nodiscard]] bool isNearlyEqual(const AABB<T>& rhs, double tolerance = FLT_EPSILON) const
+		{
+			return isNearlyEqual(*this, rhs, tolerance);
+		}
+
+		[[nodiscard]] std::string toString() const
+		{
+			return std::format("AABB(min: {}, max: {})", min.toString(), max.toString());
+		}
+
+	private:
+		// component wise min / max written as a < b ? a : b, which compiles to a single minss / maxss.
+		// the <= of Math::minT needs a compare and a blend, merges are the inner loop of bounds and BVH builds.
+		[[nodiscard]] static constexpr Vec<T, 3> lower(const Vec<T, 3>& a, const Vec<T, 3>& b)
+		{
+			return { a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z };
+		}
+
+		[[nodiscard]] static constexpr Vec<T, 3> upper(const Vec<T, 3>& a, const Vec<T, 3>& b)
+		{
+			return { a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z };
+		}
+	};
+
+	template<IsNumeric T>
+	[[nodiscard]] constexpr bool operator==(const AABB<T>& lhs, const AABB<T>& rhs)
+	{
+		return lhs.min == rhs.min && lhs.max == rhs.max;
+	}
+
+	template<IsNumeric T>
+	[[nodiscard]] constexpr bool operator!=(const AABB<T>& lhs, const AABB<T>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	namespace Scalar
+	{
+		// reference for AABB<T>::computeBounds, one point at a time.
+		template<IsNumeric T>
+		[[nodiscard]] AABB<T> computeBounds(std::span<const Vec<T, 3>> points)
+		{
+			AABB<T> bounds = AABB<T>::empty();
+			for (const Vec<T, 3>& p : points)
+			{
+				bounds.expand(p);
+			}
+			return bounds;
+		}
+	}
+
+	typedef AABB<float>		AABBf;
+	typedef AABB<double>	AABBd;
+}
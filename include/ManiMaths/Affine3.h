@@ -0,0 +1,390 @@
+#pragma once
+
+#include "_Mat.h"
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Vec2.h"
+#include "Vec3.h"
+#include "Vec4.h"
+#include "Mat3.h"
+#include "Mat4.h"
+#include "Quat.h"
+#include "Simd.h"
+#include <format>
+#include <type_traits>
+
+namespace Mani
+{
+	// 3x4 affine transform: a 3x3 linear block and a translation, the implicit last row is (0, 0, 0, 1).
+	// Same storage as Mat<T, 4, 4> without its last row: each line is a column, line 3 is the translation.
+	// 48 bytes for float, products and inverses skip all the work the last row of a Mat4 would cost.
+	template<IsNumeric T>
+	struct Affine3
+	{
+		T _00, _01, _02;
+		T _10, _11, _12;
+		T _20, _21, _22;
+		T _30, _31, _32;
+
+		[[nodiscard]] static constexpr Affine3<T> identity()
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			return {
+				_1, _0, _0,
+				_0, _1, _0,
+				_0, _0, _1,
+				_0, _0, _0
+			};
+		}
+
+		// mat must be affine, its last row is dropped.
+		[[nodiscard]] static constexpr Affine3<T> fromMat4(const Mat<T, 4, 4>& mat)
+		{
+			MANIMATHS_ASSERT(mat.isAffine());
+			return {
+				mat._00, mat._01, mat._02,
+				mat._10, mat._11, mat._12,
+				mat._20, mat._21, mat._22,
+				mat._30, mat._31, mat._32
+			};
+		}
+
+		[[nodiscard]] static Affine3<T> fromQuat(const Quat<T>& q)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			const Mat<T, 3, 3> r = toMat3(q);
+			return {
+				r._00, r._01, r._02,
+				r._10, r._11, r._12,
+				r._20, r._21, r._22,
+				_0, _0, _0
+			};
+		}
+
+		// translation * rotation * scale, same as MAT4::IDENTITY.translate(t).rotate(r).scale(s).
+		[[nodiscard]] static Affine3<T> fromTRS(const Vec<T, 3>& t, const Quat<T>& r, const Vec<T, 3>& s)
+		{
+			const Mat<T, 3, 3> m = toMat3(r);
+			return {
+				m._00 * s.x, m._01 * s.x, m._02 * s.x,
+				m._10 * s.y, m._11 * s.y, m._12 * s.y,
+				m._20 * s.z, m._21 * s.z, m._22 * s.z,
+				t.x, t.y, t.z
+			};
+		}
+
+		template<IsNumeric T1, IsNumeric T2>
+		[[nodiscard]] static bool isNearlyEqual(const Affine3<T1>& lhs, const Affine3<T2>& rhs, double tolerance = FLT_EPSILON)
+		{
+			return	Math::abs(lhs._00 - rhs._00) <= tolerance &&
+					Math::abs(lhs._01 - rhs._01) <= tolerance &&
+					Math::abs(lhs._02 - rhs._02) <= tolerance &&
+
+					Math::abs(lhs._10 - rhs._10) <= tolerance &&
+					Math::abs(lhs._11 - rhs._11) <= tolerance &&
+					Math::abs(lhs._12 - rhs._12) <= tolerance &&
+
+					Math::abs(lhs._20 - rhs._20) <= tolerance &&
+					Math::abs(lhs._21 - rhs._21) <= tolerance &&
+					Math::abs(lhs._22 - rhs._22) <= tolerance &&
+
+					Math::abs(lhs._30 - rhs._30) <= tolerance &&
+					Math::abs(lhs._31 - rhs._31) <= tolerance &&
+					Math::abs(lhs._32 - rhs._32) <= tolerance;
+		}
+
+		template<IsNumeric T2>
+		[[nodiscard]] bool isNearlyEqual(const Affine3<T2>& other, double tolerance = FLT_EPSILON) const
+		{
+			return isNearlyEqual(*this, other, tolerance);
+		}
+
+		[[nodiscard]] constexpr Vec<T, 3> getTranslation() const
+		{
+			return { _30, _31, _32 };
+		}
+
+		constexpr void setTranslation(const Vec<T, 3>& t)
+		{
+			_30 = t.x;
+			_31 = t.y;
+			_32 = t.z;
+		}
+
+		// length of each column of the linear block, assumes no shear.
+		[[nodiscard]] Vec<T, 3> getScale() const
+		{
+			return {
+				Math::sqrt(_00 * _00 + _01 * _01 + _02 * _02),
+				Math::sqrt(_10 * _10 + _11 * _11 + _12 * _12),
+				Math::sqrt(_20 * _20 + _21 * _21 + _22 * _22)
+			};
+		}
+
+		// determinant of the linear block.
+		[[nodiscard]] constexpr T determinant() const
+		{
+			return	_00 * (_11 * _22 - _21 * _12) -
+					_10 * (_01 * _22 - _21 * _02) +
+					_20 * (_01 * _12 - _11 * _02);
+		}
+
+		// rotation of the linear block, the scale is removed first. assumes no shear and a positive determinant.
+		[[nodiscard]] Quat<T> toQuat() const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			constexpr T _0_25 = static_cast<T>(0.25);
+			constexpr T _2 = static_cast<T>(2);
+
+			const Vec<T, 3> s = getScale();
+			MANIMATHS_ASSERT(s.x > _0 && s.y > _0 && s.z > _0);
+
+			// r{row}{column}
+			const T r00 = _00 / s.x, r10 = _01 / s.x, r20 = _02 / s.x;
+			const T r01 = _10 / s.y, r11 = _11 / s.y, r21 = _12 / s.y;
+			const T r02 = _20 / s.z, r12 = _21 / s.z, r22 = _22 / s.z;
+
+			// https://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/
+			const T trace = r00 + r11 + r22;
+			if (trace > _0)
+			{
+				const T k = _2 * Math::sqrt(trace + _1);
+				return { (r21 - r12) / k, (r02 - r20) / k, (r10 - r01) / k, _0_25 * k };
+			}
+			if (r00 > r11 && r00 > r22)
+			{
+				const T k = _2 * Math::sqrt(_1 + r00 - r11 - r22);
+				return { _0_25 * k, (r01 + r10) / k, (r02 + r20) / k, (r21 - r12) / k };
+			}
+			if (r11 > r22)
+			{
+				const T k = _2 * Math::sqrt(_1 + r11 - r00 - r22);
+				return { (r01 + r10) / k, _0_25 * k, (r12 + r21) / k, (r02 - r20) / k };
+			}
+			const T k = _2 * Math::sqrt(_1 + r22 - r00 - r11);
+			return { (r02 + r20) / k, (r12 + r21) / k, _0_25 * k, (r10 - r01) / k };
+		}
+
+		// general inverse through the 3x3 inverse of the linear block.
+		[[nodiscard]] Affine3<T> inverse() const
+		{
+			constexpr T _1 = static_cast<T>(1);
+
+			const T det = determinant();
+			MANIMATHS_ASSERT(!Math::isEqual(det, static_cast<T>(0)));
+			const T invDet = _1 / det;
+
+			Affine3<T> r;
+			r._00 = (_11 * _22 - _21 * _12) * invDet;
+			r._01 = (_21 * _02 - _01 * _22) * invDet;
+			r._02 = (_01 * _12 - _11 * _02) * invDet;
+			r._10 = (_20 * _12 - _10 * _22) * invDet;
+			r._11 = (_00 * _22 - _20 * _02) * invDet;
+			r._12 = (_10 * _02 - _00 * _12) * invDet;
+			r._20 = (_10 * _21 - _20 * _11) * invDet;
+			r._21 = (_20 * _01 - _00 * _21) * invDet;
+			r._22 = (_00 * _11 - _10 * _01) * invDet;
+			r.setTranslation(-r.transformDirection(getTranslation()));
+			return r;
+		}
+
+		// inverse of a rotation + translation: the linear block is transposed, no determinant needed.
+		// only valid when the linear block is orthonormal.
+		[[nodiscard]] constexpr Affine3<T> inverseRigid() const
+		{
+			Affine3<T> r = {
+				_00, _10, _20,
+				_01, _11, _21,
+				_02, _12, _22,
+				static_cast<T>(0), static_cast<T>(0), static_cast<T>(0)
+			};
+			r.setTranslation(-r.transformDirection(getTranslation()));
+			return r;
+		}
+
+		// w = 1
+		[[nodiscard]] constexpr Vec<T, 3> transformPoint(const Vec<T, 3>& v) const
+		{
+			return {
+				_00 * v.x + _10 * v.y + _20 * v.z + _30,
+				_01 * v.x + _11 * v.y + _21 * v.z + _31,
+				_02 * v.x + _12 * v.y + _22 * v.z + _32
+			};
+		}
+
+		// w = 0, the translation is ignored.
+		[[nodiscard]] constexpr Vec<T, 3> transformDirection(const Vec<T, 3>& v) const
+		{
+			return {
+				_00 * v.x + _10 * v.y + _20 * v.z,
+				_01 * v.x + _11 * v.y + _21 * v.z,
+				_02 * v.x + _12 * v.y + _22 * v.z
+			};
+		}
+
+		Affine3<T>& translate(const Vec<T, 3>& v)
+		{
+			setTranslation(transformPoint(v));
+			return *this;
+		}
+
+		[[nodiscard]] Affine3<T> translate(const Vec<T, 3>& v) const
+		{
+			Affine3<T> r = *this;
+			return r.translate(v);
+		}
+
+		Affine3<T>& rotate(const Quat<T>& q)
+		{
+			*this = *this * fromQuat(q);
+			return *this;
+		}
+
+		[[nodiscard]] Affine3<T> rotate(const Quat<T>& q) const
+		{
+			return *this * fromQuat(q);
+		}
+
+		Affine3<T>& scale(const Vec<T, 3>& s)
+		{
+			_00 *= s.x; _01 *= s.x; _02 *= s.x;
+			_10 *= s.y; _11 *= s.y; _12 *= s.y;
+			_20 *= s.z; _21 *= s.z; _22 *= s.z;
+			return *this;
+		}
+
+		[[nodiscard]] Affine3<T> scale(const Vec<T, 3>& s) const
+		{
+			Affine3<T> r = *this;
+			return r.scale(s);
+		}
+
+		constexpr operator Mat<T, 3, 3>() const
+		{
+			return {
+				_00, _01, _02,
+				_10, _11, _12,
+				_20, _21, _22,
+			};
+		}
+
+		constexpr operator Mat<T, 4, 4>() const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			return {
+				_00, _01, _02, _0,
+				_10, _11, _12, _0,
+				_20, _21, _22, _0,
+				_30, _31, _32, _1
+			};
+		}
+
+		[[nodiscard]] std::string toString() const
+		{
+			return std::format("({}, {}, {})\n({}, {}, {})\n({}, {}, {})\n({}, {}, {})",
+				_00, _01, _02, _10, _11, _12, _20, _21, _22, _30, _31, _32);
+		}
+	};
+
+	typedef Affine3<float>	Affine3f;
+	typedef Affine3<double>	Affine3d;
+
+	static_assert(sizeof(Affine3f) == 48);
+
+	template<IsNumeric T>
+	[[nodiscard]] constexpr Affine3<T> toAffine3(const Mat<T, 4, 4>& mat)
+	{
+		return Affine3<T>::fromMat4(mat);
+	}
+
+	template<IsNumeric T>
+	[[nodiscard]] Affine3<T> toAffine3(const Quat<T>& q)
+	{
+		return Affine3<T>::fromQuat(q);
+	}
+
+	template<IsNumeric T>
+	[[nodiscard]] constexpr Mat<T, 4, 4> toMat4(const Affine3<T>& a)
+	{
+		return static_cast<Mat<T, 4, 4>>(a);
+	}
+
+	template<IsNumeric T>
+	[[nodiscard]] constexpr bool operator==(const Affine3<T>& lhs, const Affine3<T>& rhs)
+	{
+		return	lhs._00 == rhs._00 && lhs._01 == rhs._01 && lhs._02 == rhs._02 &&
+				lhs._10 == rhs._10 && lhs._11 == rhs._11 && lhs._12 == rhs._12 &&
+				lhs._20 == rhs._20 && lhs._21 == rhs._21 && lhs._22 == rhs._22 &&
+				lhs._30 == rhs._30 && lhs._31 == rhs._31 && lhs._32 == rhs._32;
+	}
+
+	template<IsNumeric T>
+	[[nodiscard]] constexpr bool operator!=(const Affine3<T>& lhs, const Affine3<T>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	namespace Scalar
+	{
+		template<IsNumeric T>
+		[[nodiscard]] constexpr Affine3<T> mul(const Affine3<T>& lhs, const Affine3<T>& rhs)
+		{
+			return Affine3<T>{
+				lhs._00 * rhs._00 + lhs._10 * rhs._01 + lhs._20 * rhs._02, // _00
+				lhs._01 * rhs._00 + lhs._11 * rhs._01 + lhs._21 * rhs._02, // _01
+				lhs._02 * rhs._00 + lhs._12 * rhs._01 + lhs._22 * rhs._02, // _02
+
+				lhs._00 * rhs._10 + lhs._10 * rhs._11 + lhs._20 * rhs._12, // _10
+				lhs._01 * rhs._10 + lhs._11 * rhs._11 + lhs._21 * rhs._12, // _11
+				lhs._02 * rhs._10 + lhs._12 * rhs._11 + lhs._22 * rhs._12, // _12
+
+				lhs._00 * rhs._20 + lhs._10 * rhs._21 + lhs._20 * rhs._22, // _20
+				lhs._01 * rhs._20 + lhs._11 * rhs._21 + lhs._21 * rhs._22, // _21
+				lhs._02 * rhs._20 + lhs._12 * rhs._21 + lhs._22 * rhs._22, // _22
+
+				lhs._00 * rhs._30 + lhs._10 * rhs._31 + lhs._20 * rhs._32 + lhs._30, // _30
+				lhs._01 * rhs._30 + lhs._11 * rhs._31 + lhs._21 * rhs._32 + lhs._31, // _31
+				lhs._02 * rhs._30 + lhs._12 * rhs._31 + lhs._22 * rhs._32 + lhs._32  // _32
+			};
+		}
+	}
+
+	// lhs applied after rhs, same convention as the Mat4 product. 36 multiplies instead of 64.
+	template<IsNumeric T>
+	[[nodiscard]] constexpr Affine3<T> operator*(const Affine3<T>& lhs, const Affine3<T>& rhs)
+	{
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				Affine3<T> result;
+				Simd::affine3Mul(&lhs._00, &rhs._00, &result._00);
+				return result;
+			}
+		}
+#endif
+		return Scalar::mul(lhs, rhs);
+	}
+
+	template<IsNumeric T>
+	constexpr void operator*=(Affine3<T>& lhs, const Affine3<T>& rhs)
+	{
+		lhs = lhs * rhs;
+	}
+
+	namespace AFFINE3F
+	{
+		constexpr Affine3f IDENTITY = Affine3f::identity();
+	}
+
+	namespace AFFINE3D
+	{
+		constexpr Affine3d IDENTITY = Affine3d::identity();
+	}
+}
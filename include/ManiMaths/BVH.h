@@ -0,0 +1,581 @@
+#pragma once
+
+#include "_Aligned.h"
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Vec3.h"
+#include "AABB.h"
+#include "Ray.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace Mani
+{
+	// Bounding volume hierarchy over primitives known by their bounds, queries call back for the primitive tests.
+	// Built top down with a binned surface area heuristic, nodes are stored flat in depth first order: the left
+	// child of an interior node always follows it, and children are always stored after their parent.
+	// Triangle meshes (vertices + 3 indices per triangle) get their own build, refit and query overloads.
+	template<IsNumeric T>
+	struct BVH
+	{
+		using Index = uint32_t;
+		static constexpr Index INVALID_INDEX = std::numeric_limits<Index>::max();
+
+		// centroid bins per axis tried at each split, nodes with fewer primitives use one bin per primitive.
+		static constexpr std::size_t BIN_COUNT = 16;
+		// deeper branches are turned into leaves, this bounds the traversal stacks.
+		static constexpr std::size_t MAX_DEPTH = 64;
+
+		// 32 bytes for float, two nodes per cache line.
+		// interior node: count == 0, the right child is at nodes[index]. leaf: primitives[index, index + count).
+		struct Node
+		{
+			AABB<T> bounds;
+			Index index;
+			Index count;
+
+			[[nodiscard]] bool isLeaf() const { return count != 0; }
+		};
+
+		struct Hit
+		{
+			T t = static_cast<T>(0);
+			// barycentrics of the second and third triangle vertices.
+			T u = static_cast<T>(0);
+			T v = static_cast<T>(0);
+			Index primitive = INVALID_INDEX;
+		};
+
+		// leaves hold up to maxLeafSize primitives, fewer when the heuristic finds a cheaper split.
+		// subtrees are built as tasks of the global ThreadPool until threadCount of them run.
+		[[nodiscard]] static BVH<T> build(std::span<const AABB<T>> bounds, std::size_t threadCount = 1, std::size_t maxLeafSize = 4)
+		{
+			MANIMATHS_ASSERT(bounds.size() < INVALID_INDEX);
+			MANIMATHS_ASSERT(maxLeafSize > 0);
+
+			BVH<T> bvh;
+			if (bounds.empty())
+			{
+				return bvh;
+			}
+
+			// the build partitions copies of the bounds along with their index, every pass then streams through
+			// memory instead of gathering bounds[primitive] from all over the input.
+			std::vector<BuildPrimitive> items(bounds.size());
+			for (std::size_t i = 0; i < bounds.size(); ++i)
+			{
+				items[i] = { bounds[i], bounds[i].center(), static_cast<Index>(i) };
+			}
+			bvh.m_nodes.reserve(2 * bounds.size() / maxLeafSize + 1);
+
+			const Builder builder = { items, maxLeafSize };
+			builder.build(0, static_cast<Index>(bounds.size()), 0, Math::maxT<std::size_t>(threadCount, 1), bvh.m_nodes);
+
+			bvh.m_primitives.resize(bounds.size());
+			for (std::size_t i = 0; i < items.size(); ++i)
+			{
+				bvh.m_primitives[i] = items[i].primitive;
+			}
+			return bvh;
+		}
+
+		[[nodiscard]] static BVH<T> fromTriangles(std::span<const Vec<T, 3>> vertices, std::span<const Index> indices, std::size_t threadCount = 1, std::size_t maxLeafSize = 4)
+		{
+			const std::vector<AABB<T>> bounds = triangleBounds(vertices, indices);
+			return build(bounds, threadCount, maxLeafSize);
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return m_nodes.empty();
+		}
+
+		[[nodiscard]] AABB<T> getBounds() const
+		{
+			return empty() ? AABB<T>::empty() : m_nodes[0].bounds;
+		}
+
+		[[nodiscard]] std::span<const Node> getNodes() const
+		{
+			return m_nodes;
+		}
+
+		// primitive indices in leaf order.
+		[[nodiscard]] std::span<const Index> getPrimitives() const
+		{
+			return m_primitives;
+		}
+
+		// primitives moved but the tree is kept: node bounds are recomputed bottom up, the topology isn't.
+		// much cheaper than a rebuild, queries slow down as the motion drifts away from the built layout.
+		void refit(std::span<const AABB<T>> bounds)
+		{
+			for (std::size_t i = m_nodes.size(); i-- > 0;)
+			{
+				Node& node = m_nodes[i];
+				if (node.isLeaf())
+				{
+					AABB<T> leafBounds = AABB<T>::empty();
+					for (Index p = node.index; p < node.index + node.count; ++p)
+					{
+						MANIMATHS_ASSERT(m_primitives[p] < bounds.size());
+						leafBounds.expand(bounds[m_primitives[p]]);
+					}
+					node.bounds = leafBounds;
+				}
+				else
+				{
+					node.bounds = AABB<T>::merge(m_nodes[i + 1].bounds, m_nodes[node.index].bounds);
+				}
+			}
+		}
+
+		void refitTriangles(std::span<const Vec<T, 3>> vertices, std::span<const Index> indices)
+		{
+			refit(triangleBounds(vertices, indices));
+		}
+
+		// closest hit: intersect(primitive, tMax) tests a primitive and, when it hits closer than tMax, shrinks
+		// tMax to the hit distance and returns true. children are visited near first so tMax prunes early.
+		template<typename TIntersect>
+		bool closestHit(const Ray<T>& ray, T& tMax, TIntersect&& intersect) const
+		{
+			return traverseRay<false>(ray, tMax, intersect);
+		}
+
+		// any hit: stops at the first primitive for which intersect(primitive, tMax) returns true, e.g. shadow rays.
+		template<typename TIntersect>
+		bool anyHit(const Ray<T>& ray, T tMax, TIntersect&& intersect) const
+		{
+			return traverseRay<true>(ray, tMax, intersect);
+		}
+
+		// visit(primitive) for every primitive of the leaves overlapping box. leaves are coarser than their
+		// primitives, visit is expected to run its own exact test.
+		template<typename TVisit>
+		void overlap(const AABB<T>& box, TVisit&& visit) const
+		{
+			if (empty())
+			{
+				return;
+			}
+
+			Index stack[MAX_DEPTH];
+			std::size_t stackSize = 0;
+			stack[stackSize++] = 0;
+			while (stackSize > 0)
+			{
+				const Node& node = m_nodes[stack[--stackSize]];
+				if (!node.bounds.intersects(box))
+				{
+					continue;
+				}
+				if (node.isLeaf())
+				{
+					for (Index p = node.index; p < node.index + node.count; ++p)
+					{
+						visit(m_primitives[p]);
+					}
+				}
+				else
+				{
+					MANIMATHS_ASSERT(stackSize + 2 <= MAX_DEPTH);
+					stack[stackSize++] = node.index;
+					stack[stackSize++] = static_cast<Index>(&node - m_nodes.data()) + 1;
+				}
+			}
+		}
+
+		// closest triangle hit along the ray within tMax, hit is only written on hit.
+		bool closestHit(const Ray<T>& ray, std::span<const Vec<T, 3>> vertices, std::span<const Index> indices, Hit& hit, T tMax = std::numeric_limits<T>::max()) const
+		{
+			Hit closest;
+			const bool found = closestHit(ray, tMax, [&](Index triangle, T& tClosest)
+			{
+				T t, u, v;
+				if (intersectTriangle(ray, vertices, indices, triangle, t, u, v) && t < tClosest)
+				{
+					tClosest = t;
+					closest = { t, u, v, triangle };
+					return true;
+				}
+				return false;
+			});
+			if (found)
+			{
+				hit = closest;
+			}
+			return found;
+		}
+
+		// closest triangle hit of each ray of a packet, hits[i] is only written for the rays in the returned mask.
+		// a node is entered when any ray of the packet still needs it, coherent packets visit about the
+		// nodes a single ray would and share every box and triangle test.
+		template<std::size_t Width>
+		unsigned closestHit(const RayPacket<T, Width>& packet, std::span<const Vec<T, 3>> vertices, std::span<const Index> indices, Hit hits[Width], T tMax = std::numeric_limits<T>::max()) const
+		{
+			if (empty())
+			{
+				return 0;
+			}
+
+			alignas(32) T tClosest[Width];
+			alignas(32) T tNear[Width];
+			alignas(32) T t[Width];
+			alignas(32) T u[Width];
+			alignas(32) T v[Width];
+			std::fill_n(tClosest, Width, tMax);
+
+			unsigned found = 0;
+			Index stack[MAX_DEPTH];
+			std::size_t stackSize = 0;
+			stack[stackSize++] = 0;
+			while (stackSize > 0)
+			{
+				const Index current = stack[--stackSize];
+				const Node& node = m_nodes[current];
+				if (packet.intersectAABB(node.bounds, tClosest, tNear) == 0)
+				{
+					continue;
+				}
+				if (!node.isLeaf())
+				{
+					MANIMATHS_ASSERT(stackSize + 2 <= MAX_DEPTH);
+					stack[stackSize++] = node.index;
+					stack[stackSize++] = current + 1;
+					continue;
+				}
+
+				for (Index p = node.index; p < node.index + node.count; ++p)
+				{
+					const Index triangle = m_primitives[p];
+					unsigned mask = packet.intersectTriangle(vertices[indices[triangle * 3]], vertices[indices[triangle * 3 + 1]], vertices[indices[triangle * 3 + 2]], t, u, v);
+					while (mask != 0)
+					{
+						const int i = std::countr_zero(mask);
+						mask &= mask - 1;
+						if (t[i] < tClosest[i])
+						{
+							tClosest[i] = t[i];
+							hits[i] = { t[i], u[i], v[i], triangle };
+							found |= 1u << i;
+						}
+					}
+				}
+			}
+			return found;
+		}
+
+		// whether any triangle is hit within tMax.
+		[[nodiscard]] bool anyHit(const Ray<T>& ray, std::span<const Vec<T, 3>> vertices, std::span<const Index> indices, T tMax = std::numeric_limits<T>::max()) const
+		{
+			return anyHit(ray, tMax, [&](Index triangle, T tLimit)
+			{
+				T t, u, v;
+				return intersectTriangle(ray, vertices, indices, triangle, t, u, v) && t < tLimit;
+			});
+		}
+
+		// visit(triangle) for every triangle whose bounds overlap box.
+		template<typename TVisit>
+		void overlapTriangles(const AABB<T>& box, std::span<const Vec<T, 3>> vertices, std::span<const Index> indices, TVisit&& visit) const
+		{
+			overlap(box, [&](Index triangle)
+			{
+				const Vec<T, 3>& v0 = vertices[indices[triangle * 3]];
+				const Vec<T, 3>& v1 = vertices[indices[triangle * 3 + 1]];
+				const Vec<T, 3>& v2 = vertices[indices[triangle * 3 + 2]];
+				if (AABB<T>::merge(AABB<T>::merge({ v0, v0 }, v1), v2).intersects(box))
+				{
+					visit(triangle);
+				}
+			});
+		}
+
+	private:
+		struct StackEntry
+		{
+			Index node;
+			T tNear;
+		};
+
+		struct BuildPrimitive
+		{
+			AABB<T> bounds;
+			Vec<T, 3> centroid;
+			Index primitive;
+		};
+
+		struct Builder
+		{
+			std::span<BuildPrimitive> items;
+			std::size_t maxLeafSize;
+
+			// builds items[begin, end) into nodes, interior nodes index into nodes from its start.
+			void build(Index begin, Index end, std::size_t depth, std::size_t threadCount, std::vector<Node, AlignedAllocator<Node>>& nodes) const
+			{
+				AABB<T> nodeBounds = AABB<T>::empty();
+				AABB<T> centroidBounds = AABB<T>::empty();
+				for (Index i = begin; i < end; ++i)
+				{
+					nodeBounds.expand(items[i].bounds);
+					centroidBounds.expand(items[i].centroid);
+				}
+
+				const Index count = end - begin;
+				const std::size_t nodeIndex = nodes.size();
+				nodes.push_back({ nodeBounds, begin, count });
+				if (count == 1 || depth + 1 >= MAX_DEPTH)
+				{
+					return;
+				}
+
+				const Index middle = split(begin, end, nodeBounds, centroidBounds);
+				if (middle == begin)
+				{
+					// the heuristic prefers a leaf.
+					return;
+				}
+
+				nodes[nodeIndex].count = 0;
+				// large right subtrees are a task with their own node array, appended once both sides are done.
+				if (threadCount > 1 && count >= PARALLEL_THRESHOLD)
+				{
+					std::vector<Node, AlignedAllocator<Node>> rightNodes;
+					ThreadPool::global().invoke(
+						[&]() { build(begin, middle, depth + 1, threadCount - threadCount / 2, nodes); },
+						[&]() { build(middle, end, depth + 1, threadCount / 2, rightNodes); });
+
+					const Index offset = static_cast<Index>(nodes.size());
+					nodes[nodeIndex].index = offset;
+					for (Node& node : rightNodes)
+					{
+						node.index += node.isLeaf() ? 0 : offset;
+					}
+					nodes.insert(nodes.end(), rightNodes.begin(), rightNodes.end());
+				}
+				else
+				{
+					build(begin, middle, depth + 1, 1, nodes);
+					nodes[nodeIndex].index = static_cast<Index>(nodes.size());
+					build(middle, end, depth + 1, 1, nodes);
+				}
+			}
+
+			// partitions items[begin, end) and returns the first item of the right child,
+			// or begin when a leaf is cheaper than any split.
+			Index split(Index begin, Index end, const AABB<T>& nodeBounds, const AABB<T>& centroidBounds) const
+			{
+				constexpr T _0 = static_cast<T>(0);
+
+				struct Bin
+				{
+					AABB<T> bounds;
+					Index count;
+				};
+
+				const Index count = end - begin;
+				const std::size_t binCount = Math::minT<std::size_t>(count, BIN_COUNT);
+				const Vec<T, 3> extent = centroidBounds.size();
+				const T* pMin = &centroidBounds.min.x;
+				const T* pExtent = &extent.x;
+
+				T bestCost = std::numeric_limits<T>::max();
+				int bestAxis = -1;
+				std::size_t bestBin = 0;
+				// one pass over the primitives fills the bins of the 3 axes.
+				Bin bins[3][BIN_COUNT];
+				T scales[3];
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					scales[axis] = pExtent[axis] > _0 ? static_cast<T>(binCount) / pExtent[axis] : _0;
+					std::fill_n(bins[axis], binCount, Bin{ AABB<T>::empty(), 0 });
+				}
+				for (Index i = begin; i < end; ++i)
+				{
+					const BuildPrimitive& item = items[i];
+					for (int axis = 0; axis < 3; ++axis)
+					{
+						Bin& bin = bins[axis][binIndex(item.centroid, axis, pMin[axis], scales[axis], binCount)];
+						bin.bounds.expand(item.bounds);
+						++bin.count;
+					}
+				}
+
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (pExtent[axis] <= _0)
+					{
+						continue;
+					}
+
+					// sweep from the right to get the cost of every right side, then from the left.
+					T rightAreas[BIN_COUNT];
+					Index rightCounts[BIN_COUNT];
+					AABB<T> rightBounds = AABB<T>::empty();
+					Index rightCount = 0;
+					for (std::size_t b = binCount - 1; b > 0; --b)
+					{
+						rightBounds.expand(bins[axis][b].bounds);
+						rightCount += bins[axis][b].count;
+						rightAreas[b] = rightBounds.surfaceArea();
+						rightCounts[b] = rightCount;
+					}
+
+					AABB<T> leftBounds = AABB<T>::empty();
+					Index leftCount = 0;
+					for (std::size_t b = 0; b + 1 < binCount; ++b)
+					{
+						leftBounds.expand(bins[axis][b].bounds);
+						leftCount += bins[axis][b].count;
+						if (leftCount == 0 || rightCounts[b + 1] == 0)
+						{
+							continue;
+						}
+						const T cost = leftBounds.surfaceArea() * static_cast<T>(leftCount) + rightAreas[b + 1] * static_cast<T>(rightCounts[b + 1]);
+						if (cost < bestCost)
+						{
+							bestCost = cost;
+							bestAxis = axis;
+							bestBin = b;
+						}
+					}
+				}
+
+				// SAH with unit traversal and intersection costs, relative to the node area:
+				// leaf = count * area, split = area + sum(child area * child count).
+				const T nodeArea = nodeBounds.surfaceArea();
+				const bool canBeLeaf = count <= maxLeafSize;
+				if (bestAxis >= 0 && (!canBeLeaf || nodeArea + bestCost < static_cast<T>(count) * nodeArea))
+				{
+					const T scale = static_cast<T>(binCount) / pExtent[bestAxis];
+					BuildPrimitive* middle = std::partition(items.data() + begin, items.data() + end, [&](const BuildPrimitive& item)
+					{
+						return binIndex(item.centroid, bestAxis, pMin[bestAxis], scale, binCount) <= bestBin;
+					});
+					return static_cast<Index>(middle - items.data());
+				}
+				if (canBeLeaf)
+				{
+					return begin;
+				}
+
+				// all centroids are equal, only an arbitrary split keeps the leaves small.
+				return begin + count / 2;
+			}
+
+			static std::size_t binIndex(const Vec<T, 3>& centroid, int axis, T min, T scale, std::size_t binCount)
+			{
+				// through int, float to unsigned 64 bits conversions are much slower.
+				const int offset = static_cast<int>(((&centroid.x)[axis] - min) * scale);
+				return Math::minT(static_cast<std::size_t>(offset), binCount - 1);
+			}
+		};
+
+		// subtrees smaller than this are built by the task that split them.
+		static constexpr Index PARALLEL_THRESHOLD = 4096;
+
+		template<bool AnyHit, typename TIntersect>
+		bool traverseRay(const Ray<T>& ray, T& tMax, TIntersect& intersect) const
+		{
+			T tNear;
+			if (empty() || !ray.intersectsAABB(m_nodes[0].bounds, tMax, tNear))
+			{
+				return false;
+			}
+
+			StackEntry stack[MAX_DEPTH];
+			std::size_t stackSize = 0;
+			Index current = 0;
+			bool hit = false;
+			while (true)
+			{
+				const Node& node = m_nodes[current];
+				if (node.isLeaf())
+				{
+					for (Index p = node.index; p < node.index + node.count; ++p)
+					{
+						if (intersect(m_primitives[p], tMax))
+						{
+							if constexpr (AnyHit)
+							{
+								return true;
+							}
+							hit = true;
+						}
+					}
+				}
+				else
+				{
+					const Index left = current + 1;
+					const Index right = node.index;
+					T tLeft, tRight;
+					const bool hitLeft = ray.intersectsAABB(m_nodes[left].bounds, tMax, tLeft);
+					const bool hitRight = ray.intersectsAABB(m_nodes[right].bounds, tMax, tRight);
+					if (hitLeft && hitRight)
+					{
+						MANIMATHS_ASSERT(stackSize < MAX_DEPTH);
+						const bool leftFirst = tLeft <= tRight;
+						stack[stackSize++] = leftFirst ? StackEntry{ right, tRight } : StackEntry{ left, tLeft };
+						current = leftFirst ? left : right;
+						continue;
+					}
+					if (hitLeft || hitRight)
+					{
+						current = hitLeft ? left : right;
+						continue;
+					}
+				}
+
+				// pop the next subtree still in front of the closest hit.
+				bool found = false;
+				while (stackSize > 0)
+				{
+					const StackEntry& entry = stack[--stackSize];
+					if (entry.tNear <= tMax)
+					{
+						current = entry.node;
+						found = true;
+						break;
+					}
+				}
+				if (!found)
+				{
+					return hit;
+				}
+			}
+		}
+
+		[[nodiscard]] static bool intersectTriangle(const Ray<T>& ray, std::span<const Vec<T, 3>> vertices, std::span<const Index> indices, Index triangle, T& t, T& u, T& v)
+		{
+			return ray.intersectTriangle(vertices[indices[triangle * 3]], vertices[indices[triangle * 3 + 1]], vertices[indices[triangle * 3 + 2]], t, u, v);
+		}
+
+		[[nodiscard]] static std::vector<AABB<T>> triangleBounds(std::span<const Vec<T, 3>> vertices, std::span<const Index> indices)
+		{
+			MANIMATHS_ASSERT(indices.size() % 3 == 0);
+			std::vector<AABB<T>> bounds(indices.size() / 3);
+			for (std::size_t i = 0; i < bounds.size(); ++i)
+			{
+				const Vec<T, 3>& v0 = vertices[indices[i * 3]];
+				bounds[i] = AABB<T>::merge(AABB<T>::merge({ v0, v0 }, vertices[indices[i * 3 + 1]]), vertices[indices[i * 3 + 2]]);
+			}
+			return bounds;
+		}
+
+		std::vector<Node, AlignedAllocator<Node>> m_nodes;
+		std::vector<Index> m_primitives;
+	};
+
+	static_assert(sizeof(BVH<float>::Node) == 32);
+
+	typedef BVH<float>	BVHf;
+	typedef BVH<double>	BVHd;
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "_Mat.h"
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Simd.h"
+#include "Mat4.h"
+#include "Mat4Batch.h"
+#include "Quat.h"
+#include "QuatStream.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <span>
+#include <type_traits>
+
+namespace Mani
+{
+	// Batched Mat4 and Quat operations over spans, run as the ExecutionPolicy says:
+	// Batchf::multiply(ExecutionPolicy::parallel(), parents, locals, worlds).
+	// outputs may alias their inputs, elements are only ever combined with the ones at the same index.
+	template<IsNumeric T>
+	struct Batch
+	{
+		// mat * v for every v.
+		static void transform(const ExecutionPolicy& policy, const Mat<T, 4, 4>& mat, std::span<const Vec<T, 4>> in, std::span<Vec<T, 4>> out)
+		{
+			MANIMATHS_ASSERT(out.size() >= in.size());
+			policy.run(in.size(), [&](std::size_t begin, std::size_t end)
+			{
+				if (policy.isVectorized())
+				{
+					Mani::transform(mat, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+				}
+				else
+				{
+					Scalar::transform4(mat, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+				}
+			});
+		}
+
+		// same as transformPoints(mat, points, out), the divide by w is skipped when mat is affine.
+		static void transformPoints(const ExecutionPolicy& policy, const Mat<T, 4, 4>& mat, std::span<const Vec<T, 3>> points, std::span<Vec<T, 3>> out)
+		{
+			if (mat.isAffine())
+			{
+				transform3<true, false>(policy, mat, points, out);
+			}
+			else
+			{
+				transform3<true, true>(policy, mat, points, out);
+			}
+		}
+
+		// w = 0: translation and projection are ignored.
+		static void transformDirections(const ExecutionPolicy& policy, const Mat<T, 4, 4>& mat, std::span<const Vec<T, 3>> directions, std::span<Vec<T, 3>> out)
+		{
+			transform3<false, false>(policy, mat, directions, out);
+		}
+
+		// out[i] = lhs[i] * rhs[i]
+		static void multiply(const ExecutionPolicy& policy, std::span<const Mat<T, 4, 4>> lhs, std::span<const Mat<T, 4, 4>> rhs, std::span<Mat<T, 4, 4>> out)
+		{
+			MANIMATHS_ASSERT(lhs.size() == rhs.size() && out.size() >= rhs.size());
+			policy.run(rhs.size(), [&](std::size_t begin, std::size_t end)
+			{
+				if (policy.isVectorized())
+				{
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						out[i] = lhs[i] * rhs[i];
+					}
+				}
+				else
+				{
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						out[i] = Scalar::mul(lhs[i], rhs[i]);
+					}
+				}
+			});
+		}
+
+		// out[i] = lhs * rhs[i], e.g. a parent applied to its children.
+		static void multiply(const ExecutionPolicy& policy, const Mat<T, 4, 4>& lhs, std::span<const Mat<T, 4, 4>> rhs, std::span<Mat<T, 4, 4>> out)
+		{
+			MANIMATHS_ASSERT(out.size() >= rhs.size());
+			policy.run(rhs.size(), [&](std::size_t begin, std::size_t end)
+			{
+				if (policy.isVectorized())
+				{
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						out[i] = lhs * rhs[i];
+					}
+				}
+				else
+				{
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						out[i] = Scalar::mul(lhs, rhs[i]);
+					}
+				}
+			});
+		}
+
+		// general inverse of every matrix, see Mat4::inverse(TransformClass) when they are known to be affine.
+		static void inverse(const ExecutionPolicy& policy, std::span<const Mat<T, 4, 4>> in, std::span<Mat<T, 4, 4>> out)
+		{
+			MANIMATHS_ASSERT(out.size() >= in.size());
+			policy.run(in.size(), [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					out[i] = in[i].inverse();
+				}
+			});
+		}
+
+		static void normalize(const ExecutionPolicy& policy, std::span<const Quat<T>> in, std::span<Quat<T>> out)
+		{
+			constexpr T _1 = static_cast<T>(1);
+
+			MANIMATHS_ASSERT(out.size() >= in.size());
+			policy.run(in.size(), [&](std::size_t begin, std::size_t end)
+			{
+				// branch free, the loop vectorizes without a dedicated kernel.
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const Quat<T> q = in[i];
+					const T invLength = _1 / Math::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+					out[i] = { q.x * invLength, q.y * invLength, q.z * invLength, q.w * invLength };
+				}
+			});
+		}
+
+		// same results as QuatStream<T>::slerp: shortest path, t in [0, 1].
+		static void slerp(const ExecutionPolicy& policy, std::span<const Quat<T>> q1, std::span<const Quat<T>> q2, T t, std::span<Quat<T>> out)
+		{
+			blend<QuatBlend::Slerp, true>(policy, q1, q2, &t, out);
+		}
+
+		static void slerp(const ExecutionPolicy& policy, std::span<const Quat<T>> q1, std::span<const Quat<T>> q2, std::span<const T> t, std::span<Quat<T>> out)
+		{
+			MANIMATHS_ASSERT(t.size() >= q1.size());
+			blend<QuatBlend::Slerp, false>(policy, q1, q2, t.data(), out);
+		}
+
+		template<QuatBlend Blend>
+		static void blend(const ExecutionPolicy& policy, std::span<const Quat<T>> q1, std::span<const Quat<T>> q2, T t, std::span<Quat<T>> out)
+		{
+			blend<Blend, true>(policy, q1, q2, &t, out);
+		}
+
+		template<QuatBlend Blend>
+		static void blend(const ExecutionPolicy& policy, std::span<const Quat<T>> q1, std::span<const Quat<T>> q2, std::span<const T> t, std::span<Quat<T>> out)
+		{
+			MANIMATHS_ASSERT(t.size() >= q1.size());
+			blend<Blend, false>(policy, q1, q2, t.data(), out);
+		}
+
+	private:
+		// quaternions go through the structure of arrays kernels in blocks of this many.
+		static constexpr std::size_t BLEND_BLOCK = 64;
+
+		template<bool IsPoint, bool Divide>
+		static void transform3(const ExecutionPolicy& policy, const Mat<T, 4, 4>& mat, std::span<const Vec<T, 3>> in, std::span<Vec<T, 3>> out)
+		{
+			MANIMATHS_ASSERT(out.size() >= in.size());
+			policy.run(in.size(), [&](std::size_t begin, std::size_t end)
+			{
+				if (policy.isVectorized())
+				{
+					Mani::transform3<IsPoint, Divide>(mat, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+				}
+				else
+				{
+					Scalar::transform3<IsPoint, Divide>(mat, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+				}
+			});
+		}
+
+		template<QuatBlend Blend, bool SharedT>
+		static void blend(const ExecutionPolicy& policy, std::span<const Quat<T>> q1, std::span<const Quat<T>> q2, const T* t, std::span<Quat<T>> out)
+		{
+			MANIMATHS_ASSERT(q1.size() == q2.size() && out.size() >= q1.size());
+			policy.run(q1.size(), [&](std::size_t begin, std::size_t end)
+			{
+#if defined(MANIMATHS_SIMD_SSE2)
+				if constexpr (std::is_same_v<T, float>)
+				{
+					if (policy.isVectorized())
+					{
+						blendBlocks<Blend, SharedT>(q1, q2, t, out, begin, end);
+						return;
+					}
+				}
+#endif
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					out[i] = Scalar::quatBlend<Blend>(q1[i], q2[i], SharedT ? *t : t[i]);
+				}
+			});
+		}
+
+#if defined(MANIMATHS_SIMD_SSE2)
+		// transposes blocks of quaternions to the x, y, z, w arrays the kernels expect, and back.
+		template<QuatBlend Blend, bool SharedT>
+		static void blendBlocks(std::span<const Quat<T>> q1, std::span<const Quat<T>> q2, const float* t, std::span<Quat<T>> out, std::size_t begin, std::size_t end)
+		{
+			alignas(32) float a[4][BLEND_BLOCK];
+			alignas(32) float b[4][BLEND_BLOCK];
+			alignas(32) float r[4][BLEND_BLOCK];
+			const float* const pa[4] = { a[0], a[1], a[2], a[3] };
+			const float* const pb[4] = { b[0], b[1], b[2], b[3] };
+			float* const pr[4] = { r[0], r[1], r[2], r[3] };
+
+			for (std::size_t block = begin; block < end; block += BLEND_BLOCK)
+			{
+				const std::size_t n = std::min(BLEND_BLOCK, end - block);
+				for (std::size_t j = 0; j < n; ++j)
+				{
+					const Quat<T>& qa = q1[block + j];
+					const Quat<T>& qb = q2[block + j];
+					a[0][j] = qa.x; a[1][j] = qa.y; a[2][j] = qa.z; a[3][j] = qa.w;
+					b[0][j] = qb.x; b[1][j] = qb.y; b[2][j] = qb.z; b[3][j] = qb.w;
+				}
+				Simd::quatBlend<Blend, SharedT>(pa, pb, SharedT ? t : t + block, pr, n);
+				for (std::size_t j = 0; j < n; ++j)
+				{
+					out[block + j] = { r[0][j], r[1][j], r[2][j], r[3][j] };
+				}
+			}
+		}
+#endif
+	};
+
+	typedef Batch<float>	Batchf;
+	typedef Batch<double>	Batchd;
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "_Mat.h"
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Quat.h"
+#include "Half.h"
+#include "MappedFile.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Mani
+{
+	// Binary array format: a 64 bytes header followed by the raw elements, little endian, so that a file is
+	// written with one write of the array and read back by mapping it, without copying or parsing.
+	//   Binary::write<Mat4f>("replay.mani", worlds);
+	//   Binary::MappedArray<Mat4f> replay;
+	//   if (replay.open("replay.mani")) { std::span<const Mat4f> worlds = replay.getValues(); }
+	namespace Binary
+	{
+		static_assert(std::endian::native == std::endian::little, "the format is little endian and stored as is");
+
+		// files are refused by readers of another version.
+		constexpr std::uint16_t VERSION = 1;
+		// the elements start at this offset, aligned for any SIMD load once mapped.
+		constexpr std::size_t ALIGNMENT = 64;
+
+		enum class Kind : std::uint8_t
+		{
+			Scalar,
+			Vec,
+			Mat,
+			Quat
+		};
+
+		// bit 7: floating point, bit 6: signed, bit 4: bfloat16, the rest: size in bytes.
+		enum class ScalarType : std::uint8_t
+		{
+			UInt8	= 0x01,
+			UInt16	= 0x02,
+			UInt32	= 0x04,
+			UInt64	= 0x08,
+			Int8	= 0x41,
+			Int16	= 0x42,
+			Int32	= 0x44,
+			Int64	= 0x48,
+			Float16	= 0xC2,
+			BFloat16	= 0xD2,
+			Float32	= 0xC4,
+			Float64	= 0xC8
+		};
+
+		// what an element is, a file is only ever read back as the type it was written from.
+		struct TypeTag
+		{
+			Kind kind = Kind::Scalar;
+			ScalarType scalar = ScalarType::UInt8;
+			// columns of a matrix, elements are stored column major like Mat.
+			std::uint8_t rows = 1;
+			std::uint8_t columns = 1;
+
+			[[nodiscard]] constexpr bool operator==(const TypeTag&) const = default;
+		};
+
+		template<IsNumeric T>
+		[[nodiscard]] constexpr ScalarType getScalarType()
+		{
+			static_assert(sizeof(T) <= 8 && (std::is_integral_v<T> || IsFloatingPoint<T>), "no binary layout for this scalar");
+			constexpr std::uint8_t size = static_cast<std::uint8_t>(sizeof(T));
+			if constexpr (std::is_same_v<T, BFloat16>)
+			{
+				return ScalarType::BFloat16;
+			}
+			else if constexpr (IsFloatingPoint<T>)
+			{
+				return static_cast<ScalarType>(0xC0 | size);
+			}
+			else
+			{
+				return static_cast<ScalarType>((std::is_signed_v<T> ? 0x40 : 0x00) | size);
+			}
+		}
+
+		template<typename T>
+		struct Layout;
+
+		template<IsNumeric T>
+		struct Layout<T>
+		{
+			static constexpr TypeTag TAG{ Kind::Scalar, getScalarType<T>(), 1, 1 };
+			using Scalar = T;
+		};
+
+		template<IsNumeric T, Size I>
+		struct Layout<Vec<T, I>>
+		{
+			static constexpr TypeTag TAG{ Kind::Vec, getScalarType<T>(), I, 1 };
+			using Scalar = T;
+		};
+
+		template<IsNumeric T, Size H, Size W>
+		struct Layout<Mat<T, H, W>>
+		{
+			static constexpr TypeTag TAG{ Kind::Mat, getScalarType<T>(), H, W };
+			using Scalar = T;
+		};
+
+		template<IsNumeric T>
+		struct Layout<Quat<T>>
+		{
+			static constexpr TypeTag TAG{ Kind::Quat, getScalarType<T>(), 4, 1 };
+			using Scalar = T;
+		};
+
+		// types stored as their bytes: no padding between the components, nothing but the components.
+		template<typename T>
+		concept IsSerializable = requires { Layout<T>::TAG; }
+			&& std::is_trivially_copyable_v<T>
+			&& sizeof(T) == sizeof(typename Layout<T>::Scalar) * Layout<T>::TAG.rows * Layout<T>::TAG.columns;
+
+		struct Header
+		{
+			char magic[4] = { 'M', 'A', 'N', 'I' };
+			std::uint16_t version = VERSION;
+			std::uint16_t headerSize = static_cast<std::uint16_t>(ALIGNMENT);
+			TypeTag tag;
+			std::uint32_t elementSize = 0;
+			// of the elements in the file, the same as their offset.
+			std::uint32_t alignment = static_cast<std::uint32_t>(ALIGNMENT);
+			std::uint32_t reserved = 0;
+			std::uint64_t count = 0;
+			// of the element bytes, see checksum().
+			std::uint64_t checksum = 0;
+			std::uint8_t padding[24] = {};
+		};
+		static_assert(sizeof(Header) == ALIGNMENT && std::is_trivially_copyable_v<Header>, "the header is stored as is");
+
+		// 64 bits hash of the bytes, 4 independent lanes over 8 bytes words so that it runs at memory speed.
+		[[nodiscard]] inline std::uint64_t checksum(std::span<const std::byte> bytes)
+		{
+			constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+			constexpr std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+
+			std::uint64_t lanes[4] = { PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1 };
+			const std::byte* data = bytes.data();
+			const std::size_t size = bytes.size();
+			std::size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				for (std::size_t lane = 0; lane < 4; ++lane)
+				{
+					std::uint64_t word;
+					std::memcpy(&word, data + i + lane * 8, 8);
+					lanes[lane] = std::rotl(lanes[lane] + word * PRIME2, 31) * PRIME1;
+				}
+			}
+
+			std::uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+			hash ^= static_cast<std::uint64_t>(size) * PRIME1;
+			for (; i < size; ++i)
+			{
+				hash = std::rotl(hash ^ (static_cast<std::uint64_t>(data[i]) * PRIME1), 11) * PRIME2;
+			}
+			hash ^= hash >> 33;
+			hash *= PRIME2;
+			hash ^= hash >> 29;
+			return hash;
+		}
+
+		template<IsSerializable T>
+		[[nodiscard]] Header makeHeader(std::span<const T> values)
+		{
+			Header header;
+			header.tag = Layout<T>::TAG;
+			header.elementSize = static_cast<std::uint32_t>(sizeof(T));
+			header.count = values.size();
+			header.checksum = checksum(std::as_bytes(values));
+			return header;
+		}
+
+		// how much of a buffer is checked before handing out a view of it.
+		enum class Verify
+		{
+			// type, count and size only, the elements aren't touched.
+			Header,
+			// the checksum too, which reads every element once.
+			Checksum
+		};
+
+		// header and elements of values, e.g. for a network buffer.
+		template<IsSerializable T>
+		[[nodiscard]] std::vector<std::byte> serialize(std::span<const T> values)
+		{
+			const Header header = makeHeader(values);
+			std::vector<std::byte> bytes(sizeof(Header) + values.size_bytes());
+			std::memcpy(bytes.data(), &header, sizeof(Header));
+			if (!values.empty())
+			{
+				std::memcpy(bytes.data() + sizeof(Header), values.data(), values.size_bytes());
+			}
+			return bytes;
+		}
+
+		// values pointing into bytes, which must outlive them. false if bytes don't hold T elements, are truncated,
+		// aren't aligned for T or, with Verify::Checksum, are corrupted.
+		template<IsSerializable T>
+		[[nodiscard]] bool view(std::span<const std::byte> bytes, std::span<const T>& values, Verify verify = Verify::Header)
+		{
+			values = {};
+			if (bytes.size() < sizeof(Header))
+			{
+				return false;
+			}
+			Header header;
+			std::memcpy(&header, bytes.data(), sizeof(Header));
+			const Header expected;
+			if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != VERSION
+				|| header.headerSize != sizeof(Header) || header.tag != Layout<T>::TAG || header.elementSize != sizeof(T))
+			{
+				return false;
+			}
+			const std::byte* data = bytes.data() + sizeof(Header);
+			if (header.count > (bytes.size() - sizeof(Header)) / sizeof(T) || reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0)
+			{
+				return false;
+			}
+			const std::size_t count = static_cast<std::size_t>(header.count);
+			if (verify == Verify::Checksum && checksum({ data, count * sizeof(T) }) != header.checksum)
+			{
+				return false;
+			}
+			values = { reinterpret_cast<const T*>(data), count };
+			return true;
+		}
+
+		// header then elements in one write each, false if the file can't be written.
+		template<IsSerializable T>
+		bool write(const std::filesystem::path& path, std::span<const T> values)
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				return false;
+			}
+			const Header header = makeHeader(values);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+			return static_cast<bool>(file.flush());
+		}
+
+		// Elements of a file written by write<T>, read in place through a MappedFile.
+		template<IsSerializable T>
+		class MappedArray
+		{
+		public:
+			MappedArray() = default;
+
+			// false if the file can't be mapped or doesn't hold T elements, see view().
+			bool open(const std::filesystem::path& path, Verify verify = Verify::Header)
+			{
+				m_values = {};
+				if (!m_file.open(path) || !view(m_file.getBytes(), m_values, verify))
+				{
+					m_file.close();
+					return false;
+				}
+				return true;
+			}
+
+			void close()
+			{
+				m_values = {};
+				m_file.close();
+			}
+
+			[[nodiscard]] bool isOpen() const
+			{
+				return m_file.isOpen();
+			}
+
+			// valid until the array is closed or destroyed.
+			[[nodiscard]] std::span<const T> getValues() const
+			{
+				return m_values;
+			}
+
+			[[nodiscard]] std::size_t getCount() const
+			{
+				return m_values.size();
+			}
+
+			[[nodiscard]] const T& operator[](std::size_t i) const
+			{
+				MANIMATHS_ASSERT(i < m_values.size());
+				return m_values[i];
+			}
+
+			// see MappedFile::advise, e.g. AccessPattern::Sequential before a replay.
+			void advise(AccessPattern pattern) const
+			{
+				m_file.advise(pattern, sizeof(Header), m_values.size_bytes());
+			}
+
+		private:
+			MappedFile m_file;
+			std::span<const T> m_values;
+		};
+	}
+}
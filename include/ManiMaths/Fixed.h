@@ -0,0 +1,388 @@
+#pragma once
+
+#include "Debug.h"
+#include "Traits.h"
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Mani
+{
+	// Fixed point scalar: a 32 bits integer counting steps of 1 / 2^FracBits, IntBits hold the sign and the integer
+	// part. everything, Math:: functions included, computes exact integer results: the same bits with every
+	// compiler and cpu, what lockstep simulations need. + and - wrap on overflow, * rounds to nearest, / truncates
+	// toward zero. floats only come in through conversions, keep them to constants.
+	//   Fixed<16, 16>: [-32768, 32768) by steps of 1.5e-5.
+	template<int IntBits, int FracBits>
+	struct Fixed
+	{
+		static_assert(IntBits + FracBits == 32 && IntBits >= 2 && FracBits >= 1, "fixed point scalars are 32 bits, with room for the sign");
+		// Math:: functions compute on 30 fractional bits.
+		static_assert(FracBits <= 30, "at most 30 fractional bits");
+
+		static constexpr int INT_BITS = IntBits;
+		static constexpr int FRAC_BITS = FracBits;
+		static constexpr std::int32_t ONE = std::int32_t(1) << FracBits;
+
+		std::int32_t raw = 0;
+
+		constexpr Fixed() = default;
+
+		template<typename T>
+		requires std::is_integral_v<T>
+		constexpr Fixed(T value)
+			: raw(static_cast<std::int32_t>(static_cast<std::uint32_t>(value) << FracBits))
+		{
+		}
+
+		// rounded to nearest, ties away from zero.
+		template<typename T>
+		requires std::is_floating_point_v<T>
+		constexpr Fixed(T value)
+			: raw(static_cast<std::int32_t>(static_cast<std::int64_t>(value * static_cast<T>(ONE) + (value < 0 ? static_cast<T>(-.5) : static_cast<T>(.5)))))
+		{
+		}
+
+		[[nodiscard]] static constexpr Fixed fromRaw(std::int32_t raw)
+		{
+			Fixed value;
+			value.raw = raw;
+			return value;
+		}
+
+		// integers are truncated toward zero.
+		template<typename T>
+		requires std::is_arithmetic_v<T>
+		[[nodiscard]] explicit constexpr operator T() const
+		{
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				return static_cast<T>(raw) / static_cast<T>(ONE);
+			}
+			else
+			{
+				return static_cast<T>(raw / ONE);
+			}
+		}
+
+		[[nodiscard]] constexpr Fixed operator-() const
+		{
+			return fromRaw(static_cast<std::int32_t>(0u - static_cast<std::uint32_t>(raw)));
+		}
+
+		[[nodiscard]] friend constexpr Fixed operator+(Fixed lhs, Fixed rhs)
+		{
+			return fromRaw(static_cast<std::int32_t>(static_cast<std::uint32_t>(lhs.raw) + static_cast<std::uint32_t>(rhs.raw)));
+		}
+
+		[[nodiscard]] friend constexpr Fixed operator-(Fixed lhs, Fixed rhs)
+		{
+			return fromRaw(static_cast<std::int32_t>(static_cast<std::uint32_t>(lhs.raw) - static_cast<std::uint32_t>(rhs.raw)));
+		}
+
+		[[nodiscard]] friend constexpr Fixed operator*(Fixed lhs, Fixed rhs)
+		{
+			constexpr std::int64_t half = std::int64_t(1) << (FracBits - 1);
+			return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(lhs.raw) * rhs.raw + half) >> FracBits));
+		}
+
+		[[nodiscard]] friend constexpr Fixed operator/(Fixed lhs, Fixed rhs)
+		{
+			MANIMATHS_ASSERT(rhs.raw != 0);
+			return fromRaw(static_cast<std::int32_t>(static_cast<std::int64_t>(lhs.raw) * ONE / rhs.raw));
+		}
+
+		[[nodiscard]] friend constexpr bool operator==(Fixed lhs, Fixed rhs) = default;
+		[[nodiscard]] friend constexpr std::strong_ordering operator<=>(Fixed lhs, Fixed rhs) = default;
+
+		constexpr Fixed& operator+=(Fixed rhs) { return *this = *this + rhs; }
+		constexpr Fixed& operator-=(Fixed rhs) { return *this = *this - rhs; }
+		constexpr Fixed& operator*=(Fixed rhs) { return *this = *this * rhs; }
+		constexpr Fixed& operator/=(Fixed rhs) { return *this = *this / rhs; }
+	};
+
+	template<int IntBits, int FracBits>
+	struct NumericTraits<Fixed<IntBits, FracBits>>
+	{
+		static constexpr bool IS_NUMERIC = true;
+		static constexpr bool IS_FLOATING_POINT = false;
+	};
+
+	typedef Fixed<16, 16> Fixed16_16;
+
+	// integer kernels of the fixed point Math:: functions, angles and values in [-1, 1] on 30 fractional bits.
+	namespace FixedPoint
+	{
+		constexpr std::int64_t Q30_ONE = std::int64_t(1) << 30;
+		constexpr std::int64_t Q30_PI = 3373259426;
+		constexpr std::int64_t Q30_HALF_PI = 1686629713;
+
+		[[nodiscard]] constexpr std::int64_t mul30(std::int64_t lhs, std::int64_t rhs)
+		{
+			return (lhs * rhs + (Q30_ONE >> 1)) >> 30;
+		}
+
+		// nearest integer to the square root.
+		[[nodiscard]] constexpr std::uint64_t sqrt(std::uint64_t value)
+		{
+			std::uint64_t result = 0;
+			if (std::is_constant_evaluated())
+			{
+				std::uint64_t bit = std::uint64_t(1) << 62;
+				while (bit > value)
+				{
+					bit >>= 2;
+				}
+				while (bit != 0)
+				{
+					if (value >= result + bit)
+					{
+						value -= result + bit;
+						result = (result >> 1) + bit;
+					}
+					else
+					{
+						result >>= 1;
+					}
+					bit >>= 2;
+				}
+				// value is now the remainder, (result + 0.5)^2 = result^2 + result + 0.25
+				return value > result ? result + 1 : result;
+			}
+
+			// the hardware estimate is off by a step at most, the integer corrections make it exact everywhere.
+			result = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(value)));
+			while (result * result > value)
+			{
+				--result;
+			}
+			while ((result + 1) * (result + 1) <= value)
+			{
+				++result;
+			}
+			return value - result * result > result ? result + 1 : result;
+		}
+
+		// sin and cos of u quarter turns, u in [0, 0.5]. taylor series, below 2e-10 off.
+		[[nodiscard]] constexpr std::int64_t sinQuarter(std::int64_t u)
+		{
+			constexpr std::int64_t coefficients[] = { 1686629713, -693598668, 85569306, -5026995, 172272, -3864 };
+			const std::int64_t u2 = mul30(u, u);
+			std::int64_t result = coefficients[5];
+			for (int i = 4; i >= 0; --i)
+			{
+				result = coefficients[i] + mul30(result, u2);
+			}
+			return mul30(result, u);
+		}
+
+		[[nodiscard]] constexpr std::int64_t cosQuarter(std::int64_t u)
+		{
+			constexpr std::int64_t coefficients[] = { 1073741824, -1324675879, 272375560, -22401992, 987048, -27060 };
+			const std::int64_t u2 = mul30(u, u);
+			std::int64_t result = coefficients[5];
+			for (int i = 4; i >= 0; --i)
+			{
+				result = coefficients[i] + mul30(result, u2);
+			}
+			return result;
+		}
+
+		// of raw / 2^fracBits radians.
+		constexpr void sincos(std::int32_t raw, int fracBits, std::int64_t& outSin, std::int64_t& outCos)
+		{
+			// quarter turns on fracBits + 31 fractional bits, 2 / pi on 62 bits split in two.
+			constexpr std::int64_t twoOverPiHigh = 1367130551;
+			constexpr std::int64_t twoOverPiLow = 328271178;
+			const std::int64_t turns = raw * twoOverPiHigh + ((raw * twoOverPiLow) >> 31);
+			const std::int64_t quarters = turns >> (fracBits + 1);
+			const std::int64_t u = quarters & (Q30_ONE - 1);
+
+			std::int64_t s, c;
+			if (u <= Q30_ONE / 2)
+			{
+				s = sinQuarter(u);
+				c = cosQuarter(u);
+			}
+			else
+			{
+				s = cosQuarter(Q30_ONE - u);
+				c = sinQuarter(Q30_ONE - u);
+			}
+			switch ((quarters >> 30) & 3)
+			{
+			case 0: outSin = s;		outCos = c;		break;
+			case 1: outSin = c;		outCos = -s;	break;
+			case 2: outSin = -s;	outCos = -c;	break;
+			default: outSin = -c;	outCos = s;		break;
+			}
+		}
+
+		// atan of z in [0, 1], in [0, pi / 4]. reduced around the nearest k / 8 and a 4 terms series, below 1e-9 off.
+		[[nodiscard]] constexpr std::int64_t atanUnit(std::int64_t z)
+		{
+			constexpr std::int64_t atanEighths[] = { 0, 133525159, 263043837, 385227074, 497837829, 599791448, 690954054, 771837835, 843314857 };
+			// atan(z) = atan(k / 8) + atan(w), w = (z - k / 8) / (1 + z k / 8) in [-1 / 16, 1 / 16]
+			const std::int64_t k = (z + (Q30_ONE >> 4)) >> 27;
+			const std::int64_t t = k << 27;
+			const std::int64_t w = (z - t) * Q30_ONE / (Q30_ONE + mul30(z, t));
+			const std::int64_t w2 = mul30(w, w);
+			std::int64_t result = -153391689;
+			result = 214748365 + mul30(result, w2);
+			result = -357913941 + mul30(result, w2);
+			result = Q30_ONE + mul30(result, w2);
+			return atanEighths[k] + mul30(result, w);
+		}
+
+		// angle of (x, y) in [-pi, pi], both on the same scale.
+		[[nodiscard]] constexpr std::int64_t atan2(std::int64_t y, std::int64_t x)
+		{
+			if (x == 0 && y == 0)
+			{
+				return 0;
+			}
+			const std::int64_t absY = y < 0 ? -y : y;
+			const std::int64_t absX = x < 0 ? -x : x;
+			const bool steep = absY > absX;
+			std::int64_t angle = steep ? atanUnit(absX * Q30_ONE / absY) : atanUnit(absY * Q30_ONE / absX);
+			if (steep)
+			{
+				angle = Q30_HALF_PI - angle;
+			}
+			if (x < 0)
+			{
+				angle = Q30_PI - angle;
+			}
+			return y < 0 ? -angle : angle;
+		}
+
+		// 30 fractional bits to fracBits, rounded to nearest.
+		[[nodiscard]] constexpr std::int32_t toRaw(std::int64_t q30, int fracBits)
+		{
+			if (fracBits == 30)
+			{
+				return static_cast<std::int32_t>(q30);
+			}
+			return static_cast<std::int32_t>((q30 + (std::int64_t(1) << (29 - fracBits))) >> (30 - fracBits));
+		}
+
+		// raw clamped to [-1, 1], and sqrt(1 - x^2), on 30 fractional bits.
+		constexpr void unitAndComplement(std::int32_t raw, int fracBits, std::int64_t& outX, std::int64_t& outComplement)
+		{
+			const std::int64_t one = std::int64_t(1) << fracBits;
+			const std::int64_t clamped = raw < -one ? -one : raw > one ? one : raw;
+			outX = clamped << (30 - fracBits);
+			outComplement = static_cast<std::int64_t>(sqrt(static_cast<std::uint64_t>(Q30_ONE - mul30(outX, outX)) << 30));
+		}
+	}
+
+	// deterministic overloads of the Maths.h functions, exact to about one step of the fixed point type.
+	// declared before the generic ones are called, Maths.h includes this file.
+	namespace Math
+	{
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> sqrt(Fixed<IntBits, FracBits> v)
+		{
+			MANIMATHS_ASSERT(v.raw >= 0);
+			if (v.raw <= 0)
+			{
+				return {};
+			}
+			return Fixed<IntBits, FracBits>::fromRaw(static_cast<std::int32_t>(FixedPoint::sqrt(static_cast<std::uint64_t>(v.raw) << FracBits)));
+		}
+
+		template<int IntBits, int FracBits>
+		constexpr void sincos(Fixed<IntBits, FracBits> v, Fixed<IntBits, FracBits>& outSin, Fixed<IntBits, FracBits>& outCos)
+		{
+			std::int64_t s, c;
+			FixedPoint::sincos(v.raw, FracBits, s, c);
+			outSin = Fixed<IntBits, FracBits>::fromRaw(FixedPoint::toRaw(s, FracBits));
+			outCos = Fixed<IntBits, FracBits>::fromRaw(FixedPoint::toRaw(c, FracBits));
+		}
+
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> sin(Fixed<IntBits, FracBits> v)
+		{
+			Fixed<IntBits, FracBits> s, c;
+			sincos(v, s, c);
+			return s;
+		}
+
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> cos(Fixed<IntBits, FracBits> v)
+		{
+			Fixed<IntBits, FracBits> s, c;
+			sincos(v, s, c);
+			return c;
+		}
+
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> tan(Fixed<IntBits, FracBits> v)
+		{
+			std::int64_t s, c;
+			FixedPoint::sincos(v.raw, FracBits, s, c);
+			MANIMATHS_ASSERT(c != 0);
+			return Fixed<IntBits, FracBits>::fromRaw(static_cast<std::int32_t>(s * Fixed<IntBits, FracBits>::ONE / c));
+		}
+
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> atan(Fixed<IntBits, FracBits> v)
+		{
+			return Fixed<IntBits, FracBits>::fromRaw(FixedPoint::toRaw(FixedPoint::atan2(v.raw, Fixed<IntBits, FracBits>::ONE), FracBits));
+		}
+
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> atan2(Fixed<IntBits, FracBits> y, Fixed<IntBits, FracBits> x)
+		{
+			return Fixed<IntBits, FracBits>::fromRaw(FixedPoint::toRaw(FixedPoint::atan2(y.raw, x.raw), FracBits));
+		}
+
+		// v is clamped to [-1, 1].
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> asin(Fixed<IntBits, FracBits> v)
+		{
+			std::int64_t x, complement;
+			FixedPoint::unitAndComplement(v.raw, FracBits, x, complement);
+			return Fixed<IntBits, FracBits>::fromRaw(FixedPoint::toRaw(FixedPoint::atan2(x, complement), FracBits));
+		}
+
+		// v is clamped to [-1, 1].
+		template<int IntBits, int FracBits>
+		[[nodiscard]] constexpr Fixed<IntBits, FracBits> acos(Fixed<IntBits, FracBits> v)
+		{
+			std::int64_t x, complement;
+			FixedPoint::unitAndComplement(v.raw, FracBits, x, complement);
+			return Fixed<IntBits, FracBits>::fromRaw(FixedPoint::toRaw(FixedPoint::atan2(complement, x), FracBits));
+		}
+	}
+}
+
+namespace std
+{
+	template<int IntBits, int FracBits>
+	class numeric_limits<Mani::Fixed<IntBits, FracBits>>
+	{
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = true;
+		static constexpr bool has_infinity = false;
+		static constexpr bool has_quiet_NaN = false;
+		static constexpr bool has_signaling_NaN = false;
+		static constexpr bool is_iec559 = false;
+		static constexpr bool is_bounded = true;
+		static constexpr bool is_modulo = true;
+		static constexpr float_round_style round_style = round_to_nearest;
+		static constexpr int radix = 2;
+		static constexpr int digits = 31;
+
+		// the smallest step, like the smallest positive float.
+		static constexpr Mani::Fixed<IntBits, FracBits> min() noexcept		{ return Mani::Fixed<IntBits, FracBits>::fromRaw(1); }
+		static constexpr Mani::Fixed<IntBits, FracBits> max() noexcept		{ return Mani::Fixed<IntBits, FracBits>::fromRaw(std::numeric_limits<std::int32_t>::max()); }
+		static constexpr Mani::Fixed<IntBits, FracBits> lowest() noexcept	{ return Mani::Fixed<IntBits, FracBits>::fromRaw(std::numeric_limits<std::int32_t>::min()); }
+		static constexpr Mani::Fixed<IntBits, FracBits> epsilon() noexcept	{ return Mani::Fixed<IntBits, FracBits>::fromRaw(1); }
+	};
+}
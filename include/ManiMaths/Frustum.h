@@ -0,0 +1,209 @@
+#pragma once
+
+#include "_Vec.h"
+#include "_Mat.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Simd.h"
+#include "Vec3.h"
+#include "Vec4.h"
+#include "Mat4.h"
+#include "Vec3Stream.h"
+#include "AABB.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace Mani
+{
+	// 6 planes (normal, distance) with normalized normals pointing inside: n.p + d >= 0 for points inside.
+	// Extracted from a view projection matrix following the OpenGL clip space convention of Mat4::perspective
+	// and Mat4::orthographic (-w <= x, y, z <= w).
+	// Batched tests write one visibility bit per volume, 64 volumes per uint64_t word.
+	template<IsNumeric T>
+	struct Frustum
+	{
+		enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+		Vec<T, 4> planes[Plane::Count];
+
+		// https://www.gamedevs.org/uploads/fast-extraction-viewing-frustum-planes-from-world-view-projection-matrix.pdf
+		[[nodiscard]] static Frustum<T> fromMatrix(const Mat<T, 4, 4>& viewProjection)
+		{
+			const Mat<T, 4, 4>& m = viewProjection;
+			// matrix lines are columns, rows are gathered across them.
+			const Vec<T, 4> row0 = { m._00, m._10, m._20, m._30 };
+			const Vec<T, 4> row1 = { m._01, m._11, m._21, m._31 };
+			const Vec<T, 4> row2 = { m._02, m._12, m._22, m._32 };
+			const Vec<T, 4> row3 = { m._03, m._13, m._23, m._33 };
+
+			Frustum<T> frustum;
+			frustum.planes[Left]	= normalizePlane(row3 + row0);
+			frustum.planes[Right]	= normalizePlane(row3 - row0);
+			frustum.planes[Bottom]	= normalizePlane(row3 + row1);
+			frustum.planes[Top]		= normalizePlane(row3 - row1);
+			frustum.planes[Near]	= normalizePlane(row3 + row2);
+			frustum.planes[Far]		= normalizePlane(row3 - row2);
+			return frustum;
+		}
+
+		[[nodiscard]] T distance(Plane plane, const Vec<T, 3>& p) const
+		{
+			const Vec<T, 4>& n = planes[plane];
+			return mulAdd(n.z, p.z, mulAdd(n.y, p.y, mulAdd(n.x, p.x, n.w)));
+		}
+
+		[[nodiscard]] bool containsPoint(const Vec<T, 3>& p) const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			for (int plane = 0; plane < Plane::Count; ++plane)
+			{
+				if (distance(static_cast<Plane>(plane), p) < _0)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// conservative: spheres close to the frustum corners may pass while being outside.
+		[[nodiscard]] bool intersectsSphere(const Vec<T, 3>& center, T radius) const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			for (int plane = 0; plane < Plane::Count; ++plane)
+			{
+				if (distance(static_cast<Plane>(plane), center) + radius < _0)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// conservative, same as intersectsSphere.
+		[[nodiscard]] bool intersectsAABB(const Vec<T, 3>& min, const Vec<T, 3>& max) const
+		{
+			constexpr T _0_5 = static_cast<T>(0.5);
+			return intersectsCenterExtent((min + max) * _0_5, (max - min) * _0_5);
+		}
+
+		// conservative, same as intersectsSphere. extent is the half size of the box.
+		[[nodiscard]] bool intersectsCenterExtent(const Vec<T, 3>& center, const Vec<T, 3>& extent) const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			for (int plane = 0; plane < Plane::Count; ++plane)
+			{
+				const Vec<T, 4>& n = planes[plane];
+				const T projectedExtent = mulAdd(extent.z, Math::abs(n.z), mulAdd(extent.y, Math::abs(n.y), extent.x * Math::abs(n.x)));
+				if (distance(static_cast<Plane>(plane), center) + projectedExtent < _0)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		[[nodiscard]] bool intersectsAABB(const AABB<T>& box) const
+		{
+			return !box.isEmpty() && intersectsAABB(box.min, box.max);
+		}
+
+		// number of uint64_t words needed to hold count visibility bits.
+		[[nodiscard]] static constexpr std::size_t maskSize(std::size_t count)
+		{
+			return (count + 63) / 64;
+		}
+
+		// the batched tests give the same bits as the per volume ones above, the SIMD lanes round the same way.
+		// bit i of mask is set when sphere i is visible, returns the number of visible spheres.
+		std::size_t cullSpheres(const Vec3Stream<T>& centers, std::type_identity_t<std::span<const T>> radii, std::span<uint64_t> mask) const
+		{
+			MANIMATHS_ASSERT(radii.size() >= centers.size());
+			return cull<FrustumVolume::Sphere>(centers.x.data(), centers.y.data(), centers.z.data(), radii.data(), nullptr, nullptr, centers.size(), mask);
+		}
+
+		// bit i of mask is set when box i is visible, returns the number of visible boxes.
+		std::size_t cullAABBs(const Vec3Stream<T>& mins, const Vec3Stream<T>& maxs, std::span<uint64_t> mask) const
+		{
+			MANIMATHS_ASSERT(mins.size() == maxs.size());
+			return cull<FrustumVolume::MinMax>(mins.x.data(), mins.y.data(), mins.z.data(), maxs.x.data(), maxs.y.data(), maxs.z.data(), mins.size(), mask);
+		}
+
+		// same as cullAABBs for boxes stored as centers and half extents.
+		std::size_t cullCenterExtents(const Vec3Stream<T>& centers, const Vec3Stream<T>& extents, std::span<uint64_t> mask) const
+		{
+			MANIMATHS_ASSERT(centers.size() == extents.size());
+			return cull<FrustumVolume::CenterExtents>(centers.x.data(), centers.y.data(), centers.z.data(), extents.x.data(), extents.y.data(), extents.z.data(), centers.size(), mask);
+		}
+
+	private:
+		// a * b + c, fused when the SIMD lanes are so the scalar tests round like them.
+		[[nodiscard]] static T mulAdd(T a, T b, T c)
+		{
+#if defined(MANIMATHS_SIMD_FMA)
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				return std::fma(a, b, c);
+			}
+#endif
+			return a * b + c;
+		}
+
+		[[nodiscard]] static Vec<T, 4> normalizePlane(const Vec<T, 4>& plane)
+		{
+			const T length = Math::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			MANIMATHS_ASSERT(length > static_cast<T>(0));
+			return plane / length;
+		}
+
+		template<FrustumVolume Volume>
+		std::size_t cull(const T* x, const T* y, const T* z, const T* r, const T* s, const T* t, std::size_t n, std::span<uint64_t> mask) const
+		{
+			MANIMATHS_ASSERT(mask.size() >= maskSize(n));
+			std::fill(mask.begin(), mask.begin() + maskSize(n), uint64_t(0));
+
+			std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				const float* pPlanes = &planes[0].x;
+#if defined(MANIMATHS_SIMD_AVX)
+				i = Simd::frustumLanes<Simd::Lanes8, Volume>(pPlanes, x, y, z, r, s, t, mask.data(), i, n);
+#endif
+				i = Simd::frustumLanes<Simd::Lanes4, Volume>(pPlanes, x, y, z, r, s, t, mask.data(), i, n);
+			}
+#endif
+			for (; i < n; ++i)
+			{
+				bool visible = true;
+				if constexpr (Volume == FrustumVolume::Sphere)
+				{
+					visible = intersectsSphere({ x[i], y[i], z[i] }, r[i]);
+				}
+				else if constexpr (Volume == FrustumVolume::CenterExtents)
+				{
+					visible = intersectsCenterExtent({ x[i], y[i], z[i] }, { r[i], s[i], t[i] });
+				}
+				else
+				{
+					visible = intersectsAABB({ x[i], y[i], z[i] }, { r[i], s[i], t[i] });
+				}
+				mask[i / 64] |= static_cast<uint64_t>(visible) << (i % 64);
+			}
+
+			std::size_t visibleCount = 0;
+			for (std::size_t word = 0; word < maskSize(n); ++word)
+			{
+				visibleCount += static_cast<std::size_t>(std::popcount(mask[word]));
+			}
+			return visibleCount;
+		}
+	};
+
+	typedef Frustum<float>	Frustumf;
+	typedef Frustum<double>	Frustumd;
+}
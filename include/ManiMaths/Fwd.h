@@ -1,12 +1,36 @@
 #pragma once
 
 #include "ManiMaths/Maths.h"
+#include "ManiMaths/MathsFast.h"
 
 #include "Mat3.h"
 #include "Mat4.h"
+#include "MatN.h"
+#include "Mat4Batch.h"
+#include "Affine3.h"
+#include "AABB.h"
 
 #include "Quat.h"
 
 #include "Vec2.h"
 #include "Vec3.h"
-#include "Vec4.h"
\ No newline at end of file
+#include "Vec4.h"
+#include "VecN.h"
+
+#include "Vec3Stream.h"
+#include "QuatStream.h"
+#include "TransformHierarchy.h"
+#include "Frustum.h"
+#include "Ray.h"
+#include "BVH.h"
+#include "SpatialHash.h"
+#include "KdTree.h"
+#include "Lazy.h"
+#include "ThreadPool.h"
+#include "Batch.h"
+#include "MappedFile.h"
+#include "Binary.h"
+#include "Track.h"
+#include "Packed.h"
+#include "Half.h"
+#include "Fixed.h"
\ No newline at end of file
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Simd.h"
+#include "Vec2.h"
+#include "Vec3.h"
+#include "Vec4.h"
+#include "Quat.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace Mani
+{
+	// IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits, about 3 decimal digits up to 65504.
+	// computed in float: halves give a half rounded to nearest even, mixed with other arithmetic types they
+	// promote like std::float16_t would. doubles are rounded through float.
+	struct Half
+	{
+		std::uint16_t bits = 0;
+
+		constexpr Half() = default;
+
+		template<typename T>
+		requires std::is_arithmetic_v<T>
+		constexpr Half(T value)
+			: bits(fromFloat(static_cast<float>(value)))
+		{
+		}
+
+		[[nodiscard]] static constexpr Half fromBits(std::uint16_t bits)
+		{
+			Half half;
+			half.bits = bits;
+			return half;
+		}
+
+		// overflows to infinity, NaNs become 0x7E00 with their sign.
+		[[nodiscard]] static constexpr std::uint16_t fromFloat(float value)
+		{
+			const std::uint32_t sign = std::bit_cast<std::uint32_t>(value) & 0x80000000u;
+			const std::uint32_t bits = std::bit_cast<std::uint32_t>(value) ^ sign;
+			std::uint32_t result;
+			if (bits >= (127u + 16u) << 23)
+			{
+				result = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+			}
+			else if (bits < (127u - 14u) << 23)
+			{
+				// subnormal: the float addition aligns the mantissa on the bottom bits and rounds it.
+				constexpr std::uint32_t magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+				result = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) + std::bit_cast<float>(magic)) - magic;
+			}
+			else
+			{
+				// rebias the exponent and round the 13 dropped bits, ties to even.
+				result = (bits + ((15u - 127u) << 23) + 0xFFFu + ((bits >> 13) & 1u)) >> 13;
+			}
+			return static_cast<std::uint16_t>(result | (sign >> 16));
+		}
+
+		// exact.
+		[[nodiscard]] static constexpr float toFloat(std::uint16_t half)
+		{
+			constexpr std::uint32_t exponentMask = 0x7C00u << 13;
+			std::uint32_t bits = (half & 0x7FFFu) << 13;
+			const std::uint32_t exponent = bits & exponentMask;
+			bits += (127u - 15u) << 23;
+			if (exponent == exponentMask)
+			{
+				// infinity or NaN
+				bits += (128u - 16u) << 23;
+			}
+			else if (exponent == 0)
+			{
+				// subnormal, renormalized by the float subtraction.
+				bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits + (1u << 23)) - std::bit_cast<float>(113u << 23));
+			}
+			return std::bit_cast<float>(bits | (static_cast<std::uint32_t>(half & 0x8000u) << 16));
+		}
+
+		constexpr operator float() const
+		{
+			return toFloat(bits);
+		}
+
+		[[nodiscard]] constexpr Half operator-() const
+		{
+			return fromBits(static_cast<std::uint16_t>(bits ^ 0x8000u));
+		}
+
+		constexpr Half& operator+=(float rhs) { return *this = static_cast<float>(*this) + rhs; }
+		constexpr Half& operator-=(float rhs) { return *this = static_cast<float>(*this) - rhs; }
+		constexpr Half& operator*=(float rhs) { return *this = static_cast<float>(*this) * rhs; }
+		constexpr Half& operator/=(float rhs) { return *this = static_cast<float>(*this) / rhs; }
+	};
+
+	// bfloat16: the top half of a float, 1 sign, 8 exponent and 7 mantissa bits. the float range with about
+	// 2 decimal digits, computed like Half.
+	struct BFloat16
+	{
+		std::uint16_t bits = 0;
+
+		constexpr BFloat16() = default;
+
+		template<typename T>
+		requires std::is_arithmetic_v<T>
+		constexpr BFloat16(T value)
+			: bits(fromFloat(static_cast<float>(value)))
+		{
+		}
+
+		[[nodiscard]] static constexpr BFloat16 fromBits(std::uint16_t bits)
+		{
+			BFloat16 value;
+			value.bits = bits;
+			return value;
+		}
+
+		// rounded to nearest even, NaNs are kept quiet.
+		[[nodiscard]] static constexpr std::uint16_t fromFloat(float value)
+		{
+			const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+			if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+			{
+				return static_cast<std::uint16_t>((bits | 0x400000u) >> 16);
+			}
+			return static_cast<std::uint16_t>((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+		}
+
+		// exact.
+		[[nodiscard]] static constexpr float toFloat(std::uint16_t value)
+		{
+			return std::bit_cast<float>(static_cast<std::uint32_t>(value) << 16);
+		}
+
+		constexpr operator float() const
+		{
+			return toFloat(bits);
+		}
+
+		[[nodiscard]] constexpr BFloat16 operator-() const
+		{
+			return fromBits(static_cast<std::uint16_t>(bits ^ 0x8000u));
+		}
+
+		constexpr BFloat16& operator+=(float rhs) { return *this = static_cast<float>(*this) + rhs; }
+		constexpr BFloat16& operator-=(float rhs) { return *this = static_cast<float>(*this) - rhs; }
+		constexpr BFloat16& operator*=(float rhs) { return *this = static_cast<float>(*this) * rhs; }
+		constexpr BFloat16& operator/=(float rhs) { return *this = static_cast<float>(*this) / rhs; }
+	};
+
+	static_assert(sizeof(Half) == 2 && sizeof(BFloat16) == 2, "16 bits floats are stored as their bits");
+
+	template<typename T>
+	concept IsFloat16 = std::is_same_v<T, Half> || std::is_same_v<T, BFloat16>;
+
+	template<IsFloat16 T> [[nodiscard]] constexpr T operator+(T lhs, T rhs) { return static_cast<float>(lhs) + static_cast<float>(rhs); }
+	template<IsFloat16 T> [[nodiscard]] constexpr T operator-(T lhs, T rhs) { return static_cast<float>(lhs) - static_cast<float>(rhs); }
+	template<IsFloat16 T> [[nodiscard]] constexpr T operator*(T lhs, T rhs) { return static_cast<float>(lhs) * static_cast<float>(rhs); }
+	template<IsFloat16 T> [[nodiscard]] constexpr T operator/(T lhs, T rhs) { return static_cast<float>(lhs) / static_cast<float>(rhs); }
+
+	// otherwise the built in float operators and the ones above would be ambiguous.
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator+(T lhs, T2 rhs) { return static_cast<float>(lhs) + rhs; }
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator-(T lhs, T2 rhs) { return static_cast<float>(lhs) - rhs; }
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator*(T lhs, T2 rhs) { return static_cast<float>(lhs) * rhs; }
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator/(T lhs, T2 rhs) { return static_cast<float>(lhs) / rhs; }
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator+(T2 lhs, T rhs) { return lhs + static_cast<float>(rhs); }
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator-(T2 lhs, T rhs) { return lhs - static_cast<float>(rhs); }
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator*(T2 lhs, T rhs) { return lhs * static_cast<float>(rhs); }
+	template<IsFloat16 T, typename T2> requires std::is_arithmetic_v<T2> [[nodiscard]] constexpr auto operator/(T2 lhs, T rhs) { return lhs / static_cast<float>(rhs); }
+
+	template<>
+	struct NumericTraits<Half>
+	{
+		static constexpr bool IS_NUMERIC = true;
+		static constexpr bool IS_FLOATING_POINT = true;
+	};
+
+	template<>
+	struct NumericTraits<BFloat16>
+	{
+		static constexpr bool IS_NUMERIC = true;
+		static constexpr bool IS_FLOATING_POINT = true;
+	};
+
+	typedef Vec<Half,		2> Vec2h;
+	typedef Vec<Half,		3> Vec3h;
+	typedef Vec<Half,		4> Vec4h;
+	typedef Quat<Half>		   Quath;
+	typedef Vec<BFloat16,	2> Vec2bf;
+	typedef Vec<BFloat16,	3> Vec3bf;
+	typedef Vec<BFloat16,	4> Vec4bf;
+	typedef Quat<BFloat16>	   Quatbf;
+
+	// floats to 16 bits floats or back.
+	template<typename TIn, typename TOut>
+	void convertBatch(std::span<const TIn> in, std::span<TOut> out)
+	{
+		MANIMATHS_ASSERT(out.size() >= in.size());
+		std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_SSE2)
+		if (!in.empty())
+		{
+			if constexpr (std::is_same_v<TOut, Half>)
+			{
+				i = Simd::floatToHalfLanes(in.data(), &out.data()->bits, in.size());
+			}
+			else if constexpr (std::is_same_v<TOut, BFloat16>)
+			{
+				i = Simd::floatToBFloat16Lanes(in.data(), &out.data()->bits, in.size());
+			}
+			else if constexpr (std::is_same_v<TIn, Half>)
+			{
+				i = Simd::halfToFloatLanes(&in.data()->bits, out.data(), in.size());
+			}
+			else
+			{
+				i = Simd::bfloat16ToFloatLanes(&in.data()->bits, out.data(), in.size());
+			}
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = static_cast<TOut>(in[i]);
+		}
+	}
+
+	// vectors and quaternions as the array of their components.
+	template<typename TIn, typename TOut, std::size_t Components>
+	void convertBatch(std::span<const TIn> in, std::span<TOut> out)
+	{
+		using InScalar = decltype(in.data()->x);
+		using OutScalar = decltype(out.data()->x);
+		static_assert(sizeof(TIn) == sizeof(InScalar) * Components && sizeof(TOut) == sizeof(OutScalar) * Components);
+		MANIMATHS_ASSERT(out.size() >= in.size());
+		convertBatch(std::span<const InScalar>(reinterpret_cast<const InScalar*>(in.data()), in.size() * Components),
+			std::span<OutScalar>(reinterpret_cast<OutScalar*>(out.data()), in.size() * Components));
+	}
+
+	// batches, F16C (half) or SSE2 bit tricks under MANIMATHS_SIMD, the same bits as the scalar conversions.
+	// out may not alias in.
+	inline void convert(std::span<const float> in, std::span<Half> out)				{ convertBatch(in, out); }
+	inline void convert(std::span<const Half> in, std::span<float> out)				{ convertBatch(in, out); }
+	inline void convert(std::span<const float> in, std::span<BFloat16> out)			{ convertBatch(in, out); }
+	inline void convert(std::span<const BFloat16> in, std::span<float> out)			{ convertBatch(in, out); }
+	inline void convert(std::span<const Vec3f> in, std::span<Vec3h> out)			{ convertBatch<Vec3f, Vec3h, 3>(in, out); }
+	inline void convert(std::span<const Vec3h> in, std::span<Vec3f> out)			{ convertBatch<Vec3h, Vec3f, 3>(in, out); }
+	inline void convert(std::span<const Vec3f> in, std::span<Vec3bf> out)			{ convertBatch<Vec3f, Vec3bf, 3>(in, out); }
+	inline void convert(std::span<const Vec3bf> in, std::span<Vec3f> out)			{ convertBatch<Vec3bf, Vec3f, 3>(in, out); }
+	inline void convert(std::span<const Quatf> in, std::span<Quath> out)		{ convertBatch<Quatf, Quath, 4>(in, out); }
+	inline void convert(std::span<const Quath> in, std::span<Quatf> out)		{ convertBatch<Quath, Quatf, 4>(in, out); }
+	inline void convert(std::span<const Quatf> in, std::span<Quatbf> out)		{ convertBatch<Quatf, Quatbf, 4>(in, out); }
+	inline void convert(std::span<const Quatbf> in, std::span<Quatf> out)		{ convertBatch<Quatbf, Quatf, 4>(in, out); }
+}
+
+namespace std
+{
+	template<>
+	class numeric_limits<Mani::Half>
+	{
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = false;
+		static constexpr bool has_infinity = true;
+		static constexpr bool has_quiet_NaN = true;
+		static constexpr bool has_signaling_NaN = true;
+		static constexpr bool is_iec559 = true;
+		static constexpr bool is_bounded = true;
+		static constexpr bool is_modulo = false;
+		static constexpr float_round_style round_style = round_to_nearest;
+		static constexpr int radix = 2;
+		static constexpr int digits = 11;
+		static constexpr int digits10 = 3;
+		static constexpr int max_digits10 = 5;
+		static constexpr int min_exponent = -13;
+		static constexpr int min_exponent10 = -4;
+		static constexpr int max_exponent = 16;
+		static constexpr int max_exponent10 = 4;
+
+		static constexpr Mani::Half min() noexcept				{ return Mani::Half::fromBits(0x0400); }
+		static constexpr Mani::Half max() noexcept				{ return Mani::Half::fromBits(0x7BFF); }
+		static constexpr Mani::Half lowest() noexcept			{ return Mani::Half::fromBits(0xFBFF); }
+		static constexpr Mani::Half epsilon() noexcept			{ return Mani::Half::fromBits(0x1400); }
+		static constexpr Mani::Half round_error() noexcept		{ return Mani::Half::fromBits(0x3800); }
+		static constexpr Mani::Half infinity() noexcept			{ return Mani::Half::fromBits(0x7C00); }
+		static constexpr Mani::Half quiet_NaN() noexcept		{ return Mani::Half::fromBits(0x7E00); }
+		static constexpr Mani::Half signaling_NaN() noexcept	{ return Mani::Half::fromBits(0x7D00); }
+		static constexpr Mani::Half denorm_min() noexcept		{ return Mani::Half::fromBits(0x0001); }
+	};
+
+	template<>
+	class numeric_limits<Mani::BFloat16>
+	{
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = false;
+		static constexpr bool has_infinity = true;
+		static constexpr bool has_quiet_NaN = true;
+		static constexpr bool has_signaling_NaN = true;
+		static constexpr bool is_iec559 = false;
+		static constexpr bool is_bounded = true;
+		static constexpr bool is_modulo = false;
+		static constexpr float_round_style round_style = round_to_nearest;
+		static constexpr int radix = 2;
+		static constexpr int digits = 8;
+		static constexpr int digits10 = 2;
+		static constexpr int max_digits10 = 4;
+		static constexpr int min_exponent = -125;
+		static constexpr int min_exponent10 = -37;
+		static constexpr int max_exponent = 128;
+		static constexpr int max_exponent10 = 38;
+
+		static constexpr Mani::BFloat16 min() noexcept				{ return Mani::BFloat16::fromBits(0x0080); }
+		static constexpr Mani::BFloat16 max() noexcept				{ return Mani::BFloat16::fromBits(0x7F7F); }
+		static constexpr Mani::BFloat16 lowest() noexcept			{ return Mani::BFloat16::fromBits(0xFF7F); }
+		static constexpr Mani::BFloat16 epsilon() noexcept			{ return Mani::BFloat16::fromBits(0x3C00); }
+		static constexpr Mani::BFloat16 round_error() noexcept		{ return Mani::BFloat16::fromBits(0x3F00); }
+		static constexpr Mani::BFloat16 infinity() noexcept			{ return Mani::BFloat16::fromBits(0x7F80); }
+		static constexpr Mani::BFloat16 quiet_NaN() noexcept		{ return Mani::BFloat16::fromBits(0x7FC0); }
+		static constexpr Mani::BFloat16 signaling_NaN() noexcept	{ return Mani::BFloat16::fromBits(0x7FA0); }
+		static constexpr Mani::BFloat16 denorm_min() noexcept		{ return Mani::BFloat16::fromBits(0x0001); }
+	};
+
+#if defined(__cpp_lib_format)
+	// formatted as the float they hold.
+	template<>
+	struct formatter<Mani::Half> : formatter<float>
+	{
+		auto format(Mani::Half value, format_context& context) const
+		{
+			return formatter<float>::format(static_cast<float>(value), context);
+		}
+	};
+
+	template<>
+	struct formatter<Mani::BFloat16> : formatter<float>
+	{
+		auto format(Mani::BFloat16 value, format_context& context) const
+		{
+			return formatter<float>::format(static_cast<float>(value), context);
+		}
+	};
+#endif
+}
@@ -0,0 +1,339 @@
+#pragma once
+
+#include "_Size.h"
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Vec2.h"
+#include "Vec3.h"
+#include "Vec4.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Mani
+{
+	// Static k-d tree over 2, 3 or 4 dimensional points, stored implicitly: the points are reordered so that
+	// the node of a range [begin, end) is its middle point, its children the ranges on either side of it.
+	// Ranges of up to LEAF_SIZE points are leaves scanned linearly. Only the split axis of every node is
+	// stored next to the points, there are no child pointers or node bounds.
+	template<IsNumeric T, Size N>
+	struct KdTree
+	{
+		static_assert(N >= 2 && N <= 4, "k-d trees are built over Vec2, Vec3 or Vec4 points");
+
+		using Index = uint32_t;
+		static constexpr Index INVALID_INDEX = std::numeric_limits<Index>::max();
+		static constexpr Index LEAF_SIZE = 8;
+		static constexpr std::size_t MAX_DEPTH = 64;
+
+		// median splits along the widest axis of every range, subtrees are built as tasks of the global ThreadPool
+		// until threadCount of them run.
+		[[nodiscard]] static KdTree<T, N> build(std::span<const Vec<T, N>> points, std::size_t threadCount = 1)
+		{
+			MANIMATHS_ASSERT(points.size() < INVALID_INDEX);
+
+			KdTree<T, N> tree;
+			std::vector<Entry> entries(points.size());
+			for (std::size_t i = 0; i < points.size(); ++i)
+			{
+				entries[i] = { points[i], static_cast<Index>(i) };
+			}
+			tree.m_axes.resize(points.size());
+
+			const Builder builder = { entries, tree.m_axes };
+			builder.build(0, static_cast<Index>(points.size()), Math::maxT<std::size_t>(threadCount, 1));
+
+			tree.m_points.resize(points.size());
+			tree.m_indices.resize(points.size());
+			for (std::size_t i = 0; i < entries.size(); ++i)
+			{
+				tree.m_points[i] = entries[i].point;
+				tree.m_indices[i] = entries[i].index;
+			}
+			return tree;
+		}
+
+		[[nodiscard]] std::size_t size() const
+		{
+			return m_points.size();
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return m_points.empty();
+		}
+
+		// points in tree order, getIndices()[i] is the input index of getPoints()[i].
+		[[nodiscard]] std::span<const Vec<T, N>> getPoints() const
+		{
+			return m_points;
+		}
+
+		[[nodiscard]] std::span<const Index> getIndices() const
+		{
+			return m_indices;
+		}
+
+		// input index of the point closest to p within maxRadius, INVALID_INDEX when there is none.
+		[[nodiscard]] Index queryNearest(const Vec<T, N>& p, T maxRadius = std::numeric_limits<T>::max()) const
+		{
+			Index nearest = INVALID_INDEX;
+			T boundSquared = squaredRadius(maxRadius);
+			search(p, boundSquared, [&](Index i, T distanceSquared)
+			{
+				nearest = i;
+				boundSquared = distanceSquared;
+			});
+			return nearest;
+		}
+
+		// up to out.size() nearest points within maxRadius of p, closest first. returns how many were written.
+		std::size_t queryKNearest(const Vec<T, N>& p, std::span<Index> out, T maxRadius = std::numeric_limits<T>::max()) const
+		{
+			std::vector<std::pair<T, Index>> best;
+			return queryKNearest(p, out, maxRadius, best);
+		}
+
+		// visit(index, distanceSquared) for every point within radius of p, in no particular order.
+		template<typename TVisit>
+		void forEachInRadius(const Vec<T, N>& p, T radius, TVisit&& visit) const
+		{
+			T boundSquared = squaredRadius(radius);
+			search(p, boundSquared, visit);
+		}
+
+		// appends the indices of the points within radius of p to out, returns how many were appended.
+		std::size_t queryRadius(const Vec<T, N>& p, T radius, std::vector<Index>& out) const
+		{
+			const std::size_t initialSize = out.size();
+			forEachInRadius(p, radius, [&out](Index i, T) { out.push_back(i); });
+			return out.size() - initialSize;
+		}
+
+		// out[i] is the nearest point of queries[i], the queries are split in threadCount chunks run on the global ThreadPool.
+		void queryNearest(std::span<const Vec<T, N>> queries, std::span<Index> out, std::size_t threadCount = 1) const
+		{
+			MANIMATHS_ASSERT(out.size() >= queries.size());
+			ThreadPool::forEachChunk(queries.size(), threadCount, [&](std::size_t, std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					out[i] = queryNearest(queries[i]);
+				}
+			});
+		}
+
+		// the k nearest points of queries[i], closest first, in out[i * k, (i + 1) * k).
+		// slots past the point count are INVALID_INDEX.
+		void queryKNearest(std::span<const Vec<T, N>> queries, std::size_t k, std::span<Index> out, std::size_t threadCount = 1) const
+		{
+			MANIMATHS_ASSERT(out.size() >= queries.size() * k);
+			ThreadPool::forEachChunk(queries.size(), threadCount, [&](std::size_t, std::size_t begin, std::size_t end)
+			{
+				// one heap per chunk, reused by all its queries.
+				std::vector<std::pair<T, Index>> best;
+				best.reserve(k);
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const std::span<Index> neighbors = out.subspan(i * k, k);
+					const std::size_t count = queryKNearest(queries[i], neighbors, std::numeric_limits<T>::max(), best);
+					std::fill(neighbors.begin() + count, neighbors.end(), INVALID_INDEX);
+				}
+			});
+		}
+
+	private:
+		struct Entry
+		{
+			Vec<T, N> point;
+			Index index;
+		};
+
+		struct Builder
+		{
+			std::vector<Entry>& entries;
+			std::vector<uint8_t>& axes;
+
+			void build(Index begin, Index end, std::size_t threadCount) const
+			{
+				const Index count = end - begin;
+				if (count <= LEAF_SIZE)
+				{
+					return;
+				}
+
+				T lo[N];
+				T hi[N];
+				for (std::size_t axis = 0; axis < N; ++axis)
+				{
+					lo[axis] = hi[axis] = component(entries[begin].point, axis);
+				}
+				for (Index i = begin + 1; i < end; ++i)
+				{
+					for (std::size_t axis = 0; axis < N; ++axis)
+					{
+						const T value = component(entries[i].point, axis);
+						lo[axis] = value < lo[axis] ? value : lo[axis];
+						hi[axis] = value > hi[axis] ? value : hi[axis];
+					}
+				}
+				std::size_t splitAxis = 0;
+				for (std::size_t axis = 1; axis < N; ++axis)
+				{
+					splitAxis = hi[axis] - lo[axis] > hi[splitAxis] - lo[splitAxis] ? axis : splitAxis;
+				}
+
+				const Index middle = begin + count / 2;
+				std::nth_element(entries.begin() + begin, entries.begin() + middle, entries.begin() + end, [splitAxis](const Entry& a, const Entry& b)
+				{
+					return component(a.point, splitAxis) < component(b.point, splitAxis);
+				});
+				axes[middle] = static_cast<uint8_t>(splitAxis);
+
+				// both sides are disjoint ranges of the same arrays, large ones are built as tasks of ThreadPool::global().
+				if (threadCount > 1 && count >= PARALLEL_THRESHOLD)
+				{
+					ThreadPool::global().invoke(
+						[&]() { build(begin, middle, threadCount - threadCount / 2); },
+						[&]() { build(middle + 1, end, threadCount / 2); });
+				}
+				else
+				{
+					build(begin, middle, 1);
+					build(middle + 1, end, 1);
+				}
+			}
+		};
+
+		static constexpr Index PARALLEL_THRESHOLD = 16384;
+
+		// Vec components are contiguous from x.
+		[[nodiscard]] static T component(const Vec<T, N>& v, std::size_t axis)
+		{
+			return (&v.x)[axis];
+		}
+
+		[[nodiscard]] static T squaredRadius(T radius)
+		{
+			// the default max radius would overflow once squared.
+			return radius < Math::sqrt(std::numeric_limits<T>::max()) ? radius * radius : std::numeric_limits<T>::max();
+		}
+
+		// depth first, near side first. visit(index, distanceSquared) is called for every point within
+		// boundSquared of p and may shrink boundSquared, which prunes the ranges left on the stack.
+		template<typename TVisit>
+		void search(const Vec<T, N>& p, T& boundSquared, TVisit&& visit) const
+		{
+			struct Range
+			{
+				Index begin;
+				Index end;
+				// lower bound of the distance squared from p to any point of the range.
+				T distanceSquared;
+			};
+
+			if (m_points.empty())
+			{
+				return;
+			}
+
+			Range stack[MAX_DEPTH];
+			std::size_t stackSize = 0;
+			stack[stackSize++] = { 0, static_cast<Index>(m_points.size()), static_cast<T>(0) };
+			while (stackSize > 0)
+			{
+				const Range range = stack[--stackSize];
+				if (range.distanceSquared > boundSquared)
+				{
+					continue;
+				}
+
+				if (range.end - range.begin <= LEAF_SIZE)
+				{
+					for (Index i = range.begin; i < range.end; ++i)
+					{
+						const T distanceSquared = m_points[i].distanceSquared(p);
+						if (distanceSquared <= boundSquared)
+						{
+							visit(m_indices[i], distanceSquared);
+						}
+					}
+					continue;
+				}
+
+				const Index middle = range.begin + (range.end - range.begin) / 2;
+				const std::size_t axis = m_axes[middle];
+				const T distanceSquared = m_points[middle].distanceSquared(p);
+				if (distanceSquared <= boundSquared)
+				{
+					visit(m_indices[middle], distanceSquared);
+				}
+
+				const T delta = component(p, axis) - component(m_points[middle], axis);
+				const Range left = { range.begin, middle, range.distanceSquared };
+				const Range right = { middle + 1, range.end, range.distanceSquared };
+				Range far = delta < static_cast<T>(0) ? right : left;
+				far.distanceSquared = Math::maxT(range.distanceSquared, delta * delta);
+				MANIMATHS_ASSERT(stackSize + 2 <= MAX_DEPTH);
+				stack[stackSize++] = far;
+				stack[stackSize++] = delta < static_cast<T>(0) ? left : right;
+			}
+		}
+
+		std::size_t queryKNearest(const Vec<T, N>& p, std::span<Index> out, T maxRadius, std::vector<std::pair<T, Index>>& best) const
+		{
+			const std::size_t k = out.size();
+			if (k == 0)
+			{
+				return 0;
+			}
+
+			// max heap on distance, the farthest of the k best is on top and bounds the search once full.
+			best.clear();
+			T boundSquared = squaredRadius(maxRadius);
+			search(p, boundSquared, [&](Index i, T distanceSquared)
+			{
+				if (best.size() < k)
+				{
+					best.emplace_back(distanceSquared, i);
+					std::push_heap(best.begin(), best.end());
+				}
+				else if (distanceSquared < best.front().first)
+				{
+					std::pop_heap(best.begin(), best.end());
+					best.back() = { distanceSquared, i };
+					std::push_heap(best.begin(), best.end());
+				}
+				if (best.size() == k)
+				{
+					boundSquared = best.front().first;
+				}
+			});
+
+			std::sort_heap(best.begin(), best.end());
+			for (std::size_t i = 0; i < best.size(); ++i)
+			{
+				out[i] = best[i].second;
+			}
+			return best.size();
+		}
+
+		std::vector<Vec<T, N>> m_points;
+		std::vector<Index> m_indices;
+		// split axis of the node at each position, unused for leaf points.
+		std::vector<uint8_t> m_axes;
+	};
+
+	typedef KdTree<float, 2>	KdTree2f;
+	typedef KdTree<float, 3>	KdTree3f;
+	typedef KdTree<float, 4>	KdTree4f;
+	typedef KdTree<double, 2>	KdTree2d;
+	typedef KdTree<double, 3>	KdTree3d;
+	typedef KdTree<double, 4>	KdTree4d;
+}
@@ -0,0 +1,385 @@
+#pragma once
+
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Simd.h"
+#include "Quat.h"
+#include "VecN.h"
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+// Expression templates for component-wise Vec/Quat arithmetic.
+// lazy(v) wraps a vector, a quaternion or a range of them. Operators on the wrappers only build a tree,
+// evaluated on assignment one element at a time: lazy(out) = lazy(a) * s + lazy(b) * t - lazy(c) is a single
+// loop without intermediate vectors, and a * b + c nodes use a fused multiply add when MANIMATHS_SIMD_FMA is on.
+// Every operation is component-wise, Quat * Quat (the Hamilton product) isn't available lazily.
+namespace Mani
+{
+	namespace Lazy
+	{
+		// size of an expression without any range operand, its single value applies to every element.
+		constexpr std::size_t BROADCAST = std::numeric_limits<std::size_t>::max();
+
+		// component access of the types an expression can be made of.
+		template<typename TValue>
+		struct Traits;
+
+		template<IsNumeric T, Size I>
+		struct Traits<Vec<T, I>>
+		{
+			using Scalar = T;
+			static constexpr std::size_t COUNT = I;
+			static constexpr bool COMPONENT_WISE_PRODUCT = true;
+
+			[[nodiscard]] static constexpr T& get(Vec<T, I>& v, std::size_t c) { return component(v, c); }
+			[[nodiscard]] static constexpr const T& get(const Vec<T, I>& v, std::size_t c) { return component(v, c); }
+		};
+
+		template<IsNumeric T>
+		struct Traits<Quat<T>>
+		{
+			using Scalar = T;
+			static constexpr std::size_t COUNT = 4;
+			static constexpr bool COMPONENT_WISE_PRODUCT = false;
+
+			[[nodiscard]] static constexpr T& get(Quat<T>& q, std::size_t c) { return (&q.x)[c]; }
+			[[nodiscard]] static constexpr const T& get(const Quat<T>& q, std::size_t c) { return (&q.x)[c]; }
+		};
+
+		template<typename TValue>
+		concept IsValue = requires { Traits<TValue>::COUNT; };
+
+		// a * b + c, fused when the target has fma.
+		template<IsNumeric T>
+		[[nodiscard]] constexpr T mulAdd(T a, T b, T c)
+		{
+#if defined(MANIMATHS_SIMD_FMA)
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					return std::fma(a, b, c);
+				}
+			}
+#endif
+			return a * b + c;
+		}
+
+		// base of every node. TExpr provides Value (void when only made of scalars), Scalar,
+		// size() and at(i, c), component c of element i.
+		template<typename TExpr>
+		struct Expression
+		{
+			// evaluates an expression without range operand.
+			[[nodiscard]] constexpr auto eval() const
+			{
+				const TExpr& self = static_cast<const TExpr&>(*this);
+				using TValue = typename TExpr::Value;
+				MANIMATHS_ASSERT(self.size() == BROADCAST || self.size() == 1);
+				TValue result;
+				Generic::unroll<Traits<TValue>::COUNT>([&](std::size_t c) { Traits<TValue>::get(result, c) = self.at(0, c); });
+				return result;
+			}
+
+			template<typename TValue> requires std::is_same_v<TValue, typename TExpr::Value>
+			constexpr operator TValue() const
+			{
+				return eval();
+			}
+		};
+
+		template<typename TExpr>
+		concept IsExpression = std::is_base_of_v<Expression<std::remove_cvref_t<TExpr>>, std::remove_cvref_t<TExpr>>;
+
+		// a value copied in the tree.
+		template<typename TValue>
+		struct Constant : Expression<Constant<TValue>>
+		{
+			using Value = TValue;
+			using Scalar = typename Traits<TValue>::Scalar;
+
+			TValue value;
+
+			[[nodiscard]] constexpr std::size_t size() const { return BROADCAST; }
+			[[nodiscard]] constexpr Scalar at(std::size_t, std::size_t c) const { return Traits<TValue>::get(value, c); }
+		};
+
+		// a number applied to every component.
+		template<IsNumeric T>
+		struct Number : Expression<Number<T>>
+		{
+			using Value = void;
+			using Scalar = T;
+
+			T value;
+
+			[[nodiscard]] constexpr std::size_t size() const { return BROADCAST; }
+			[[nodiscard]] constexpr T at(std::size_t, std::size_t) const { return value; }
+		};
+
+		// read only range of values.
+		template<typename TValue>
+		struct Elements : Expression<Elements<TValue>>
+		{
+			using Value = TValue;
+			using Scalar = typename Traits<TValue>::Scalar;
+
+			std::span<const TValue> values;
+
+			[[nodiscard]] constexpr std::size_t size() const { return values.size(); }
+			[[nodiscard]] constexpr Scalar at(std::size_t i, std::size_t c) const { return Traits<TValue>::get(values[i], c); }
+		};
+
+		// range of numbers, one per element, e.g. per particle inverse masses.
+		template<IsNumeric T>
+		struct Numbers : Expression<Numbers<T>>
+		{
+			using Value = void;
+			using Scalar = T;
+
+			std::span<const T> values;
+
+			[[nodiscard]] constexpr std::size_t size() const { return values.size(); }
+			[[nodiscard]] constexpr T at(std::size_t i, std::size_t) const { return values[i]; }
+		};
+
+		template<typename TOperand>
+		concept IsOperand = IsExpression<TOperand> || IsNumeric<std::remove_cvref_t<TOperand>> || IsValue<std::remove_cvref_t<TOperand>>;
+
+		template<typename TOperand>
+		[[nodiscard]] constexpr auto wrap(const TOperand& operand)
+		{
+			if constexpr (IsExpression<TOperand>)
+			{
+				return operand;
+			}
+			else if constexpr (IsNumeric<TOperand>)
+			{
+				return Number<TOperand>{ {}, operand };
+			}
+			else
+			{
+				return Constant<TOperand>{ {}, operand };
+			}
+		}
+
+		template<typename TOperand>
+		using Wrapped = decltype(wrap(std::declval<const TOperand&>()));
+
+		struct Add { template<typename T> static constexpr T apply(T a, T b) { return a + b; } };
+		struct Subtract { template<typename T> static constexpr T apply(T a, T b) { return a - b; } };
+		struct Multiply { template<typename T> static constexpr T apply(T a, T b) { return a * b; } };
+		struct Divide { template<typename T> static constexpr T apply(T a, T b) { return a / b; } };
+
+		template<typename TOp, typename TLhs, typename TRhs>
+		struct Binary : Expression<Binary<TOp, TLhs, TRhs>>
+		{
+			using Value = std::conditional_t<std::is_void_v<typename TLhs::Value>, typename TRhs::Value, typename TLhs::Value>;
+			// promoted like the eager operators, e.g. Vec3f * double computes in double.
+			using Scalar = std::common_type_t<typename TLhs::Scalar, typename TRhs::Scalar>;
+
+			static_assert(std::is_void_v<typename TLhs::Value> || std::is_void_v<typename TRhs::Value> || std::is_same_v<typename TLhs::Value, typename TRhs::Value>,
+				"lazy operands should have the same type");
+			static_assert(!std::is_same_v<TOp, Multiply> || std::is_void_v<typename TLhs::Value> || std::is_void_v<typename TRhs::Value> || Traits<Value>::COMPONENT_WISE_PRODUCT,
+				"only component-wise products are lazy");
+			static_assert(!std::is_same_v<TOp, Divide> || std::is_void_v<typename TRhs::Value>, "lazy divisions are by scalars");
+
+			TLhs lhs;
+			TRhs rhs;
+
+			[[nodiscard]] constexpr std::size_t size() const
+			{
+				const std::size_t lhsSize = lhs.size();
+				const std::size_t rhsSize = rhs.size();
+				MANIMATHS_ASSERT(lhsSize == BROADCAST || rhsSize == BROADCAST || lhsSize == rhsSize);
+				return lhsSize == BROADCAST ? rhsSize : lhsSize;
+			}
+
+			[[nodiscard]] constexpr Scalar at(std::size_t i, std::size_t c) const;
+		};
+
+		template<typename TExpr>
+		constexpr bool IsProduct = false;
+
+		template<typename TLhs, typename TRhs>
+		constexpr bool IsProduct<Binary<Multiply, TLhs, TRhs>> = true;
+
+		template<typename TOp, typename TLhs, typename TRhs>
+		constexpr typename Binary<TOp, TLhs, TRhs>::Scalar Binary<TOp, TLhs, TRhs>::at(std::size_t i, std::size_t c) const
+		{
+			// products feeding a sum are contracted.
+			if constexpr (std::is_same_v<TOp, Add> && IsProduct<TLhs>)
+			{
+				return mulAdd<Scalar>(lhs.lhs.at(i, c), lhs.rhs.at(i, c), rhs.at(i, c));
+			}
+			else if constexpr (std::is_same_v<TOp, Add> && IsProduct<TRhs>)
+			{
+				return mulAdd<Scalar>(rhs.lhs.at(i, c), rhs.rhs.at(i, c), lhs.at(i, c));
+			}
+			else if constexpr (std::is_same_v<TOp, Subtract> && IsProduct<TLhs>)
+			{
+				return mulAdd<Scalar>(lhs.lhs.at(i, c), lhs.rhs.at(i, c), -static_cast<Scalar>(rhs.at(i, c)));
+			}
+			else if constexpr (std::is_same_v<TOp, Subtract> && IsProduct<TRhs>)
+			{
+				return mulAdd<Scalar>(-static_cast<Scalar>(rhs.lhs.at(i, c)), rhs.rhs.at(i, c), lhs.at(i, c));
+			}
+			else
+			{
+				return TOp::apply(static_cast<Scalar>(lhs.at(i, c)), static_cast<Scalar>(rhs.at(i, c)));
+			}
+		}
+
+		template<typename TExpr>
+		struct Negate : Expression<Negate<TExpr>>
+		{
+			using Value = typename TExpr::Value;
+			using Scalar = typename TExpr::Scalar;
+
+			TExpr expr;
+
+			[[nodiscard]] constexpr std::size_t size() const { return expr.size(); }
+			[[nodiscard]] constexpr Scalar at(std::size_t i, std::size_t c) const { return -expr.at(i, c); }
+		};
+
+		// writable range of values, assigning an expression to it evaluates the expression.
+		// every operation being component-wise, the target may appear in its own expression.
+		// a Single target wraps one value, read in a range expression it applies to every element.
+		template<typename TValue, bool Single = false>
+		struct Target : Expression<Target<TValue, Single>>
+		{
+			using Value = TValue;
+			using Scalar = typename Traits<TValue>::Scalar;
+
+			std::span<TValue> values;
+
+			constexpr explicit Target(std::span<TValue> values) : values(values) {}
+			constexpr Target(const Target&) = default;
+
+			[[nodiscard]] constexpr std::size_t size() const { return Single ? BROADCAST : values.size(); }
+			[[nodiscard]] constexpr Scalar at(std::size_t i, std::size_t c) const { return Traits<TValue>::get(values[Single ? 0 : i], c); }
+
+			template<typename TOperand> requires IsOperand<TOperand>
+			constexpr Target& operator=(const TOperand& operand)
+			{
+				const Wrapped<TOperand> expr = wrap(operand);
+				static_assert(std::is_void_v<typename decltype(expr)::Value> || std::is_same_v<typename decltype(expr)::Value, TValue>,
+					"lazy operands should have the same type");
+				MANIMATHS_ASSERT(expr.size() == BROADCAST || expr.size() == values.size());
+
+				for (std::size_t i = 0; i < values.size(); ++i)
+				{
+					TValue result;
+					Generic::unroll<Traits<TValue>::COUNT>([&](std::size_t c) { Traits<TValue>::get(result, c) = static_cast<Scalar>(expr.at(i, c)); });
+					values[i] = result;
+				}
+				return *this;
+			}
+
+			// lazy(a) = lazy(b) copies the values, not the view.
+			constexpr Target& operator=(const Target& other)
+			{
+				return operator=<Target>(other);
+			}
+
+			template<typename TOperand> requires IsOperand<TOperand>
+			constexpr Target& operator+=(const TOperand& operand)
+			{
+				return *this = Binary<Add, Target, Wrapped<TOperand>>{ {}, *this, wrap(operand) };
+			}
+
+			template<typename TOperand> requires IsOperand<TOperand>
+			constexpr Target& operator-=(const TOperand& operand)
+			{
+				return *this = Binary<Subtract, Target, Wrapped<TOperand>>{ {}, *this, wrap(operand) };
+			}
+
+			template<typename TOperand> requires IsOperand<TOperand>
+			constexpr Target& operator*=(const TOperand& operand)
+			{
+				return *this = Binary<Multiply, Target, Wrapped<TOperand>>{ {}, *this, wrap(operand) };
+			}
+
+			template<typename TOperand> requires IsOperand<TOperand>
+			constexpr Target& operator/=(const TOperand& operand)
+			{
+				return *this = Binary<Divide, Target, Wrapped<TOperand>>{ {}, *this, wrap(operand) };
+			}
+		};
+
+		// at least one side is lazy, the other one is wrapped.
+		template<typename TLhs, typename TRhs>
+		concept IsLazyOperation = (IsExpression<TLhs> || IsExpression<TRhs>) && IsOperand<TLhs> && IsOperand<TRhs>;
+
+		template<typename TLhs, typename TRhs> requires IsLazyOperation<TLhs, TRhs>
+		[[nodiscard]] constexpr auto operator+(const TLhs& lhs, const TRhs& rhs)
+		{
+			return Binary<Add, Wrapped<TLhs>, Wrapped<TRhs>>{ {}, wrap(lhs), wrap(rhs) };
+		}
+
+		template<typename TLhs, typename TRhs> requires IsLazyOperation<TLhs, TRhs>
+		[[nodiscard]] constexpr auto operator-(const TLhs& lhs, const TRhs& rhs)
+		{
+			return Binary<Subtract, Wrapped<TLhs>, Wrapped<TRhs>>{ {}, wrap(lhs), wrap(rhs) };
+		}
+
+		template<typename TLhs, typename TRhs> requires IsLazyOperation<TLhs, TRhs>
+		[[nodiscard]] constexpr auto operator*(const TLhs& lhs, const TRhs& rhs)
+		{
+			return Binary<Multiply, Wrapped<TLhs>, Wrapped<TRhs>>{ {}, wrap(lhs), wrap(rhs) };
+		}
+
+		template<typename TLhs, typename TRhs> requires IsLazyOperation<TLhs, TRhs>
+		[[nodiscard]] constexpr auto operator/(const TLhs& lhs, const TRhs& rhs)
+		{
+			return Binary<Divide, Wrapped<TLhs>, Wrapped<TRhs>>{ {}, wrap(lhs), wrap(rhs) };
+		}
+
+		template<typename TExpr> requires IsExpression<TExpr>
+		[[nodiscard]] constexpr Negate<TExpr> operator-(const TExpr& expr)
+		{
+			return { {}, expr };
+		}
+	}
+
+	// a copy of value, for temporaries and const values.
+	template<typename TValue> requires Lazy::IsValue<TValue>
+	[[nodiscard]] constexpr Lazy::Constant<TValue> lazy(const TValue& value)
+	{
+		return { {}, value };
+	}
+
+	// value as an assignable target.
+	template<typename TValue> requires Lazy::IsValue<TValue>
+	[[nodiscard]] constexpr Lazy::Target<TValue, true> lazy(TValue& value)
+	{
+		return Lazy::Target<TValue, true>(std::span<TValue>(&value, 1));
+	}
+
+	// a contiguous range of Vec/Quat (assignable unless const) or of numbers (read only).
+	template<std::ranges::contiguous_range TRange>
+	[[nodiscard]] constexpr auto lazy(TRange&& range)
+	{
+		using TElement = std::remove_reference_t<std::ranges::range_reference_t<TRange>>;
+		using TValue = std::remove_const_t<TElement>;
+		if constexpr (IsNumeric<TValue>)
+		{
+			return Lazy::Numbers<TValue>{ {}, std::span<const TValue>(std::ranges::data(range), std::ranges::size(range)) };
+		}
+		else if constexpr (std::is_const_v<TElement>)
+		{
+			static_assert(Lazy::IsValue<TValue>, "lazy ranges hold Vec, Quat or numbers");
+			return Lazy::Elements<TValue>{ {}, std::span<const TValue>(std::ranges::data(range), std::ranges::size(range)) };
+		}
+		else
+		{
+			static_assert(Lazy::IsValue<TValue>, "lazy ranges hold Vec, Quat or numbers");
+			return Lazy::Target<TValue>(std::span<TValue>(std::ranges::data(range), std::ranges::size(range)));
+		}
+	}
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Mani
+{
+	// how a mapped range is about to be read, so the kernel can read ahead or not.
+	enum class AccessPattern
+	{
+		Normal,
+		// front to back, pages are read ahead aggressively.
+		Sequential,
+		// no read ahead.
+		Random,
+		// start reading the range now.
+		WillNeed,
+		// the range won't be read again soon, its pages may be dropped.
+		DontNeed
+	};
+
+	// Read only file, opened once to map several windows of it.
+	class FileHandle
+	{
+	public:
+		FileHandle() = default;
+
+		explicit FileHandle(const std::filesystem::path& path)
+		{
+			open(path);
+		}
+
+		~FileHandle()
+		{
+			close();
+		}
+
+		FileHandle(const FileHandle&) = delete;
+		FileHandle& operator=(const FileHandle&) = delete;
+
+		FileHandle(FileHandle&& other) noexcept
+		{
+			*this = std::move(other);
+		}
+
+		FileHandle& operator=(FileHandle&& other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+				m_handle = std::exchange(other.m_handle, INVALID);
+				m_size = std::exchange(other.m_size, 0);
+			}
+			return *this;
+		}
+
+		bool open(const std::filesystem::path& path)
+		{
+			close();
+#if defined(_WIN32)
+			m_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			LARGE_INTEGER size;
+			if (m_handle == INVALID || !GetFileSizeEx(m_handle, &size))
+			{
+				close();
+				return false;
+			}
+			m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+			m_handle = ::open(path.c_str(), O_RDONLY);
+			struct stat status;
+			if (m_handle == INVALID || fstat(m_handle, &status) != 0)
+			{
+				close();
+				return false;
+			}
+			m_size = static_cast<std::size_t>(status.st_size);
+#endif
+			return true;
+		}
+
+		void close()
+		{
+			if (m_handle != INVALID)
+			{
+#if defined(_WIN32)
+				CloseHandle(m_handle);
+#else
+				::close(m_handle);
+#endif
+			}
+			m_handle = INVALID;
+			m_size = 0;
+		}
+
+		[[nodiscard]] bool isOpen() const
+		{
+			return m_handle != INVALID;
+		}
+
+		[[nodiscard]] std::size_t getSize() const
+		{
+			return m_size;
+		}
+
+	private:
+		friend class MappedFile;
+
+#if defined(_WIN32)
+		using Native = HANDLE;
+		static inline const Native INVALID = INVALID_HANDLE_VALUE;
+#else
+		using Native = int;
+		static constexpr Native INVALID = -1;
+#endif
+
+		Native m_handle = INVALID;
+		std::size_t m_size = 0;
+	};
+
+	// Read only mapping of a file or of a window of it: pages are loaded on first access and shared with the
+	// page cache, nothing is copied or parsed. empty ranges can't be mapped.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+
+		explicit MappedFile(const std::filesystem::path& path)
+		{
+			open(path);
+		}
+
+		~MappedFile()
+		{
+			close();
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept
+		{
+			*this = std::move(other);
+		}
+
+		MappedFile& operator=(MappedFile&& other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+				m_base = std::exchange(other.m_base, nullptr);
+				m_data = std::exchange(other.m_data, nullptr);
+				m_size = std::exchange(other.m_size, 0);
+			}
+			return *this;
+		}
+
+		// the whole file, false if it can't be opened or is empty.
+		bool open(const std::filesystem::path& path)
+		{
+			const FileHandle file(path);
+			// the mapping keeps the file alive.
+			return open(file, 0, file.getSize());
+		}
+
+		// bytes [offset, offset + length) of file, clamped to its size. offset needn't be aligned, the mapping
+		// starts at the page before it.
+		bool open(const FileHandle& file, std::size_t offset, std::size_t length)
+		{
+			close();
+			if (!file.isOpen() || offset >= file.getSize())
+			{
+				return false;
+			}
+			length = std::min(length, file.getSize() - offset);
+			const std::size_t begin = offset / getGranularity() * getGranularity();
+			const std::size_t mappedLength = offset + length - begin;
+#if defined(_WIN32)
+			HANDLE mapping = CreateFileMappingW(file.m_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping == nullptr)
+			{
+				return false;
+			}
+			void* base = MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(static_cast<std::uint64_t>(begin) >> 32),
+				static_cast<DWORD>(begin & 0xFFFFFFFFu), mappedLength);
+			// the view keeps the mapping alive.
+			CloseHandle(mapping);
+			if (base == nullptr)
+			{
+				return false;
+			}
+#else
+			void* base = mmap(nullptr, mappedLength, PROT_READ, MAP_SHARED, file.m_handle, static_cast<off_t>(begin));
+			if (base == MAP_FAILED)
+			{
+				return false;
+			}
+#endif
+			m_base = static_cast<const std::byte*>(base);
+			m_data = m_base + (offset - begin);
+			m_size = length;
+			return true;
+		}
+
+		void close()
+		{
+			if (m_base != nullptr)
+			{
+#if defined(_WIN32)
+				UnmapViewOfFile(m_base);
+#else
+				munmap(const_cast<std::byte*>(m_base), static_cast<std::size_t>(m_data - m_base) + m_size);
+#endif
+			}
+			m_base = nullptr;
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		[[nodiscard]] bool isOpen() const
+		{
+			return m_data != nullptr;
+		}
+
+		[[nodiscard]] const std::byte* getData() const
+		{
+			return m_data;
+		}
+
+		[[nodiscard]] std::size_t getSize() const
+		{
+			return m_size;
+		}
+
+		[[nodiscard]] std::span<const std::byte> getBytes() const
+		{
+			return { m_data, m_size };
+		}
+
+		// a hint only, the range is relative to getData(), widened to whole pages and clamped to the mapping.
+		// madvise on posix, WillNeed prefetches on windows and the rest is ignored there.
+		void advise(AccessPattern pattern, std::size_t offset = 0, std::size_t length = SIZE_MAX) const
+		{
+			if (m_data == nullptr || offset >= m_size)
+			{
+				return;
+			}
+			length = std::min(length, m_size - offset);
+#if defined(_WIN32)
+			if (pattern == AccessPattern::WillNeed)
+			{
+				WIN32_MEMORY_RANGE_ENTRY range{ const_cast<std::byte*>(m_data) + offset, length };
+				PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+			}
+#else
+			const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+			const std::size_t from = static_cast<std::size_t>(m_data - m_base) + offset;
+			const std::size_t begin = from / pageSize * pageSize;
+			int advice = MADV_NORMAL;
+			switch (pattern)
+			{
+			case AccessPattern::Normal:		advice = MADV_NORMAL;		break;
+			case AccessPattern::Sequential:	advice = MADV_SEQUENTIAL;	break;
+			case AccessPattern::Random:		advice = MADV_RANDOM;		break;
+			case AccessPattern::WillNeed:	advice = MADV_WILLNEED;		break;
+			case AccessPattern::DontNeed:	advice = MADV_DONTNEED;		break;
+			}
+			madvise(const_cast<std::byte*>(m_base) + begin, from + length - begin, advice);
+#endif
+		}
+
+		// mapping offsets are rounded down to a multiple of this.
+		[[nodiscard]] static std::size_t getGranularity()
+		{
+#if defined(_WIN32)
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			return static_cast<std::size_t>(info.dwAllocationGranularity);
+#else
+			return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+		}
+
+	private:
+		// start of the mapping, the page before m_data.
+		const std::byte* m_base = nullptr;
+		const std::byte* m_data = nullptr;
+		std::size_t m_size = 0;
+	};
+}
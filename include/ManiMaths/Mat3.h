@@ -142,6 +142,7 @@ namespace Mani
 	typedef Mat<double,			3, 3> Mat3d;
 	typedef Mat<unsigned int,	3, 3> Mat3ui;
 	typedef Mat<unsigned long,	3, 3> Mat3ul;
+	typedef Mat<Fixed16_16,		3, 3> Mat3x;
 
 	template<IsNumeric T>
 	[[nodiscard]] constexpr bool operator==(const Mat<T, 3, 3>& lhs, const Mat<T, 3, 3>& rhs)
@@ -6,10 +6,22 @@
 #include "Debug.h"
 #include "Traits.h"
 #include "Maths.h"
+#include "Simd.h"
 #include <format>
 
 namespace Mani
 {
+	// what a 4x4 matrix does, from the cheapest to invert to the most expensive.
+	enum class TransformClass
+	{
+		// orthonormal rotation + translation, e.g. lookAt.
+		Rigid,
+		// last row is (0, 0, 0, 1), e.g. translate/rotate/scale.
+		Affine,
+		// anything else, e.g. perspective.
+		Projective
+	};
+
 	template<IsNumeric T>
 	struct Mat<T, 4, 4>
 	{
@@ -156,6 +168,106 @@ namespace Mani
 			return _13 * c0 - _03 * c1 + _33 * c2 - _23 * c3;
 		}
 
+		// true when the last row is (0, 0, 0, 1), i.e. a product with this matrix leaves w untouched.
+		constexpr bool isAffine() const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			return _03 == _0 && _13 == _0 && _23 == _0 && _33 == _1;
+		}
+
+		// inspects the matrix once so that the right inverse can be picked for it.
+		[[nodiscard]] TransformClass classify(double tolerance = 1e-5) const
+		{
+			if (!isAffine())
+			{
+				return TransformClass::Projective;
+			}
+
+			constexpr T _1 = static_cast<T>(1);
+			const bool isOrthonormal =
+				Math::abs(_00 * _00 + _01 * _01 + _02 * _02 - _1) <= tolerance &&
+				Math::abs(_10 * _10 + _11 * _11 + _12 * _12 - _1) <= tolerance &&
+				Math::abs(_20 * _20 + _21 * _21 + _22 * _22 - _1) <= tolerance &&
+				Math::abs(_00 * _10 + _01 * _11 + _02 * _12) <= tolerance &&
+				Math::abs(_00 * _20 + _01 * _21 + _02 * _22) <= tolerance &&
+				Math::abs(_10 * _20 + _11 * _21 + _12 * _22) <= tolerance;
+			return isOrthonormal ? TransformClass::Rigid : TransformClass::Affine;
+		}
+
+		// inverse of an affine matrix: 3x3 inverse of the upper block, translation = -inverse * t.
+		[[nodiscard]] Mat<T, 4, 4> inverseAffine() const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+
+			MANIMATHS_ASSERT(isAffine());
+			const T det =	_00 * (_11 * _22 - _21 * _12) -
+							_10 * (_01 * _22 - _21 * _02) +
+							_20 * (_01 * _12 - _11 * _02);
+			MANIMATHS_ASSERT(!Math::isEqual(det, _0));
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				Mat<T, 4, 4> result;
+				Simd::mat4InverseAffine(&_00, &result._00);
+				return result;
+			}
+#endif
+			const T invDet = _1 / det;
+
+			const T i00 = (_11 * _22 - _21 * _12) * invDet;
+			const T i01 = (_21 * _02 - _01 * _22) * invDet;
+			const T i02 = (_01 * _12 - _11 * _02) * invDet;
+			const T i10 = (_20 * _12 - _10 * _22) * invDet;
+			const T i11 = (_00 * _22 - _20 * _02) * invDet;
+			const T i12 = (_10 * _02 - _00 * _12) * invDet;
+			const T i20 = (_10 * _21 - _20 * _11) * invDet;
+			const T i21 = (_20 * _01 - _00 * _21) * invDet;
+			const T i22 = (_00 * _11 - _10 * _01) * invDet;
+
+			return {
+				i00, i01, i02, _0,
+				i10, i11, i12, _0,
+				i20, i21, i22, _0,
+				-(i00 * _30 + i10 * _31 + i20 * _32), -(i01 * _30 + i11 * _31 + i21 * _32), -(i02 * _30 + i12 * _31 + i22 * _32), _1
+			};
+		}
+
+		// inverse of a rotation + translation: the rotation is transposed, translation = -R^T * t.
+		[[nodiscard]] Mat<T, 4, 4> inverseRigid() const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+
+			MANIMATHS_ASSERT(isAffine());
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				Mat<T, 4, 4> result;
+				Simd::mat4InverseRigid(&_00, &result._00);
+				return result;
+			}
+#endif
+			return {
+				_00, _10, _20, _0,
+				_01, _11, _21, _0,
+				_02, _12, _22, _0,
+				-(_00 * _30 + _01 * _31 + _02 * _32), -(_10 * _30 + _11 * _31 + _12 * _32), -(_20 * _30 + _21 * _31 + _22 * _32), _1
+			};
+		}
+
+		// picks the cheapest inverse for a class returned by classify().
+		[[nodiscard]] Mat<T, 4, 4> inverse(TransformClass transformClass) const
+		{
+			switch (transformClass)
+			{
+				case TransformClass::Rigid: return inverseRigid();
+				case TransformClass::Affine: return inverseAffine();
+				default: return inverse();
+			}
+		}
+
 		operator Mat<T, 3, 3>() const
 		{
 			return {
@@ -249,11 +361,14 @@ namespace Mani
 
 			MANIMATHS_ASSERT(!Math::isEqual(aspect, _0));
 
-			const T tanHalffov = Math::tan(fov / _2);
+			// 1 / tan(fov / 2) straight from sincos, saves the tan call and a division.
+			T sinHalfFov, cosHalfFov;
+			Math::sincos(fov / _2, sinHalfFov, cosHalfFov);
+			const T cotHalfFov = cosHalfFov / sinHalfFov;
 
 			return {
-				_1 / (aspect * tanHalffov),				   _0,	 	     						  _0,  _0,
-				                        _0,	_1 / (tanHalffov),	 	     						  _0,  _0,
+				       cotHalfFov / aspect,				   _0,	 	     						  _0,  _0,
+				                        _0,	       cotHalfFov,	 	     						  _0,  _0,
 				                        _0,	               _0,      -(zFar + zNear) / (zFar - zNear), -_1,
 				                        _0,	               _0, -(_2 * zFar * zNear) / (zFar - zNear),  _0,
 			};
@@ -294,6 +409,7 @@ namespace Mani
 	typedef Mat<double,			4, 4> Mat4d;
 	typedef Mat<unsigned int,	4, 4> Mat4ui;
 	typedef Mat<unsigned long,	4, 4> Mat4ul;
+	typedef Mat<Fixed16_16,		4, 4> Mat4x;
 
 	template<IsNumeric T>
 	constexpr bool operator==(const Mat<T, 4, 4>& lhs, const Mat<T, 4, 4>& rhs)
@@ -353,30 +469,50 @@ namespace Mani
 		lhs._30 -= rhs._30; lhs._31 -= rhs._31; lhs._32 -= rhs._32; lhs._33 -= rhs._33;
 	}
 
+	namespace Scalar
+	{
+		template<IsNumeric T>
+		constexpr Mat<T, 4, 4> mul(const Mat<T, 4, 4>& lhs, const Mat<T, 4, 4>& rhs)
+		{
+			return Mat<T, 4, 4>{
+				lhs._00 * rhs._00 + lhs._10 * rhs._01 + lhs._20 * rhs._02 + lhs._30 * rhs._03, // _00
+				lhs._01 * rhs._00 + lhs._11 * rhs._01 + lhs._21 * rhs._02 + lhs._31 * rhs._03, // _01
+				lhs._02 * rhs._00 + lhs._12 * rhs._01 + lhs._22 * rhs._02 + lhs._32 * rhs._03, // _02
+				lhs._03 * rhs._00 + lhs._13 * rhs._01 + lhs._23 * rhs._02 + lhs._33 * rhs._03, // _03
+
+				lhs._00 * rhs._10 + lhs._10 * rhs._11 + lhs._20 * rhs._12 + lhs._30 * rhs._13, // _10
+				lhs._01 * rhs._10 + lhs._11 * rhs._11 + lhs._21 * rhs._12 + lhs._31 * rhs._13, // _11
+				lhs._02 * rhs._10 + lhs._12 * rhs._11 + lhs._22 * rhs._12 + lhs._32 * rhs._13, // _12
+				lhs._03 * rhs._10 + lhs._13 * rhs._11 + lhs._23 * rhs._12 + lhs._33 * rhs._13, // _13
+
+				lhs._00 * rhs._20 + lhs._10 * rhs._21 + lhs._20 * rhs._22 + lhs._30 * rhs._23, // _20
+				lhs._01 * rhs._20 + lhs._11 * rhs._21 + lhs._21 * rhs._22 + lhs._31 * rhs._23, // _21
+				lhs._02 * rhs._20 + lhs._12 * rhs._21 + lhs._22 * rhs._22 + lhs._32 * rhs._23, // _22
+				lhs._03 * rhs._20 + lhs._13 * rhs._21 + lhs._23 * rhs._22 + lhs._33 * rhs._23, // _23
+
+				lhs._00 * rhs._30 + lhs._10 * rhs._31 + lhs._20 * rhs._32 + lhs._30 * rhs._33, // _30
+				lhs._01 * rhs._30 + lhs._11 * rhs._31 + lhs._21 * rhs._32 + lhs._31 * rhs._33, // _31
+				lhs._02 * rhs._30 + lhs._12 * rhs._31 + lhs._22 * rhs._32 + lhs._32 * rhs._33, // _32
+				lhs._03 * rhs._30 + lhs._13 * rhs._31 + lhs._23 * rhs._32 + lhs._33 * rhs._33  // _33
+			};
+		}
+	}
+
 	template<IsNumeric T>
 	constexpr Mat<T, 4, 4> operator*(const Mat<T, 4, 4>& lhs, const Mat<T, 4, 4>& rhs)
 	{
-		return Mat<T, 4, 4>{
-			lhs._00 * rhs._00 + lhs._10 * rhs._01 + lhs._20 * rhs._02 + lhs._30 * rhs._03, // _00
-			lhs._01 * rhs._00 + lhs._11 * rhs._01 + lhs._21 * rhs._02 + lhs._31 * rhs._03, // _01
-			lhs._02 * rhs._00 + lhs._12 * rhs._01 + lhs._22 * rhs._02 + lhs._32 * rhs._03, // _02
-			lhs._03 * rhs._00 + lhs._13 * rhs._01 + lhs._23 * rhs._02 + lhs._33 * rhs._03, // _03
-
-			lhs._00 * rhs._10 + lhs._10 * rhs._11 + lhs._20 * rhs._12 + lhs._30 * rhs._13, // _10
-			lhs._01 * rhs._10 + lhs._11 * rhs._11 + lhs._21 * rhs._12 + lhs._31 * rhs._13, // _11
-			lhs._02 * rhs._10 + lhs._12 * rhs._11 + lhs._22 * rhs._12 + lhs._32 * rhs._13, // _12
-			lhs._03 * rhs._10 + lhs._13 * rhs._11 + lhs._23 * rhs._12 + lhs._33 * rhs._13, // _13
-
-			lhs._00 * rhs._20 + lhs._10 * rhs._21 + lhs._20 * rhs._22 + lhs._30 * rhs._23, // _20
-			lhs._01 * rhs._20 + lhs._11 * rhs._21 + lhs._21 * rhs._22 + lhs._31 * rhs._23, // _21
-			lhs._02 * rhs._20 + lhs._12 * rhs._21 + lhs._22 * rhs._22 + lhs._32 * rhs._23, // _22
-			lhs._03 * rhs._20 + lhs._13 * rhs._21 + lhs._23 * rhs._22 + lhs._33 * rhs._23, // _23
-
-			lhs._00 * rhs._30 + lhs._10 * rhs._31 + lhs._20 * rhs._32 + lhs._30 * rhs._33, // _30
-			lhs._01 * rhs._30 + lhs._11 * rhs._31 + lhs._21 * rhs._32 + lhs._31 * rhs._33, // _31
-			lhs._02 * rhs._30 + lhs._12 * rhs._31 + lhs._22 * rhs._32 + lhs._32 * rhs._33, // _32
-			lhs._03 * rhs._30 + lhs._13 * rhs._31 + lhs._23 * rhs._32 + lhs._33 * rhs._33  // _33
-		};
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				Mat<T, 4, 4> result;
+				Simd::mat4Mul(&lhs._00, &rhs._00, &result._00);
+				return result;
+			}
+		}
+#endif
+		return Scalar::mul(lhs, rhs);
 	}
 
 	template<IsNumeric T>
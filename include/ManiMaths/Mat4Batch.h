@@ -0,0 +1,139 @@
+#pragma once
+
+#include "_Mat.h"
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Simd.h"
+#include "Vec3.h"
+#include "Vec4.h"
+#include "Mat4.h"
+#include <span>
+#include <type_traits>
+
+// Batched Mat4 x Vec3/Vec4 products over spans.
+// The matrix is only inspected once per batch, so affine matrices skip the perspective divide for every point.
+// Spans are non-deduced, vectors and arrays can be passed directly as long as the matrix type is known.
+namespace Mani
+{
+	namespace Scalar
+	{
+		// IsPoint adds the translation (w = 1), Divide divides the result by its w component. out may alias in.
+		template<bool IsPoint, bool Divide, IsNumeric T>
+		void transform3(const Mat<T, 4, 4>& mat, std::span<const Vec<T, 3>> in, std::span<Vec<T, 3>> out)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			constexpr T w = IsPoint ? _1 : _0;
+
+			for (std::size_t i = 0; i < in.size(); ++i)
+			{
+				const Vec<T, 3> v = in[i];
+				const Vec<T, 3> r = {
+					mat._00 * v.x + mat._10 * v.y + mat._20 * v.z + mat._30 * w,
+					mat._01 * v.x + mat._11 * v.y + mat._21 * v.z + mat._31 * w,
+					mat._02 * v.x + mat._12 * v.y + mat._22 * v.z + mat._32 * w
+				};
+				if constexpr (Divide)
+				{
+					const T rw = mat._03 * v.x + mat._13 * v.y + mat._23 * v.z + mat._33 * w;
+					out[i] = r / rw;
+				}
+				else
+				{
+					out[i] = r;
+				}
+			}
+		}
+
+		template<IsNumeric T>
+		void transform4(const Mat<T, 4, 4>& mat, std::span<const Vec<T, 4>> in, std::span<Vec<T, 4>> out)
+		{
+			for (std::size_t i = 0; i < in.size(); ++i)
+			{
+				out[i] = mat * in[i];
+			}
+		}
+	}
+
+	template<bool IsPoint, bool Divide, IsNumeric T>
+	void transform3(const Mat<T, 4, 4>& mat, std::span<const Vec<T, 3>> in, std::span<Vec<T, 3>> out)
+	{
+		MANIMATHS_ASSERT(out.size() >= in.size());
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Simd::transform3<IsPoint, Divide>(&mat._00, reinterpret_cast<const float*>(in.data()), reinterpret_cast<float*>(out.data()), in.size());
+			return;
+		}
+#endif
+		Scalar::transform3<IsPoint, Divide>(mat, in, out);
+	}
+
+	// same as mat * point for every point, the divide by w is skipped when mat is affine.
+	template<IsNumeric T>
+	void transformPoints(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<const Vec<T, 3>>> points, std::type_identity_t<std::span<Vec<T, 3>>> out)
+	{
+		if (mat.isAffine())
+		{
+			transform3<true, false>(mat, points, out);
+		}
+		else
+		{
+			transform3<true, true>(mat, points, out);
+		}
+	}
+
+	template<IsNumeric T>
+	void transformPoints(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<Vec<T, 3>>> points)
+	{
+		transformPoints(mat, std::span<const Vec<T, 3>>(points), points);
+	}
+
+	// always divides by w, for projection matrices where the affine check would always fail.
+	template<IsNumeric T>
+	void transformPointsProjective(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<const Vec<T, 3>>> points, std::type_identity_t<std::span<Vec<T, 3>>> out)
+	{
+		transform3<true, true>(mat, points, out);
+	}
+
+	template<IsNumeric T>
+	void transformPointsProjective(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<Vec<T, 3>>> points)
+	{
+		transformPointsProjective(mat, std::span<const Vec<T, 3>>(points), points);
+	}
+
+	// w = 0: translation and projection are ignored.
+	template<IsNumeric T>
+	void transformDirections(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<const Vec<T, 3>>> directions, std::type_identity_t<std::span<Vec<T, 3>>> out)
+	{
+		transform3<false, false>(mat, directions, out);
+	}
+
+	template<IsNumeric T>
+	void transformDirections(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<Vec<T, 3>>> directions)
+	{
+		transformDirections(mat, std::span<const Vec<T, 3>>(directions), directions);
+	}
+
+	// same as mat * v for every v.
+	template<IsNumeric T>
+	void transform(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<const Vec<T, 4>>> in, std::type_identity_t<std::span<Vec<T, 4>>> out)
+	{
+		MANIMATHS_ASSERT(out.size() >= in.size());
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Simd::transform4(&mat._00, reinterpret_cast<const float*>(in.data()), reinterpret_cast<float*>(out.data()), in.size());
+			return;
+		}
+#endif
+		Scalar::transform4(mat, in, out);
+	}
+
+	template<IsNumeric T>
+	void transform(const Mat<T, 4, 4>& mat, std::type_identity_t<std::span<Vec<T, 4>>> v)
+	{
+		transform(mat, std::span<const Vec<T, 4>>(v), v);
+	}
+}
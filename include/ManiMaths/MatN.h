@@ -0,0 +1,359 @@
+#pragma once
+
+#include "_Mat.h"
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "VecN.h"
+#include <cstddef>
+#include <format>
+#include <string>
+#include <utility>
+
+namespace Mani
+{
+	// sizes without a hand written specialization.
+	template<Size H, Size W>
+	concept IsGenericMatSize = !(H == W && (H == 3 || H == 4));
+
+	// Array backed H rows x W columns matrix of any size but the hand written 3x3 and 4x4,
+	// e.g. Mat<float, 6, 6> for a filter covariance or Mat<float, 3, 4> for an affine transform.
+	// Column major like Mat3 and Mat4: m[row][column] is data[column * H + row].
+	template<IsNumeric T, Size H, Size W>
+	struct Mat
+	{
+		static_assert(H > 0 && W > 0, "matrices have at least one row and one column");
+
+		T data[H * W] = {};
+
+		MatLineView<T, H>		operator[](Size i)			{ return MatLineView<T, H>{ data, i }; };
+		const MatLineView<T, H>	operator[](Size i) const	{ return MatLineView<T, H>{ data, i }; };
+
+		// same element as m[row][column], usable in constant expressions.
+		[[nodiscard]] constexpr T& at(Size row, Size column)
+		{
+			MANIMATHS_ASSERT(row < H && column < W);
+			return data[column * H + row];
+		}
+
+		[[nodiscard]] constexpr const T& at(Size row, Size column) const
+		{
+			MANIMATHS_ASSERT(row < H && column < W);
+			return data[column * H + row];
+		}
+
+		// column i, as stored.
+		Vec<T, H> getLineAt(Size i) const
+		{
+			MANIMATHS_ASSERT(i < W);
+			Vec<T, H> line{};
+			Generic::unroll<H>([&](std::size_t row) { component(line, row) = data[i * H + row]; });
+			return line;
+		}
+
+		void setLineAt(Size i, const Vec<T, H>& v)
+		{
+			MANIMATHS_ASSERT(i < W);
+			Generic::unroll<H>([&](std::size_t row) { data[i * H + row] = component(v, row); });
+		}
+
+		[[nodiscard]] static constexpr Mat<T, H, W> make(T v)
+		{
+			Mat<T, H, W> result;
+			Generic::unroll<H * W>([&](std::size_t i) { result.data[i] = v; });
+			return result;
+		}
+
+		[[nodiscard]] static constexpr Mat<T, H, W> identity() requires (H == W)
+		{
+			Mat<T, H, W> result;
+			Generic::unroll<H>([&](std::size_t i) { result.data[i * H + i] = static_cast<T>(1); });
+			return result;
+		}
+
+		template<IsNumeric T1, IsNumeric T2>
+		[[nodiscard]] static bool isNearlyEqual(const Mat<T1, H, W>& lhs, const Mat<T2, H, W>& rhs, double tolerance = FLT_EPSILON)
+		{
+			bool equal = true;
+			Generic::unroll<H * W>([&](std::size_t i) { equal &= Math::abs(lhs.data[i] - rhs.data[i]) <= tolerance; });
+			return equal;
+		}
+
+		template<IsNumeric T2>
+		[[nodiscard]] bool isNearlyEqual(const Mat<T2, H, W>& other, double tolerance = FLT_EPSILON) const
+		{
+			return isNearlyEqual(*this, other, tolerance);
+		}
+
+		[[nodiscard]] constexpr Mat<T, W, H> transpose() const
+		{
+			Mat<T, W, H> result{};
+			for (std::size_t row = 0; row < H; ++row)
+			{
+				Generic::unroll<W>([&](std::size_t column) { element(result, column, row) = data[column * H + row]; });
+			}
+			return result;
+		}
+
+		// LU elimination with partial pivoting.
+		[[nodiscard]] T determinant() const requires (H == W)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			Mat<T, H, W> lu = *this;
+			T det = static_cast<T>(1);
+			for (Size k = 0; k < H; ++k)
+			{
+				const Size pivot = findPivot(lu, k);
+				if (lu.at(pivot, k) == _0)
+				{
+					return _0;
+				}
+				if (pivot != k)
+				{
+					swapRows(lu, k, pivot);
+					det = -det;
+				}
+				det *= lu.at(k, k);
+				for (Size row = k + 1; row < H; ++row)
+				{
+					const T f = lu.at(row, k) / lu.at(k, k);
+					for (Size column = k + 1; column < W; ++column)
+					{
+						lu.at(row, column) -= f * lu.at(k, column);
+					}
+				}
+			}
+			return det;
+		}
+
+		// Gauss-Jordan elimination with partial pivoting, the matrix must be invertible.
+		[[nodiscard]] Mat<T, H, W> inverse() const requires (H == W)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			Mat<T, H, W> a = *this;
+			Mat<T, H, W> result = identity();
+			for (Size k = 0; k < H; ++k)
+			{
+				const Size pivot = findPivot(a, k);
+				MANIMATHS_ASSERT(a.at(pivot, k) != _0); // singular matrix
+				swapRows(a, k, pivot);
+				swapRows(result, k, pivot);
+
+				const T f = _1 / a.at(k, k);
+				for (Size column = 0; column < W; ++column)
+				{
+					a.at(k, column) *= f;
+					result.at(k, column) *= f;
+				}
+				for (Size row = 0; row < H; ++row)
+				{
+					const T factor = a.at(row, k);
+					if (row == k || factor == _0)
+					{
+						continue;
+					}
+					for (Size column = 0; column < W; ++column)
+					{
+						a.at(row, column) -= factor * a.at(k, column);
+						result.at(row, column) -= factor * result.at(k, column);
+					}
+				}
+			}
+			return result;
+		}
+
+		std::string toString() const
+		{
+			return joinLines("\n");
+		}
+
+		std::string toStringOnOneLine() const
+		{
+			return joinLines("");
+		}
+
+	private:
+		// row of the largest magnitude element of column k, from row k down.
+		[[nodiscard]] static Size findPivot(const Mat<T, H, W>& m, Size k)
+		{
+			Size pivot = k;
+			for (Size row = k + 1; row < H; ++row)
+			{
+				pivot = Math::abs(m.at(row, k)) > Math::abs(m.at(pivot, k)) ? row : pivot;
+			}
+			return pivot;
+		}
+
+		static void swapRows(Mat<T, H, W>& m, Size a, Size b)
+		{
+			if (a == b)
+			{
+				return;
+			}
+			for (Size column = 0; column < W; ++column)
+			{
+				std::swap(m.at(a, column), m.at(b, column));
+			}
+		}
+
+		// one line per column like Mat3 and Mat4.
+		std::string joinLines(const char* separator) const
+		{
+			std::string result;
+			for (Size column = 0; column < W; ++column)
+			{
+				result += column == 0 ? "(" : std::string(separator) + "(";
+				for (Size row = 0; row < H; ++row)
+				{
+					result += std::format(row == 0 ? "{}" : ", {}", data[column * H + row]);
+				}
+				result += ")";
+			}
+			return result;
+		}
+	};
+
+	// element (row, column) of any matrix, hand written ones included. generic code over every size goes through it.
+	template<IsNumeric T, Size H, Size W>
+	[[nodiscard]] constexpr T& element(Mat<T, H, W>& m, std::size_t row, std::size_t column)
+	{
+		MANIMATHS_ASSERT(row < H && column < W);
+		if constexpr (IsGenericMatSize<H, W>)
+		{
+			return m.data[column * H + row];
+		}
+		else
+		{
+			return (&m._00)[column * H + row];
+		}
+	}
+
+	template<IsNumeric T, Size H, Size W>
+	[[nodiscard]] constexpr const T& element(const Mat<T, H, W>& m, std::size_t row, std::size_t column)
+	{
+		MANIMATHS_ASSERT(row < H && column < W);
+		if constexpr (IsGenericMatSize<H, W>)
+		{
+			return m.data[column * H + row];
+		}
+		else
+		{
+			return (&m._00)[column * H + row];
+		}
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr bool operator==(const Mat<T, H, W>& lhs, const Mat<T, H, W>& rhs)
+	{
+		bool equal = true;
+		Generic::unroll<H * W>([&](std::size_t i) { equal &= lhs.data[i] == rhs.data[i]; });
+		return equal;
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr bool operator!=(const Mat<T, H, W>& lhs, const Mat<T, H, W>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr Mat<T, H, W> operator+(const Mat<T, H, W>& lhs, const Mat<T, H, W>& rhs)
+	{
+		Mat<T, H, W> result;
+		Generic::unroll<H * W>([&](std::size_t i) { result.data[i] = lhs.data[i] + rhs.data[i]; });
+		return result;
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr Mat<T, H, W> operator-(const Mat<T, H, W>& lhs, const Mat<T, H, W>& rhs)
+	{
+		Mat<T, H, W> result;
+		Generic::unroll<H * W>([&](std::size_t i) { result.data[i] = lhs.data[i] - rhs.data[i]; });
+		return result;
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	constexpr void operator+=(Mat<T, H, W>& lhs, const Mat<T, H, W>& rhs)
+	{
+		Generic::unroll<H * W>([&](std::size_t i) { lhs.data[i] += rhs.data[i]; });
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	constexpr void operator-=(Mat<T, H, W>& lhs, const Mat<T, H, W>& rhs)
+	{
+		Generic::unroll<H * W>([&](std::size_t i) { lhs.data[i] -= rhs.data[i]; });
+	}
+
+	// any product involving a generic matrix, e.g. Mat<T, 4, 3> * Mat3 or Mat<T, 4, 3> * Mat<T, 3, 4> = Mat4.
+	// column j of the result is the lhs columns weighted by column j of rhs, contiguous multiply adds.
+	template<IsNumeric T, Size H, Size K, Size W> requires (IsGenericMatSize<H, K> || IsGenericMatSize<K, W>)
+	[[nodiscard]] constexpr Mat<T, H, W> operator*(const Mat<T, H, K>& lhs, const Mat<T, K, W>& rhs)
+	{
+		Mat<T, H, W> result{};
+		// only the column axpy is unrolled, fully unrolling the three levels defeats inlining past 4x4.
+		for (std::size_t j = 0; j < W; ++j)
+		{
+			for (std::size_t k = 0; k < K; ++k)
+			{
+				const T weight = element(rhs, k, j);
+				Generic::unroll<H>([&](std::size_t i) { element(result, i, j) += element(lhs, i, k) * weight; });
+			}
+		}
+		return result;
+	}
+
+	template<IsNumeric T, Size H> requires IsGenericMatSize<H, H>
+	constexpr void operator*=(Mat<T, H, H>& lhs, const Mat<T, H, H>& rhs)
+	{
+		lhs = lhs * rhs;
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr Mat<T, H, W> operator*(const Mat<T, H, W>& lhs, T rhs)
+	{
+		Mat<T, H, W> result;
+		Generic::unroll<H * W>([&](std::size_t i) { result.data[i] = lhs.data[i] * rhs; });
+		return result;
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr Mat<T, H, W> operator*(T lhs, const Mat<T, H, W>& rhs)
+	{
+		return rhs * lhs;
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	constexpr void operator*=(Mat<T, H, W>& lhs, T rhs)
+	{
+		Generic::unroll<H * W>([&](std::size_t i) { lhs.data[i] *= rhs; });
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr Mat<T, H, W> operator/(const Mat<T, H, W>& lhs, T rhs)
+	{
+		Mat<T, H, W> result;
+		Generic::unroll<H * W>([&](std::size_t i) { result.data[i] = lhs.data[i] / rhs; });
+		return result;
+	}
+
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	constexpr void operator/=(Mat<T, H, W>& lhs, T rhs)
+	{
+		Generic::unroll<H * W>([&](std::size_t i) { lhs.data[i] /= rhs; });
+	}
+
+	// the vector sizes may be hand written, e.g. Mat<T, 3, 4> * Vec4 = Vec3.
+	template<IsNumeric T, Size H, Size W> requires IsGenericMatSize<H, W>
+	[[nodiscard]] constexpr Vec<T, H> operator*(const Mat<T, H, W>& mat, const Vec<T, W>& v)
+	{
+		Vec<T, H> result{};
+		Generic::unroll<W>([&](std::size_t j)
+		{
+			const T weight = component(v, j);
+			Generic::unroll<H>([&](std::size_t i) { component(result, i) += mat.data[j * H + i] * weight; });
+		});
+		return result;
+	}
+}
@@ -2,8 +2,11 @@
 
 #include "Debug.h"
 #include "Traits.h"
+// its Math:: overloads have to be declared before the templates calling them.
+#include "Fixed.h"
 #include <cmath>
 #include <float.h>
+#include <span>
 
 namespace Mani
 {
@@ -30,6 +33,27 @@ namespace Mani
 			return std::sin(v);
 		}
 
+		// sin and cos of the same angle side by side, gcc and clang merge them into a single sincos call.
+		template<IsNumeric T>
+		void sincos(T v, T& outSin, T& outCos)
+		{
+			outSin = std::sin(v);
+			outCos = std::cos(v);
+		}
+
+		template<IsNumeric T>
+		void sincosBatch(std::span<const T> in, std::span<T> outSin, std::span<T> outCos)
+		{
+			MANIMATHS_ASSERT(outSin.size() >= in.size() && outCos.size() >= in.size());
+			for (std::size_t i = 0; i < in.size(); ++i)
+			{
+				Math::sincos(in[i], outSin[i], outCos[i]);
+			}
+		}
+
+		inline void sincos(std::span<const float> in, std::span<float> outSin, std::span<float> outCos)		{ sincosBatch(in, outSin, outCos); }
+		inline void sincos(std::span<const double> in, std::span<double> outSin, std::span<double> outCos)	{ sincosBatch(in, outSin, outCos); }
+
 		template<IsNumeric T>
 		[[nodiscard]] T tan(T v)
 		{
@@ -0,0 +1,444 @@
+#pragma once
+
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Opt-in polynomial approximations of the Math functions, trading a known amount of precision for speed.
+// They are branch free, selects are bit masks and there are no library calls, so that loops over them
+// vectorize: the span overloads are exactly that.
+// Measured max errors against the std functions (float / double):
+//	sin, cos			1e-7 / 2e-11 absolute,	|v| < 1e4
+//	sincos				1e-7 / 3e-9 absolute,	|v| < 1e4
+//	atan, atan2			3e-7 / 2e-8 radians
+//	acos, asin			5e-7 / 3e-8 radians,	v in [-1, 1]
+//	rsqrt				5e-6 relative,			v > 0
+//	exp					2e-7 / 2e-9 relative,	v in [-87, 87], clamped outside
+//	log					5e-7 / 2e-9 absolute,	v > 0 and normal
+namespace Mani
+{
+	namespace Math
+	{
+		namespace fast
+		{
+			template<IsFloatingPoint T>
+			using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+			// ifTrue where mask bits are set, ifFalse elsewhere.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T selectBits(Bits<T> mask, T ifTrue, T ifFalse)
+			{
+				static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double are supported");
+				return std::bit_cast<T>((std::bit_cast<Bits<T>>(ifTrue) & mask) | (std::bit_cast<Bits<T>>(ifFalse) & ~mask));
+			}
+
+			// through a mask, a ternary on floats is often compiled to a branch that stops vectorization.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T select(bool condition, T ifTrue, T ifFalse)
+			{
+				return selectBits(static_cast<Bits<T>>(0) - static_cast<Bits<T>>(condition), ifTrue, ifFalse);
+			}
+
+			// magnitude with the sign of sign, std::copysign isn't constexpr.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T copySign(T magnitude, T sign)
+			{
+				constexpr Bits<T> SIGN_BIT = static_cast<Bits<T>>(1) << (sizeof(T) * 8 - 1);
+				return std::bit_cast<T>((std::bit_cast<Bits<T>>(magnitude) & ~SIGN_BIT) | (std::bit_cast<Bits<T>>(sign) & SIGN_BIT));
+			}
+
+			// v negated where signBit is set, signBit is the sign bit or 0.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T flipSign(T v, Bits<T> signBit)
+			{
+				return std::bit_cast<T>(std::bit_cast<Bits<T>>(v) ^ signBit);
+			}
+
+			// round half away from zero.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr int32_t roundToInt(T v)
+			{
+				return static_cast<int32_t>(v + copySign(static_cast<T>(0.5), v));
+			}
+
+			// v = k * pi / 2 + r with r in [-pi / 4, pi / 4], pi / 2 is split in 3 so that r stays exact.
+			template<IsFloatingPoint T>
+			constexpr void reduceQuadrant(T v, T& r, int32_t& k)
+			{
+				constexpr T _2_OVER_PI = static_cast<T>(0.636619772367581343075535053490057448);
+				constexpr T PIO2_1 = static_cast<T>(1.5703125);
+				constexpr T PIO2_2 = static_cast<T>(4.837512969970703125e-4);
+				constexpr T PIO2_3 = static_cast<T>(7.54978995489188216e-8);
+
+				k = roundToInt(v * _2_OVER_PI);
+				const T kf = static_cast<T>(k);
+				r = ((v - kf * PIO2_1) - kf * PIO2_2) - kf * PIO2_3;
+			}
+
+			// sin on [-pi / 4, pi / 4]
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T sinKernel(T r)
+			{
+				const T r2 = r * r;
+				return r + r * r2 * (static_cast<T>(-1.6666654611e-1) + r2 * (static_cast<T>(8.3321608736e-3) + r2 * static_cast<T>(-1.9515295891e-4)));
+			}
+
+			// cos on [-pi / 4, pi / 4]
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T cosKernel(T r)
+			{
+				const T r2 = r * r;
+				return static_cast<T>(1) - static_cast<T>(0.5) * r2 + r2 * r2 * (static_cast<T>(4.166664568298827e-2) + r2 * (static_cast<T>(-1.388731625493765e-3) + r2 * static_cast<T>(2.443315711809948e-5)));
+			}
+
+			template<IsFloatingPoint T>
+			constexpr void sincos(T v, T& outSin, T& outCos)
+			{
+				T r = static_cast<T>(0);
+				int32_t k = 0;
+				reduceQuadrant(v, r, k);
+
+				const T s = sinKernel(r);
+				const T c = cosKernel(r);
+
+				// quadrant 0: ( s,  c), 1: ( c, -s), 2: (-s, -c), 3: (-c,  s)
+				// masks straight from k, through bool the double loops don't vectorize.
+				constexpr int SHIFT = sizeof(T) * 8 - 2;
+				const Bits<T> swap = static_cast<Bits<T>>(0) - static_cast<Bits<T>>(k & 1);
+				outSin = flipSign(selectBits(swap, c, s), static_cast<Bits<T>>(k & 2) << SHIFT);
+				outCos = flipSign(selectBits(swap, s, c), static_cast<Bits<T>>((k + 1) & 2) << SHIFT);
+			}
+
+			// sin on [-pi / 2, pi / 2], least squares fits on chebyshev nodes: 5e-9 absolute before rounding for
+			// float, 2e-11 for double. one polynomial over a half turn, sin and cos alone don't need both quadrant
+			// kernels.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T sinHalfTurnKernel(T r)
+			{
+				const T r2 = r * r;
+				T p = static_cast<T>(0);
+				if constexpr (sizeof(T) == 4)
+				{
+					p = static_cast<T>(2.600614835452918e-06);
+					p = p * r2 + static_cast<T>(-1.980690216508909e-04);
+					p = p * r2 + static_cast<T>(8.333021879496291e-03);
+					p = p * r2 + static_cast<T>(-1.6666657318496228e-01);
+				}
+				else
+				{
+					p = static_cast<T>(-2.38517700654413e-08);
+					p = p * r2 + static_cast<T>(2.752294829638303e-06);
+					p = p * r2 + static_cast<T>(-1.9840811595925857e-04);
+					p = p * r2 + static_cast<T>(8.333330566801784e-03);
+					p = p * r2 + static_cast<T>(-1.6666666608706782e-01);
+				}
+				return r + r * r2 * p;
+			}
+
+			// v = m * pi / 2 + r with r in [-pi / 2, pi / 2], for an odd m when cos is true and an even one otherwise.
+			// returns (m - 1) / 2 for cos, m / 2 for sin.
+			template<IsFloatingPoint T>
+			constexpr int32_t reduceHalfTurn(T v, T& r, bool cos)
+			{
+				constexpr T _1_OVER_PI = static_cast<T>(0.318309886183790671537767526745028724);
+				constexpr T PIO2_1 = static_cast<T>(1.5703125);
+				constexpr T PIO2_2 = static_cast<T>(4.837512969970703125e-4);
+				constexpr T PIO2_3 = static_cast<T>(7.54978995489188216e-8);
+
+				const int32_t k = roundToInt(v * _1_OVER_PI - (cos ? static_cast<T>(0.5) : static_cast<T>(0)));
+				const T mf = static_cast<T>(2 * k + (cos ? 1 : 0));
+				r = ((v - mf * PIO2_1) - mf * PIO2_2) - mf * PIO2_3;
+				return k;
+			}
+
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T sin(T v)
+			{
+				// sin(k * pi + r) = (-1)^k sin(r)
+				T r = static_cast<T>(0);
+				const int32_t k = reduceHalfTurn(v, r, false);
+				return flipSign(sinHalfTurnKernel(r), static_cast<Bits<T>>(k & 1) << (sizeof(T) * 8 - 1));
+			}
+
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T cos(T v)
+			{
+				// cos((k + 1 / 2) * pi + r) = (-1)^(k + 1) sin(r)
+				T r = static_cast<T>(0);
+				const int32_t k = reduceHalfTurn(v, r, true);
+				return flipSign(sinHalfTurnKernel(r), static_cast<Bits<T>>(~k & 1) << (sizeof(T) * 8 - 1));
+			}
+
+			// atan on [0, 1], Abramowitz & Stegun 4.4.49
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T atanKernel(T v)
+			{
+				const T v2 = v * v;
+				T p = static_cast<T>(0.0028662257);
+				p = p * v2 + static_cast<T>(-0.0161657367);
+				p = p * v2 + static_cast<T>(0.0429096138);
+				p = p * v2 + static_cast<T>(-0.0752896400);
+				p = p * v2 + static_cast<T>(0.1065626393);
+				p = p * v2 + static_cast<T>(-0.1420889944);
+				p = p * v2 + static_cast<T>(0.1999355085);
+				p = p * v2 + static_cast<T>(-0.3333314528);
+				return v + v * v2 * p;
+			}
+
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T atan2(T y, T x)
+			{
+				constexpr T _0 = static_cast<T>(0);
+				constexpr T PI = static_cast<T>(PId);
+				constexpr T PI_OVER_2 = static_cast<T>(PId / 2.0);
+
+				const T absX = Math::abs(x);
+				const T absY = Math::abs(y);
+				const bool steep = absY > absX;
+				const T num = select(steep, absX, absY);
+				const T den = select(steep, absY, absX);
+
+				// atan2(0, 0) is 0
+				T r = atanKernel(den > _0 ? num / den : _0);
+				r = select(steep, PI_OVER_2 - r, r);
+				r = select(x < _0, PI - r, r);
+				return select(y < _0, -r, r);
+			}
+
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T atan(T v)
+			{
+				return atan2(v, static_cast<T>(1));
+			}
+
+			// v * 1 / sqrt(v), with the bit trick guess refined by 3 newton iterations: 4e-11 relative, then
+			// rounding. std::sqrt isn't constexpr, and keeps loops scalar for errno unless -fno-math-errno.
+			// v >= 0, 0 gives 0.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T sqrt(T v)
+			{
+				static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double are supported");
+				constexpr T _0_5 = static_cast<T>(0.5);
+				constexpr T _1_5 = static_cast<T>(1.5);
+
+				T r = static_cast<T>(0);
+				if constexpr (sizeof(T) == 4)
+				{
+					r = std::bit_cast<T>(0x5f375a86u - (std::bit_cast<uint32_t>(v) >> 1));
+				}
+				else
+				{
+					r = std::bit_cast<T>(0x5fe6eb50c7b537a9ull - (std::bit_cast<uint64_t>(v) >> 1));
+				}
+				const T halfV = v * _0_5;
+				r = r * (_1_5 - halfV * r * r);
+				r = r * (_1_5 - halfV * r * r);
+				r = r * (_1_5 - halfV * r * r);
+				return v * r;
+			}
+
+			// Abramowitz & Stegun 4.4.46
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T acos(T v)
+			{
+				constexpr T _1 = static_cast<T>(1);
+				constexpr T PI = static_cast<T>(PId);
+
+				MANIMATHS_ASSERT(v >= -_1 && v <= _1);
+				const T a = Math::abs(v);
+				T p = static_cast<T>(-0.0012624911);
+				p = p * a + static_cast<T>(0.0066700901);
+				p = p * a + static_cast<T>(-0.0170881256);
+				p = p * a + static_cast<T>(0.0308918810);
+				p = p * a + static_cast<T>(-0.0501743046);
+				p = p * a + static_cast<T>(0.0889789874);
+				p = p * a + static_cast<T>(-0.2145988016);
+				p = p * a + static_cast<T>(1.5707963050);
+				const T r = fast::sqrt(_1 - a) * p;
+				return select(v < static_cast<T>(0), PI - r, r);
+			}
+
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T asin(T v)
+			{
+				return static_cast<T>(PId / 2.0) - acos(v);
+			}
+
+			// bit trick initial guess refined by 2 newton iterations.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T rsqrt(T v)
+			{
+				static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double are supported");
+				MANIMATHS_ASSERT(v > static_cast<T>(0));
+				constexpr T _0_5 = static_cast<T>(0.5);
+				constexpr T _1_5 = static_cast<T>(1.5);
+
+				T r = static_cast<T>(0);
+				if constexpr (sizeof(T) == 4)
+				{
+					r = std::bit_cast<T>(0x5f375a86u - (std::bit_cast<uint32_t>(v) >> 1));
+				}
+				else
+				{
+					r = std::bit_cast<T>(0x5fe6eb50c7b537a9ull - (std::bit_cast<uint64_t>(v) >> 1));
+				}
+				const T halfV = v * _0_5;
+				r = r * (_1_5 - halfV * r * r);
+				r = r * (_1_5 - halfV * r * r);
+				return r;
+			}
+
+			// 2^n for n in the normal exponent range.
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T exp2i(int32_t n)
+			{
+				static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double are supported");
+				if constexpr (sizeof(T) == 4)
+				{
+					return std::bit_cast<T>(static_cast<uint32_t>(n + 127) << 23);
+				}
+				else
+				{
+					return std::bit_cast<T>(static_cast<uint64_t>(n + 1023) << 52);
+				}
+			}
+
+			// e^v = 2^n * e^r with |r| <= ln(2) / 2
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T exp(T v)
+			{
+				constexpr T LOG2E = static_cast<T>(1.44269504088896341);
+				constexpr T LN2_1 = static_cast<T>(0.693359375);
+				constexpr T LN2_2 = static_cast<T>(-2.12194440e-4);
+
+				// a symmetric clamp is a single comparison, two of them get merged into branches.
+				v = copySign(Math::minT(copySign(v, static_cast<T>(0)), static_cast<T>(87)), v);
+				const int32_t n = roundToInt(v * LOG2E);
+				const T nf = static_cast<T>(n);
+				const T r = (v - nf * LN2_1) - nf * LN2_2;
+
+				T p = static_cast<T>(1.9875691500e-4);
+				p = p * r + static_cast<T>(1.3981999507e-3);
+				p = p * r + static_cast<T>(8.3334519073e-3);
+				p = p * r + static_cast<T>(4.1665795894e-2);
+				p = p * r + static_cast<T>(1.6666665459e-1);
+				p = p * r + static_cast<T>(5.0000001201e-1);
+				const T er = static_cast<T>(1) + r + r * r * p;
+				return er * exp2i<T>(n);
+			}
+
+			// log(v) = e * ln(2) + log(m) with m in [sqrt(2) / 2, sqrt(2)]
+			template<IsFloatingPoint T>
+			[[nodiscard]] constexpr T log(T v)
+			{
+				static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double are supported");
+				MANIMATHS_ASSERT(v > static_cast<T>(0));
+				constexpr T SQRT_HALF = static_cast<T>(0.707106781186547524);
+				constexpr T LN2_1 = static_cast<T>(0.693359375);
+				constexpr T LN2_2 = static_cast<T>(-2.12194440e-4);
+
+				int32_t e = 0;
+				T m = static_cast<T>(0);
+				if constexpr (sizeof(T) == 4)
+				{
+					const uint32_t bits = std::bit_cast<uint32_t>(v);
+					e = static_cast<int32_t>((bits >> 23) & 0xff) - 126;
+					m = std::bit_cast<T>((bits & 0x007fffffu) | 0x3f000000u); // [0.5, 1)
+				}
+				else
+				{
+					const uint64_t bits = std::bit_cast<uint64_t>(v);
+					e = static_cast<int32_t>((bits >> 52) & 0x7ff) - 1022;
+					m = std::bit_cast<T>((bits & 0x000fffffffffffffull) | 0x3fe0000000000000ull);
+				}
+
+				const bool small = m < SQRT_HALF;
+				e = small ? e - 1 : e;
+				const T f = select(small, m + m, m) - static_cast<T>(1);
+				const T f2 = f * f;
+
+				T p = static_cast<T>(7.0376836292e-2);
+				p = p * f + static_cast<T>(-1.1514610310e-1);
+				p = p * f + static_cast<T>(1.1676998740e-1);
+				p = p * f + static_cast<T>(-1.2420140846e-1);
+				p = p * f + static_cast<T>(1.4249322787e-1);
+				p = p * f + static_cast<T>(-1.6668057665e-1);
+				p = p * f + static_cast<T>(2.0000714765e-1);
+				p = p * f + static_cast<T>(-2.4999993993e-1);
+				p = p * f + static_cast<T>(3.3333331174e-1);
+
+				const T ef = static_cast<T>(e);
+				T r = f * f2 * p + ef * LN2_2 - static_cast<T>(0.5) * f2;
+				return f + r + ef * LN2_1;
+			}
+
+			template<IsFloatingPoint T, typename TFunction>
+			void forEach(std::span<const T> in, std::span<T> out, TFunction function)
+			{
+				MANIMATHS_ASSERT(out.size() >= in.size());
+				const T* pIn = in.data();
+				T* pOut = out.data();
+				for (std::size_t i = 0; i < in.size(); ++i)
+				{
+					pOut[i] = function(pIn[i]);
+				}
+			}
+
+			// batch forms, out may be in.
+			inline void sin(std::span<const float> in, std::span<float> out)		{ forEach(in, out, [](float v) { return fast::sin(v); }); }
+			inline void sin(std::span<const double> in, std::span<double> out)		{ forEach(in, out, [](double v) { return fast::sin(v); }); }
+			inline void cos(std::span<const float> in, std::span<float> out)		{ forEach(in, out, [](float v) { return fast::cos(v); }); }
+			inline void cos(std::span<const double> in, std::span<double> out)		{ forEach(in, out, [](double v) { return fast::cos(v); }); }
+			inline void atan(std::span<const float> in, std::span<float> out)		{ forEach(in, out, [](float v) { return fast::atan(v); }); }
+			inline void atan(std::span<const double> in, std::span<double> out)		{ forEach(in, out, [](double v) { return fast::atan(v); }); }
+			inline void acos(std::span<const float> in, std::span<float> out)		{ forEach(in, out, [](float v) { return fast::acos(v); }); }
+			inline void acos(std::span<const double> in, std::span<double> out)		{ forEach(in, out, [](double v) { return fast::acos(v); }); }
+			inline void rsqrt(std::span<const float> in, std::span<float> out)		{ forEach(in, out, [](float v) { return fast::rsqrt(v); }); }
+			inline void rsqrt(std::span<const double> in, std::span<double> out)	{ forEach(in, out, [](double v) { return fast::rsqrt(v); }); }
+			inline void exp(std::span<const float> in, std::span<float> out)		{ forEach(in, out, [](float v) { return fast::exp(v); }); }
+			inline void exp(std::span<const double> in, std::span<double> out)		{ forEach(in, out, [](double v) { return fast::exp(v); }); }
+			inline void log(std::span<const float> in, std::span<float> out)		{ forEach(in, out, [](float v) { return fast::log(v); }); }
+			inline void log(std::span<const double> in, std::span<double> out)		{ forEach(in, out, [](double v) { return fast::log(v); }); }
+
+			template<IsFloatingPoint T>
+			void sincosBatch(std::span<const T> in, std::span<T> outSin, std::span<T> outCos)
+			{
+				MANIMATHS_ASSERT(outSin.size() >= in.size() && outCos.size() >= in.size());
+				const T* pIn = in.data();
+				T* pSin = outSin.data();
+				T* pCos = outCos.data();
+				for (std::size_t i = 0; i < in.size(); ++i)
+				{
+					T s = static_cast<T>(0);
+					T c = static_cast<T>(0);
+					fast::sincos(pIn[i], s, c);
+					pSin[i] = s;
+					pCos[i] = c;
+				}
+			}
+
+			inline void sincos(std::span<const float> in, std::span<float> outSin, std::span<float> outCos)		{ sincosBatch(in, outSin, outCos); }
+			inline void sincos(std::span<const double> in, std::span<double> outSin, std::span<double> outCos)	{ sincosBatch(in, outSin, outCos); }
+
+			template<IsFloatingPoint T>
+			void atan2Batch(std::span<const T> y, std::span<const T> x, std::span<T> out)
+			{
+				MANIMATHS_ASSERT(x.size() == y.size() && out.size() >= y.size());
+				const T* pY = y.data();
+				const T* pX = x.data();
+				T* pOut = out.data();
+				for (std::size_t i = 0; i < y.size(); ++i)
+				{
+					pOut[i] = fast::atan2(pY[i], pX[i]);
+				}
+			}
+
+			inline void atan2(std::span<const float> y, std::span<const float> x, std::span<float> out)		{ atan2Batch(y, x, out); }
+			inline void atan2(std::span<const double> y, std::span<const double> x, std::span<double> out)	{ atan2Batch(y, x, out); }
+		}
+	}
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Simd.h"
+#include "Vec3.h"
+#include "Quat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace Mani
+{
+	// Smallest three quaternion: the largest component is dropped and rebuilt from the unit length, its index takes
+	// 2 bits and the other three, which lie in [-1/sqrt(2), 1/sqrt(2)], are quantized on (Bits - 2) / 3 bits each.
+	// q and -q are the same rotation, the sign is chosen to make the dropped component positive.
+	// quaternions are expected normalized, decoded ones always are.
+	//   32 bits: 10 bits per component, 4 bytes, max error 0.29 degrees.
+	//   48 bits: 15 bits per component, 6 bytes, max error 0.009 degrees.
+	//   64 bits: 20 bits per component, 8 bytes, max error 0.0003 degrees.
+	template<std::size_t Bits>
+	struct PackedQuat
+	{
+		static_assert(Bits == 32 || Bits == 48 || Bits == 64, "smallest three quaternions are packed on 32, 48 or 64 bits");
+
+		static constexpr std::size_t COMPONENT_BITS = (Bits - 2) / 3;
+		static constexpr std::uint64_t COMPONENT_MASK = (std::uint64_t(1) << COMPONENT_BITS) - 1;
+		// highest quantized value, even so that 0 is exact: the identity and axis rotations survive the round trip.
+		static constexpr std::uint64_t COMPONENT_MAX = COMPONENT_MASK - 1;
+		// worst angle in radians between a unit quaternion and its decoded self, with some margin over the
+		// error measured on random rotations.
+		static constexpr double MAX_ANGULAR_ERROR = Bits == 32 ? 5e-3 : Bits == 48 ? 1.6e-4 : 5e-6;
+
+		using Storage = std::conditional_t<Bits == 32, std::uint32_t, std::conditional_t<Bits == 64, std::uint64_t, std::uint16_t[3]>>;
+
+		Storage bits{};
+
+		template<IsFloatingPoint T>
+		[[nodiscard]] static PackedQuat encode(const Quat<T>& q)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _05 = static_cast<T>(.5);
+			constexpr T max = static_cast<T>(COMPONENT_MAX);
+			// [-1/sqrt(2), 1/sqrt(2)] to [0, max]
+			const T scale = max * static_cast<T>(0.70710678118654752440);
+
+			const T components[4] = { q.x, q.y, q.z, q.w };
+			std::uint64_t largest = 0;
+			T largestAbs = Math::abs(components[0]);
+			for (std::uint64_t i = 1; i < 4; ++i)
+			{
+				if (Math::abs(components[i]) > largestAbs)
+				{
+					largestAbs = Math::abs(components[i]);
+					largest = i;
+				}
+			}
+			const T sign = components[largest] < _0 ? -static_cast<T>(1) : static_cast<T>(1);
+
+			std::uint64_t packed = largest;
+			for (std::uint64_t i = 0; i < 4; ++i)
+			{
+				if (i != largest)
+				{
+					const T quantized = std::clamp(components[i] * sign * scale + max * _05, _0, max);
+					packed = (packed << COMPONENT_BITS) | static_cast<std::uint64_t>(quantized + _05);
+				}
+			}
+
+			PackedQuat result;
+			result.setBits(packed);
+			return result;
+		}
+
+		template<IsFloatingPoint T = float>
+		[[nodiscard]] Quat<T> decode() const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			// [0, max] to [-1/sqrt(2), 1/sqrt(2)], centered as integers first so that 0 stays exact.
+			constexpr std::int64_t half = static_cast<std::int64_t>(COMPONENT_MAX / 2);
+			const T scale = static_cast<T>(1.41421356237309504880) / static_cast<T>(COMPONENT_MAX);
+
+			const std::uint64_t packed = getBits();
+			const std::uint64_t largest = (packed >> (3 * COMPONENT_BITS)) & 3;
+			const T a = static_cast<T>(static_cast<std::int64_t>((packed >> (2 * COMPONENT_BITS)) & COMPONENT_MASK) - half) * scale;
+			const T b = static_cast<T>(static_cast<std::int64_t>((packed >> COMPONENT_BITS) & COMPONENT_MASK) - half) * scale;
+			const T c = static_cast<T>(static_cast<std::int64_t>(packed & COMPONENT_MASK) - half) * scale;
+			const T l = Math::sqrt(std::max(_1 - a * a - b * b - c * c, _0));
+			// selects rather than a switch, the largest component is random and a branch on it mispredicts.
+			return {
+				largest == 0 ? l : a,
+				largest == 0 ? a : largest == 1 ? l : b,
+				largest == 3 ? c : largest == 2 ? l : b,
+				largest == 3 ? l : c
+			};
+		}
+
+		// index of the dropped component in the 2 high bits, then the other three in order.
+		[[nodiscard]] constexpr std::uint64_t getBits() const
+		{
+			if constexpr (Bits == 48)
+			{
+				return std::uint64_t(bits[0]) | (std::uint64_t(bits[1]) << 16) | (std::uint64_t(bits[2]) << 32);
+			}
+			else
+			{
+				return bits;
+			}
+		}
+
+		constexpr void setBits(std::uint64_t packed)
+		{
+			if constexpr (Bits == 48)
+			{
+				bits[0] = static_cast<std::uint16_t>(packed);
+				bits[1] = static_cast<std::uint16_t>(packed >> 16);
+				bits[2] = static_cast<std::uint16_t>(packed >> 32);
+			}
+			else
+			{
+				bits = static_cast<Storage>(packed);
+			}
+		}
+
+		[[nodiscard]] constexpr bool operator==(const PackedQuat& other) const
+		{
+			return getBits() == other.getBits();
+		}
+	};
+
+	typedef PackedQuat<32>	PackedQuat32;
+	typedef PackedQuat<48>	PackedQuat48;
+	typedef PackedQuat<64>	PackedQuat64;
+
+	static_assert(sizeof(PackedQuat32) == 4 && sizeof(PackedQuat48) == 6 && sizeof(PackedQuat64) == 8, "packed quaternions have no padding");
+
+	// Octahedral unit vector: the direction is projected on the octahedron |x| + |y| + |z| = 1, whose lower half is
+	// folded over the upper one, leaving 2 coordinates in [-1, 1] quantized on Bits / 2 bits each.
+	// vectors are expected normalized, decoded ones always are, a zero vector decodes as +z.
+	//   16 bits: 8 bits per coordinate, 2 bytes, max error 1.15 degrees.
+	//   32 bits: 16 bits per coordinate, 4 bytes, max error 0.0046 degrees.
+	template<std::size_t Bits>
+	struct PackedNormal
+	{
+		static_assert(Bits == 16 || Bits == 32, "octahedral normals are packed on 16 or 32 bits");
+
+		static constexpr std::size_t COMPONENT_BITS = Bits / 2;
+		static constexpr std::uint32_t COMPONENT_MASK = (std::uint32_t(1) << COMPONENT_BITS) - 1;
+		// highest quantized value, even so that 0 is exact: the axes survive the round trip.
+		static constexpr std::uint32_t COMPONENT_MAX = COMPONENT_MASK - 1;
+		// worst angle in radians between a unit vector and its decoded self, with some margin over the error
+		// measured on random directions.
+		static constexpr double MAX_ANGULAR_ERROR = Bits == 16 ? 2e-2 : 8e-5;
+
+		using Storage = std::conditional_t<Bits == 16, std::uint16_t, std::uint32_t>;
+
+		// x in the low half, y in the high half.
+		Storage bits = 0;
+
+		template<IsFloatingPoint T>
+		[[nodiscard]] static PackedNormal encode(const Vec<T, 3>& v)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _05 = static_cast<T>(.5);
+			constexpr T _1 = static_cast<T>(1);
+			constexpr T max = static_cast<T>(COMPONENT_MAX);
+
+			const T length1 = std::max(Math::abs(v.x) + Math::abs(v.y) + Math::abs(v.z), std::numeric_limits<T>::min());
+			T x = v.x / length1;
+			T y = v.y / length1;
+			if (v.z < _0)
+			{
+				const T foldedX = (_1 - Math::abs(y)) * (x >= _0 ? _1 : -_1);
+				y = (_1 - Math::abs(x)) * (y >= _0 ? _1 : -_1);
+				x = foldedX;
+			}
+
+			const T qx = std::clamp(x * (max * _05) + max * _05, _0, max) + _05;
+			const T qy = std::clamp(y * (max * _05) + max * _05, _0, max) + _05;
+			PackedNormal result;
+			result.bits = static_cast<Storage>(static_cast<std::uint32_t>(qx) | (static_cast<std::uint32_t>(qy) << COMPONENT_BITS));
+			return result;
+		}
+
+		template<IsFloatingPoint T = float>
+		[[nodiscard]] Vec<T, 3> decode() const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			// [0, max] to [-1, 1], centered as integers first so that 0 stays exact.
+			constexpr std::int32_t half = static_cast<std::int32_t>(COMPONENT_MAX / 2);
+			const T scale = static_cast<T>(2) / static_cast<T>(COMPONENT_MAX);
+
+			T x = static_cast<T>(static_cast<std::int32_t>(bits & COMPONENT_MASK) - half) * scale;
+			T y = static_cast<T>(static_cast<std::int32_t>((bits >> COMPONENT_BITS) & COMPONENT_MASK) - half) * scale;
+			const T z = _1 - Math::abs(x) - Math::abs(y);
+			// unfolds the lower half.
+			const T t = std::max(-z, _0);
+			x += x >= _0 ? -t : t;
+			y += y >= _0 ? -t : t;
+			const T invLength = _1 / Math::sqrt(x * x + y * y + z * z);
+			return { x * invLength, y * invLength, z * invLength };
+		}
+
+		[[nodiscard]] constexpr bool operator==(const PackedNormal&) const = default;
+	};
+
+	typedef PackedNormal<16>	PackedNormal16;
+	typedef PackedNormal<32>	PackedNormal32;
+
+	// batches, every quaternion decode and the 32 bits encodes go through SIMD kernels (MANIMATHS_SIMD).
+	// std::sqrt keeps the scalar decode from vectorizing unless errno is disabled. out may not alias in.
+	template<std::size_t Bits>
+	void encode(std::span<const Quat<float>> in, std::span<PackedQuat<Bits>> out)
+	{
+		MANIMATHS_ASSERT(out.size() >= in.size());
+		if (in.empty())
+		{
+			return;
+		}
+		std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (Bits == 32)
+		{
+			i = Simd::smallestThreeEncodeLanes(&in.data()->x, &out.data()->bits, in.size());
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = PackedQuat<Bits>::encode(in[i]);
+		}
+	}
+
+	template<std::size_t Bits>
+	void decode(std::span<const PackedQuat<Bits>> in, std::span<Quat<float>> out)
+	{
+		MANIMATHS_ASSERT(out.size() >= in.size());
+		if (in.empty())
+		{
+			return;
+		}
+		std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (Bits == 32)
+		{
+			i = Simd::smallestThreeDecodeLanes(&in.data()->bits, &out.data()->x, in.size());
+		}
+		else if constexpr (Bits == 64)
+		{
+			i = Simd::smallestThreeDecodeWideLanes<PackedQuat<Bits>::COMPONENT_BITS>(&in.data()->bits, &out.data()->x, in.size());
+		}
+		else
+		{
+			// 6 bytes elements are widened to 8 bytes in blocks first.
+			constexpr std::size_t BLOCK = 64;
+			std::uint64_t widened[BLOCK];
+			while (in.size() - i >= 4)
+			{
+				const std::size_t n = std::min(BLOCK, (in.size() - i) / 4 * 4);
+				for (std::size_t j = 0; j < n; ++j)
+				{
+					widened[j] = in[i + j].getBits();
+				}
+				i += Simd::smallestThreeDecodeWideLanes<PackedQuat<Bits>::COMPONENT_BITS>(widened, &out[i].x, n);
+			}
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = in[i].template decode<float>();
+		}
+	}
+
+	template<std::size_t Bits>
+	void encode(std::span<const Vec<float, 3>> in, std::span<PackedNormal<Bits>> out)
+	{
+		MANIMATHS_ASSERT(out.size() >= in.size());
+		if (in.empty())
+		{
+			return;
+		}
+		std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (Bits == 32)
+		{
+			i = Simd::octahedralEncodeLanes(&in.data()->x, &out.data()->bits, in.size());
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = PackedNormal<Bits>::encode(in[i]);
+		}
+	}
+
+	template<std::size_t Bits>
+	void decode(std::span<const PackedNormal<Bits>> in, std::span<Vec<float, 3>> out)
+	{
+		MANIMATHS_ASSERT(out.size() >= in.size());
+		if (in.empty())
+		{
+			return;
+		}
+		std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_SSE2)
+		if constexpr (Bits == 32)
+		{
+			i = Simd::octahedralDecodeLanes(&in.data()->bits, &out.data()->x, in.size());
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = in[i].template decode<float>();
+		}
+	}
+}
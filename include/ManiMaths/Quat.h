@@ -50,7 +50,7 @@ namespace Mani
 		[[nodiscard]] Quat<T> normalize() const
 		{
 			constexpr T _1 = static_cast<T>(1);
-			const float l = length();
+			const T l = length();
 			if (l > 0)
 			{
 				return *this * (_1 / l);
@@ -104,8 +104,9 @@ namespace Mani
 		[[nodiscard]] static Quat<T> axisAngle(T angle, Vec<T, 3> axis)
 		{
 			constexpr T _0_5 = static_cast<T>(0.5);
-			const T sinHalfAngle = Math::sin(angle * _0_5);
-			const T cosHalfAngle = Math::cos(angle * _0_5);
+			T sinHalfAngle;
+			T cosHalfAngle;
+			Math::sincos(angle * _0_5, sinHalfAngle, cosHalfAngle);
 			return {
 				axis.x * sinHalfAngle,
 				axis.y * sinHalfAngle,
@@ -215,6 +216,7 @@ namespace Mani
 
 	typedef Quat<float> Quatf;
 	typedef Quat<double> Quatd;
+	typedef Quat<Fixed16_16> Quatx;
 
 	template<IsNumeric T>
 	[[nodiscard]] Mat<T, 3, 3> toMat3(const Quat<T>& q)
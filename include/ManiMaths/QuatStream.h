@@ -0,0 +1,227 @@
+#pragma once
+
+#include "_Aligned.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Simd.h"
+#include "Quat.h"
+#include <span>
+#include <vector>
+
+namespace Mani
+{
+	namespace Scalar
+	{
+		// reference for the batched blends, branch free and always along the shortest path, unlike Quat<T>::slerp.
+		// t is expected in [0, 1].
+		template<QuatBlend Blend, IsNumeric T>
+		[[nodiscard]] Quat<T> quatBlend(const Quat<T>& q1, const Quat<T>& q2, T t)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			constexpr T _0_5 = static_cast<T>(0.5);
+			constexpr T epsilon = static_cast<T>(0.001);
+
+			const T dot = q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+			const T sign = dot < _0 ? -_1 : _1;
+			const T cosTheta = Math::minT(dot * sign, _1);
+
+			T ta;
+			T tb;
+			if constexpr (Blend == QuatBlend::Slerp)
+			{
+				const T theta = Math::acos(cosTheta);
+				const T sinTheta = Math::sqrt(_1 - cosTheta * cosTheta);
+				const bool nearlyParallel = sinTheta < epsilon;
+				const T invSinTheta = nearlyParallel ? _1 : _1 / sinTheta;
+				ta = nearlyParallel ? _1 - t : Math::sin((_1 - t) * theta) * invSinTheta;
+				tb = nearlyParallel ? t : Math::sin(t * theta) * invSinTheta;
+			}
+			else
+			{
+				if constexpr (Blend == QuatBlend::FastSlerp)
+				{
+					// https://zeux.io/2015/07/23/approximating-slerp/
+					const T d = cosTheta;
+					const T a = static_cast<T>(1.0904) + d * (static_cast<T>(-3.2452) + d * (static_cast<T>(3.55645) - d * static_cast<T>(1.43519)));
+					const T b = static_cast<T>(0.848013) + d * (static_cast<T>(-1.06021) + d * static_cast<T>(0.215638));
+					const T k = a * (t - _0_5) * (t - _0_5) + b;
+					t = t + t * (t - _0_5) * (t - _1) * k;
+				}
+				ta = _1 - t;
+				tb = t;
+			}
+			tb *= sign;
+
+			Quat<T> result = {
+				q1.x * ta + q2.x * tb,
+				q1.y * ta + q2.y * tb,
+				q1.z * ta + q2.z * tb,
+				q1.w * ta + q2.w * tb,
+			};
+
+			if constexpr (Blend != QuatBlend::Slerp)
+			{
+				const T invLength = _1 / Math::sqrt(result.x * result.x + result.y * result.y + result.z * result.z + result.w * result.w);
+				result = result * invLength;
+			}
+			return result;
+		}
+	}
+
+	// Structure of arrays container for Quat<T>, meant for animation sampling where thousands of rotations
+	// are blended per frame. Interpolations are branch free and go through the SIMD kernels for float.
+	template<IsNumeric T>
+	struct QuatStream
+	{
+		using Array = std::vector<T, AlignedAllocator<T>>;
+
+		Array x;
+		Array y;
+		Array z;
+		Array w;
+
+		[[nodiscard]] static QuatStream<T> make(std::size_t size)
+		{
+			QuatStream<T> stream;
+			stream.resize(size);
+			return stream;
+		}
+
+		[[nodiscard]] static QuatStream<T> make(std::span<const Quat<T>> values)
+		{
+			QuatStream<T> stream;
+			stream.gather(values);
+			return stream;
+		}
+
+		[[nodiscard]] std::size_t size() const
+		{
+			return x.size();
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return x.empty();
+		}
+
+		void resize(std::size_t size)
+		{
+			x.resize(size);
+			y.resize(size);
+			z.resize(size);
+			w.resize(size);
+		}
+
+		[[nodiscard]] Quat<T> get(std::size_t i) const
+		{
+			MANIMATHS_ASSERT(i < size());
+			return { x[i], y[i], z[i], w[i] };
+		}
+
+		void set(std::size_t i, const Quat<T>& q)
+		{
+			MANIMATHS_ASSERT(i < size());
+			x[i] = q.x;
+			y[i] = q.y;
+			z[i] = q.z;
+			w[i] = q.w;
+		}
+
+		// AoS -> SoA, resizes the stream to match values.
+		void gather(std::span<const Quat<T>> values)
+		{
+			resize(values.size());
+			for (std::size_t i = 0; i < values.size(); ++i)
+			{
+				x[i] = values[i].x;
+				y[i] = values[i].y;
+				z[i] = values[i].z;
+				w[i] = values[i].w;
+			}
+		}
+
+		// SoA -> AoS, out must be as large as the stream.
+		void scatter(std::span<Quat<T>> out) const
+		{
+			MANIMATHS_ASSERT(out.size() >= size());
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				out[i] = { x[i], y[i], z[i], w[i] };
+			}
+		}
+
+		// out[i] = slerp(q1[i], q2[i], t[i]) along the shortest path, t in [0, 1]. out may be q1 or q2.
+		static void slerp(const QuatStream<T>& q1, const QuatStream<T>& q2, std::span<const T> t, QuatStream<T>& out)
+		{
+			blend<QuatBlend::Slerp>(q1, q2, t, out);
+		}
+
+		static void slerp(const QuatStream<T>& q1, const QuatStream<T>& q2, T t, QuatStream<T>& out)
+		{
+			blend<QuatBlend::Slerp>(q1, q2, t, out);
+		}
+
+		// normalized lerp along the shortest path.
+		static void nlerp(const QuatStream<T>& q1, const QuatStream<T>& q2, std::span<const T> t, QuatStream<T>& out)
+		{
+			blend<QuatBlend::Nlerp>(q1, q2, t, out);
+		}
+
+		static void nlerp(const QuatStream<T>& q1, const QuatStream<T>& q2, T t, QuatStream<T>& out)
+		{
+			blend<QuatBlend::Nlerp>(q1, q2, t, out);
+		}
+
+		// nlerp with a corrected t, within ~1e-3 radians of slerp at the cost of an nlerp.
+		static void fastSlerp(const QuatStream<T>& q1, const QuatStream<T>& q2, std::span<const T> t, QuatStream<T>& out)
+		{
+			blend<QuatBlend::FastSlerp>(q1, q2, t, out);
+		}
+
+		static void fastSlerp(const QuatStream<T>& q1, const QuatStream<T>& q2, T t, QuatStream<T>& out)
+		{
+			blend<QuatBlend::FastSlerp>(q1, q2, t, out);
+		}
+
+		template<QuatBlend Blend>
+		static void blend(const QuatStream<T>& q1, const QuatStream<T>& q2, std::span<const T> t, QuatStream<T>& out)
+		{
+			MANIMATHS_ASSERT(t.size() >= q1.size());
+			blend<Blend, false>(q1, q2, t.data(), out);
+		}
+
+		template<QuatBlend Blend>
+		static void blend(const QuatStream<T>& q1, const QuatStream<T>& q2, T t, QuatStream<T>& out)
+		{
+			blend<Blend, true>(q1, q2, &t, out);
+		}
+
+	private:
+		template<QuatBlend Blend, bool SharedT>
+		static void blend(const QuatStream<T>& q1, const QuatStream<T>& q2, const T* t, QuatStream<T>& out)
+		{
+			MANIMATHS_ASSERT(q1.size() == q2.size());
+			const std::size_t n = q1.size();
+			out.resize(n);
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				const float* const pq1[4] = { q1.x.data(), q1.y.data(), q1.z.data(), q1.w.data() };
+				const float* const pq2[4] = { q2.x.data(), q2.y.data(), q2.z.data(), q2.w.data() };
+				float* const pOut[4] = { out.x.data(), out.y.data(), out.z.data(), out.w.data() };
+				Simd::quatBlend<Blend, SharedT>(pq1, pq2, t, pOut, n);
+				return;
+			}
+#endif
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				out.set(i, Scalar::quatBlend<Blend>(q1.get(i), q2.get(i), SharedT ? *t : t[i]));
+			}
+		}
+	};
+
+	typedef QuatStream<float>	QuatfStream;
+	typedef QuatStream<double>	QuatdStream;
+}
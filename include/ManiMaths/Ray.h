@@ -0,0 +1,314 @@
+#pragma once
+
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Vec3.h"
+#include "Vec4.h"
+#include "AABB.h"
+#include "Simd.h"
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace Mani
+{
+	// Half line origin + t * direction, t >= 0.
+	// The inverse direction is cached for the slab tests run against every box of a traversal.
+	template<IsNumeric T>
+	struct Ray
+	{
+		Vec<T, 3> origin;
+		Vec<T, 3> direction;
+		Vec<T, 3> invDirection;
+
+		// direction doesn't need to be normalized, hit distances are then in units of its length.
+		[[nodiscard]] static Ray<T> make(const Vec<T, 3>& origin, const Vec<T, 3>& direction)
+		{
+			return { origin, direction, { inverse(direction.x), inverse(direction.y), inverse(direction.z) } };
+		}
+
+		[[nodiscard]] static Ray<T> fromPoints(const Vec<T, 3>& from, const Vec<T, 3>& to)
+		{
+			return make(from, (to - from).normalize());
+		}
+
+		[[nodiscard]] constexpr Vec<T, 3> at(T t) const
+		{
+			return origin + direction * t;
+		}
+
+		// slab test, tNear is the entry distance clamped to 0 when the origin is inside the box.
+		[[nodiscard]] bool intersectsAABB(const AABB<T>& box, T tMax, T& tNear) const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			const T tx0 = (box.min.x - origin.x) * invDirection.x;
+			const T tx1 = (box.max.x - origin.x) * invDirection.x;
+			const T ty0 = (box.min.y - origin.y) * invDirection.y;
+			const T ty1 = (box.max.y - origin.y) * invDirection.y;
+			const T tz0 = (box.min.z - origin.z) * invDirection.z;
+			const T tz1 = (box.max.z - origin.z) * invDirection.z;
+
+			const T tEnter = Math::maxT(Math::maxT(Math::minT(tx0, tx1), Math::minT(ty0, ty1)), Math::maxT(Math::minT(tz0, tz1), _0));
+			const T tExit = Math::minT(Math::minT(Math::maxT(tx0, tx1), Math::maxT(ty0, ty1)), Math::minT(Math::maxT(tz0, tz1), tMax));
+			tNear = tEnter;
+			return tEnter <= tExit;
+		}
+
+		[[nodiscard]] bool intersectsAABB(const AABB<T>& box, T tMax = std::numeric_limits<T>::max()) const
+		{
+			T tNear;
+			return intersectsAABB(box, tMax, tNear);
+		}
+
+		// Moller-Trumbore, both faces are hit. on hit, t is the distance and (u, v) the barycentrics of v1 and v2.
+		// https://cadxfem.org/inf/Fast%20MinimumStorage%20RayTriangle%20Intersection.pdf
+		[[nodiscard]] bool intersectTriangle(const Vec<T, 3>& v0, const Vec<T, 3>& v1, const Vec<T, 3>& v2, T& t, T& u, T& v) const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+
+			const Vec<T, 3> edge1 = v1 - v0;
+			const Vec<T, 3> edge2 = v2 - v0;
+			const Vec<T, 3> p = direction.cross(edge2);
+			const T det = edge1.dot(p);
+			if (det == _0)
+			{
+				// parallel to the triangle plane.
+				return false;
+			}
+
+			const T invDet = _1 / det;
+			const Vec<T, 3> s = origin - v0;
+			u = s.dot(p) * invDet;
+			if (u < _0 || u > _1)
+			{
+				return false;
+			}
+
+			const Vec<T, 3> q = s.cross(edge1);
+			v = direction.dot(q) * invDet;
+			if (v < _0 || u + v > _1)
+			{
+				return false;
+			}
+
+			t = edge2.dot(q) * invDet;
+			return t >= _0;
+		}
+
+		// nearest non negative hit, rays starting inside the sphere hit its far side.
+		[[nodiscard]] bool intersectSphere(const Vec<T, 3>& center, T radius, T& t) const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			const Vec<T, 3> oc = origin - center;
+			const T a = direction.dot(direction);
+			const T b = direction.dot(oc);
+			const T c = oc.dot(oc) - radius * radius;
+			const T discriminant = b * b - a * c;
+			if (discriminant < _0)
+			{
+				return false;
+			}
+
+			const T root = Math::sqrt(discriminant);
+			const T tNear = (-b - root) / a;
+			t = tNear >= _0 ? tNear : (root - b) / a;
+			return t >= _0;
+		}
+
+		// plane (nx, ny, nz, d) with n.p + d = 0 on the plane, as stored by Frustum. both sides are hit.
+		[[nodiscard]] bool intersectPlane(const Vec<T, 4>& plane, T& t) const
+		{
+			constexpr T _0 = static_cast<T>(0);
+			const T denominator = plane.x * direction.x + plane.y * direction.y + plane.z * direction.z;
+			if (denominator == _0)
+			{
+				return false;
+			}
+			t = -(plane.x * origin.x + plane.y * origin.y + plane.z * origin.z + plane.w) / denominator;
+			return t >= _0;
+		}
+
+		[[nodiscard]] std::string toString() const
+		{
+			return std::format("Ray(origin: {}, direction: {})", origin.toString(), direction.toString());
+		}
+
+	private:
+		// axis parallel components get a huge but finite inverse: an infinite one gives 0 * inf = NaN in the
+		// slab test for rays lying in a box face plane, e.g. along the shared edges of a grid mesh.
+		[[nodiscard]] static T inverse(T v)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			constexpr T tiny = std::numeric_limits<T>::min();
+			return _1 / (v != _0 ? v : (std::signbit(v) ? -tiny : tiny));
+		}
+	};
+
+	// Width rays stored as structure of arrays, tested together against one primitive.
+	// Coherent rays (lightmap texels, pixel tiles, shadow rays to one light) share most of their traversal,
+	// a packet pays for each primitive load and setup once for all its rays.
+	// float packets run one SIMD lane per ray, tests return one hit bit per ray, ray i in bit i, and write
+	// per ray results whether they hit or not.
+	template<IsNumeric T, std::size_t Width>
+	struct RayPacket
+	{
+		static_assert(Width == 4 || Width == 8, "packets are 4 or 8 rays wide");
+		static constexpr std::size_t WIDTH = Width;
+		static constexpr unsigned ALL_RAYS = (1u << Width) - 1;
+
+		// contiguous, the SIMD kernels address the 9 rows from origin.
+		alignas(32) T origin[3][Width];
+		T direction[3][Width];
+		T invDirection[3][Width];
+
+		// lanes past rays.size() repeat the first ray, mask them out of the results.
+		[[nodiscard]] static RayPacket<T, Width> make(std::span<const Ray<T>> rays)
+		{
+			MANIMATHS_ASSERT(!rays.empty() && rays.size() <= Width);
+			RayPacket<T, Width> packet;
+			for (std::size_t i = 0; i < Width; ++i)
+			{
+				packet.set(i, rays[i < rays.size() ? i : 0]);
+			}
+			return packet;
+		}
+
+		void set(std::size_t i, const Ray<T>& ray)
+		{
+			MANIMATHS_ASSERT(i < Width);
+			const T* o = &ray.origin.x;
+			const T* d = &ray.direction.x;
+			const T* inv = &ray.invDirection.x;
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				origin[k][i] = o[k];
+				direction[k][i] = d[k];
+				invDirection[k][i] = inv[k];
+			}
+		}
+
+		[[nodiscard]] Ray<T> get(std::size_t i) const
+		{
+			MANIMATHS_ASSERT(i < Width);
+			return {
+				{ origin[0][i], origin[1][i], origin[2][i] },
+				{ direction[0][i], direction[1][i], direction[2][i] },
+				{ invDirection[0][i], invDirection[1][i], invDirection[2][i] }
+			};
+		}
+
+		unsigned intersectTriangle(const Vec<T, 3>& v0, const Vec<T, 3>& v1, const Vec<T, 3>& v2, T t[Width], T u[Width], T v[Width]) const
+		{
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return forLanes([&]<typename L>(L, std::size_t offset)
+				{
+					return Simd::rayTriangleLanes<L>(&origin[0][0], Width, offset, &v0.x, &v1.x, &v2.x, t + offset, u + offset, v + offset);
+				});
+			}
+#endif
+			unsigned mask = 0;
+			for (std::size_t i = 0; i < Width; ++i)
+			{
+				mask |= static_cast<unsigned>(get(i).intersectTriangle(v0, v1, v2, t[i], u[i], v[i])) << i;
+			}
+			return mask;
+		}
+
+		// tMax holds one limit per ray.
+		unsigned intersectAABB(const AABB<T>& box, const T tMax[Width], T tNear[Width]) const
+		{
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return forLanes([&]<typename L>(L, std::size_t offset)
+				{
+					return Simd::rayAABBLanes<L>(&origin[0][0], Width, offset, &box.min.x, &box.max.x, tMax + offset, tNear + offset);
+				});
+			}
+#endif
+			unsigned mask = 0;
+			for (std::size_t i = 0; i < Width; ++i)
+			{
+				mask |= static_cast<unsigned>(get(i).intersectsAABB(box, tMax[i], tNear[i])) << i;
+			}
+			return mask;
+		}
+
+		unsigned intersectSphere(const Vec<T, 3>& center, T radius, T t[Width]) const
+		{
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return forLanes([&]<typename L>(L, std::size_t offset)
+				{
+					return Simd::raySphereLanes<L>(&origin[0][0], Width, offset, &center.x, radius, t + offset);
+				});
+			}
+#endif
+			unsigned mask = 0;
+			for (std::size_t i = 0; i < Width; ++i)
+			{
+				mask |= static_cast<unsigned>(get(i).intersectSphere(center, radius, t[i])) << i;
+			}
+			return mask;
+		}
+
+		unsigned intersectPlane(const Vec<T, 4>& plane, T t[Width]) const
+		{
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return forLanes([&]<typename L>(L, std::size_t offset)
+				{
+					return Simd::rayPlaneLanes<L>(&origin[0][0], Width, offset, &plane.x, t + offset);
+				});
+			}
+#endif
+			unsigned mask = 0;
+			for (std::size_t i = 0; i < Width; ++i)
+			{
+				mask |= static_cast<unsigned>(get(i).intersectPlane(plane, t[i])) << i;
+			}
+			return mask;
+		}
+
+	private:
+#if defined(MANIMATHS_SIMD_SSE2)
+		// runs kernel(Lanes, offset) over the packet: a single 8 lanes group with AVX, 4 lanes groups otherwise.
+		template<typename TKernel>
+		static unsigned forLanes(TKernel&& kernel)
+		{
+#if defined(MANIMATHS_SIMD_AVX)
+			if constexpr (Width == 8)
+			{
+				return kernel(Simd::Lanes8{}, 0);
+			}
+#endif
+			unsigned mask = 0;
+			for (std::size_t offset = 0; offset < Width; offset += 4)
+			{
+				mask |= kernel(Simd::Lanes4{}, offset) << offset;
+			}
+			return mask;
+		}
+#endif
+	};
+
+	typedef Ray<float>	Rayf;
+	typedef Ray<double>	Rayd;
+
+	typedef RayPacket<float, 4>		RayPacket4f;
+	typedef RayPacket<float, 8>		RayPacket8f;
+	typedef RayPacket<double, 4>	RayPacket4d;
+
+	static_assert(offsetof(RayPacket4f, direction) == 3 * 4 * sizeof(float));
+}
@@ -0,0 +1,1149 @@
+#pragma once
+
+// SIMD kernels are opt-in: define MANIMATHS_SIMD to enable them.
+// SSE2 is the baseline, AVX and FMA are picked up when the compiler targets them.
+// If MANIMATHS_SIMD isn't defined, or the target lacks SSE2, the scalar paths are used.
+#if defined(MANIMATHS_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define MANIMATHS_SIMD_SSE2
+		#include <emmintrin.h>
+	#endif
+
+	#if defined(MANIMATHS_SIMD_SSE2) && defined(__AVX__)
+		#define MANIMATHS_SIMD_AVX
+		#include <immintrin.h>
+	#endif
+
+	// msvc doesn't define __FMA__, but /arch:AVX2 implies it.
+	#if defined(MANIMATHS_SIMD_AVX) && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+		#define MANIMATHS_SIMD_FMA
+	#endif
+
+	// float <-> half conversions, same as FMA for msvc.
+	#if defined(MANIMATHS_SIMD_AVX) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+		#define MANIMATHS_SIMD_F16C
+	#endif
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Mani
+{
+	// quaternion interpolation flavours of the batched blends.
+	enum class QuatBlend
+	{
+		// exact spherical interpolation, constant angular velocity.
+		Slerp,
+		// normalized lerp, cheapest but the angular velocity isn't constant.
+		Nlerp,
+		// normalized lerp with t remapped by a polynomial fit, close to slerp for the cost of an nlerp.
+		FastSlerp
+	};
+
+	// volume layouts of the batched frustum tests.
+	enum class FrustumVolume
+	{
+		// x, y, z centers and r radii.
+		Sphere,
+		// x, y, z centers and r, s, t half extents.
+		CenterExtents,
+		// x, y, z mins and r, s, t maxs.
+		MinMax
+	};
+
+	namespace Simd
+	{
+#if defined(MANIMATHS_SIMD_SSE2)
+		// a * b + c
+		inline __m128 mulAdd(__m128 a, __m128 b, __m128 c)
+		{
+#if defined(MANIMATHS_SIMD_FMA)
+			return _mm_fmadd_ps(a, b, c);
+#else
+			return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+		}
+
+		template<int I>
+		inline __m128 splat(__m128 v)
+		{
+			return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+		}
+
+#if defined(MANIMATHS_SIMD_AVX)
+		// a * b + c
+		inline __m256 mulAdd(__m256 a, __m256 b, __m256 c)
+		{
+#if defined(MANIMATHS_SIMD_FMA)
+			return _mm256_fmadd_ps(a, b, c);
+#else
+			return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+		}
+#endif
+
+		// 4x4 product over 16 contiguous floats, matrices are stored line by line where each line is a column.
+		// out line j = lhs line 0 * rhs[j][0] + lhs line 1 * rhs[j][1] + lhs line 2 * rhs[j][2] + lhs line 3 * rhs[j][3]
+		// out may alias lhs or rhs.
+		inline void mat4Mul(const float* lhs, const float* rhs, float* out)
+		{
+#if defined(MANIMATHS_SIMD_AVX)
+			// lhs lines duplicated in both 128 bit lanes, two output lines per iteration.
+			const __m256 l0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 0));
+			const __m256 l1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 4));
+			const __m256 l2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 8));
+			const __m256 l3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 12));
+
+			const __m256 r01 = _mm256_loadu_ps(rhs + 0);
+			const __m256 r23 = _mm256_loadu_ps(rhs + 8);
+
+			__m256 o01 = _mm256_mul_ps(l0, _mm256_permute_ps(r01, 0x00));
+			o01 = mulAdd(l1, _mm256_permute_ps(r01, 0x55), o01);
+			o01 = mulAdd(l2, _mm256_permute_ps(r01, 0xAA), o01);
+			o01 = mulAdd(l3, _mm256_permute_ps(r01, 0xFF), o01);
+
+			__m256 o23 = _mm256_mul_ps(l0, _mm256_permute_ps(r23, 0x00));
+			o23 = mulAdd(l1, _mm256_permute_ps(r23, 0x55), o23);
+			o23 = mulAdd(l2, _mm256_permute_ps(r23, 0xAA), o23);
+			o23 = mulAdd(l3, _mm256_permute_ps(r23, 0xFF), o23);
+
+			_mm256_storeu_ps(out + 0, o01);
+			_mm256_storeu_ps(out + 8, o23);
+#else
+			const __m128 l0 = _mm_loadu_ps(lhs + 0);
+			const __m128 l1 = _mm_loadu_ps(lhs + 4);
+			const __m128 l2 = _mm_loadu_ps(lhs + 8);
+			const __m128 l3 = _mm_loadu_ps(lhs + 12);
+
+			for (int j = 0; j < 4; ++j)
+			{
+				const __m128 r = _mm_loadu_ps(rhs + j * 4);
+				__m128 o = _mm_mul_ps(l0, splat<0>(r));
+				o = mulAdd(l1, splat<1>(r), o);
+				o = mulAdd(l2, splat<2>(r), o);
+				o = mulAdd(l3, splat<3>(r), o);
+				_mm_storeu_ps(out + j * 4, o);
+			}
+#endif
+		}
+
+		// 3x4 affine product over 12 contiguous floats, 4 columns of 3 with an implicit (0, 0, 0, 1) last row.
+		// out column j = lhs column 0 * rhs[j][0] + lhs column 1 * rhs[j][1] + lhs column 2 * rhs[j][2] (+ lhs column 3 for j = 3)
+		// out may alias lhs or rhs.
+		inline void affine3Mul(const float* lhs, const float* rhs, float* out)
+		{
+			// 4 wide loads of the first 3 columns pick up the next column's first float, it only ends up in the unused lane.
+			const __m128 l0 = _mm_loadu_ps(lhs + 0);
+			const __m128 l1 = _mm_loadu_ps(lhs + 3);
+			const __m128 l2 = _mm_loadu_ps(lhs + 6);
+			const __m128 l3 = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(lhs + 9)), _mm_load_ss(lhs + 11));
+
+			const __m128 r0 = _mm_loadu_ps(rhs + 0);
+			const __m128 r1 = _mm_loadu_ps(rhs + 3);
+			const __m128 r2 = _mm_loadu_ps(rhs + 6);
+			const __m128 r3 = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(rhs + 9)), _mm_load_ss(rhs + 11));
+
+			const __m128 o0 = mulAdd(l2, splat<2>(r0), mulAdd(l1, splat<1>(r0), _mm_mul_ps(l0, splat<0>(r0))));
+			const __m128 o1 = mulAdd(l2, splat<2>(r1), mulAdd(l1, splat<1>(r1), _mm_mul_ps(l0, splat<0>(r1))));
+			const __m128 o2 = mulAdd(l2, splat<2>(r2), mulAdd(l1, splat<1>(r2), _mm_mul_ps(l0, splat<0>(r2))));
+			const __m128 o3 = mulAdd(l2, splat<2>(r3), mulAdd(l1, splat<1>(r3), mulAdd(l0, splat<0>(r3), l3)));
+
+			// packed back into 3 non overlapping stores, overlapping ones would defeat store forwarding on the next read.
+			const __m128 o0z1x = _mm_shuffle_ps(o0, o1, _MM_SHUFFLE(0, 0, 2, 2));
+			const __m128 o2z3x = _mm_shuffle_ps(o2, o3, _MM_SHUFFLE(0, 0, 2, 2));
+			_mm_storeu_ps(out + 0, _mm_shuffle_ps(o0, o0z1x, _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(out + 4, _mm_shuffle_ps(o1, o2, _MM_SHUFFLE(1, 0, 2, 1)));
+			_mm_storeu_ps(out + 8, _mm_shuffle_ps(o2z3x, o3, _MM_SHUFFLE(2, 1, 2, 0)));
+		}
+
+		// inverse of a rotation + translation 4x4 (16 floats, column lines): transposed rotation, translation = -R^T t.
+		// out may alias m.
+		inline void mat4InverseRigid(const float* m, float* out)
+		{
+			__m128 c0 = _mm_loadu_ps(m + 0);
+			__m128 c1 = _mm_loadu_ps(m + 4);
+			__m128 c2 = _mm_loadu_ps(m + 8);
+			const __m128 t = _mm_loadu_ps(m + 12);
+			__m128 c3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			__m128 r = _mm_mul_ps(c0, splat<0>(t));
+			r = mulAdd(c1, splat<1>(t), r);
+			r = mulAdd(c2, splat<2>(t), r);
+			// -r with w = 1
+			const __m128 translation = _mm_sub_ps(_mm_set_ps(1.f, 0.f, 0.f, 0.f), r);
+
+			_mm_storeu_ps(out + 0, c0);
+			_mm_storeu_ps(out + 4, c1);
+			_mm_storeu_ps(out + 8, c2);
+			_mm_storeu_ps(out + 12, translation);
+		}
+
+		// (a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x, 0) when a.w and b.w are 0.
+		inline __m128 cross3(__m128 a, __m128 b)
+		{
+			const __m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+			return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+		}
+
+		// inverse of an affine 4x4 (16 floats, column lines, last row 0 0 0 1). the 3x3 inverse rows are
+		// the cross products of the columns over the determinant. out may alias m.
+		inline void mat4InverseAffine(const float* m, float* out)
+		{
+			const __m128 c0 = _mm_loadu_ps(m + 0);
+			const __m128 c1 = _mm_loadu_ps(m + 4);
+			const __m128 c2 = _mm_loadu_ps(m + 8);
+			const __m128 t = _mm_loadu_ps(m + 12);
+
+			__m128 r0 = cross3(c1, c2);
+			__m128 r1 = cross3(c2, c0);
+			__m128 r2 = cross3(c0, c1);
+
+			// det = c0 . (c1 x c2), summed across the lanes.
+			__m128 det = _mm_mul_ps(c0, r0);
+			det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+			det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+			const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+			r0 = _mm_mul_ps(r0, invDet);
+			r1 = _mm_mul_ps(r1, invDet);
+			r2 = _mm_mul_ps(r2, invDet);
+
+			__m128 r3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			__m128 r = _mm_mul_ps(r0, splat<0>(t));
+			r = mulAdd(r1, splat<1>(t), r);
+			r = mulAdd(r2, splat<2>(t), r);
+			const __m128 translation = _mm_sub_ps(_mm_set_ps(1.f, 0.f, 0.f, 0.f), r);
+
+			_mm_storeu_ps(out + 0, r0);
+			_mm_storeu_ps(out + 4, r1);
+			_mm_storeu_ps(out + 8, r2);
+			_mm_storeu_ps(out + 12, translation);
+		}
+
+		// out[i] = |(x[i], y[i], z[i])| over n structure of arrays elements.
+		inline void length3(const float* x, const float* y, const float* z, float* out, std::size_t n)
+		{
+			std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_AVX)
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m256 vx = _mm256_loadu_ps(x + i);
+				const __m256 vy = _mm256_loadu_ps(y + i);
+				const __m256 vz = _mm256_loadu_ps(z + i);
+				const __m256 l2 = mulAdd(vz, vz, mulAdd(vy, vy, _mm256_mul_ps(vx, vx)));
+				_mm256_storeu_ps(out + i, _mm256_sqrt_ps(l2));
+			}
+#endif
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 vx = _mm_loadu_ps(x + i);
+				const __m128 vy = _mm_loadu_ps(y + i);
+				const __m128 vz = _mm_loadu_ps(z + i);
+				const __m128 l2 = mulAdd(vz, vz, mulAdd(vy, vy, _mm_mul_ps(vx, vx)));
+				_mm_storeu_ps(out + i, _mm_sqrt_ps(l2));
+			}
+			for (; i < n; ++i)
+			{
+				out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+			}
+		}
+
+		// same semantic as Vec<T, 3>::normalize, zero length vectors are left untouched.
+		// out arrays may alias the input arrays.
+		inline void normalize3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, std::size_t n)
+		{
+			std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_AVX)
+			const __m256 one8 = _mm256_set1_ps(1.f);
+			const __m256 zero8 = _mm256_setzero_ps();
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m256 vx = _mm256_loadu_ps(x + i);
+				const __m256 vy = _mm256_loadu_ps(y + i);
+				const __m256 vz = _mm256_loadu_ps(z + i);
+				const __m256 l = _mm256_sqrt_ps(mulAdd(vz, vz, mulAdd(vy, vy, _mm256_mul_ps(vx, vx))));
+				const __m256 mask = _mm256_cmp_ps(l, zero8, _CMP_GT_OQ);
+				// 1 where the length is zero, so that the vector is multiplied by one.
+				const __m256 invL = _mm256_blendv_ps(one8, _mm256_div_ps(one8, l), mask);
+				_mm256_storeu_ps(outX + i, _mm256_mul_ps(vx, invL));
+				_mm256_storeu_ps(outY + i, _mm256_mul_ps(vy, invL));
+				_mm256_storeu_ps(outZ + i, _mm256_mul_ps(vz, invL));
+			}
+#endif
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 zero = _mm_setzero_ps();
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 vx = _mm_loadu_ps(x + i);
+				const __m128 vy = _mm_loadu_ps(y + i);
+				const __m128 vz = _mm_loadu_ps(z + i);
+				const __m128 l = _mm_sqrt_ps(mulAdd(vz, vz, mulAdd(vy, vy, _mm_mul_ps(vx, vx))));
+				const __m128 mask = _mm_cmpgt_ps(l, zero);
+				const __m128 invL = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(one, l)), _mm_andnot_ps(mask, one));
+				_mm_storeu_ps(outX + i, _mm_mul_ps(vx, invL));
+				_mm_storeu_ps(outY + i, _mm_mul_ps(vy, invL));
+				_mm_storeu_ps(outZ + i, _mm_mul_ps(vz, invL));
+			}
+			for (; i < n; ++i)
+			{
+				const float l = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+				const float invL = l > 0.f ? 1.f / l : 1.f;
+				outX[i] = x[i] * invL;
+				outY[i] = y[i] * invL;
+				outZ[i] = z[i] * invL;
+			}
+		}
+
+		// transforms n Vec3 (3 contiguous floats each) by the 4x4 matrix m.
+		// IsPoint adds the translation (w = 1), Divide divides the result by its w component.
+		// out may alias in.
+		template<bool IsPoint, bool Divide>
+		inline void transform3(const float* m, const float* in, float* out, std::size_t n)
+		{
+			const __m128 c0 = _mm_loadu_ps(m + 0);
+			const __m128 c1 = _mm_loadu_ps(m + 4);
+			const __m128 c2 = _mm_loadu_ps(m + 8);
+			const __m128 c3 = _mm_loadu_ps(m + 12);
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const float* v = in + i * 3;
+				__m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+				r = mulAdd(c1, _mm_set1_ps(v[1]), r);
+				r = mulAdd(c2, _mm_set1_ps(v[2]), r);
+				if constexpr (IsPoint)
+				{
+					r = _mm_add_ps(r, c3);
+				}
+				if constexpr (Divide)
+				{
+					r = _mm_div_ps(r, splat<3>(r));
+				}
+
+				// 3 floats only, a 4 wide store would clobber the next element.
+				float* o = out + i * 3;
+				_mm_storel_pi(reinterpret_cast<__m64*>(o), r);
+				_mm_store_ss(o + 2, _mm_movehl_ps(r, r));
+			}
+		}
+
+		// transforms n Vec4 (4 contiguous floats each) by the 4x4 matrix m. out may alias in.
+		inline void transform4(const float* m, const float* in, float* out, std::size_t n)
+		{
+			const __m128 c0 = _mm_loadu_ps(m + 0);
+			const __m128 c1 = _mm_loadu_ps(m + 4);
+			const __m128 c2 = _mm_loadu_ps(m + 8);
+			const __m128 c3 = _mm_loadu_ps(m + 12);
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const __m128 v = _mm_loadu_ps(in + i * 4);
+				__m128 r = _mm_mul_ps(c0, splat<0>(v));
+				r = mulAdd(c1, splat<1>(v), r);
+				r = mulAdd(c2, splat<2>(v), r);
+				r = mulAdd(c3, splat<3>(v), r);
+				_mm_storeu_ps(out + i * 4, r);
+			}
+		}
+
+		// 4 float lanes, same interface as Lanes8 so that a kernel can be written once for both widths.
+		struct Lanes4
+		{
+			using Type = __m128;
+			static constexpr std::size_t WIDTH = 4;
+
+			static Type load(const float* p) { return _mm_loadu_ps(p); }
+			static void store(float* p, Type v) { _mm_storeu_ps(p, v); }
+			static Type set(float v) { return _mm_set1_ps(v); }
+			static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+			static Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+			static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+			static Type div(Type a, Type b) { return _mm_div_ps(a, b); }
+			static Type mulAdd(Type a, Type b, Type c) { return Simd::mulAdd(a, b, c); }
+			static Type min(Type a, Type b) { return _mm_min_ps(a, b); }
+			static Type max(Type a, Type b) { return _mm_max_ps(a, b); }
+			static Type sqrt(Type v) { return _mm_sqrt_ps(v); }
+			static Type less(Type a, Type b) { return _mm_cmplt_ps(a, b); }
+			static Type lessEqual(Type a, Type b) { return _mm_cmple_ps(a, b); }
+			static Type bitAnd(Type a, Type b) { return _mm_and_ps(a, b); }
+			static Type bitXor(Type a, Type b) { return _mm_xor_ps(a, b); }
+			// mask ? ifTrue : ifFalse, mask lanes are all ones or all zeros.
+			static Type select(Type mask, Type ifTrue, Type ifFalse) { return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse)); }
+			static Type bitOr(Type a, Type b) { return _mm_or_ps(a, b); }
+			// one bit per lane, lane 0 in bit 0.
+			static unsigned bits(Type mask) { return static_cast<unsigned>(_mm_movemask_ps(mask)); }
+		};
+
+#if defined(MANIMATHS_SIMD_AVX)
+		struct Lanes8
+		{
+			using Type = __m256;
+			static constexpr std::size_t WIDTH = 8;
+
+			static Type load(const float* p) { return _mm256_loadu_ps(p); }
+			static void store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+			static Type set(float v) { return _mm256_set1_ps(v); }
+			static Type add(Type a, Type b) { return _mm256_add_ps(a, b); }
+			static Type sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+			static Type mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+			static Type div(Type a, Type b) { return _mm256_div_ps(a, b); }
+			static Type mulAdd(Type a, Type b, Type c) { return Simd::mulAdd(a, b, c); }
+			static Type min(Type a, Type b) { return _mm256_min_ps(a, b); }
+			static Type max(Type a, Type b) { return _mm256_max_ps(a, b); }
+			static Type sqrt(Type v) { return _mm256_sqrt_ps(v); }
+			static Type less(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			static Type lessEqual(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+			static Type bitAnd(Type a, Type b) { return _mm256_and_ps(a, b); }
+			static Type bitXor(Type a, Type b) { return _mm256_xor_ps(a, b); }
+			static Type select(Type mask, Type ifTrue, Type ifFalse) { return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+			static Type bitOr(Type a, Type b) { return _mm256_or_ps(a, b); }
+			static unsigned bits(Type mask) { return static_cast<unsigned>(_mm256_movemask_ps(mask)); }
+		};
+#endif
+
+		// component wise bounds of packed (x, y, z) points, WIDTH points per iteration are loaded as 3 registers
+		// without any shuffle: lane k of register r always holds component (r * WIDTH + k) % 3, lanes are only
+		// sorted out by component once at the end. outMin and outMax are merged with, not overwritten.
+		// returns the number of points processed, a multiple of WIDTH.
+		template<typename L>
+		inline std::size_t bounds3Lanes(const float* xyz, std::size_t n, float outMin[3], float outMax[3])
+		{
+			constexpr std::size_t W = L::WIDTH;
+			if (n < W)
+			{
+				return 0;
+			}
+
+			typename L::Type lo[3];
+			typename L::Type hi[3];
+			for (std::size_t r = 0; r < 3; ++r)
+			{
+				lo[r] = hi[r] = L::load(xyz + r * W);
+			}
+			std::size_t i = W;
+			for (; i + W <= n; i += W)
+			{
+				for (std::size_t r = 0; r < 3; ++r)
+				{
+					const typename L::Type v = L::load(xyz + i * 3 + r * W);
+					lo[r] = L::min(lo[r], v);
+					hi[r] = L::max(hi[r], v);
+				}
+			}
+
+			float los[3 * W];
+			float his[3 * W];
+			for (std::size_t r = 0; r < 3; ++r)
+			{
+				L::store(los + r * W, lo[r]);
+				L::store(his + r * W, hi[r]);
+			}
+			for (std::size_t k = 0; k < 3 * W; ++k)
+			{
+				outMin[k % 3] = los[k] < outMin[k % 3] ? los[k] : outMin[k % 3];
+				outMax[k % 3] = his[k] > outMax[k % 3] ? his[k] : outMax[k % 3];
+			}
+			return i;
+		}
+
+		// min and max of n floats, merged into lo and hi. returns the number of values processed, a multiple of WIDTH.
+		template<typename L>
+		inline std::size_t bounds1Lanes(const float* v, std::size_t n, float& lo, float& hi)
+		{
+			constexpr std::size_t W = L::WIDTH;
+			typename L::Type vLo = L::set(lo);
+			typename L::Type vHi = L::set(hi);
+			std::size_t i = 0;
+			for (; i + W <= n; i += W)
+			{
+				const typename L::Type x = L::load(v + i);
+				vLo = L::min(vLo, x);
+				vHi = L::max(vHi, x);
+			}
+
+			float los[W];
+			float his[W];
+			L::store(los, vLo);
+			L::store(his, vHi);
+			for (std::size_t k = 0; k < W; ++k)
+			{
+				lo = los[k] < lo ? los[k] : lo;
+				hi = his[k] > hi ? his[k] : hi;
+			}
+			return i;
+		}
+
+		// ray packet kernels: rays is a packet laid out as origin[3][stride], direction[3][stride] and
+		// invDirection[3][stride], the kernels test rays [offset, offset + WIDTH) and return one hit bit per lane.
+		// all comparisons are written so that NaN lanes (degenerate cases) miss.
+		template<typename L>
+		struct RayLanes
+		{
+			typename L::Type o[3];
+			typename L::Type d[3];
+
+			RayLanes(const float* rays, std::size_t stride, std::size_t offset)
+			{
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					o[k] = L::load(rays + k * stride + offset);
+					d[k] = L::load(rays + (3 + k) * stride + offset);
+				}
+			}
+
+			typename L::Type invDirection(const float* rays, std::size_t stride, std::size_t offset, std::size_t k) const
+			{
+				return L::load(rays + (6 + k) * stride + offset);
+			}
+		};
+
+		template<typename L>
+		inline typename L::Type dot3(const typename L::Type a[3], const typename L::Type b[3])
+		{
+			return L::mulAdd(a[2], b[2], L::mulAdd(a[1], b[1], L::mul(a[0], b[0])));
+		}
+
+		// Moller-Trumbore against one triangle, same as Ray::intersectTriangle.
+		template<typename L>
+		inline unsigned rayTriangleLanes(const float* rays, std::size_t stride, std::size_t offset, const float v0[3], const float v1[3], const float v2[3], float* t, float* u, float* v)
+		{
+			using Type = typename L::Type;
+			const RayLanes<L> r(rays, stride, offset);
+			const Type e1[3] = { L::set(v1[0] - v0[0]), L::set(v1[1] - v0[1]), L::set(v1[2] - v0[2]) };
+			const Type e2[3] = { L::set(v2[0] - v0[0]), L::set(v2[1] - v0[1]), L::set(v2[2] - v0[2]) };
+
+			const Type p[3] = {
+				L::sub(L::mul(r.d[1], e2[2]), L::mul(r.d[2], e2[1])),
+				L::sub(L::mul(r.d[2], e2[0]), L::mul(r.d[0], e2[2])),
+				L::sub(L::mul(r.d[0], e2[1]), L::mul(r.d[1], e2[0]))
+			};
+			// det == 0 gives an infinite inverse and infinite or NaN barycentrics, which fail the range tests below.
+			const Type invDet = L::div(L::set(1.f), dot3<L>(e1, p));
+			const Type s[3] = { L::sub(r.o[0], L::set(v0[0])), L::sub(r.o[1], L::set(v0[1])), L::sub(r.o[2], L::set(v0[2])) };
+			const Type q[3] = {
+				L::sub(L::mul(s[1], e1[2]), L::mul(s[2], e1[1])),
+				L::sub(L::mul(s[2], e1[0]), L::mul(s[0], e1[2])),
+				L::sub(L::mul(s[0], e1[1]), L::mul(s[1], e1[0]))
+			};
+			const Type vu = L::mul(dot3<L>(s, p), invDet);
+			const Type vv = L::mul(dot3<L>(r.d, q), invDet);
+			const Type vt = L::mul(dot3<L>(e2, q), invDet);
+
+			const Type zero = L::set(0.f);
+			const Type one = L::set(1.f);
+			Type hit = L::bitAnd(L::lessEqual(zero, vu), L::lessEqual(zero, vv));
+			hit = L::bitAnd(hit, L::lessEqual(L::add(vu, vv), one));
+			hit = L::bitAnd(hit, L::lessEqual(zero, vt));
+			L::store(t, vt);
+			L::store(u, vu);
+			L::store(v, vv);
+			return L::bits(hit);
+		}
+
+		// slab test, same as Ray::intersectsAABB. tMax holds one limit per ray.
+		template<typename L>
+		inline unsigned rayAABBLanes(const float* rays, std::size_t stride, std::size_t offset, const float min[3], const float max[3], const float* tMax, float* tNear)
+		{
+			using Type = typename L::Type;
+			const RayLanes<L> r(rays, stride, offset);
+			Type tEnter = L::set(0.f);
+			Type tExit = L::load(tMax);
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				const Type inv = r.invDirection(rays, stride, offset, k);
+				const Type t0 = L::mul(L::sub(L::set(min[k]), r.o[k]), inv);
+				const Type t1 = L::mul(L::sub(L::set(max[k]), r.o[k]), inv);
+				tEnter = L::max(tEnter, L::min(t0, t1));
+				tExit = L::min(tExit, L::max(t0, t1));
+			}
+			L::store(tNear, tEnter);
+			return L::bits(L::lessEqual(tEnter, tExit));
+		}
+
+		// nearest non negative hit, the exit point for rays starting inside. same as Ray::intersectSphere.
+		template<typename L>
+		inline unsigned raySphereLanes(const float* rays, std::size_t stride, std::size_t offset, const float center[3], float radius, float* t)
+		{
+			using Type = typename L::Type;
+			const RayLanes<L> r(rays, stride, offset);
+			const Type oc[3] = { L::sub(r.o[0], L::set(center[0])), L::sub(r.o[1], L::set(center[1])), L::sub(r.o[2], L::set(center[2])) };
+			const Type a = dot3<L>(r.d, r.d);
+			const Type b = dot3<L>(r.d, oc);
+			const Type c = L::sub(dot3<L>(oc, oc), L::set(radius * radius));
+			const Type discriminant = L::sub(L::mul(b, b), L::mul(a, c));
+
+			const Type zero = L::set(0.f);
+			const Type root = L::sqrt(L::max(discriminant, zero));
+			const Type invA = L::div(L::set(1.f), a);
+			const Type tNear = L::mul(L::sub(L::bitXor(b, L::set(-0.f)), root), invA);
+			const Type tFar = L::mul(L::sub(root, b), invA);
+			const Type vt = L::select(L::lessEqual(zero, tNear), tNear, tFar);
+			L::store(t, vt);
+			return L::bits(L::bitAnd(L::lessEqual(zero, discriminant), L::lessEqual(zero, vt)));
+		}
+
+		// plane (nx, ny, nz, d) with n.p + d = 0, same as Ray::intersectPlane.
+		template<typename L>
+		inline unsigned rayPlaneLanes(const float* rays, std::size_t stride, std::size_t offset, const float plane[4], float* t)
+		{
+			using Type = typename L::Type;
+			const RayLanes<L> r(rays, stride, offset);
+			const Type n[3] = { L::set(plane[0]), L::set(plane[1]), L::set(plane[2]) };
+			const Type distance = L::add(dot3<L>(n, r.o), L::set(plane[3]));
+			const Type vt = L::div(L::bitXor(distance, L::set(-0.f)), dot3<L>(n, r.d));
+			L::store(t, vt);
+			// parallel rays divide by 0, their infinite or NaN distances are rejected.
+			return L::bits(L::bitAnd(L::lessEqual(L::set(0.f), vt), L::less(vt, L::set(std::numeric_limits<float>::infinity()))));
+		}
+
+		// sin over [0, pi / 2], taylor series up to x^11, 6e-8 absolute.
+		template<typename L>
+		inline typename L::Type sinQuarter(typename L::Type v)
+		{
+			const typename L::Type v2 = L::mul(v, v);
+			typename L::Type p = L::set(-2.5052108e-8f);
+			p = L::mulAdd(p, v2, L::set(2.7557319e-6f));
+			p = L::mulAdd(p, v2, L::set(-1.9841270e-4f));
+			p = L::mulAdd(p, v2, L::set(8.3333333e-3f));
+			p = L::mulAdd(p, v2, L::set(-1.6666667e-1f));
+			return L::mulAdd(L::mul(p, v2), v, v);
+		}
+
+		// acos over [0, 1], same coefficients as Math::fast::acos.
+		template<typename L>
+		inline typename L::Type acosPositive(typename L::Type v)
+		{
+			typename L::Type p = L::set(-0.0012624911f);
+			p = L::mulAdd(p, v, L::set(0.0066700901f));
+			p = L::mulAdd(p, v, L::set(-0.0170881256f));
+			p = L::mulAdd(p, v, L::set(0.0308918810f));
+			p = L::mulAdd(p, v, L::set(-0.0501743046f));
+			p = L::mulAdd(p, v, L::set(0.0889789874f));
+			p = L::mulAdd(p, v, L::set(-0.2145988016f));
+			p = L::mulAdd(p, v, L::set(1.5707963050f));
+			return L::mul(L::sqrt(L::sub(L::set(1.f), v)), p);
+		}
+
+		// frustum tests over structure of arrays volumes, planes are 6 (nx, ny, nz, d) with inside at n.p + d >= 0.
+		// visible volumes set their bit in mask, bit i % 64 of word i / 64. mask must be zeroed by the caller.
+		// the plane distances and projected extents are evaluated like Frustum's scalar tests, same order and same fused
+		// multiply adds, so a volume touching a plane gets the same answer from both.
+		template<typename L, FrustumVolume Volume>
+		inline std::size_t frustumLanes(const float* planes, const float* x, const float* y, const float* z, const float* r, const float* s, const float* t, uint64_t* mask, std::size_t i, std::size_t n)
+		{
+			using Type = typename L::Type;
+			const Type zero = L::set(0.f);
+			const Type half = L::set(.5f);
+			for (; i + L::WIDTH <= n; i += L::WIDTH)
+			{
+				Type vx = L::load(x + i);
+				Type vy = L::load(y + i);
+				Type vz = L::load(z + i);
+				Type vr = L::load(r + i);
+				Type vs = zero;
+				Type vt = zero;
+				if constexpr (Volume != FrustumVolume::Sphere)
+				{
+					vs = L::load(s + i);
+					vt = L::load(t + i);
+				}
+				if constexpr (Volume == FrustumVolume::MinMax)
+				{
+					// centers and half extents of the min / max corners.
+					const Type minX = vx, minY = vy, minZ = vz;
+					vx = L::mul(L::add(minX, vr), half);
+					vy = L::mul(L::add(minY, vs), half);
+					vz = L::mul(L::add(minZ, vt), half);
+					vr = L::mul(L::sub(vr, minX), half);
+					vs = L::mul(L::sub(vs, minY), half);
+					vt = L::mul(L::sub(vt, minZ), half);
+				}
+
+				Type outside = zero;
+				for (int p = 0; p < 6; ++p)
+				{
+					const float* plane = planes + p * 4;
+					Type distance = L::mulAdd(vx, L::set(plane[0]), L::set(plane[3]));
+					distance = L::mulAdd(vy, L::set(plane[1]), distance);
+					distance = L::mulAdd(vz, L::set(plane[2]), distance);
+					if constexpr (Volume == FrustumVolume::Sphere)
+					{
+						outside = L::bitOr(outside, L::less(L::add(distance, vr), zero));
+					}
+					else
+					{
+						// projected half extent on the plane normal.
+						Type extent = L::mul(vr, L::set(std::fabs(plane[0])));
+						extent = L::mulAdd(vs, L::set(std::fabs(plane[1])), extent);
+						extent = L::mulAdd(vt, L::set(std::fabs(plane[2])), extent);
+						outside = L::bitOr(outside, L::less(L::add(distance, extent), zero));
+					}
+				}
+				const uint64_t visible = ~L::bits(outside) & ((1u << L::WIDTH) - 1u);
+				mask[i / 64] |= visible << (i % 64);
+			}
+			return i;
+		}
+
+		// one lane group of quaternion interpolation, always along the shortest path. a, b and out are x, y, z, w lanes.
+		template<typename L, QuatBlend Blend>
+		inline void quatBlendGroup(const typename L::Type* a, const typename L::Type* b, typename L::Type t, typename L::Type* out)
+		{
+			using Type = typename L::Type;
+			const Type one = L::set(1.f);
+
+			Type cosTheta = L::mul(a[0], b[0]);
+			cosTheta = L::mulAdd(a[1], b[1], cosTheta);
+			cosTheta = L::mulAdd(a[2], b[2], cosTheta);
+			cosTheta = L::mulAdd(a[3], b[3], cosTheta);
+
+			// sign bit of the dot product, b is negated through tb when the quaternions are more than 180 degrees apart.
+			const Type sign = L::bitAnd(cosTheta, L::set(-0.f));
+			cosTheta = L::bitXor(cosTheta, sign);
+
+			Type ta;
+			Type tb;
+			if constexpr (Blend == QuatBlend::Slerp)
+			{
+				cosTheta = L::min(cosTheta, one);
+				const Type theta = acosPositive<L>(cosTheta);
+				const Type sinTheta = L::sqrt(L::sub(one, L::mul(cosTheta, cosTheta)));
+				// nearly parallel quaternions fall back to a plain lerp, the division by ~0 is discarded by the select.
+				const Type nearlyParallel = L::less(sinTheta, L::set(1e-3f));
+				const Type invSinTheta = L::div(one, sinTheta);
+				const Type oneMinusT = L::sub(one, t);
+				ta = L::select(nearlyParallel, oneMinusT, L::mul(sinQuarter<L>(L::mul(oneMinusT, theta)), invSinTheta));
+				tb = L::select(nearlyParallel, t, L::mul(sinQuarter<L>(L::mul(t, theta)), invSinTheta));
+			}
+			else
+			{
+				if constexpr (Blend == QuatBlend::FastSlerp)
+				{
+					// https://zeux.io/2015/07/23/approximating-slerp/
+					// t is remapped so that the normalized lerp follows the slerp angular velocity.
+					const Type d = cosTheta;
+					Type k = L::mulAdd(d, L::set(-1.43519f), L::set(3.55645f));
+					k = L::mulAdd(d, k, L::set(-3.2452f));
+					k = L::mulAdd(d, k, L::set(1.0904f));
+					Type bias = L::mulAdd(d, L::set(0.215638f), L::set(-1.06021f));
+					bias = L::mulAdd(d, bias, L::set(0.848013f));
+					const Type tHalf = L::sub(t, L::set(.5f));
+					k = L::mulAdd(L::mul(k, tHalf), tHalf, bias);
+					t = L::mulAdd(L::mul(L::mul(t, tHalf), L::sub(t, one)), k, t);
+				}
+				ta = L::sub(one, t);
+				tb = t;
+			}
+			tb = L::bitXor(tb, sign);
+
+			for (int k = 0; k < 4; ++k)
+			{
+				out[k] = L::mulAdd(b[k], tb, L::mul(a[k], ta));
+			}
+
+			if constexpr (Blend != QuatBlend::Slerp)
+			{
+				Type lengthSquared = L::mul(out[0], out[0]);
+				lengthSquared = L::mulAdd(out[1], out[1], lengthSquared);
+				lengthSquared = L::mulAdd(out[2], out[2], lengthSquared);
+				lengthSquared = L::mulAdd(out[3], out[3], lengthSquared);
+				const Type invLength = L::div(one, L::sqrt(lengthSquared));
+				for (int k = 0; k < 4; ++k)
+				{
+					out[k] = L::mul(out[k], invLength);
+				}
+			}
+		}
+
+		template<typename L, QuatBlend Blend, bool SharedT>
+		inline std::size_t quatBlendLanes(const float* const q1[4], const float* const q2[4], const float* t, float* const out[4], std::size_t i, std::size_t n)
+		{
+			typename L::Type a[4], b[4], r[4];
+			for (; i + L::WIDTH <= n; i += L::WIDTH)
+			{
+				for (int k = 0; k < 4; ++k)
+				{
+					a[k] = L::load(q1[k] + i);
+					b[k] = L::load(q2[k] + i);
+				}
+				quatBlendGroup<L, Blend>(a, b, SharedT ? L::set(*t) : L::load(t + i), r);
+				for (int k = 0; k < 4; ++k)
+				{
+					L::store(out[k] + i, r[k]);
+				}
+			}
+			return i;
+		}
+
+		// interpolates n structure of arrays quaternions, q1, q2 and out are the x, y, z and w arrays.
+		// t holds n values, or a single one when SharedT. out arrays may alias the input arrays.
+		template<QuatBlend Blend, bool SharedT>
+		inline void quatBlend(const float* const q1[4], const float* const q2[4], const float* t, float* const out[4], std::size_t n)
+		{
+			std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_AVX)
+			i = quatBlendLanes<Lanes8, Blend, SharedT>(q1, q2, t, out, i, n);
+#endif
+			i = quatBlendLanes<Lanes4, Blend, SharedT>(q1, q2, t, out, i, n);
+			if (i == n)
+			{
+				return;
+			}
+
+			// tail, padded with identities up to a full 4 lanes group.
+			float a[4][4] = { { 0.f, 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f } };
+			float b[4][4] = { { 0.f, 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f } };
+			float tailT[4] = { 0.f, 0.f, 0.f, 0.f };
+			float r[4][4];
+			for (std::size_t j = 0; j < n - i; ++j)
+			{
+				for (int k = 0; k < 4; ++k)
+				{
+					a[k][j] = q1[k][i + j];
+					b[k][j] = q2[k][i + j];
+				}
+				tailT[j] = SharedT ? *t : t[i + j];
+			}
+			const float* const pa[4] = { a[0], a[1], a[2], a[3] };
+			const float* const pb[4] = { b[0], b[1], b[2], b[3] };
+			float* const pr[4] = { r[0], r[1], r[2], r[3] };
+			quatBlendLanes<Lanes4, Blend, false>(pa, pb, tailT, pr, 0, 4);
+			for (std::size_t j = 0; j < n - i; ++j)
+			{
+				for (int k = 0; k < 4; ++k)
+				{
+					out[k][i + j] = r[k][j];
+				}
+			}
+		}
+
+		// (x, y, z) of 4 packed Vec3 as 3 registers.
+		inline void load3x4(const float* v, __m128& x, __m128& y, __m128& z)
+		{
+			const __m128 r0 = _mm_loadu_ps(v);
+			const __m128 r1 = _mm_loadu_ps(v + 4);
+			const __m128 r2 = _mm_loadu_ps(v + 8);
+			x = _mm_shuffle_ps(r0, _mm_shuffle_ps(r1, r2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(_mm_shuffle_ps(r0, r1, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(r1, r2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			z = _mm_shuffle_ps(_mm_shuffle_ps(r0, r1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		}
+
+		inline void store3x4(float* v, __m128 x, __m128 y, __m128 z)
+		{
+			const __m128 xy01 = _mm_unpacklo_ps(x, y);
+			const __m128 xy23 = _mm_unpackhi_ps(x, y);
+			_mm_storeu_ps(v, _mm_shuffle_ps(xy01, _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(v + 4, _mm_shuffle_ps(_mm_shuffle_ps(xy01, z, _MM_SHUFFLE(1, 1, 3, 3)), xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(v + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, xy23, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(xy23, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+
+		// 32 bits smallest three quaternions, see PackedQuat. the same operations as the scalar code, 4 quaternions
+		// (x, y, z, w) per iteration. return the number processed, a multiple of 4.
+		inline std::size_t smallestThreeEncodeLanes(const float* q, std::uint32_t* out, std::size_t n)
+		{
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 max = _mm_set1_ps(1022.f);
+			const __m128 scale = _mm_set1_ps(1022.f * 0.70710678118654752440f);
+			const __m128 offset = _mm_set1_ps(1022.f * .5f);
+			const __m128 half = _mm_set1_ps(.5f);
+
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(q + i * 4);
+				__m128 y = _mm_loadu_ps(q + i * 4 + 4);
+				__m128 z = _mm_loadu_ps(q + i * 4 + 8);
+				__m128 w = _mm_loadu_ps(q + i * 4 + 12);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+
+				// largest magnitude, the first one on ties.
+				__m128 largestAbs = _mm_andnot_ps(signMask, x);
+				__m128 largest = x;
+				__m128i index = _mm_setzero_si128();
+				const __m128 candidates[3] = { y, z, w };
+				for (int k = 0; k < 3; ++k)
+				{
+					const __m128 candidateAbs = _mm_andnot_ps(signMask, candidates[k]);
+					const __m128 greater = _mm_cmpgt_ps(candidateAbs, largestAbs);
+					largestAbs = Lanes4::select(greater, candidateAbs, largestAbs);
+					largest = Lanes4::select(greater, candidates[k], largest);
+					index = _mm_or_si128(_mm_and_si128(_mm_castps_si128(greater), _mm_set1_epi32(k + 1)), _mm_andnot_si128(_mm_castps_si128(greater), index));
+				}
+				const __m128 flip = _mm_and_ps(_mm_cmplt_ps(largest, zero), signMask);
+				x = _mm_xor_ps(x, flip);
+				y = _mm_xor_ps(y, flip);
+				z = _mm_xor_ps(z, flip);
+				w = _mm_xor_ps(w, flip);
+
+				const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+				const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+				const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+				const __m128 kept[3] = { Lanes4::select(is0, y, x), Lanes4::select(_mm_or_ps(is0, is1), z, y), Lanes4::select(is3, z, w) };
+
+				__m128i packed = index;
+				for (int k = 0; k < 3; ++k)
+				{
+					const __m128 quantized = _mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(kept[k], scale), offset), zero), max), half);
+					packed = _mm_or_si128(_mm_slli_epi32(packed, 10), _mm_cvttps_epi32(quantized));
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+			}
+			return i;
+		}
+
+		// 4 smallest three quaternions from their kept components and the index of the dropped one, stored as (x, y, z, w).
+		inline void smallestThreeDecode4(__m128 a, __m128 b, __m128 c, __m128i index, float* q)
+		{
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 l = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(one, _mm_mul_ps(a, a)), _mm_mul_ps(b, b)), _mm_mul_ps(c, c)), _mm_setzero_ps()));
+
+			const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+			const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+			const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+			const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+			__m128 x = Lanes4::select(is0, l, a);
+			__m128 y = Lanes4::select(is0, a, Lanes4::select(is1, l, b));
+			__m128 z = Lanes4::select(is3, c, Lanes4::select(is2, l, b));
+			__m128 w = Lanes4::select(is3, l, c);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(q, x);
+			_mm_storeu_ps(q + 4, y);
+			_mm_storeu_ps(q + 8, z);
+			_mm_storeu_ps(q + 12, w);
+		}
+
+		inline std::size_t smallestThreeDecodeLanes(const std::uint32_t* in, float* q, std::size_t n)
+		{
+			const __m128i mask = _mm_set1_epi32(1023);
+			const __m128i half = _mm_set1_epi32(511);
+			const __m128 scale = _mm_set1_ps(1.41421356237309504880f / 1022.f);
+
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				const __m128 a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(packed, 20), mask), half)), scale);
+				const __m128 b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(packed, 10), mask), half)), scale);
+				const __m128 c = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(packed, mask), half)), scale);
+				smallestThreeDecode4(a, b, c, _mm_srli_epi32(packed, 30), q + i * 4);
+			}
+			return i;
+		}
+
+		// 48 and 64 bits smallest three quaternions, as the 64 bits of PackedQuat::getBits() with ComponentBits per
+		// component. return the number processed, a multiple of 4.
+		template<int ComponentBits>
+		inline std::size_t smallestThreeDecodeWideLanes(const std::uint64_t* in, float* q, std::size_t n)
+		{
+			const __m128i mask = _mm_set1_epi64x((std::int64_t(1) << ComponentBits) - 1);
+			const __m128i half = _mm_set1_epi32((1 << (ComponentBits - 1)) - 1);
+			const __m128 scale = _mm_set1_ps(1.41421356237309504880f / static_cast<float>((1 << ComponentBits) - 2));
+			// the low 32 bits of the four 64 bits lanes of lo and hi.
+			const auto narrow = [](__m128i lo, __m128i hi)
+			{
+				return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+			};
+			const auto component = [&](__m128i lo, __m128i hi, int shift)
+			{
+				const __m128i quantized = narrow(_mm_and_si128(_mm_srl_epi64(lo, _mm_cvtsi32_si128(shift)), mask), _mm_and_si128(_mm_srl_epi64(hi, _mm_cvtsi32_si128(shift)), mask));
+				return _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(quantized, half)), scale);
+			};
+
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 2));
+				const __m128i index = narrow(_mm_and_si128(_mm_srli_epi64(lo, 3 * ComponentBits), _mm_set1_epi64x(3)), _mm_and_si128(_mm_srli_epi64(hi, 3 * ComponentBits), _mm_set1_epi64x(3)));
+				smallestThreeDecode4(component(lo, hi, 2 * ComponentBits), component(lo, hi, ComponentBits), component(lo, hi, 0), index, q + i * 4);
+			}
+			return i;
+		}
+
+		// 32 bits octahedral unit vectors, see PackedNormal. 4 Vec3 per iteration, return the number processed.
+		inline std::size_t octahedralEncodeLanes(const float* v, std::uint32_t* out, std::size_t n)
+		{
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 max = _mm_set1_ps(65534.f);
+			const __m128 halfMax = _mm_set1_ps(65534.f * .5f);
+			const __m128 half = _mm_set1_ps(.5f);
+
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x, y, z;
+				load3x4(v + i * 3, x, y, z);
+				const __m128 length1 = _mm_max_ps(_mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z)), _mm_set1_ps(std::numeric_limits<float>::min()));
+				x = _mm_div_ps(x, length1);
+				y = _mm_div_ps(y, length1);
+				const __m128 signX = Lanes4::select(_mm_cmpge_ps(x, zero), one, _mm_set1_ps(-1.f));
+				const __m128 signY = Lanes4::select(_mm_cmpge_ps(y, zero), one, _mm_set1_ps(-1.f));
+				const __m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, y)), signX);
+				const __m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), signY);
+				const __m128 lower = _mm_cmplt_ps(z, zero);
+				x = Lanes4::select(lower, foldedX, x);
+				y = Lanes4::select(lower, foldedY, y);
+
+				const __m128i qx = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(x, halfMax), halfMax), zero), max), half));
+				const __m128i qy = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(y, halfMax), halfMax), zero), max), half));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(qx, _mm_slli_epi32(qy, 16)));
+			}
+			return i;
+		}
+
+		inline std::size_t octahedralDecodeLanes(const std::uint32_t* in, float* v, std::size_t n)
+		{
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128i half = _mm_set1_epi32(32767);
+			const __m128 scale = _mm_set1_ps(2.f / 65534.f);
+
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128 x = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(packed, _mm_set1_epi32(0xFFFF)), half)), scale);
+				__m128 y = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(packed, 16), half)), scale);
+				const __m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), _mm_andnot_ps(signMask, y));
+				const __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+				x = _mm_add_ps(x, Lanes4::select(_mm_cmpge_ps(x, zero), _mm_sub_ps(zero, t), t));
+				y = _mm_add_ps(y, Lanes4::select(_mm_cmpge_ps(y, zero), _mm_sub_ps(zero, t), t));
+				const __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+				store3x4(v + i * 3, _mm_mul_ps(x, invLength), _mm_mul_ps(y, invLength), _mm_mul_ps(z, invLength));
+			}
+			return i;
+		}
+
+		// float to IEEE half bits, 8 at a time, rounded to nearest even, NaNs become 0x7E00 with their sign.
+		// return the number converted, a multiple of 8.
+		inline std::size_t floatToHalfLanes(const float* in, std::uint16_t* out, std::size_t n)
+		{
+			std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_F16C)
+			const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000u)));
+			const __m256 quietNan = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FC00000));
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m256 v = _mm256_loadu_ps(in + i);
+				// f16c keeps the top of NaN payloads, the scalar path doesn't.
+				const __m256 canonical = _mm256_blendv_ps(v, _mm256_or_ps(_mm256_and_ps(v, signMask), quietNan), _mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(canonical, _MM_FROUND_TO_NEAREST_INT));
+			}
+#else
+			const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+			// smallest float that overflows the half range once rounded.
+			const __m128i overflow = _mm_set1_epi32((127 + 16) << 23);
+			const __m128i smallestNormal = _mm_set1_epi32((127 - 14) << 23);
+			// adding it shifts a subnormal result's mantissa to the bottom bits, the float addition rounds it.
+			const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+			const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+			const auto convert4 = [&](__m128 v)
+			{
+				const __m128 sign = _mm_and_ps(v, _mm_castsi128_ps(signMask));
+				const __m128 absolute = _mm_xor_ps(v, sign);
+				const __m128i bits = _mm_castps_si128(absolute);
+				const __m128i infOrNan = _mm_or_si128(_mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(absolute, absolute)), _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+				const __m128i isRegular = _mm_cmpgt_epi32(overflow, bits);
+				const __m128i isSubnormal = _mm_cmpgt_epi32(smallestNormal, bits);
+
+				const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+				// + 0xFFF, + 1 more when the kept mantissa is odd: ties to even.
+				const __m128i odd = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+				const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, normalBias), odd), 13);
+
+				const __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+				const __m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNan));
+				// the sign sign-extends to 0xFFFF8000 so that the saturating pack keeps it.
+				return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+			};
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i lo = convert4(_mm_loadu_ps(in + i));
+				const __m128i hi = convert4(_mm_loadu_ps(in + i + 4));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+			}
+#endif
+			return i;
+		}
+
+		// IEEE half bits to float, 8 at a time, exact. return the number converted, a multiple of 8.
+		inline std::size_t halfToFloatLanes(const std::uint16_t* in, float* out, std::size_t n)
+		{
+			std::size_t i = 0;
+#if defined(MANIMATHS_SIMD_F16C)
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+			}
+#else
+			// 2^112 moves the half exponent bias to the float one, subnormal halves come out normalized.
+			const __m128 rebias = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+			const __m128i largestFinite = _mm_set1_epi32(0x7BFF);
+			const auto convert4 = [&](__m128i h)
+			{
+				const __m128i magnitude = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+				const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, magnitude), 16);
+				const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), rebias);
+				const __m128 infOrNan = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(magnitude, largestFinite)), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+				return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infOrNan));
+			};
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				_mm_storeu_ps(out + i, convert4(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+				_mm_storeu_ps(out + i + 4, convert4(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+			}
+#endif
+			return i;
+		}
+
+		// float to bfloat16 bits, 8 at a time, rounded to nearest even, NaNs are kept quiet.
+		// return the number converted, a multiple of 8.
+		inline std::size_t floatToBFloat16Lanes(const float* in, std::uint16_t* out, std::size_t n)
+		{
+			const auto convert4 = [](__m128 v)
+			{
+				const __m128i bits = _mm_castps_si128(v);
+				const __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+				const __m128i rounded = _mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(0x7FFF)), odd);
+				const __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(v, v));
+				const __m128i result = _mm_or_si128(_mm_and_si128(isNan, _mm_or_si128(bits, _mm_set1_epi32(0x400000))), _mm_andnot_si128(isNan, rounded));
+				// arithmetic shift, the saturating pack keeps negative values.
+				return _mm_srai_epi32(result, 16);
+			};
+			std::size_t i = 0;
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i lo = convert4(_mm_loadu_ps(in + i));
+				const __m128i hi = convert4(_mm_loadu_ps(in + i + 4));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+			}
+			return i;
+		}
+
+		// bfloat16 bits to float, 8 at a time, exact. return the number converted, a multiple of 8.
+		inline std::size_t bfloat16ToFloatLanes(const std::uint16_t* in, float* out, std::size_t n)
+		{
+			std::size_t i = 0;
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(_mm_setzero_si128(), h));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(_mm_setzero_si128(), h));
+			}
+			return i;
+		}
+#endif
+	}
+}
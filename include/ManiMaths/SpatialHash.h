@@ -0,0 +1,307 @@
+#pragma once
+
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Vec3.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Mani
+{
+	// Uniform grid over an unbounded space: points are binned by their integer cell coordinates, hashed into a
+	// power of 2 bucket table. build() radix sorts the points by bucket, each bucket is then a contiguous
+	// range of a positions copy stored in bucket order, queries read memory linearly.
+	// Distinct cells sharing a bucket only cost extra distance tests, queries never report a point twice.
+	template<IsNumeric T>
+	struct SpatialHash
+	{
+		using Index = uint32_t;
+
+		// queries are cheapest with a cell size close to their radius, they then visit 27 cells.
+		explicit SpatialHash(T cellSize) : m_cellSize(cellSize), m_invCellSize(static_cast<T>(1) / cellSize)
+		{
+			MANIMATHS_ASSERT(cellSize > static_cast<T>(0));
+		}
+
+		[[nodiscard]] T getCellSize() const
+		{
+			return m_cellSize;
+		}
+
+		[[nodiscard]] std::size_t size() const
+		{
+			return m_points.size();
+		}
+
+		[[nodiscard]] std::size_t getBucketCount() const
+		{
+			return m_bucketStarts.empty() ? 0 : m_bucketStarts.size() - 1;
+		}
+
+		// tableSize is rounded up to a power of 2, 0 picks twice the point count.
+		// the points are split in threadCount chunks run on the global ThreadPool for every pass of the radix sort.
+		// the result doesn't depend on it.
+		void build(std::span<const Vec<T, 3>> points, std::size_t threadCount = 1, std::size_t tableSize = 0)
+		{
+			MANIMATHS_ASSERT(points.size() < std::numeric_limits<Index>::max());
+			const std::size_t n = points.size();
+			const std::size_t bucketCount = std::bit_ceil(Math::maxT<std::size_t>(tableSize > 0 ? tableSize : n * 2, 1));
+			m_mask = bucketCount - 1;
+			threadCount = std::clamp<std::size_t>(threadCount, 1, Math::maxT<std::size_t>(n / MIN_POINTS_PER_CHUNK, 1));
+
+			// bucket << 32 | index pairs, sorted on the bucket bits.
+			std::vector<uint64_t> pairs(n);
+			std::vector<uint64_t> sorted(n);
+			ThreadPool::forEachChunk(n, threadCount, [&](std::size_t, std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					pairs[i] = (static_cast<uint64_t>(bucketOf(cellOf(points[i]))) << 32) | i;
+				}
+			});
+
+			// least significant digit first, every pass is stable so equal buckets keep the point order.
+			// per chunk counts, then per chunk write offsets, of every digit.
+			std::vector<Index> offsets(threadCount * RADIX_SIZE);
+			const int bucketBits = std::countr_zero(bucketCount);
+			for (int shift = 32; shift < 32 + bucketBits; shift += RADIX_BITS)
+			{
+				std::fill(offsets.begin(), offsets.end(), 0);
+				ThreadPool::forEachChunk(n, threadCount, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+				{
+					Index* counts = offsets.data() + chunk * RADIX_SIZE;
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						++counts[(pairs[i] >> shift) & (RADIX_SIZE - 1)];
+					}
+				});
+
+				// exclusive prefix sum over digits, chunks in order within a digit.
+				Index start = 0;
+				for (std::size_t digit = 0; digit < RADIX_SIZE; ++digit)
+				{
+					for (std::size_t chunk = 0; chunk < threadCount; ++chunk)
+					{
+						const Index counted = offsets[chunk * RADIX_SIZE + digit];
+						offsets[chunk * RADIX_SIZE + digit] = start;
+						start += counted;
+					}
+				}
+
+				ThreadPool::forEachChunk(n, threadCount, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+				{
+					Index* writes = offsets.data() + chunk * RADIX_SIZE;
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						sorted[writes[(pairs[i] >> shift) & (RADIX_SIZE - 1)]++] = pairs[i];
+					}
+				});
+				pairs.swap(sorted);
+			}
+
+			// point i starts every bucket after the one of point i - 1 up to its own.
+			m_bucketStarts.resize(bucketCount + 1);
+			m_points.resize(n);
+			m_indices.resize(n);
+			ThreadPool::forEachChunk(n, threadCount, [&](std::size_t, std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const Index index = static_cast<Index>(pairs[i]);
+					m_points[i] = points[index];
+					m_indices[i] = index;
+
+					const std::size_t bucket = static_cast<std::size_t>(pairs[i] >> 32);
+					for (std::size_t b = i > 0 ? static_cast<std::size_t>(pairs[i - 1] >> 32) + 1 : 0; b <= bucket; ++b)
+					{
+						m_bucketStarts[b] = static_cast<Index>(i);
+					}
+				}
+			});
+			const std::size_t endBucket = n > 0 ? static_cast<std::size_t>(pairs[n - 1] >> 32) + 1 : 0;
+			std::fill(m_bucketStarts.begin() + endBucket, m_bucketStarts.end(), static_cast<Index>(n));
+		}
+
+		// visit(index, distanceSquared) for every point within radius of p, in no particular order.
+		template<typename TVisit>
+		void forEachInRadius(const Vec<T, 3>& p, T radius, TVisit&& visit) const
+		{
+			if (m_points.empty())
+			{
+				return;
+			}
+
+			const T radiusSquared = radius * radius;
+			auto visitRange = [&](Index begin, Index end)
+			{
+				for (Index i = begin; i < end; ++i)
+				{
+					const T distanceSquared = m_points[i].distanceSquared(p);
+					if (distanceSquared <= radiusSquared)
+					{
+						visit(m_indices[i], distanceSquared);
+					}
+				}
+			};
+
+			// a query box with more cells than buckets reads every bucket anyway, scan all the points instead.
+			const T cellsPerAxis = radius * static_cast<T>(2) * m_invCellSize + static_cast<T>(1);
+			if (cellsPerAxis * cellsPerAxis * cellsPerAxis >= static_cast<T>(getBucketCount()))
+			{
+				visitRange(0, static_cast<Index>(m_points.size()));
+				return;
+			}
+
+			const Vec<T, 3> offset = { radius, radius, radius };
+			const Cell lo = cellOf(p - offset);
+			const Cell hi = cellOf(p + offset);
+
+			// buckets already visited, several cells of the query may share one.
+			Index visited[VISITED_CAPACITY];
+			std::vector<bool> visitedBuckets;
+			std::size_t visitedCount = 0;
+			for (int z = lo.z; z <= hi.z; ++z)
+			{
+				for (int y = lo.y; y <= hi.y; ++y)
+				{
+					for (int x = lo.x; x <= hi.x; ++x)
+					{
+						const Index bucket = bucketOf({ x, y, z });
+						if (visitedCount < VISITED_CAPACITY)
+						{
+							if (std::find(visited, visited + visitedCount, bucket) != visited + visitedCount)
+							{
+								continue;
+							}
+							visited[visitedCount++] = bucket;
+						}
+						else
+						{
+							// large queries switch to one flag per bucket.
+							if (visitedBuckets.empty())
+							{
+								visitedBuckets.resize(getBucketCount(), false);
+								for (Index b : visited)
+								{
+									visitedBuckets[b] = true;
+								}
+							}
+							if (visitedBuckets[bucket])
+							{
+								continue;
+							}
+							visitedBuckets[bucket] = true;
+						}
+						visitRange(m_bucketStarts[bucket], m_bucketStarts[bucket + 1]);
+					}
+				}
+			}
+		}
+
+		// appends the indices of the points within radius of p to out, returns how many were appended.
+		std::size_t queryRadius(const Vec<T, 3>& p, T radius, std::vector<Index>& out) const
+		{
+			const std::size_t initialSize = out.size();
+			forEachInRadius(p, radius, [&out](Index i, T) { out.push_back(i); });
+			return out.size() - initialSize;
+		}
+
+		// up to out.size() nearest points within maxRadius of p, closest first. returns how many were written.
+		// searches balls of growing radius from one cell size until enough points are found.
+		std::size_t queryKNearest(const Vec<T, 3>& p, std::span<Index> out, T maxRadius = std::numeric_limits<T>::max()) const
+		{
+			const std::size_t k = out.size();
+			if (k == 0 || m_points.empty())
+			{
+				return 0;
+			}
+
+			// max heap on distance, the farthest of the k best is on top.
+			std::vector<std::pair<T, Index>> best;
+			best.reserve(k);
+			T radius = Math::minT(m_cellSize, maxRadius);
+			while (true)
+			{
+				best.clear();
+				forEachInRadius(p, radius, [&](Index i, T distanceSquared)
+				{
+					if (best.size() < k)
+					{
+						best.emplace_back(distanceSquared, i);
+						std::push_heap(best.begin(), best.end());
+					}
+					else if (distanceSquared < best.front().first)
+					{
+						std::pop_heap(best.begin(), best.end());
+						best.back() = { distanceSquared, i };
+						std::push_heap(best.begin(), best.end());
+					}
+				});
+				// every point outside the ball is farther than radius, so k points inside it are the k nearest.
+				if (best.size() == k || radius >= maxRadius || best.size() == m_points.size())
+				{
+					break;
+				}
+				radius = Math::minT(radius * static_cast<T>(2), maxRadius);
+			}
+
+			std::sort_heap(best.begin(), best.end());
+			for (std::size_t i = 0; i < best.size(); ++i)
+			{
+				out[i] = best[i].second;
+			}
+			return best.size();
+		}
+
+	private:
+		struct Cell
+		{
+			int x;
+			int y;
+			int z;
+		};
+
+		// below this, one more chunk costs more than it saves.
+		static constexpr std::size_t MIN_POINTS_PER_CHUNK = 16384;
+		// 11 bit digits, 2 passes up to 4M buckets and a histogram that stays in L1.
+		static constexpr int RADIX_BITS = 11;
+		static constexpr std::size_t RADIX_SIZE = std::size_t(1) << RADIX_BITS;
+		static constexpr std::size_t VISITED_CAPACITY = 64;
+
+		[[nodiscard]] Cell cellOf(const Vec<T, 3>& p) const
+		{
+			return {
+				static_cast<int>(Math::floorToInt(p.x * m_invCellSize)),
+				static_cast<int>(Math::floorToInt(p.y * m_invCellSize)),
+				static_cast<int>(Math::floorToInt(p.z * m_invCellSize))
+			};
+		}
+
+		// Teschner et al. 2003, Optimized Spatial Hashing for Collision Detection of Deformable Objects.
+		[[nodiscard]] Index bucketOf(const Cell& cell) const
+		{
+			const uint32_t h = (static_cast<uint32_t>(cell.x) * 73856093u) ^ (static_cast<uint32_t>(cell.y) * 19349663u) ^ (static_cast<uint32_t>(cell.z) * 83492791u);
+			return static_cast<Index>(h & m_mask);
+		}
+
+		T m_cellSize;
+		T m_invCellSize;
+		std::size_t m_mask = 0;
+
+		// bucket b holds m_points[m_bucketStarts[b], m_bucketStarts[b + 1]), originally at m_indices[...].
+		std::vector<Index> m_bucketStarts;
+		std::vector<Vec<T, 3>> m_points;
+		std::vector<Index> m_indices;
+	};
+
+	typedef SpatialHash<float>	SpatialHashf;
+	typedef SpatialHash<double>	SpatialHashd;
+}
@@ -0,0 +1,631 @@
+#pragma once
+
+#include "Debug.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Mani
+{
+	// Chase-Lev work stealing deque, after "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013).
+	// the owner thread pushes and pops at the bottom, any thread steals from the top. the ring buffer grows on
+	// push, retired buffers are kept until destruction since a thief may still be reading one.
+	template<typename T>
+	class WorkStealingDeque
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "deque elements are stored in atomics");
+
+	public:
+		// capacity is rounded up to a power of 2.
+		explicit WorkStealingDeque(std::size_t capacity = 256)
+		{
+			std::int64_t rounded = 1;
+			while (rounded < static_cast<std::int64_t>(capacity))
+			{
+				rounded <<= 1;
+			}
+			m_buffers.push_back(std::make_unique<Buffer>(rounded));
+			m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+		}
+
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+		// owner only.
+		void push(T value)
+		{
+			const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			const std::int64_t top = m_top.load(std::memory_order_acquire);
+			Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+			if (bottom - top >= buffer->capacity())
+			{
+				buffer = grow(buffer, top, bottom);
+			}
+			buffer->put(bottom, value);
+			m_bottom.store(bottom + 1, std::memory_order_release);
+		}
+
+		// owner only, last pushed first.
+		bool pop(T& value)
+		{
+			const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t top = m_top.load(std::memory_order_relaxed);
+			if (top > bottom)
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			value = buffer->get(bottom);
+			if (top < bottom)
+			{
+				return true;
+			}
+			// last element, thieves may be after it too.
+			const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		// any thread, first pushed first. may fail while the deque isn't empty when racing another thread.
+		bool steal(T& value)
+		{
+			std::int64_t top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+			if (top >= bottom)
+			{
+				return false;
+			}
+
+			const T stolen = m_buffer.load(std::memory_order_acquire)->get(top);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				return false;
+			}
+			value = stolen;
+			return true;
+		}
+
+		// a snapshot, exact only when no other thread touches the deque.
+		[[nodiscard]] std::size_t size() const
+		{
+			const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			const std::int64_t top = m_top.load(std::memory_order_relaxed);
+			return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return size() == 0;
+		}
+
+	private:
+		struct Buffer
+		{
+			explicit Buffer(std::int64_t capacity)
+				: mask(capacity - 1), slots(std::make_unique<std::atomic<T>[]>(static_cast<std::size_t>(capacity)))
+			{
+			}
+
+			[[nodiscard]] std::int64_t capacity() const { return mask + 1; }
+			[[nodiscard]] T get(std::int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+			void put(std::int64_t i, T value) { slots[i & mask].store(value, std::memory_order_relaxed); }
+
+			std::int64_t mask;
+			std::unique_ptr<std::atomic<T>[]> slots;
+		};
+
+		Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+		{
+			m_buffers.push_back(std::make_unique<Buffer>(buffer->capacity() * 2));
+			Buffer* grown = m_buffers.back().get();
+			for (std::int64_t i = top; i < bottom; ++i)
+			{
+				grown->put(i, buffer->get(i));
+			}
+			m_buffer.store(grown, std::memory_order_release);
+			return grown;
+		}
+
+		alignas(64) std::atomic<std::int64_t> m_top = 0;
+		alignas(64) std::atomic<std::int64_t> m_bottom = 0;
+		std::atomic<Buffer*> m_buffer = nullptr;
+		// owner only, the current buffer last.
+		std::vector<std::unique_ptr<Buffer>> m_buffers;
+	};
+
+	class TaskGroup;
+
+	// Persistent work stealing scheduler for the batched operations, so that a batch doesn't pay for thread creation.
+	// every worker owns a Chase-Lev deque: it pushes and pops its own tasks at the bottom while idle workers steal
+	// from the top, nearest workers first. threads that aren't workers of the pool submit through a shared queue
+	// and help while they wait. workers sleep while there's nothing to take.
+	// parallelFor splits ranges lazily: a task halves its range, offering one half to thieves, until it fits the grain.
+	// TaskGroup and invoke give fork/join on top of the same deques.
+	class ThreadPool
+	{
+	public:
+		// an automatic grain never goes below this many elements, smaller tasks cost more to schedule than to run.
+		static constexpr std::size_t MIN_AUTO_GRAIN = 1024;
+		// an automatic grain aims for this many leaf tasks per worker, leaving room to steal.
+		static constexpr std::size_t TASKS_PER_WORKER = 8;
+
+		// workerCount includes the calling thread, 1 runs everything inline.
+		// pinThreads binds worker i to the i-th cpu of the process affinity on linux (ignored elsewhere), the caller
+		// keeps its own. stealing goes to the nearest workers first, so with cpus numbered by socket most steals
+		// stay on the same NUMA node.
+		explicit ThreadPool(std::size_t workerCount = std::thread::hardware_concurrency(), bool pinThreads = false)
+		{
+			const std::size_t threadCount = std::max<std::size_t>(workerCount, 1) - 1;
+			m_deques.reserve(threadCount);
+			for (std::size_t worker = 0; worker < threadCount; ++worker)
+			{
+				m_deques.push_back(std::make_unique<WorkStealingDeque<Task*>>());
+			}
+			m_threads.reserve(threadCount);
+			for (std::size_t worker = 0; worker < threadCount; ++worker)
+			{
+				m_threads.emplace_back([this, worker]() { workerLoop(worker); });
+				if (pinThreads)
+				{
+					pin(m_threads.back(), worker + 1);
+				}
+			}
+		}
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_sleepMutex);
+				m_stopping = true;
+			}
+			m_wakeUp.notify_all();
+			for (std::thread& thread : m_threads)
+			{
+				thread.join();
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// shared pool sized after the hardware, used by the batched operations unless told otherwise.
+		[[nodiscard]] static ThreadPool& global()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+
+		[[nodiscard]] std::size_t getWorkerCount() const
+		{
+			return m_threads.size() + 1;
+		}
+
+		// grain of a parallelFor given 0 for count elements.
+		[[nodiscard]] std::size_t getAutoGrain(std::size_t count) const
+		{
+			return std::max(count / (getWorkerCount() * TASKS_PER_WORKER), MIN_AUTO_GRAIN);
+		}
+
+		// body(begin, end) over [0, count) in chunks of at most grainSize elements (0 picks one), returns once every
+		// chunk ran. body is called concurrently and must be safe for disjoint ranges.
+		template<typename TBody>
+		void parallelFor(std::size_t count, std::size_t grainSize, TBody&& body)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+			grainSize = grainSize > 0 ? grainSize : getAutoGrain(count);
+			if (m_threads.empty() || count <= grainSize)
+			{
+				body(std::size_t(0), count);
+				return;
+			}
+
+			// leaves hold more than half a grain, which bounds the task count.
+			RangeJob job(2 * (count / grainSize) + 2);
+			job.body = [](void* context, std::size_t begin, std::size_t end) { (*static_cast<std::remove_reference_t<TBody>*>(context))(begin, end); };
+			job.context = const_cast<void*>(static_cast<const void*>(&body));
+			job.grainSize = grainSize;
+			job.remaining.store(count, std::memory_order_relaxed);
+
+			runRange(*this, job.allocate(0, count));
+			helpWhile(job.remaining);
+		}
+
+		// runs first on the calling thread and second as a task, returns once both are done.
+		template<typename TFirst, typename TSecond>
+		void invoke(TFirst&& first, TSecond&& second);
+
+		// work(chunk, begin, end) over [0, count) cut in chunkCount even chunks, the first on the calling thread and
+		// the others as tasks of global(), returns once every chunk ran. unlike parallelFor the chunks only depend on
+		// count and chunkCount, for callers keeping one partial result per chunk. what the threadCount parameters of
+		// the spatial structures map onto, a single chunk runs inline without starting the pool.
+		template<typename TWork>
+		static void forEachChunk(std::size_t count, std::size_t chunkCount, TWork&& work);
+
+	private:
+		friend class TaskGroup;
+
+		struct Task
+		{
+			void (*execute)(ThreadPool& pool, Task* task) = nullptr;
+		};
+
+		struct RangeJob;
+
+		struct RangeTask : Task
+		{
+			RangeJob* job = nullptr;
+			std::size_t begin = 0;
+			std::size_t end = 0;
+		};
+
+		struct RangeJob
+		{
+			explicit RangeJob(std::size_t capacity)
+				: tasks(std::make_unique<RangeTask[]>(capacity)), capacity(capacity)
+			{
+			}
+
+			RangeTask* allocate(std::size_t begin, std::size_t end)
+			{
+				const std::size_t index = allocated.fetch_add(1, std::memory_order_relaxed);
+				MANIMATHS_ASSERT(index < capacity);
+				RangeTask* task = &tasks[index];
+				task->execute = [](ThreadPool& pool, Task* task) { runRange(pool, static_cast<RangeTask*>(task)); };
+				task->job = this;
+				task->begin = begin;
+				task->end = end;
+				return task;
+			}
+
+			void (*body)(void* context, std::size_t begin, std::size_t end) = nullptr;
+			void* context = nullptr;
+			std::size_t grainSize = 1;
+			// elements not processed yet.
+			std::atomic<std::size_t> remaining = 0;
+			std::unique_ptr<RangeTask[]> tasks;
+			std::size_t capacity;
+			std::atomic<std::size_t> allocated = 0;
+		};
+
+		// the worker a thread is, if any.
+		struct Worker
+		{
+			ThreadPool* pool = nullptr;
+			std::size_t index = 0;
+		};
+
+		[[nodiscard]] static Worker& currentWorker()
+		{
+			thread_local Worker worker;
+			return worker;
+		}
+
+		static void runRange(ThreadPool& pool, RangeTask* task)
+		{
+			RangeJob& job = *task->job;
+			const std::size_t begin = task->begin;
+			std::size_t end = task->end;
+			while (end - begin > job.grainSize)
+			{
+				const std::size_t middle = begin + (end - begin) / 2;
+				pool.push(job.allocate(middle, end));
+				end = middle;
+			}
+			job.body(job.context, begin, end);
+			// last access, the job may be gone as soon as its caller sees 0.
+			job.remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+		}
+
+		void push(Task* task)
+		{
+			// counted first, so that a thief taking it right away never brings the count below 0.
+			m_pending.fetch_add(1, std::memory_order_seq_cst);
+			const Worker& worker = currentWorker();
+			if (worker.pool == this)
+			{
+				m_deques[worker.index]->push(task);
+			}
+			else
+			{
+				std::lock_guard<std::mutex> lock(m_submittedMutex);
+				m_submitted.push_back(task);
+			}
+
+			if (m_sleeping.load(std::memory_order_seq_cst) > 0)
+			{
+				std::lock_guard<std::mutex> lock(m_sleepMutex);
+				m_wakeUp.notify_one();
+			}
+		}
+
+		// own deque, then submissions, then the other deques nearest first.
+		Task* take()
+		{
+			const Worker& worker = currentWorker();
+			const bool isWorker = worker.pool == this;
+			Task* task = nullptr;
+			if (isWorker && m_deques[worker.index]->pop(task))
+			{
+				m_pending.fetch_sub(1, std::memory_order_relaxed);
+				return task;
+			}
+
+			if (m_pending.load(std::memory_order_relaxed) == 0)
+			{
+				return nullptr;
+			}
+			{
+				std::lock_guard<std::mutex> lock(m_submittedMutex);
+				if (!m_submitted.empty())
+				{
+					task = m_submitted.front();
+					m_submitted.pop_front();
+					m_pending.fetch_sub(1, std::memory_order_relaxed);
+					return task;
+				}
+			}
+
+			const std::size_t count = m_deques.size();
+			for (std::size_t distance = 1; distance <= count; ++distance)
+			{
+				// +1, -1, +2, -2... around a worker, every deque in order for anyone else.
+				const std::size_t step = (distance + 1) / 2;
+				const std::size_t victim = !isWorker ? distance - 1
+					: (distance & 1) ? (worker.index + step) % count : (worker.index + count - step % count) % count;
+				if (m_deques[victim]->steal(task))
+				{
+					m_pending.fetch_sub(1, std::memory_order_relaxed);
+					return task;
+				}
+			}
+			return nullptr;
+		}
+
+		// runs tasks, of any job, until remaining drops to 0.
+		void helpWhile(const std::atomic<std::size_t>& remaining)
+		{
+			while (remaining.load(std::memory_order_acquire) > 0)
+			{
+				if (Task* task = take())
+				{
+					task->execute(*this, task);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		void workerLoop(std::size_t index)
+		{
+			currentWorker() = { this, index };
+			while (true)
+			{
+				if (Task* task = take())
+				{
+					task->execute(*this, task);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_sleepMutex);
+				m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+				m_wakeUp.wait(lock, [this]() { return m_stopping || m_pending.load(std::memory_order_seq_cst) > 0; });
+				m_sleeping.fetch_sub(1, std::memory_order_seq_cst);
+				if (m_stopping && m_pending.load(std::memory_order_seq_cst) == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		static void pin([[maybe_unused]] std::thread& thread, [[maybe_unused]] std::size_t index)
+		{
+#if defined(__linux__)
+			cpu_set_t allowed;
+			CPU_ZERO(&allowed);
+			if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0)
+			{
+				return;
+			}
+			std::size_t target = index % static_cast<std::size_t>(CPU_COUNT(&allowed));
+			for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+			{
+				if (CPU_ISSET(cpu, &allowed) && target-- == 0)
+				{
+					cpu_set_t set;
+					CPU_ZERO(&set);
+					CPU_SET(cpu, &set);
+					pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+					return;
+				}
+			}
+#endif
+		}
+
+		std::vector<std::unique_ptr<WorkStealingDeque<Task*>>> m_deques;
+		std::vector<std::thread> m_threads;
+
+		// tasks pushed by threads that aren't workers.
+		std::mutex m_submittedMutex;
+		std::deque<Task*> m_submitted;
+
+		// tasks pushed and not taken yet, workers sleep while it's 0.
+		std::atomic<std::size_t> m_pending = 0;
+		std::atomic<std::size_t> m_sleeping = 0;
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wakeUp;
+		bool m_stopping = false;
+	};
+
+	// Fork/join on a ThreadPool: run() queues functions, wait() helps running tasks until they are all done.
+	// the destructor waits too.
+	class TaskGroup
+	{
+	public:
+		explicit TaskGroup(ThreadPool& pool = ThreadPool::global())
+			: m_pool(pool)
+		{
+		}
+
+		~TaskGroup()
+		{
+			wait();
+		}
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		template<typename TFunction>
+		void run(TFunction&& function)
+		{
+			if (m_pool.m_threads.empty())
+			{
+				function();
+				return;
+			}
+			m_pending.fetch_add(1, std::memory_order_relaxed);
+			m_pool.push(new FunctionTask<std::decay_t<TFunction>>(this, std::forward<TFunction>(function)));
+		}
+
+		void wait()
+		{
+			m_pool.helpWhile(m_pending);
+		}
+
+	private:
+		template<typename TFunction>
+		struct FunctionTask : ThreadPool::Task
+		{
+			FunctionTask(TaskGroup* group, TFunction&& function)
+				: group(group), function(std::move(function))
+			{
+				execute = &run;
+			}
+
+			FunctionTask(TaskGroup* group, const TFunction& function)
+				: group(group), function(function)
+			{
+				execute = &run;
+			}
+
+			static void run(ThreadPool&, ThreadPool::Task* task)
+			{
+				FunctionTask* self = static_cast<FunctionTask*>(task);
+				TaskGroup* group = self->group;
+				self->function();
+				delete self;
+				group->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+			}
+
+			TaskGroup* group;
+			TFunction function;
+		};
+
+		ThreadPool& m_pool;
+		std::atomic<std::size_t> m_pending = 0;
+	};
+
+	template<typename TFirst, typename TSecond>
+	void ThreadPool::invoke(TFirst&& first, TSecond&& second)
+	{
+		TaskGroup group(*this);
+		group.run([&second]() { second(); });
+		first();
+		group.wait();
+	}
+
+	template<typename TWork>
+	void ThreadPool::forEachChunk(std::size_t count, std::size_t chunkCount, TWork&& work)
+	{
+		if (chunkCount <= 1)
+		{
+			work(std::size_t(0), std::size_t(0), count);
+			return;
+		}
+
+		TaskGroup group(global());
+		for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+		{
+			group.run([&work, count, chunkCount, chunk]() { work(chunk, count * chunk / chunkCount, count * (chunk + 1) / chunkCount); });
+		}
+		work(std::size_t(0), std::size_t(0), count / chunkCount);
+		group.wait();
+	}
+
+	// how a batched operation runs.
+	enum class Execution
+	{
+		// one element after the other with the scalar code.
+		Sequential,
+		// SIMD kernels where they exist (MANIMATHS_SIMD), on the calling thread.
+		Vectorized,
+		// vectorized, split across a ThreadPool.
+		Parallel
+	};
+
+	struct ExecutionPolicy
+	{
+		Execution execution = Execution::Sequential;
+		// elements per task of a parallel run, 0 picks one from the batch size and the worker count.
+		std::size_t grainSize = 0;
+		// pool of a parallel run, ThreadPool::global() when null.
+		ThreadPool* pool = nullptr;
+
+		[[nodiscard]] static constexpr ExecutionPolicy sequential()
+		{
+			return { Execution::Sequential };
+		}
+
+		[[nodiscard]] static constexpr ExecutionPolicy vectorized()
+		{
+			return { Execution::Vectorized };
+		}
+
+		[[nodiscard]] static constexpr ExecutionPolicy parallel(std::size_t grainSize = 0, ThreadPool* pool = nullptr)
+		{
+			return { Execution::Parallel, grainSize, pool };
+		}
+
+		[[nodiscard]] constexpr bool isVectorized() const
+		{
+			return execution != Execution::Sequential;
+		}
+
+		// body(begin, end) over [0, count), split across the pool for a parallel policy.
+		template<typename TBody>
+		void run(std::size_t count, TBody&& body) const
+		{
+			if (execution == Execution::Parallel)
+			{
+				(pool != nullptr ? *pool : ThreadPool::global()).parallelFor(count, grainSize, body);
+			}
+			else
+			{
+				body(std::size_t(0), count);
+			}
+		}
+	};
+}
@@ -0,0 +1,495 @@
+#pragma once
+
+#include "Debug.h"
+#include "Binary.h"
+#include "MappedFile.h"
+#include "_Aligned.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace Mani
+{
+	// chunks start at multiples of this, the windows allocation granularity which covers posix pages too,
+	// so that each one is mapped on its own. the header takes the first block.
+	constexpr std::size_t TRACK_BLOCK_SIZE = 65536;
+	constexpr std::size_t TRACK_MAX_COLUMNS = 16;
+	constexpr std::size_t TRACK_DEFAULT_FRAMES_PER_CHUNK = 16384;
+	constexpr std::uint16_t TRACK_VERSION = 1;
+
+	struct TrackHeader
+	{
+		char magic[4] = { 'M', 'T', 'R', 'K' };
+		std::uint16_t version = TRACK_VERSION;
+		std::uint16_t columnCount = 0;
+		std::uint32_t framesPerChunk = 0;
+		std::uint32_t reserved = 0;
+		std::uint64_t chunkSize = 0;
+		std::uint64_t frameCount = 0;
+		Binary::TypeTag columns[TRACK_MAX_COLUMNS] = {};
+	};
+	static_assert(sizeof(TrackHeader) <= TRACK_BLOCK_SIZE && std::is_trivially_copyable_v<TrackHeader>, "the header is stored as is");
+
+	// Where the values of a frame live: chunks hold framesPerChunk frames as one column per type, each column
+	// aligned to Binary::ALIGNMENT, e.g. 16384 Quatf then 16384 Vec3f, padded to a whole number of blocks.
+	template<Binary::IsSerializable... Ts>
+	struct TrackLayout
+	{
+		static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= TRACK_MAX_COLUMNS, "a track has 1 to 16 columns");
+
+		static constexpr std::size_t COLUMN_COUNT = sizeof...(Ts);
+
+		using Frame = std::tuple<Ts...>;
+
+		template<std::size_t C>
+		using Column = std::tuple_element_t<C, Frame>;
+
+		// offsets of the columns in a chunk, the chunk size last.
+		[[nodiscard]] static std::array<std::size_t, COLUMN_COUNT + 1> getOffsets(std::size_t framesPerChunk)
+		{
+			constexpr std::size_t sizes[] = { sizeof(Ts)... };
+			std::array<std::size_t, COLUMN_COUNT + 1> offsets{};
+			std::size_t offset = 0;
+			for (std::size_t column = 0; column < COLUMN_COUNT; ++column)
+			{
+				offsets[column] = offset;
+				offset = roundUp(offset + sizes[column] * framesPerChunk, Binary::ALIGNMENT);
+			}
+			offsets[COLUMN_COUNT] = roundUp(offset, TRACK_BLOCK_SIZE);
+			return offsets;
+		}
+
+		[[nodiscard]] static TrackHeader makeHeader(std::size_t framesPerChunk, std::size_t frameCount)
+		{
+			TrackHeader header;
+			header.columnCount = static_cast<std::uint16_t>(COLUMN_COUNT);
+			header.framesPerChunk = static_cast<std::uint32_t>(framesPerChunk);
+			header.chunkSize = getOffsets(framesPerChunk)[COLUMN_COUNT];
+			header.frameCount = frameCount;
+			const Binary::TypeTag tags[] = { Binary::Layout<Ts>::TAG... };
+			std::copy(std::begin(tags), std::end(tags), header.columns);
+			return header;
+		}
+
+		// whether a header read from a file describes Ts.
+		[[nodiscard]] static bool matches(const TrackHeader& header)
+		{
+			const TrackHeader expected = makeHeader(header.framesPerChunk, header.frameCount);
+			return header.framesPerChunk > 0 && std::memcmp(&header, &expected, sizeof(TrackHeader)) == 0;
+		}
+
+	private:
+		[[nodiscard]] static constexpr std::size_t roundUp(std::size_t value, std::size_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	};
+
+	// Appends frames to a track file, one write per full chunk. the frame count is stored on close.
+	//   TrackWriter<Quatf, Vec3f> writer;
+	//   writer.open("capture.track");
+	//   writer.append(rotation, position);
+	template<Binary::IsSerializable... Ts>
+	class TrackWriter
+	{
+		using Layout = TrackLayout<Ts...>;
+
+	public:
+		TrackWriter() = default;
+
+		~TrackWriter()
+		{
+			close();
+		}
+
+		TrackWriter(const TrackWriter&) = delete;
+		TrackWriter& operator=(const TrackWriter&) = delete;
+
+		// replaces the file, false if it can't be written.
+		bool open(const std::filesystem::path& path, std::size_t framesPerChunk = TRACK_DEFAULT_FRAMES_PER_CHUNK)
+		{
+			close();
+			MANIMATHS_ASSERT(framesPerChunk > 0 && framesPerChunk <= UINT32_MAX);
+			m_offsets = Layout::getOffsets(framesPerChunk);
+			m_framesPerChunk = framesPerChunk;
+			m_chunkFrames = 0;
+			m_frameCount = 0;
+			m_chunk.assign(m_offsets[Layout::COLUMN_COUNT], std::byte{ 0 });
+
+			m_file.open(path, std::ios::binary | std::ios::trunc);
+			// the header block, rewritten with the frame count on close.
+			const std::vector<std::byte> block(TRACK_BLOCK_SIZE);
+			m_file.write(reinterpret_cast<const char*>(block.data()), TRACK_BLOCK_SIZE);
+			if (!m_file)
+			{
+				m_file.close();
+				return false;
+			}
+			return true;
+		}
+
+		// writes the chunk in progress and the header, false if any write failed since open.
+		bool close()
+		{
+			if (!m_file.is_open())
+			{
+				return false;
+			}
+			if (m_chunkFrames > 0)
+			{
+				// the unused end of the last chunk is zeroed, so that files are reproducible.
+				for (std::size_t column = 0; column < Layout::COLUMN_COUNT; ++column)
+				{
+					const std::size_t end = column + 1 < Layout::COLUMN_COUNT ? m_offsets[column + 1] : m_offsets[Layout::COLUMN_COUNT];
+					const std::size_t used = m_offsets[column] + m_chunkFrames * getElementSize(column);
+					std::fill(m_chunk.begin() + used, m_chunk.begin() + end, std::byte{ 0 });
+				}
+				flush();
+			}
+			const TrackHeader header = Layout::makeHeader(m_framesPerChunk, m_frameCount);
+			m_file.seekp(0);
+			m_file.write(reinterpret_cast<const char*>(&header), sizeof(TrackHeader));
+			m_file.flush();
+			const bool ok = static_cast<bool>(m_file);
+			m_file.close();
+			m_chunk = {};
+			return ok;
+		}
+
+		[[nodiscard]] bool isOpen() const
+		{
+			return m_file.is_open();
+		}
+
+		[[nodiscard]] std::size_t getFrameCount() const
+		{
+			return m_frameCount;
+		}
+
+		void append(const Ts&... values)
+		{
+			MANIMATHS_ASSERT(isOpen());
+			std::size_t column = 0;
+			((std::memcpy(m_chunk.data() + m_offsets[column++] + m_chunkFrames * sizeof(Ts), &values, sizeof(Ts))), ...);
+			++m_frameCount;
+			if (++m_chunkFrames == m_framesPerChunk)
+			{
+				flush();
+			}
+		}
+
+		// frames i = values[i]..., every span the same size.
+		void append(std::span<const Ts>... values)
+		{
+			MANIMATHS_ASSERT(isOpen());
+			const std::size_t sizes[] = { values.size()... };
+			const std::size_t count = sizes[0];
+			MANIMATHS_ASSERT(std::all_of(std::begin(sizes), std::end(sizes), [count](std::size_t size) { return size == count; }));
+
+			for (std::size_t frame = 0; frame < count;)
+			{
+				const std::size_t n = std::min(count - frame, m_framesPerChunk - m_chunkFrames);
+				std::size_t column = 0;
+				((std::memcpy(m_chunk.data() + m_offsets[column++] + m_chunkFrames * sizeof(Ts), values.data() + frame, n * sizeof(Ts))), ...);
+				frame += n;
+				m_frameCount += n;
+				m_chunkFrames += n;
+				if (m_chunkFrames == m_framesPerChunk)
+				{
+					flush();
+				}
+			}
+		}
+
+	private:
+		[[nodiscard]] static std::size_t getElementSize(std::size_t column)
+		{
+			constexpr std::size_t sizes[] = { sizeof(Ts)... };
+			return sizes[column];
+		}
+
+		void flush()
+		{
+			m_file.write(reinterpret_cast<const char*>(m_chunk.data()), static_cast<std::streamsize>(m_chunk.size()));
+			m_chunkFrames = 0;
+		}
+
+		std::ofstream m_file;
+		std::vector<std::byte, AlignedAllocator<std::byte>> m_chunk;
+		std::array<std::size_t, Layout::COLUMN_COUNT + 1> m_offsets{};
+		std::size_t m_framesPerChunk = 0;
+		// frames in m_chunk.
+		std::size_t m_chunkFrames = 0;
+		std::size_t m_frameCount = 0;
+	};
+
+	// Reads a track file written by TrackWriter<Ts...> through mapped chunks, so that memory use is bounded by the
+	// cache whatever the file size. a chunk read right after the one before starts the read ahead of the next
+	// ones (madvise), other chunks are mapped on demand and the least recently used dropped.
+	// a chunk that can't be mapped closes the reader, the access that hit it returns false.
+	// not thread safe, use one reader per thread.
+	//   TrackReader<Quatf, Vec3f> reader;
+	//   reader.open("capture.track");
+	//   Quatf rotation;
+	//   reader.get<0>(frame, rotation);
+	template<Binary::IsSerializable... Ts>
+	class TrackReader
+	{
+		using Layout = TrackLayout<Ts...>;
+
+	public:
+		template<std::size_t C>
+		using Column = typename Layout::template Column<C>;
+
+		// Frames of one chunk, kept mapped as long as the view lives even once the reader dropped the chunk.
+		class Chunk
+		{
+		public:
+			template<std::size_t C>
+			[[nodiscard]] std::span<const Column<C>> getColumn() const
+			{
+				return { reinterpret_cast<const Column<C>*>(m_mapping->getData() + m_offsets[C]), m_frameCount };
+			}
+
+			[[nodiscard]] std::size_t getFirstFrame() const
+			{
+				return m_firstFrame;
+			}
+
+			[[nodiscard]] std::size_t getFrameCount() const
+			{
+				return m_frameCount;
+			}
+
+		private:
+			friend class TrackReader;
+
+			std::shared_ptr<const MappedFile> m_mapping;
+			std::array<std::size_t, Layout::COLUMN_COUNT + 1> m_offsets{};
+			std::size_t m_firstFrame = 0;
+			std::size_t m_frameCount = 0;
+		};
+
+		TrackReader() = default;
+
+		TrackReader(const TrackReader&) = delete;
+		TrackReader& operator=(const TrackReader&) = delete;
+
+		// cacheSize chunks stay mapped, readAhead of them are read ahead of a sequential playback.
+		// false if the file can't be opened or wasn't written with Ts.
+		bool open(const std::filesystem::path& path, std::size_t cacheSize = 8, std::size_t readAhead = 2)
+		{
+			close();
+			if (!m_file.open(path) || m_file.getSize() < TRACK_BLOCK_SIZE)
+			{
+				m_file.close();
+				return false;
+			}
+			MappedFile headerBlock;
+			if (!headerBlock.open(m_file, 0, sizeof(TrackHeader)))
+			{
+				m_file.close();
+				return false;
+			}
+			std::memcpy(&m_header, headerBlock.getData(), sizeof(TrackHeader));
+			// divided rather than multiplied, a corrupted frame count could overflow the size of the chunks.
+			if (!Layout::matches(m_header) || getChunkCount() > (m_file.getSize() - TRACK_BLOCK_SIZE) / m_header.chunkSize)
+			{
+				close();
+				return false;
+			}
+			m_offsets = Layout::getOffsets(m_header.framesPerChunk);
+			m_readAhead = readAhead;
+			// the current chunk and the ones read ahead are never dropped for each other.
+			m_cacheSize = std::max(cacheSize, readAhead + 1);
+			return true;
+		}
+
+		void close()
+		{
+			m_cache.clear();
+			m_current = {};
+			m_currentIndex = NONE;
+			m_file.close();
+			m_header = TrackHeader();
+		}
+
+		[[nodiscard]] bool isOpen() const
+		{
+			return m_file.isOpen();
+		}
+
+		[[nodiscard]] std::size_t getFrameCount() const
+		{
+			return static_cast<std::size_t>(m_header.frameCount);
+		}
+
+		[[nodiscard]] std::size_t getFramesPerChunk() const
+		{
+			return m_header.framesPerChunk;
+		}
+
+		// 0 once closed.
+		[[nodiscard]] std::size_t getChunkCount() const
+		{
+			if (getFramesPerChunk() == 0)
+			{
+				return 0;
+			}
+			return getFrameCount() / getFramesPerChunk() + (getFrameCount() % getFramesPerChunk() != 0 ? 1 : 0);
+		}
+
+		// value of column C at frame, false if the reader is closed or the chunk can't be mapped.
+		template<std::size_t C>
+		[[nodiscard]] bool get(std::size_t frame, Column<C>& value)
+		{
+			if (!isOpen())
+			{
+				return false;
+			}
+			MANIMATHS_ASSERT(frame < getFrameCount());
+			const std::size_t chunk = frame / getFramesPerChunk();
+			if (chunk != m_currentIndex && !select(chunk))
+			{
+				return false;
+			}
+			std::memcpy(&value, m_current->getData() + m_offsets[C] + (frame - chunk * getFramesPerChunk()) * sizeof(Column<C>), sizeof(Column<C>));
+			return true;
+		}
+
+		[[nodiscard]] bool getFrame(std::size_t frame, std::tuple<Ts...>& values)
+		{
+			return getFrame(frame, values, std::make_index_sequence<Layout::COLUMN_COUNT>{});
+		}
+
+		// whole chunks, for batched playback: chunk i holds frames [i * getFramesPerChunk(), ...).
+		// false if the reader is closed or the chunk can't be mapped.
+		[[nodiscard]] bool getChunk(std::size_t chunk, Chunk& view)
+		{
+			if (!isOpen())
+			{
+				return false;
+			}
+			MANIMATHS_ASSERT(chunk < getChunkCount());
+			if (chunk != m_currentIndex && !select(chunk))
+			{
+				return false;
+			}
+			view.m_mapping = m_current;
+			view.m_offsets = m_offsets;
+			view.m_firstFrame = chunk * getFramesPerChunk();
+			view.m_frameCount = std::min(getFramesPerChunk(), getFrameCount() - view.m_firstFrame);
+			return true;
+		}
+
+	private:
+		static constexpr std::size_t NONE = SIZE_MAX;
+
+		struct Entry
+		{
+			std::size_t chunk = NONE;
+			std::shared_ptr<const MappedFile> mapping;
+			std::uint64_t lastUse = 0;
+		};
+
+		template<std::size_t... Cs>
+		[[nodiscard]] bool getFrame(std::size_t frame, std::tuple<Ts...>& values, std::index_sequence<Cs...>)
+		{
+			return (get<Cs>(frame, std::get<Cs>(values)) && ...);
+		}
+
+		// false, with the reader closed, if the chunk can't be mapped.
+		[[nodiscard]] bool select(std::size_t chunk)
+		{
+			const bool sequential = m_currentIndex != NONE && chunk == m_currentIndex + 1;
+			std::shared_ptr<const MappedFile> mapping = load(chunk);
+			if (!mapping)
+			{
+				close();
+				return false;
+			}
+			m_current = std::move(mapping);
+			m_currentIndex = chunk;
+			if (sequential)
+			{
+				m_current->advise(AccessPattern::Sequential);
+				// only a hint, a chunk that can't be mapped ahead will fail when it is reached.
+				for (std::size_t ahead = chunk + 1; ahead <= chunk + m_readAhead && ahead < getChunkCount(); ++ahead)
+				{
+					if (find(ahead) == nullptr)
+					{
+						const std::shared_ptr<const MappedFile> next = load(ahead);
+						if (!next)
+						{
+							break;
+						}
+						next->advise(AccessPattern::WillNeed);
+					}
+				}
+			}
+			return true;
+		}
+
+		[[nodiscard]] Entry* find(std::size_t chunk)
+		{
+			for (Entry& entry : m_cache)
+			{
+				if (entry.chunk == chunk)
+				{
+					return &entry;
+				}
+			}
+			return nullptr;
+		}
+
+		// the chunk mapping, cached, or nullptr if it can't be mapped. the size was checked on open, running out of
+		// address space or mapping limits is what fails here.
+		[[nodiscard]] std::shared_ptr<const MappedFile> load(std::size_t chunk)
+		{
+			if (Entry* entry = find(chunk))
+			{
+				entry->lastUse = ++m_clock;
+				return entry->mapping;
+			}
+
+			auto mapping = std::make_shared<MappedFile>();
+			if (!mapping->open(m_file, TRACK_BLOCK_SIZE + chunk * m_header.chunkSize, m_header.chunkSize))
+			{
+				return nullptr;
+			}
+
+			Entry* slot = nullptr;
+			if (m_cache.size() < m_cacheSize)
+			{
+				slot = &m_cache.emplace_back();
+			}
+			else
+			{
+				slot = &*std::min_element(m_cache.begin(), m_cache.end(), [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+			}
+			slot->chunk = chunk;
+			slot->mapping = std::move(mapping);
+			slot->lastUse = ++m_clock;
+			return slot->mapping;
+		}
+
+		FileHandle m_file;
+		TrackHeader m_header;
+		std::array<std::size_t, Layout::COLUMN_COUNT + 1> m_offsets{};
+		std::vector<Entry> m_cache;
+		std::size_t m_cacheSize = 8;
+		std::size_t m_readAhead = 2;
+		std::uint64_t m_clock = 0;
+		// chunk of the last access, held so that it is never unmapped under get().
+		std::shared_ptr<const MappedFile> m_current;
+		std::size_t m_currentIndex = NONE;
+	};
+}
@@ -4,11 +4,19 @@
 
 namespace Mani
 {
+	// scalars the standard doesn't classify, like Half: specialize to let them in the numeric concepts.
 	template<typename T>
-	concept IsNumeric = std::is_arithmetic<T>::value;
+	struct NumericTraits
+	{
+		static constexpr bool IS_NUMERIC = false;
+		static constexpr bool IS_FLOATING_POINT = false;
+	};
 
 	template<typename T>
-	concept IsFloatingPoint = std::is_floating_point<T>::value;
+	concept IsNumeric = std::is_arithmetic<T>::value || NumericTraits<T>::IS_NUMERIC;
+
+	template<typename T>
+	concept IsFloatingPoint = std::is_floating_point<T>::value || NumericTraits<T>::IS_FLOATING_POINT;
 
 	template<typename T>
 	concept IsInteger = std::is_integral<T>::value;
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Vec3.h"
+#include "Quat.h"
+#include "Affine3.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace Mani
+{
+	// Scene graph of translation / rotation / scale nodes propagated into world transforms.
+	// Nodes are append only and a parent always exists before its children, so the arrays are in topological
+	// order and a single linear pass sees every parent before its children.
+	// Only dirty nodes and their descendants are recomputed by update().
+	template<IsNumeric T>
+	struct TransformHierarchy
+	{
+		using Index = uint32_t;
+		static constexpr Index INVALID_INDEX = std::numeric_limits<Index>::max();
+
+		[[nodiscard]] std::size_t size() const
+		{
+			return m_parents.size();
+		}
+
+		void reserve(std::size_t capacity)
+		{
+			m_parents.reserve(capacity);
+			m_translations.reserve(capacity);
+			m_rotations.reserve(capacity);
+			m_scales.reserve(capacity);
+			m_worlds.reserve(capacity);
+			m_dirty.reserve(capacity);
+		}
+
+		void clear()
+		{
+			m_parents.clear();
+			m_translations.clear();
+			m_rotations.clear();
+			m_scales.clear();
+			m_worlds.clear();
+			m_dirty.clear();
+			m_top.clear();
+			m_chunks.clear();
+			m_partitionThreadCount = 0;
+		}
+
+		// parent must already be in the hierarchy, or INVALID_INDEX for a root. the new node starts dirty.
+		Index add(Index parent, const Vec<T, 3>& translation, const Quat<T>& rotation, const Vec<T, 3>& scale)
+		{
+			MANIMATHS_ASSERT(parent == INVALID_INDEX || parent < size());
+			MANIMATHS_ASSERT(size() < INVALID_INDEX);
+
+			const Index index = static_cast<Index>(size());
+			m_parents.push_back(parent);
+			m_translations.push_back(translation);
+			m_rotations.push_back(rotation);
+			m_scales.push_back(scale);
+			m_worlds.push_back(Affine3<T>::identity());
+			m_dirty.push_back(1);
+			m_partitionThreadCount = 0;
+			return index;
+		}
+
+		Index add(Index parent = INVALID_INDEX)
+		{
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			return add(parent, { _0, _0, _0 }, { _0, _0, _0, _1 }, { _1, _1, _1 });
+		}
+
+		[[nodiscard]] Index getParent(Index i) const
+		{
+			MANIMATHS_ASSERT(i < size());
+			return m_parents[i];
+		}
+
+		[[nodiscard]] const Vec<T, 3>& getLocalTranslation(Index i) const	{ MANIMATHS_ASSERT(i < size()); return m_translations[i]; }
+		[[nodiscard]] const Quat<T>& getLocalRotation(Index i) const		{ MANIMATHS_ASSERT(i < size()); return m_rotations[i]; }
+		[[nodiscard]] const Vec<T, 3>& getLocalScale(Index i) const			{ MANIMATHS_ASSERT(i < size()); return m_scales[i]; }
+
+		void setLocalTranslation(Index i, const Vec<T, 3>& translation)		{ MANIMATHS_ASSERT(i < size()); m_translations[i] = translation; m_dirty[i] = 1; }
+		void setLocalRotation(Index i, const Quat<T>& rotation)				{ MANIMATHS_ASSERT(i < size()); m_rotations[i] = rotation; m_dirty[i] = 1; }
+		void setLocalScale(Index i, const Vec<T, 3>& scale)					{ MANIMATHS_ASSERT(i < size()); m_scales[i] = scale; m_dirty[i] = 1; }
+
+		void setLocal(Index i, const Vec<T, 3>& translation, const Quat<T>& rotation, const Vec<T, 3>& scale)
+		{
+			MANIMATHS_ASSERT(i < size());
+			m_translations[i] = translation;
+			m_rotations[i] = rotation;
+			m_scales[i] = scale;
+			m_dirty[i] = 1;
+		}
+
+		[[nodiscard]] bool isDirty(Index i) const
+		{
+			MANIMATHS_ASSERT(i < size());
+			return m_dirty[i] != 0;
+		}
+
+		// world transforms are only valid after update().
+		[[nodiscard]] const Affine3<T>& getWorld(Index i) const
+		{
+			MANIMATHS_ASSERT(i < size());
+			return m_worlds[i];
+		}
+
+		[[nodiscard]] Mat<T, 4, 4> getWorldMatrix(Index i) const
+		{
+			return toMat4(getWorld(i));
+		}
+
+		[[nodiscard]] std::span<const Affine3<T>> getWorlds() const
+		{
+			return m_worlds;
+		}
+
+		// single linear pass: a node is recomputed when it, or any of its ancestors, is dirty.
+		void update()
+		{
+			const std::size_t n = size();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				updateNode(static_cast<Index>(i));
+			}
+			std::fill(m_dirty.begin(), m_dirty.end(), static_cast<uint8_t>(0));
+		}
+
+		// the hierarchy is cut in independent subtrees dealt to threadCount chunks, see partition(). the few nodes above
+		// the cut are updated inline, then one fork / join on the global ThreadPool runs every chunk. small hierarchies
+		// aren't worth the fork and stay serial.
+		void update(std::size_t threadCount)
+		{
+			if (threadCount <= 1 || size() < PARALLEL_THRESHOLD)
+			{
+				update();
+				return;
+			}
+
+			if (m_partitionThreadCount != threadCount)
+			{
+				partition(threadCount);
+			}
+			for (const Index i : m_top)
+			{
+				updateNode(i);
+			}
+			ThreadPool::forEachChunk(m_chunks.size(), m_chunks.size(), [this](std::size_t chunk, std::size_t, std::size_t)
+			{
+				for (const Index i : m_chunks[chunk])
+				{
+					updateNode(i);
+				}
+			});
+			std::fill(m_dirty.begin(), m_dirty.end(), static_cast<uint8_t>(0));
+		}
+
+	private:
+		static constexpr std::size_t PARALLEL_THRESHOLD = 4096;
+
+		// nodes with a subtree bigger than size / (threadCount * 4) form the top, the subtrees hanging off the top don't
+		// depend on each other. largest subtrees go first to the least loaded chunk, every chunk keeps its nodes in index
+		// order so parents are still visited first. cached until the hierarchy or the thread count changes.
+		void partition(std::size_t threadCount)
+		{
+			const std::size_t n = size();
+			std::vector<Index> subtreeSizes(n, 1);
+			for (std::size_t i = n; i-- > 0;)
+			{
+				if (m_parents[i] != INVALID_INDEX)
+				{
+					subtreeSizes[m_parents[i]] += subtreeSizes[i];
+				}
+			}
+
+			// subtree of every node below the top, INVALID_INDEX for the top.
+			const std::size_t grain = Math::maxT(n / (threadCount * 4), static_cast<std::size_t>(1));
+			std::vector<Index> subtrees(n);
+			std::vector<Index> subtreeCounts;
+			m_top.clear();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const Index parent = m_parents[i];
+				if (subtreeSizes[i] > grain)
+				{
+					subtrees[i] = INVALID_INDEX;
+					m_top.push_back(static_cast<Index>(i));
+				}
+				else if (parent == INVALID_INDEX || subtrees[parent] == INVALID_INDEX)
+				{
+					subtrees[i] = static_cast<Index>(subtreeCounts.size());
+					subtreeCounts.push_back(subtreeSizes[i]);
+				}
+				else
+				{
+					subtrees[i] = subtrees[parent];
+				}
+			}
+
+			std::vector<Index> order(subtreeCounts.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&subtreeCounts](Index a, Index b) { return subtreeCounts[a] > subtreeCounts[b]; });
+
+			std::vector<std::size_t> loads(Math::minT(threadCount, subtreeCounts.size()), 0);
+			std::vector<Index> subtreeChunks(subtreeCounts.size());
+			for (const Index subtree : order)
+			{
+				const auto chunk = std::min_element(loads.begin(), loads.end());
+				*chunk += subtreeCounts[subtree];
+				subtreeChunks[subtree] = static_cast<Index>(chunk - loads.begin());
+			}
+
+			m_chunks.assign(loads.size(), {});
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				if (subtrees[i] != INVALID_INDEX)
+				{
+					m_chunks[subtreeChunks[subtrees[i]]].push_back(static_cast<Index>(i));
+				}
+			}
+			m_partitionThreadCount = threadCount;
+		}
+
+		// the parent has already been visited, its dirty flag tells whether its world changed during this pass.
+		void updateNode(Index i)
+		{
+			const Index parent = m_parents[i];
+			if (parent != INVALID_INDEX)
+			{
+				m_dirty[i] |= m_dirty[parent];
+			}
+			if (m_dirty[i] == 0)
+			{
+				return;
+			}
+
+			const Affine3<T> local = Affine3<T>::fromTRS(m_translations[i], m_rotations[i], m_scales[i]);
+			m_worlds[i] = parent != INVALID_INDEX ? m_worlds[parent] * local : local;
+		}
+
+		std::vector<Index> m_parents;
+		std::vector<Vec<T, 3>> m_translations;
+		std::vector<Quat<T>> m_rotations;
+		std::vector<Vec<T, 3>> m_scales;
+		std::vector<Affine3<T>> m_worlds;
+		std::vector<uint8_t> m_dirty;
+
+		// threaded update partition, stale when m_partitionThreadCount is 0.
+		std::vector<Index> m_top;
+		std::vector<std::vector<Index>> m_chunks;
+		std::size_t m_partitionThreadCount = 0;
+	};
+
+	typedef TransformHierarchy<float>	TransformHierarchyf;
+	typedef TransformHierarchy<double>	TransformHierarchyd;
+}
@@ -119,6 +119,7 @@ namespace Mani
 	typedef Vec<double,			2> Vec2d;
 	typedef Vec<unsigned int,	2> Vec2ui;
 	typedef Vec<unsigned long,	2> Vec2ul;
+	typedef Vec<Fixed16_16,		2> Vec2x;
 
 	template<IsNumeric T1, IsNumeric T2>
 	[[nodiscard]] constexpr bool operator==(const Vec<T1, 2>& lhs, const Vec<T2, 2>& rhs)
@@ -116,7 +116,6 @@ namespace Mani
 			return clamp(*this, target);
 		}
 
-		template<IsNumeric T>
 		[[nodiscard]] static Vec<T, 3> sphericalRandom(T radius)
 		{
 			constexpr T _2PI = static_cast<T>(Math::PId * 2);
@@ -126,13 +125,18 @@ namespace Mani
 			
 			MANIMATHS_ASSERT(radius > _0);
 
-			const float theta = Math::linearRand(_0, _2PI);
-			const float phi = Math::acos(Math::linearRand(__1, _1));
+			const T theta = Math::linearRand(_0, _2PI);
+			const T phi = Math::acos(Math::linearRand(__1, _1));
+
+			T sinTheta, cosTheta;
+			T sinPhi, cosPhi;
+			Math::sincos(theta, sinTheta, cosTheta);
+			Math::sincos(phi, sinPhi, cosPhi);
 
 			const Vec<T, 3> v = {
-				Math::sin(phi) * Math::cos(theta),
-				Math::sin(phi) * Math::sin(theta),
-				Math::cos(phi),
+				sinPhi * cosTheta,
+				sinPhi * sinTheta,
+				cosPhi,
 			};
 			return v * radius;
 		}
@@ -158,6 +162,7 @@ namespace Mani
 	typedef Vec<double,			3> Vec3d;
 	typedef Vec<unsigned int,	3> Vec3ui;
 	typedef Vec<unsigned long,	3> Vec3ul;
+	typedef Vec<Fixed16_16,		3> Vec3x;
 
 	template<IsNumeric T1, IsNumeric T2>
 	[[nodiscard]] constexpr bool operator==(const Vec<T1, 3>& lhs, const Vec<T2, 3>& rhs)
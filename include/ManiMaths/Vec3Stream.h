@@ -0,0 +1,327 @@
+#pragma once
+
+#include "_Vec.h"
+#include "_Aligned.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include "Simd.h"
+#include "Vec3.h"
+#include <span>
+#include <vector>
+
+namespace Mani
+{
+	// Structure of arrays container for Vec<T, 3>.
+	// x, y and z live in separate aligned arrays so that batched operations run over contiguous lanes
+	// instead of paying a call per element.
+	template<IsNumeric T>
+	struct Vec3Stream
+	{
+		using Array = std::vector<T, AlignedAllocator<T>>;
+
+		Array x;
+		Array y;
+		Array z;
+
+		[[nodiscard]] static Vec3Stream<T> make(std::size_t size)
+		{
+			Vec3Stream<T> stream;
+			stream.resize(size);
+			return stream;
+		}
+
+		[[nodiscard]] static Vec3Stream<T> make(std::span<const Vec<T, 3>> values)
+		{
+			Vec3Stream<T> stream;
+			stream.gather(values);
+			return stream;
+		}
+
+		[[nodiscard]] std::size_t size() const
+		{
+			return x.size();
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return x.empty();
+		}
+
+		void resize(std::size_t size)
+		{
+			x.resize(size);
+			y.resize(size);
+			z.resize(size);
+		}
+
+		[[nodiscard]] Vec<T, 3> get(std::size_t i) const
+		{
+			MANIMATHS_ASSERT(i < size());
+			return { x[i], y[i], z[i] };
+		}
+
+		void set(std::size_t i, const Vec<T, 3>& v)
+		{
+			MANIMATHS_ASSERT(i < size());
+			x[i] = v.x;
+			y[i] = v.y;
+			z[i] = v.z;
+		}
+
+		// AoS -> SoA, resizes the stream to match values. no allocation happens when the capacity is already there.
+		void gather(std::span<const Vec<T, 3>> values)
+		{
+			resize(values.size());
+			T* px = x.data();
+			T* py = y.data();
+			T* pz = z.data();
+			for (std::size_t i = 0; i < values.size(); ++i)
+			{
+				px[i] = values[i].x;
+				py[i] = values[i].y;
+				pz[i] = values[i].z;
+			}
+		}
+
+		// SoA -> AoS, out must be as large as the stream.
+		void scatter(std::span<Vec<T, 3>> out) const
+		{
+			MANIMATHS_ASSERT(out.size() >= size());
+			const T* px = x.data();
+			const T* py = y.data();
+			const T* pz = z.data();
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				out[i] = { px[i], py[i], pz[i] };
+			}
+		}
+
+		// out[i] = lhs[i] + rhs[i], out may be lhs or rhs.
+		static void add(const Vec3Stream<T>& lhs, const Vec3Stream<T>& rhs, Vec3Stream<T>& out)
+		{
+			MANIMATHS_ASSERT(lhs.size() == rhs.size());
+			out.resize(lhs.size());
+			addArrays(lhs.x.data(), rhs.x.data(), out.x.data(), lhs.size());
+			addArrays(lhs.y.data(), rhs.y.data(), out.y.data(), lhs.size());
+			addArrays(lhs.z.data(), rhs.z.data(), out.z.data(), lhs.size());
+		}
+
+		// out[i] = lhs[i] - rhs[i], out may be lhs or rhs.
+		static void sub(const Vec3Stream<T>& lhs, const Vec3Stream<T>& rhs, Vec3Stream<T>& out)
+		{
+			MANIMATHS_ASSERT(lhs.size() == rhs.size());
+			out.resize(lhs.size());
+			subArrays(lhs.x.data(), rhs.x.data(), out.x.data(), lhs.size());
+			subArrays(lhs.y.data(), rhs.y.data(), out.y.data(), lhs.size());
+			subArrays(lhs.z.data(), rhs.z.data(), out.z.data(), lhs.size());
+		}
+
+		// out[i] = v[i] * scale, out may be v.
+		template<IsNumeric TScale>
+		static void scale(const Vec3Stream<T>& v, TScale scale, Vec3Stream<T>& out)
+		{
+			out.resize(v.size());
+			scaleArray(v.x.data(), static_cast<T>(scale), out.x.data(), v.size());
+			scaleArray(v.y.data(), static_cast<T>(scale), out.y.data(), v.size());
+			scaleArray(v.z.data(), static_cast<T>(scale), out.z.data(), v.size());
+		}
+
+		// out[i] = dot(v1[i], v2[i])
+		static void dot(const Vec3Stream<T>& v1, const Vec3Stream<T>& v2, std::span<T> out)
+		{
+			MANIMATHS_ASSERT(v1.size() == v2.size() && out.size() >= v1.size());
+			const T* x1 = v1.x.data(); const T* y1 = v1.y.data(); const T* z1 = v1.z.data();
+			const T* x2 = v2.x.data(); const T* y2 = v2.y.data(); const T* z2 = v2.z.data();
+			T* o = out.data();
+			for (std::size_t i = 0; i < v1.size(); ++i)
+			{
+				o[i] = x1[i] * x2[i] + y1[i] * y2[i] + z1[i] * z2[i];
+			}
+		}
+
+		void dot(const Vec3Stream<T>& other, std::span<T> out) const
+		{
+			dot(*this, other, out);
+		}
+
+		// out[i] = cross(v1[i], v2[i]), out may be v1 or v2.
+		static void cross(const Vec3Stream<T>& v1, const Vec3Stream<T>& v2, Vec3Stream<T>& out)
+		{
+			MANIMATHS_ASSERT(v1.size() == v2.size());
+			const std::size_t n = v1.size();
+			out.resize(n);
+			const T* x1 = v1.x.data(); const T* y1 = v1.y.data(); const T* z1 = v1.z.data();
+			const T* x2 = v2.x.data(); const T* y2 = v2.y.data(); const T* z2 = v2.z.data();
+			T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				// load everything first, out may alias the inputs.
+				const T ax = x1[i], ay = y1[i], az = z1[i];
+				const T bx = x2[i], by = y2[i], bz = z2[i];
+				ox[i] = ay * bz - by * az;
+				oy[i] = az * bx - bz * ax;
+				oz[i] = ax * by - bx * ay;
+			}
+		}
+
+		void cross(const Vec3Stream<T>& other, Vec3Stream<T>& out) const
+		{
+			cross(*this, other, out);
+		}
+
+		void lengthSquared(std::span<T> out) const
+		{
+			MANIMATHS_ASSERT(out.size() >= size());
+			dot(*this, *this, out);
+		}
+
+		void length(std::span<T> out) const
+		{
+			MANIMATHS_ASSERT(out.size() >= size());
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				Simd::length3(x.data(), y.data(), z.data(), out.data(), size());
+				return;
+			}
+#endif
+			const T* px = x.data(); const T* py = y.data(); const T* pz = z.data();
+			T* o = out.data();
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				o[i] = Math::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+			}
+		}
+
+		// same semantic as Vec<T, 3>::normalize, zero length vectors are left untouched. out may be v.
+		static void normalize(const Vec3Stream<T>& v, Vec3Stream<T>& out)
+		{
+			const std::size_t n = v.size();
+			out.resize(n);
+#if defined(MANIMATHS_SIMD_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				Simd::normalize3(v.x.data(), v.y.data(), v.z.data(), out.x.data(), out.y.data(), out.z.data(), n);
+				return;
+			}
+#endif
+			constexpr T _0 = static_cast<T>(0);
+			constexpr T _1 = static_cast<T>(1);
+			const T* px = v.x.data(); const T* py = v.y.data(); const T* pz = v.z.data();
+			T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const T l = Math::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+				const T invL = l > _0 ? _1 / l : _1;
+				ox[i] = px[i] * invL;
+				oy[i] = py[i] * invL;
+				oz[i] = pz[i] * invL;
+			}
+		}
+
+		Vec3Stream<T>& normalize()
+		{
+			normalize(*this, *this);
+			return *this;
+		}
+
+		// out[i] = distanceSquared(v1[i], v2[i])
+		static void distanceSquared(const Vec3Stream<T>& v1, const Vec3Stream<T>& v2, std::span<T> out)
+		{
+			MANIMATHS_ASSERT(v1.size() == v2.size() && out.size() >= v1.size());
+			const T* x1 = v1.x.data(); const T* y1 = v1.y.data(); const T* z1 = v1.z.data();
+			const T* x2 = v2.x.data(); const T* y2 = v2.y.data(); const T* z2 = v2.z.data();
+			T* o = out.data();
+			for (std::size_t i = 0; i < v1.size(); ++i)
+			{
+				const T dx = x2[i] - x1[i];
+				const T dy = y2[i] - y1[i];
+				const T dz = z2[i] - z1[i];
+				o[i] = dx * dx + dy * dy + dz * dz;
+			}
+		}
+
+		void distanceSquared(const Vec3Stream<T>& other, std::span<T> out) const
+		{
+			distanceSquared(*this, other, out);
+		}
+
+	private:
+		// plain loops over contiguous arrays, compilers vectorize these on their own.
+		static void addArrays(const T* lhs, const T* rhs, T* out, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				out[i] = lhs[i] + rhs[i];
+			}
+		}
+
+		static void subArrays(const T* lhs, const T* rhs, T* out, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				out[i] = lhs[i] - rhs[i];
+			}
+		}
+
+		static void scaleArray(const T* v, T scale, T* out, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				out[i] = v[i] * scale;
+			}
+		}
+	};
+
+	typedef Vec3Stream<float>	Vec3fStream;
+	typedef Vec3Stream<double>	Vec3dStream;
+
+	template<IsNumeric T>
+	[[nodiscard]] Vec3Stream<T> operator+(const Vec3Stream<T>& lhs, const Vec3Stream<T>& rhs)
+	{
+		Vec3Stream<T> result;
+		Vec3Stream<T>::add(lhs, rhs, result);
+		return result;
+	}
+
+	template<IsNumeric T>
+	[[nodiscard]] Vec3Stream<T> operator-(const Vec3Stream<T>& lhs, const Vec3Stream<T>& rhs)
+	{
+		Vec3Stream<T> result;
+		Vec3Stream<T>::sub(lhs, rhs, result);
+		return result;
+	}
+
+	template<IsNumeric T, IsNumeric TScale>
+	[[nodiscard]] Vec3Stream<T> operator*(const Vec3Stream<T>& lhs, TScale scale)
+	{
+		Vec3Stream<T> result;
+		Vec3Stream<T>::scale(lhs, scale, result);
+		return result;
+	}
+
+	template<IsNumeric T, IsNumeric TScale>
+	[[nodiscard]] Vec3Stream<T> operator*(TScale scale, const Vec3Stream<T>& rhs)
+	{
+		return rhs * scale;
+	}
+
+	template<IsNumeric T>
+	void operator+=(Vec3Stream<T>& lhs, const Vec3Stream<T>& rhs)
+	{
+		Vec3Stream<T>::add(lhs, rhs, lhs);
+	}
+
+	template<IsNumeric T>
+	void operator-=(Vec3Stream<T>& lhs, const Vec3Stream<T>& rhs)
+	{
+		Vec3Stream<T>::sub(lhs, rhs, lhs);
+	}
+
+	template<IsNumeric T, IsNumeric TScale>
+	void operator*=(Vec3Stream<T>& lhs, TScale scale)
+	{
+		Vec3Stream<T>::scale(lhs, scale, lhs);
+	}
+}
@@ -122,6 +122,7 @@ namespace Mani
     typedef Vec<double,         4> Vec4d;
     typedef Vec<unsigned int,   4> Vec4ui;
     typedef Vec<unsigned long,  4> Vec4ul;
+    typedef Vec<Fixed16_16,     4> Vec4x;
 
     template<IsNumeric T1, IsNumeric T2>
     [[nodiscard]] constexpr bool operator==(const Vec<T1, 4>& lhs, const Vec<T2, 4>& rhs)
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "_Vec.h"
+#include "Debug.h"
+#include "Traits.h"
+#include "Maths.h"
+#include <cstddef>
+#include <format>
+#include <string>
+#include <utility>
+
+namespace Mani
+{
+	// sizes without a hand written specialization.
+	template<Size I>
+	concept IsGenericVecSize = I != 2 && I != 3 && I != 4;
+
+	namespace Generic
+	{
+		// f(0), f(1) ... f(N - 1) expanded at compile time: the loops of the generic types are unrolled
+		// whatever the optimizer decides, and stay usable in constant expressions.
+		template<std::size_t N, typename TFunc>
+		constexpr void unroll(TFunc&& f)
+		{
+			[&]<std::size_t... Is>(std::index_sequence<Is...>)
+			{
+				(f(Is), ...);
+			}(std::make_index_sequence<N>{});
+		}
+	}
+
+	// Array backed vector of any size but the hand written 2, 3 and 4, e.g. Vec<float, 6> for a filter state.
+	template<IsNumeric T, Size I>
+	struct Vec
+	{
+		static_assert(I > 0, "vectors have at least one component");
+
+		T data[I] = {};
+
+		[[nodiscard]] static constexpr Vec<T, I> make(T v)
+		{
+			Vec<T, I> result;
+			Generic::unroll<I>([&](std::size_t i) { result.data[i] = v; });
+			return result;
+		}
+
+		[[nodiscard]] constexpr T& operator[](Size i)
+		{
+			MANIMATHS_ASSERT(i < I);
+			return data[i];
+		}
+
+		[[nodiscard]] constexpr const T& operator[](Size i) const
+		{
+			MANIMATHS_ASSERT(i < I);
+			return data[i];
+		}
+
+		template<IsNumeric T1, IsNumeric T2>
+		[[nodiscard]] static bool isNearlyEqual(const Vec<T1, I>& lhs, const Vec<T2, I>& rhs, double tolerance = FLT_EPSILON)
+		{
+			bool equal = true;
+			Generic::unroll<I>([&](std::size_t i) { equal &= Math::abs(lhs.data[i] - rhs.data[i]) <= tolerance; });
+			return equal;
+		}
+
+		template<IsNumeric T2>
+		[[nodiscard]] bool isNearlyEqual(const Vec<T2, I>& rhs, double tolerance = FLT_EPSILON) const
+		{
+			return isNearlyEqual(*this, rhs, tolerance);
+		}
+
+		[[nodiscard]] T length() const
+		{
+			return Math::sqrt(lengthSquared());
+		}
+
+		[[nodiscard]] constexpr T lengthSquared() const
+		{
+			return dot(*this, *this);
+		}
+
+		[[nodiscard]] Vec<T, I> normalize() const
+		{
+			constexpr T _1 = static_cast<T>(1);
+			T l = length();
+			if (l > 0)
+			{
+				return *this * (_1 / l);
+			}
+			return *this;
+		}
+
+		template<IsNumeric T1, IsNumeric T2>
+		[[nodiscard]] static T distance(const Vec<T1, I>& v1, const Vec<T2, I>& v2)
+		{
+			return Math::sqrt(distanceSquared(v1, v2));
+		}
+
+		template<IsNumeric T2>
+		[[nodiscard]] T distance(const Vec<T2, I>& other) const
+		{
+			return distance(*this, other);
+		}
+
+		template<IsNumeric T1, IsNumeric T2>
+		[[nodiscard]] static constexpr T distanceSquared(const Vec<T1, I>& v1, const Vec<T2, I>& v2)
+		{
+			T sum = static_cast<T>(0);
+			Generic::unroll<I>([&](std::size_t i) { sum += (v2.data[i] - v1.data[i]) * (v2.data[i] - v1.data[i]); });
+			return sum;
+		}
+
+		template<IsNumeric T2>
+		[[nodiscard]] constexpr T distanceSquared(const Vec<T2, I>& other) const
+		{
+			return distanceSquared(*this, other);
+		}
+
+		template<IsNumeric T1, IsNumeric T2>
+		[[nodiscard]] static constexpr T dot(const Vec<T1, I>& v1, const Vec<T2, I>& v2)
+		{
+			T sum = static_cast<T>(0);
+			Generic::unroll<I>([&](std::size_t i) { sum += v1.data[i] * v2.data[i]; });
+			return sum;
+		}
+
+		template<IsNumeric T2>
+		[[nodiscard]] constexpr T dot(const Vec<T2, I>& other) const
+		{
+			return dot(*this, other);
+		}
+
+		[[nodiscard]] static Vec<T, I> clamp(const Vec<T, I>& v, T target)
+		{
+			if (v.length() > target)
+			{
+				return v.normalize() * target;
+			}
+			return v;
+		}
+
+		[[nodiscard]] Vec<T, I> clamp(T target) const
+		{
+			return clamp(*this, target);
+		}
+
+		[[nodiscard]] constexpr Vec<T, I> operator-() const
+		{
+			Vec<T, I> result;
+			Generic::unroll<I>([&](std::size_t i) { result.data[i] = -data[i]; });
+			return result;
+		}
+
+		[[nodiscard]] std::string toString() const
+		{
+			std::string result = "(";
+			for (Size i = 0; i < I; ++i)
+			{
+				result += std::format(i == 0 ? "{}" : ", {}", data[i]);
+			}
+			return result + ")";
+		}
+	};
+
+	// component i of any vector, hand written ones included. generic code over every size goes through it.
+	template<IsNumeric T, Size I>
+	[[nodiscard]] constexpr T& component(Vec<T, I>& v, std::size_t i)
+	{
+		MANIMATHS_ASSERT(i < I);
+		if constexpr (IsGenericVecSize<I>)
+		{
+			return v.data[i];
+		}
+		else
+		{
+			return (&v.x)[i];
+		}
+	}
+
+	template<IsNumeric T, Size I>
+	[[nodiscard]] constexpr const T& component(const Vec<T, I>& v, std::size_t i)
+	{
+		MANIMATHS_ASSERT(i < I);
+		if constexpr (IsGenericVecSize<I>)
+		{
+			return v.data[i];
+		}
+		else
+		{
+			return (&v.x)[i];
+		}
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr bool operator==(const Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		bool equal = true;
+		Generic::unroll<I>([&](std::size_t i) { equal &= lhs.data[i] == rhs.data[i]; });
+		return equal;
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr bool operator!=(const Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I, IsNumeric TReturn = T1> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr Vec<TReturn, I> operator+(const Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		Vec<TReturn, I> result;
+		Generic::unroll<I>([&](std::size_t i) { result.data[i] = lhs.data[i] + rhs.data[i]; });
+		return result;
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I, IsNumeric TReturn = T1> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr Vec<TReturn, I> operator-(const Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		Vec<TReturn, I> result;
+		Generic::unroll<I>([&](std::size_t i) { result.data[i] = lhs.data[i] - rhs.data[i]; });
+		return result;
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I, IsNumeric TReturn = T1> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr Vec<TReturn, I> operator*(const Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		Vec<TReturn, I> result;
+		Generic::unroll<I>([&](std::size_t i) { result.data[i] = lhs.data[i] * rhs.data[i]; });
+		return result;
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I> requires IsGenericVecSize<I>
+	constexpr void operator+=(Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		Generic::unroll<I>([&](std::size_t i) { lhs.data[i] += rhs.data[i]; });
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I> requires IsGenericVecSize<I>
+	constexpr void operator-=(Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		Generic::unroll<I>([&](std::size_t i) { lhs.data[i] -= rhs.data[i]; });
+	}
+
+	template<IsNumeric T1, IsNumeric T2, Size I> requires IsGenericVecSize<I>
+	constexpr void operator*=(Vec<T1, I>& lhs, const Vec<T2, I>& rhs)
+	{
+		Generic::unroll<I>([&](std::size_t i) { lhs.data[i] *= rhs.data[i]; });
+	}
+
+	template<IsNumeric T, IsNumeric TScale, Size I, IsNumeric TReturn = T> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr Vec<TReturn, I> operator*(const Vec<T, I>& lhs, TScale scale)
+	{
+		Vec<TReturn, I> result;
+		Generic::unroll<I>([&](std::size_t i) { result.data[i] = lhs.data[i] * scale; });
+		return result;
+	}
+
+	template<IsNumeric T, IsNumeric TScale, Size I, IsNumeric TReturn = T> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr Vec<TReturn, I> operator*(TScale scale, const Vec<T, I>& rhs)
+	{
+		return rhs * scale;
+	}
+
+	template<IsNumeric T, IsNumeric TScale, Size I> requires IsGenericVecSize<I>
+	constexpr void operator*=(Vec<T, I>& lhs, TScale scale)
+	{
+		Generic::unroll<I>([&](std::size_t i) { lhs.data[i] *= scale; });
+	}
+
+	template<IsNumeric T, IsNumeric TScale, Size I, IsNumeric TReturn = T> requires IsGenericVecSize<I>
+	[[nodiscard]] constexpr Vec<TReturn, I> operator/(const Vec<T, I>& lhs, TScale scale)
+	{
+		MANIMATHS_ASSERT(Math::abs(scale) > 0);
+		Vec<TReturn, I> result;
+		Generic::unroll<I>([&](std::size_t i) { result.data[i] = lhs.data[i] / scale; });
+		return result;
+	}
+
+	template<IsNumeric T, IsNumeric TScale, Size I> requires IsGenericVecSize<I>
+	constexpr void operator/=(Vec<T, I>& lhs, TScale scale)
+	{
+		MANIMATHS_ASSERT(Math::abs(scale) > 0);
+		Generic::unroll<I>([&](std::size_t i) { lhs.data[i] /= scale; });
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace Mani
+{
+	// cache line aligned allocations, wide enough for any SIMD register width.
+	constexpr std::size_t DEFAULT_ALIGNMENT = 64;
+
+	// allocator for std containers whose storage is consumed by SIMD loops.
+	template<typename T, std::size_t Alignment = DEFAULT_ALIGNMENT>
+	struct AlignedAllocator
+	{
+		using value_type = T;
+
+		template<typename U>
+		struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+		constexpr AlignedAllocator() noexcept = default;
+
+		template<typename U>
+		constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+		[[nodiscard]] T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+		}
+
+		void deallocate(T* ptr, std::size_t) noexcept
+		{
+			::operator delete(ptr, std::align_val_t{ Alignment });
+		}
+
+		template<typename U>
+		[[nodiscard]] constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+		{
+			return true;
+		}
+	};
+}
@@ -5,8 +5,10 @@
 
 namespace Mani
 {
+	// 3x3 and 4x4 are hand written with _00.._33 members (Mat3.h, Mat4.h),
+	// any other size is the array backed generic matrix of MatN.h.
 	template<IsNumeric T, Size H, Size W>
-	struct Mat {};
+	struct Mat;
 
 	// helper struct for matrix that allows to call matrices like so mat[x][y]
 	template<IsNumeric T, Size H>
@@ -5,6 +5,8 @@
 
 namespace Mani
 {
+	// 2, 3 and 4 are hand written with x, y, z, w members (Vec2.h, Vec3.h, Vec4.h),
+	// any other size is the array backed generic vector of VecN.h.
 	template<IsNumeric T, Size I>
-	struct Vec {};
+	struct Vec;
 }
\ No newline at end of file
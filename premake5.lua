@@ -1,7 +1,7 @@
 workspace "ManiMaths"
     outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
-    configurations { "Debug" }
+    configurations { "Debug", "Release" }
     startproject "Sandbox"
     architecture "x64"
     language "C++"
@@ -14,8 +14,33 @@ workspace "ManiMaths"
     includedirs { "ThirdParties/ManiTests/include" }
     includedirs { "ThirdParties/ManiZ/include" }
 
+    filter "configurations:Release"
+        optimize "Speed"
+        defines { "NDEBUG" }
+
+    filter { "configurations:Release", "toolset:gcc or clang" }
+        buildoptions { "-O3", "-march=native" }
+
+    filter { "configurations:Release", "toolset:msc*" }
+        vectorextensions "AVX2"
+
+    -- std::thread
+    filter "system:linux"
+        links { "pthread" }
+
+    filter {}
+
 project "Sandbox"
     kind "ConsoleApp"
     location "%{prj.name}"
 
     files { "%{prj.name}/**.h", "%{prj.name}/**.cpp" }
+    defines { "MANIMATHS_SIMD" }
+
+-- microbenchmarks, run the Release configuration: Bench --out results.json
+project "Bench"
+    kind "ConsoleApp"
+    location "%{prj.name}"
+
+    files { "%{prj.name}/**.h", "%{prj.name}/**.cpp" }
+    defines { "MANIMATHS_SIMD" }